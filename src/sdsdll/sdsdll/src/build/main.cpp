@@ -5,6 +5,10 @@
 
 #include <build/sdsdll_pch.hpp>
 
-int __STDCALL_OR_CDECL DllMain(HMODULE, unsigned long, void*) {
-    return 1; // nothing happens when loading/unloading library
+int __STDCALL_OR_CDECL DllMain(HMODULE, unsigned long _Reason, void*) {
+    if (_Reason == DLL_PROCESS_DETACH) { // the static objects are destroyed under the loader lock
+        _SDSDLL _Process_detaching().store(true, _STD memory_order_relaxed);
+    }
+
+    return 1;
 }
\ No newline at end of file
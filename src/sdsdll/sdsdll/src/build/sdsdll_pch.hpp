@@ -30,14 +30,23 @@
 #include <cryptography/cipher/symmetric/aes256_gcm.hpp>
 #include <cryptography/cipher/symmetric/aes_key.hpp>
 #include <cryptography/cipher/symmetric/iv.hpp>
+#include <cryptography/cipher/symmetric/session.hpp>
+#include <cryptography/cipher/symmetric/stream.hpp>
 #include <cryptography/hash/generic/blake3.hpp>
+#include <cryptography/hash/generic/blake3_tree.hpp>
+#include <cryptography/hash/generic/file_reader.hpp>
 #include <cryptography/hash/generic/sha512.hpp>
 #include <cryptography/hash/generic/xxhash.hpp>
 #include <cryptography/hash/hash_types.hpp>
+#include <cryptography/hash/password/arena.hpp>
+#include <cryptography/hash/password/argon2_core.hpp>
 #include <cryptography/hash/password/argon2d.hpp>
 #include <cryptography/hash/password/argon2i.hpp>
 #include <cryptography/hash/password/argon2id.hpp>
+#include <cryptography/hash/password/calibration.hpp>
 #include <cryptography/hash/password/scrypt.hpp>
+#include <cryptography/hash/password/scrypt_core.hpp>
+#include <cryptography/random/drbg.hpp>
 #include <cryptography/random/random.hpp>
 #include <cryptography/random/salt.hpp>
 #include <encoding/bom.hpp>
@@ -49,12 +58,22 @@
 #include <filesystem/directory.hpp>
 #include <filesystem/file.hpp>
 #include <filesystem/link.hpp>
+#include <filesystem/mapped_file.hpp>
 #include <filesystem/path.hpp>
 #include <filesystem/security.hpp>
 #include <filesystem/shortcut.hpp>
 #include <filesystem/status.hpp>
 #include <recovery/arc.hpp>
+#include <system/execution/distributed_lock.hpp>
+#include <system/execution/futex_lock.hpp>
+#include <system/execution/parallel.hpp>
+#include <system/execution/parker.hpp>
 #include <system/execution/process.hpp>
+#include <system/execution/ring_queue.hpp>
+#include <system/execution/task.hpp>
+#include <system/execution/telemetry.hpp>
+#include <system/execution/thread_pool.hpp>
+#include <system/execution/work_stealing.hpp>
 #include <system/handle/generic_handle.hpp>
 #include <system/handle/handle_wrapper.hpp>
 #include <system/handle/library_handle.hpp>
@@ -0,0 +1,195 @@
+// digest_index.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SDSDLL_CORE_CONTAINER_DIGEST_INDEX_HPP_
+#define _SDSDLL_CORE_CONTAINER_DIGEST_INDEX_HPP_
+#include <core/defs.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+#include <core/traits/memory_traits.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// STD types
+using _STD vector;
+
+_SDSDLL_BEGIN
+// CLASS TEMPLATE _Digest_index
+template <size_t _Key_size>
+class _Digest_index { // open-addressing index that maps a fixed-size digest to a position
+private:
+    static_assert(_Key_size >= 8, "Requires at least 8-byte digest.");
+
+public:
+    using size_type = size_t;
+    using pos_type  = uint32_t;
+
+    static constexpr pos_type npos = static_cast<pos_type>(-1);
+
+    _Digest_index() noexcept : _Myslots(), _Mysize(0) {}
+
+    ~_Digest_index() noexcept {}
+
+    _Digest_index(const _Digest_index&) = delete;
+    _Digest_index& operator=(const _Digest_index&) = delete;
+
+    // returns the number of indexed keys
+    _NODISCARD size_type _Size() const noexcept {
+        return _Mysize;
+    }
+
+    // removes all keys
+    void _Clear() noexcept {
+        _Myslots.clear();
+        _Mysize = 0;
+    }
+
+    // prepares the index for at least _Count keys
+    void _Reserve(const size_type _Count) {
+        size_type _New_capacity = _Min_capacity;
+        while (_New_capacity < _Count * 2) { // keep the load factor at most 50%
+            _New_capacity <<= 1;
+        }
+
+        if (_New_capacity > _Myslots.size()) {
+            _Rehash(_New_capacity);
+        }
+    }
+
+    // returns the position stored under _Key (npos if not found)
+    template <class _Fn>
+    _NODISCARD pos_type _Find(const uint8_t* const _Key, const _Fn& _Key_at) const noexcept {
+        // Note: The _Key_at(pos) must return the digest stored at the selected position.
+        //       Only the first 8 bytes are kept in the index, so the whole digest must be
+        //       compared with the source before the position is returned.
+        if (_Mysize == 0) {
+            return npos;
+        }
+
+        const uint64_t _Hash  = _Hash_key(_Key);
+        const size_type _Mask = _Myslots.size() - 1;
+        for (size_type _Idx = static_cast<size_type>(_Hash) & _Mask;; _Idx = (_Idx + 1) & _Mask) {
+            const _Slot& _Cur = _Myslots[_Idx];
+            if (_Cur._Pos == npos) { // empty slot, key not found
+                return npos;
+            }
+
+            if (_Cur._Hash == _Hash
+                && memory_traits::compare(_Key_at(_Cur._Pos), _Key, _Key_size) == 0) { // key found
+                return _Cur._Pos;
+            }
+        }
+    }
+
+    // inserts a new key (the key must not be indexed yet)
+    void _Insert(const uint8_t* const _Key, const pos_type _Pos) {
+        if ((_Mysize + 1) * 2 > _Myslots.size()) { // keep the load factor at most 50%
+            _Rehash(_Myslots.empty() ? _Min_capacity : _Myslots.size() * 2);
+        }
+
+        _Place(_Hash_key(_Key), _Pos);
+        ++_Mysize;
+    }
+
+    // erases the key stored at the selected position
+    void _Erase(const uint8_t* const _Key, const pos_type _Pos) noexcept {
+        const size_type _Idx = _Find_slot(_Hash_key(_Key), _Pos);
+        if (_Idx == static_cast<size_type>(-1)) { // key not indexed
+            return;
+        }
+
+        // Note: Instead of leaving a tombstone, shift the following keys back, so that
+        //       lookups never have to skip deleted slots.
+        const size_type _Mask = _Myslots.size() - 1;
+        size_type _Hole       = _Idx;
+        for (size_type _Next = (_Hole + 1) & _Mask;; _Next = (_Next + 1) & _Mask) {
+            const _Slot& _Cur = _Myslots[_Next];
+            if (_Cur._Pos == npos) { // end of the cluster
+                break;
+            }
+
+            const size_type _Home = static_cast<size_type>(_Cur._Hash) & _Mask;
+            if (((_Next - _Home) & _Mask) >= ((_Next - _Hole) & _Mask)) { // key may fill the hole
+                _Myslots[_Hole] = _Cur;
+                _Hole           = _Next;
+            }
+        }
+
+        _Myslots[_Hole]._Pos = npos;
+        --_Mysize;
+    }
+
+    // changes the position of an indexed key
+    void _Relocate(const uint8_t* const _Key, const pos_type _Old_pos, const pos_type _New_pos) noexcept {
+        const size_type _Idx = _Find_slot(_Hash_key(_Key), _Old_pos);
+        if (_Idx != static_cast<size_type>(-1)) {
+            _Myslots[_Idx]._Pos = _New_pos;
+        }
+    }
+
+private:
+    struct _Slot {
+        uint64_t _Hash; // the first 8 bytes of the digest
+        pos_type _Pos; // position of the digest, npos if the slot is empty
+    };
+
+    static constexpr size_type _Min_capacity = 16;
+
+    // digests are uniformly distributed, so the first 8 bytes are a sufficient hash
+    _NODISCARD static uint64_t _Hash_key(const uint8_t* const _Key) noexcept {
+        uint64_t _Result;
+        memory_traits::copy(&_Result, _Key, sizeof(uint64_t));
+        return _Result;
+    }
+
+    // returns the slot that stores the selected position, -1 if not found
+    _NODISCARD size_type _Find_slot(const uint64_t _Hash, const pos_type _Pos) const noexcept {
+        if (_Mysize == 0) {
+            return static_cast<size_type>(-1);
+        }
+
+        const size_type _Mask = _Myslots.size() - 1;
+        for (size_type _Idx = static_cast<size_type>(_Hash) & _Mask;; _Idx = (_Idx + 1) & _Mask) {
+            const _Slot& _Cur = _Myslots[_Idx];
+            if (_Cur._Pos == npos) { // empty slot, position not found
+                return static_cast<size_type>(-1);
+            }
+
+            if (_Cur._Hash == _Hash && _Cur._Pos == _Pos) {
+                return _Idx;
+            }
+        }
+    }
+
+    // stores a key in the first free slot (no growth)
+    void _Place(const uint64_t _Hash, const pos_type _Pos) noexcept {
+        const size_type _Mask = _Myslots.size() - 1;
+        size_type _Idx        = static_cast<size_type>(_Hash) & _Mask;
+        while (_Myslots[_Idx]._Pos != npos) {
+            _Idx = (_Idx + 1) & _Mask;
+        }
+
+        _Myslots[_Idx] = _Slot{_Hash, _Pos};
+    }
+
+    // moves all keys to a new table with the selected capacity (power of 2)
+    void _Rehash(const size_type _New_capacity) {
+        vector<_Slot> _Old(_New_capacity, _Slot{0, npos});
+        _Myslots.swap(_Old);
+        for (const _Slot& _Cur : _Old) {
+            if (_Cur._Pos != npos) {
+                _Place(_Cur._Hash, _Cur._Pos);
+            }
+        }
+    }
+
+    vector<_Slot> _Myslots;
+    size_type _Mysize; // number of indexed keys
+};
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
+#endif // _SDSDLL_CORE_CONTAINER_DIGEST_INDEX_HPP_
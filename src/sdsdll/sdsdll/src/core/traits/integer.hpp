@@ -11,6 +11,7 @@
 #include <array>
 #include <core/traits/concepts.hpp>
 #include <core/traits/memory_traits.hpp>
+#include <cstddef>
 #include <cstdint>
 
 // STD types
@@ -54,6 +55,53 @@ _NODISCARD constexpr array<uint8_t, sizeof(_Integer)> unpack_integer(const _Inte
         return _Result;
     }
 }
+
+// CONSTANT TEMPLATE max_varint_size
+template <class _Integer>
+inline constexpr size_t max_varint_size = (sizeof(_Integer) * 8 + 6) / 7; // 7 bits per byte
+
+// FUNCTION TEMPLATE encode_varint
+template <class _Integer>
+constexpr size_t encode_varint(_Integer _Val, uint8_t* const _Buf) noexcept {
+    // Note: The _Buf must be able to store at least max_varint_size<_Integer> bytes. Each byte stores
+    //       the next 7 bits (the least significant first), the highest bit marks that more bytes follow.
+    static_assert(is_any_of_v<_Integer, unsigned char, unsigned short, unsigned int, unsigned long,
+        unsigned long long>, "Requires 1/2/4/8-byte unsigned integer.");
+    size_t _Size = 0;
+    while (_Val >= 0x80) {
+        _Buf[_Size++] = static_cast<uint8_t>(_Val | 0x80);
+        _Val        >>= 7;
+    }
+
+    _Buf[_Size++] = static_cast<uint8_t>(_Val);
+    return _Size;
+}
+
+// FUNCTION TEMPLATE decode_varint
+template <class _Integer>
+constexpr size_t decode_varint(const uint8_t* const _Bytes, const size_t _Count, _Integer& _Val) noexcept {
+    // Note: Returns the number of decoded bytes, 0 if the varint is incomplete or does not fit
+    //       into the _Integer.
+    static_assert(is_any_of_v<_Integer, unsigned char, unsigned short, unsigned int, unsigned long,
+        unsigned long long>, "Requires 1/2/4/8-byte unsigned integer.");
+    constexpr size_t _Bits = sizeof(_Integer) * 8;
+    _Integer _Result       = 0;
+    for (size_t _Idx = 0; _Idx < _Count && _Idx < max_varint_size<_Integer>; ++_Idx) {
+        const _Integer _Part = static_cast<_Integer>(_Bytes[_Idx] & 0x7F);
+        const size_t _Shift  = _Idx * 7;
+        if (_Shift + 7 > _Bits && (_Part >> (_Bits - _Shift)) != 0) { // value too large
+            return 0;
+        }
+
+        _Result |= static_cast<_Integer>(_Part << _Shift);
+        if ((_Bytes[_Idx] & 0x80) == 0) { // last byte
+            _Val = _Result;
+            return _Idx + 1;
+        }
+    }
+
+    return 0;
+}
 _SDSDLL_END
 
 #endif // _SDSDLL_PREPROCESSOR_GUARD
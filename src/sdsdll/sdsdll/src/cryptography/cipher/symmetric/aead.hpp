@@ -12,6 +12,10 @@
 #include <openssl/types.h>
 
 _SDSDLL_BEGIN
+// STRUCT TEMPLATE _Aead_evp_cipher
+template <class _Traits>
+struct _Aead_evp_cipher; // selects the OpenSSL cipher for the selected traits
+
 // CLASS _Aead_cipher_context_proxy
 struct _Aead_cipher_context_proxy {
     EVP_CIPHER_CTX* _Ctx;
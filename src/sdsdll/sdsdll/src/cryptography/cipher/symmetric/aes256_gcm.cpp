@@ -22,24 +22,12 @@ _NODISCARD constexpr typename aes256_gcm_traits<_Elem>::size_type
     return _Count - _Tag_size; // always cipher text length - 16-byte tag
 }
 
-// FUNCTION TEMPLATE aes256_gcm_traits::encrypt
+// FUNCTION TEMPLATE aes256_gcm_traits::_Encrypt_raw
 template <class _Elem>
-_NODISCARD constexpr bool aes256_gcm_traits<_Elem>::encrypt(
-    byte_type* const _Buf, const size_type _Buf_size, const char_type* const _Data,
+_NODISCARD bool aes256_gcm_traits<_Elem>::_Encrypt_raw(
+    byte_type* const _Buf, const size_type _Buf_size, const byte_type* const _Data,
     const size_type _Data_size, const key& _Key, const iv& _Iv) noexcept {
-    if (!_Buf) {
-        return false;
-    }
-
-    byte_string _Raw_data;
-    if constexpr (sizeof(_Elem) == 1) { // encrypt a UTF-8 string
-        _Raw_data.assign(reinterpret_cast<const byte_type*>(_Data), _Data_size);
-    } else { // encrypt a Unicode string
-        const utf8_string& _Narrow = utf8_string::from_utf16(_Data, _Data_size);
-        _Raw_data.assign(reinterpret_cast<const byte_type*>(_Narrow.c_str()), _Narrow.size());
-    }
-
-    const size_type _Optimal_buf_size = bytes_count(_Raw_data.size());
+    const size_type _Optimal_buf_size = bytes_count(_Data_size);
     if (_Buf_size < _Optimal_buf_size) {
         return false;
     }
@@ -54,8 +42,7 @@ _NODISCARD constexpr bool aes256_gcm_traits<_Elem>::encrypt(
     }
 
     int _Bytes = 0; // encrypted bytes (unused)
-    if (::EVP_EncryptUpdate(
-        _Proxy._Ctx, _Buf, &_Bytes, _Raw_data.c_str(), static_cast<int>(_Raw_data.size())) == 0) {
+    if (::EVP_EncryptUpdate(_Proxy._Ctx, _Buf, &_Bytes, _Data, static_cast<int>(_Data_size)) == 0) {
         return false;
     }
 
@@ -66,23 +53,10 @@ _NODISCARD constexpr bool aes256_gcm_traits<_Elem>::encrypt(
     return _Get_aead_tag(_Proxy, _Buf + (_Optimal_buf_size - _Tag_size));
 }
 
-// FUNCTION TEMPLATE aes256_gcm_traits::decrypt
+// FUNCTION TEMPLATE aes256_gcm_traits::_Decrypt_raw
 template <class _Elem>
-_NODISCARD constexpr bool aes256_gcm_traits<_Elem>::decrypt(char_type* const _Buf,
-    const size_type _Buf_size, const byte_type* const _Data, const size_type _Data_size,
-    const key& _Key, const iv& _Iv, size_type* const _Count) noexcept {
-    if (!_Buf) {
-        return false;
-    }
-
-    const size_type _Optimal_buf_size = chars_count(_Data_size);
-    if constexpr (sizeof(_Elem) == 1) {
-        // Note: A UTF-8 string length is always equal to _Optimal_buf_size.
-        if (_Buf_size < _Optimal_buf_size) {
-            return false;
-        }
-    }
-
+_NODISCARD bool aes256_gcm_traits<_Elem>::_Decrypt_raw(byte_type* const _Buf,
+    const byte_type* const _Data, const size_type _Data_size, const key& _Key, const iv& _Iv) noexcept {
     _Aead_cipher_context_proxy _Proxy;
     if (!_Proxy._Ctx) {
         return false;
@@ -92,31 +66,72 @@ _NODISCARD constexpr bool aes256_gcm_traits<_Elem>::decrypt(char_type* const _Bu
         return false;
     }
 
-    _Sbo_buffer<byte_type> _Temp_buf(_Optimal_buf_size);
-    if (_Temp_buf._Empty()) { // failed to allocate a buffer
+    int _Bytes = 0; // decrypted bytes (unused)
+    if (::EVP_DecryptUpdate(
+        _Proxy._Ctx, _Buf, &_Bytes, _Data, static_cast<int>(_Data_size - _Tag_size)) == 0) {
         return false;
     }
 
-    int _Bytes = 0; // decrypted bytes (unused)
-    if (::EVP_DecryptUpdate(_Proxy._Ctx,
-        _Temp_buf._Get(), &_Bytes, _Data, static_cast<int>(_Data_size - _Tag_size)) == 0) {
+    if (!_Set_aead_tag(_Proxy, _Data + (_Data_size - _Tag_size))) {
         return false;
     }
 
-    if (!_Set_aead_tag(_Proxy, _Data + (_Data_size - _Tag_size))) {
+    return ::EVP_DecryptFinal_ex(_Proxy._Ctx, _Buf + _Bytes, &_Bytes) != 0;
+}
+
+// FUNCTION TEMPLATE aes256_gcm_traits::encrypt
+template <class _Elem>
+_NODISCARD constexpr bool aes256_gcm_traits<_Elem>::encrypt(
+    byte_type* const _Buf, const size_type _Buf_size, const char_type* const _Data,
+    const size_type _Data_size, const key& _Key, const iv& _Iv) noexcept {
+    if (!_Buf) {
         return false;
     }
 
-    if (::EVP_DecryptFinal_ex(_Proxy._Ctx, _Temp_buf._Get() + _Bytes, &_Bytes) == 0) {
+    if constexpr (sizeof(_Elem) == 1) { // encrypt a UTF-8 string, no copy is needed
+        return _Encrypt_raw(
+            _Buf, _Buf_size, reinterpret_cast<const byte_type*>(_Data), _Data_size, _Key, _Iv);
+    } else { // encrypt a Unicode string
+        const utf8_string& _Narrow = utf8_string::from_utf16(_Data, _Data_size);
+        return _Encrypt_raw(_Buf, _Buf_size,
+            reinterpret_cast<const byte_type*>(_Narrow.c_str()), _Narrow.size(), _Key, _Iv);
+    }
+}
+
+// FUNCTION TEMPLATE aes256_gcm_traits::decrypt
+template <class _Elem>
+_NODISCARD constexpr bool aes256_gcm_traits<_Elem>::decrypt(char_type* const _Buf,
+    const size_type _Buf_size, const byte_type* const _Data, const size_type _Data_size,
+    const key& _Key, const iv& _Iv, size_type* const _Count) noexcept {
+    if (!_Buf || _Data_size < _Tag_size) {
         return false;
     }
 
-    if constexpr (sizeof(_Elem) == 1) { // decrypt a UTF-8 string
-        memory_traits::copy(_Buf, _Temp_buf._Get(), _Optimal_buf_size);
+    const size_type _Optimal_buf_size = chars_count(_Data_size);
+    if constexpr (sizeof(_Elem) == 1) { // decrypt a UTF-8 string directly into the buffer
+        // Note: A UTF-8 string length is always equal to _Optimal_buf_size.
+        if (_Buf_size < _Optimal_buf_size) {
+            return false;
+        }
+
+        if (!_Decrypt_raw(reinterpret_cast<byte_type*>(_Buf), _Data, _Data_size, _Key, _Iv)) {
+            memory_traits::set(_Buf, 0, _Optimal_buf_size); // wipe the unauthenticated plain bytes
+            return false;
+        }
+
         if (_Count) {
             *_Count = _Optimal_buf_size;
         }
     } else { // decrypt a Unicode string
+        _Sbo_buffer<byte_type> _Temp_buf(_Optimal_buf_size);
+        if (_Temp_buf._Empty()) { // failed to allocate a buffer
+            return false;
+        }
+
+        if (!_Decrypt_raw(_Temp_buf._Get(), _Data, _Data_size, _Key, _Iv)) {
+            return false;
+        }
+
         const utf16_string& _Wide = utf16_string::from_utf8(
             reinterpret_cast<const char*>(_Temp_buf._Get()), _Temp_buf._Size());
         memory_traits::copy(_Buf, _Wide.c_str(), _Wide.size() * sizeof(_Elem));
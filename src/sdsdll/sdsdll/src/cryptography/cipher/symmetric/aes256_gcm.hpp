@@ -63,6 +63,23 @@ public:
 
 private:
     static constexpr size_type _Tag_size = 16; // 16-byte authentication tag
+
+    // encrypts raw bytes
+    _NODISCARD static bool _Encrypt_raw(
+        byte_type* const _Buf, const size_type _Buf_size, const byte_type* const _Data,
+        const size_type _Data_size, const key& _Key, const iv& _Iv) noexcept;
+
+    // decrypts raw bytes (the _Buf must be able to store chars_count(_Data_size) bytes)
+    _NODISCARD static bool _Decrypt_raw(byte_type* const _Buf,
+        const byte_type* const _Data, const size_type _Data_size, const key& _Key, const iv& _Iv) noexcept;
+};
+
+// STRUCT TEMPLATE _Aead_evp_cipher
+template <class _Elem>
+struct _Aead_evp_cipher<aes256_gcm_traits<_Elem>> {
+    _NODISCARD static const EVP_CIPHER* _Get() noexcept {
+        return ::EVP_aes_256_gcm();
+    }
 };
 _SDSDLL_END
 
@@ -71,8 +71,13 @@ _NODISCARD constexpr iv<_Size> make_iv() noexcept {
     using _Iv_t    = iv<_Size>;
     using _Value_t = typename _Iv_t::value_type;
     _Value_t _Buf[_Iv_t::size];
-    ::RAND_bytes(_Buf, static_cast<int>(_Iv_t::size));
-    return _Iv_t{_Buf};
+    if (!_SDSDLL _Random_fill(_Buf, _Iv_t::size)) { // no random bytes, return an empty iv
+        return _Iv_t{};
+    }
+
+    const _Iv_t _Result{_Buf};
+    memory_traits::set(_Buf, 0, sizeof(_Buf));
+    return _Result;
 }
 
 template _SDSDLL_API _NODISCARD iv<12> make_iv() noexcept;
@@ -12,8 +12,8 @@
 #include <core/container/bytes.hpp>
 #include <core/traits/string_traits.hpp>
 #include <core/traits/type_traits.hpp>
+#include <cryptography/random/drbg.hpp>
 #include <cstddef>
-#include <openssl/rand.h>
 #include <type_traits>
 
 _SDSDLL_BEGIN
@@ -0,0 +1,214 @@
+// session.cpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <build/sdsdll_pch.hpp>
+#include <cryptography/cipher/symmetric/session.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+
+_SDSDLL_BEGIN
+// FUNCTION _Aead_keyed_contexts constructor/destructor
+_Aead_keyed_contexts::_Aead_keyed_contexts(
+    const EVP_CIPHER* const _Cipher, const symmetric_key<32>& _Key) noexcept
+    : _Myenc(), _Mydec(), _Myfree_enc(), _Myfree_dec(), _Mylock(), _Myvalid(false) {
+    // Note: The key is expanded only once, here. Each message copies one of these contexts
+    //       (with the expanded key) and then sets its own nonce only.
+    if (_Myenc._Ctx && _Mydec._Ctx) {
+        _Myvalid = ::EVP_EncryptInit_ex(_Myenc._Ctx, _Cipher, nullptr, _Key.get(), nullptr) != 0
+            && ::EVP_DecryptInit_ex(_Mydec._Ctx, _Cipher, nullptr, _Key.get(), nullptr) != 0;
+    }
+}
+
+_Aead_keyed_contexts::~_Aead_keyed_contexts() noexcept {
+    for (EVP_CIPHER_CTX* const _Ctx : _Myfree_enc) {
+        ::EVP_CIPHER_CTX_free(_Ctx);
+    }
+
+    for (EVP_CIPHER_CTX* const _Ctx : _Myfree_dec) {
+        ::EVP_CIPHER_CTX_free(_Ctx);
+    }
+}
+
+// FUNCTION _Aead_keyed_contexts::_Acquire
+_NODISCARD EVP_CIPHER_CTX* _Aead_keyed_contexts::_Acquire(const bool _Encrypt) const noexcept {
+    vector<EVP_CIPHER_CTX*>& _Free = _Encrypt ? _Myfree_enc : _Myfree_dec;
+    { // take a free context, each thread that uses the session at the same time gets its own context
+        exclusive_lock_guard _Guard(_Mylock);
+        if (!_Free.empty()) {
+            EVP_CIPHER_CTX* const _Ctx = _Free.back();
+            _Free.pop_back();
+            return _Ctx;
+        }
+    }
+
+    EVP_CIPHER_CTX* const _Ctx = ::EVP_CIPHER_CTX_new();
+    if (!_Ctx) {
+        return nullptr;
+    }
+
+    if (::EVP_CIPHER_CTX_copy(_Ctx, _Encrypt ? _Myenc._Ctx : _Mydec._Ctx) == 0) {
+        ::EVP_CIPHER_CTX_free(_Ctx);
+        return nullptr;
+    }
+
+    return _Ctx;
+}
+
+// FUNCTION _Aead_keyed_contexts::_Release
+void _Aead_keyed_contexts::_Release(EVP_CIPHER_CTX* const _Ctx, const bool _Encrypt) const noexcept {
+    exclusive_lock_guard _Guard(_Mylock);
+    try {
+        (_Encrypt ? _Myfree_enc : _Myfree_dec).push_back(_Ctx);
+    } catch (...) { // failed to allocate, drop the context
+        ::EVP_CIPHER_CTX_free(_Ctx);
+    }
+}
+
+// FUNCTION _Aead_keyed_contexts::_Valid
+_NODISCARD bool _Aead_keyed_contexts::_Valid() const noexcept {
+    return _Myvalid;
+}
+
+// FUNCTION _Aead_keyed_contexts::_Seal
+_NODISCARD bool _Aead_keyed_contexts::_Seal(byte_type* const _Buf,
+    const byte_type* const _Data, const size_type _Data_size, const iv<12>& _Iv) const noexcept {
+    if (!_Myvalid) {
+        return false;
+    }
+
+    EVP_CIPHER_CTX* const _Ctx = _Acquire(true);
+    if (!_Ctx) {
+        return false;
+    }
+
+    int _Bytes         = 0; // encrypted bytes
+    int _Final_bytes   = 0; // always 0 for AEAD ciphers
+    const bool _Result = ::EVP_EncryptInit_ex(_Ctx, nullptr, nullptr, nullptr, _Iv.get()) != 0
+        && ::EVP_EncryptUpdate(_Ctx, _Buf, &_Bytes, _Data, static_cast<int>(_Data_size)) != 0
+        && ::EVP_EncryptFinal_ex(_Ctx, _Buf + _Bytes, &_Final_bytes) != 0
+        && ::EVP_CIPHER_CTX_ctrl(_Ctx, EVP_CTRL_AEAD_GET_TAG, _Tag_size, _Buf + _Data_size) != 0;
+    _Release(_Ctx, true);
+    return _Result;
+}
+
+// FUNCTION _Aead_keyed_contexts::_Open
+_NODISCARD bool _Aead_keyed_contexts::_Open(byte_type* const _Buf,
+    const byte_type* const _Data, const size_type _Data_size, const iv<12>& _Iv) const noexcept {
+    if (!_Myvalid || _Data_size < _Tag_size) {
+        return false;
+    }
+
+    EVP_CIPHER_CTX* const _Ctx = _Acquire(false);
+    if (!_Ctx) {
+        return false;
+    }
+
+    const size_type _Plain_size = _Data_size - _Tag_size;
+    int _Bytes                  = 0; // decrypted bytes
+    int _Final_bytes            = 0; // always 0 for AEAD ciphers
+    const bool _Result          = ::EVP_DecryptInit_ex(_Ctx, nullptr, nullptr, nullptr, _Iv.get()) != 0
+        && ::EVP_DecryptUpdate(_Ctx, _Buf, &_Bytes, _Data, static_cast<int>(_Plain_size)) != 0
+        && ::EVP_CIPHER_CTX_ctrl(_Ctx, EVP_CTRL_AEAD_SET_TAG, _Tag_size,
+            const_cast<byte_type*>(_Data + _Plain_size)) != 0
+        && ::EVP_DecryptFinal_ex(_Ctx, _Buf + _Bytes, &_Final_bytes) != 0; // authentication
+    _Release(_Ctx, false);
+    return _Result;
+}
+
+// FUNCTION TEMPLATE aead_session constructor/destructor
+template <class _Traits>
+aead_session<_Traits>::aead_session(const key& _Key) noexcept
+    : _Mycontexts(_Aead_evp_cipher<_Traits>::_Get(), _Key) {}
+
+template <class _Traits>
+aead_session<_Traits>::~aead_session() noexcept {}
+
+// FUNCTION TEMPLATE aead_session::valid
+template <class _Traits>
+_NODISCARD bool aead_session<_Traits>::valid() const noexcept {
+    return _Mycontexts._Valid();
+}
+
+// FUNCTION TEMPLATE aead_session::encrypt
+template <class _Traits>
+_NODISCARD bool aead_session<_Traits>::encrypt(byte_type* const _Buf, const size_type _Buf_size,
+    const char_type* const _Data, const size_type _Data_size, const iv& _Iv) const noexcept {
+    if (!_Buf) {
+        return false;
+    }
+
+    if constexpr (sizeof(char_type) == 1) { // encrypt a UTF-8 string, no copy is needed
+        if (_Buf_size < _Traits::bytes_count(_Data_size)) {
+            return false;
+        }
+
+        return _Mycontexts._Seal(_Buf, reinterpret_cast<const byte_type*>(_Data), _Data_size, _Iv);
+    } else { // encrypt a Unicode string
+        const utf8_string& _Narrow = utf8_string::from_utf16(_Data, _Data_size);
+        if (_Buf_size < _Traits::bytes_count(_Narrow.size())) {
+            return false;
+        }
+
+        return _Mycontexts._Seal(
+            _Buf, reinterpret_cast<const byte_type*>(_Narrow.c_str()), _Narrow.size(), _Iv);
+    }
+}
+
+// FUNCTION TEMPLATE aead_session::decrypt
+template <class _Traits>
+_NODISCARD bool aead_session<_Traits>::decrypt(char_type* const _Buf, const size_type _Buf_size,
+    const byte_type* const _Data, const size_type _Data_size, const iv& _Iv,
+    size_type* const _Count) const noexcept {
+    if (!_Buf || _Data_size < _Aead_keyed_contexts::_Tag_size) {
+        return false;
+    }
+
+    const size_type _Optimal_buf_size = _Traits::chars_count(_Data_size);
+    if constexpr (sizeof(char_type) == 1) { // decrypt a UTF-8 string directly into the buffer
+        if (_Buf_size < _Optimal_buf_size) {
+            return false;
+        }
+
+        if (!_Mycontexts._Open(reinterpret_cast<byte_type*>(_Buf), _Data, _Data_size, _Iv)) {
+            memory_traits::set(_Buf, 0, _Optimal_buf_size); // wipe the unauthenticated plain bytes
+            return false;
+        }
+
+        if (_Count) {
+            *_Count = _Optimal_buf_size;
+        }
+    } else { // decrypt a Unicode string
+        _Sbo_buffer<byte_type> _Temp_buf(_Optimal_buf_size);
+        if (_Temp_buf._Empty()) { // failed to allocate a buffer
+            return false;
+        }
+
+        if (!_Mycontexts._Open(_Temp_buf._Get(), _Data, _Data_size, _Iv)) {
+            return false;
+        }
+
+        const utf16_string& _Wide = utf16_string::from_utf8(
+            reinterpret_cast<const char*>(_Temp_buf._Get()), _Temp_buf._Size());
+        if (_Buf_size < _Wide.size()) {
+            return false;
+        }
+
+        memory_traits::copy(_Buf, _Wide.c_str(), _Wide.size() * sizeof(char_type));
+        if (_Count) {
+            *_Count = _Wide.size();
+        }
+    }
+
+    return true;
+}
+
+template class _SDSDLL_API aead_session<aes256_gcm_traits<char>>;
+template class _SDSDLL_API aead_session<aes256_gcm_traits<unsigned char>>;
+template class _SDSDLL_API aead_session<aes256_gcm_traits<wchar_t>>;
+template class _SDSDLL_API aead_session<chacha20_poly1305_traits<char>>;
+template class _SDSDLL_API aead_session<chacha20_poly1305_traits<unsigned char>>;
+template class _SDSDLL_API aead_session<chacha20_poly1305_traits<wchar_t>>;
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
@@ -0,0 +1,125 @@
+// session.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SDSDLL_CRYPTOGRAPHY_CIPHER_SYMMETRIC_SESSION_HPP_
+#define _SDSDLL_CRYPTOGRAPHY_CIPHER_SYMMETRIC_SESSION_HPP_
+#include <core/defs.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+#include <core/api.hpp>
+#include <cryptography/cipher/symmetric/aead.hpp>
+#include <cryptography/cipher/symmetric/aes256_gcm.hpp>
+#include <cryptography/cipher/symmetric/chacha20_poly1305.hpp>
+#include <cryptography/cipher/symmetric/iv.hpp>
+#include <cryptography/cipher/symmetric/symmetric_key.hpp>
+#include <cstddef>
+#include <openssl/evp.h>
+#include <openssl/types.h>
+#include <system/execution/shared_lock.hpp>
+#include <vector>
+
+// STD types
+using _STD vector;
+
+_SDSDLL_BEGIN
+// CLASS _Aead_keyed_contexts
+class _SDSDLL_API _Aead_keyed_contexts { // cipher contexts that share one expanded key
+public:
+    using byte_type = unsigned char;
+    using size_type = size_t;
+
+    static constexpr size_type _Tag_size = 16; // 16-byte authentication tag
+
+    explicit _Aead_keyed_contexts(const EVP_CIPHER* const _Cipher, const symmetric_key<32>& _Key) noexcept;
+    ~_Aead_keyed_contexts() noexcept;
+
+    _Aead_keyed_contexts() = delete;
+    _Aead_keyed_contexts(const _Aead_keyed_contexts&) = delete;
+    _Aead_keyed_contexts& operator=(const _Aead_keyed_contexts&) = delete;
+
+    // checks if the key has been set
+    _NODISCARD bool _Valid() const noexcept;
+
+    // encrypts raw bytes (the _Buf must be able to store _Data_size + 16 bytes)
+    _NODISCARD bool _Seal(byte_type* const _Buf,
+        const byte_type* const _Data, const size_type _Data_size, const iv<12>& _Iv) const noexcept;
+
+    // decrypts raw bytes (the _Buf must be able to store _Data_size - 16 bytes)
+    _NODISCARD bool _Open(byte_type* const _Buf,
+        const byte_type* const _Data, const size_type _Data_size, const iv<12>& _Iv) const noexcept;
+
+private:
+    // returns a free context, copies the keyed one if there is no free context
+    _NODISCARD EVP_CIPHER_CTX* _Acquire(const bool _Encrypt) const noexcept;
+
+    // makes the context available for the next message
+    void _Release(EVP_CIPHER_CTX* const _Ctx, const bool _Encrypt) const noexcept;
+
+#ifdef _MSC_VER
+#pragma warning(push, 1)
+#pragma warning(disable : 4251) // C4251: _Aead_cipher_context_proxy and std::vector
+                                //        require dll-interface
+#endif // _MSC_VER
+    _Aead_cipher_context_proxy _Myenc; // keyed encryption context, never used directly
+    _Aead_cipher_context_proxy _Mydec; // keyed decryption context, never used directly
+    mutable vector<EVP_CIPHER_CTX*> _Myfree_enc; // free encryption contexts
+    mutable vector<EVP_CIPHER_CTX*> _Myfree_dec; // free decryption contexts
+    mutable shared_lock _Mylock;
+    bool _Myvalid;
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif // _MSC_VER
+};
+
+// CLASS TEMPLATE aead_session
+template <class _Traits>
+class _SDSDLL_API aead_session { // encrypts/decrypts many messages with the same key
+public:
+    using char_type = typename _Traits::char_type;
+    using byte_type = typename _Traits::byte_type;
+    using size_type = typename _Traits::size_type;
+    using key       = typename _Traits::key;
+    using iv        = typename _Traits::iv;
+
+    explicit aead_session(const key& _Key) noexcept;
+    ~aead_session() noexcept;
+
+    aead_session() = delete;
+    aead_session(const aead_session&) = delete;
+    aead_session& operator=(const aead_session&) = delete;
+
+    // checks if the session is ready to use
+    _NODISCARD bool valid() const noexcept;
+
+    // encrypts a UTF-8/Unicode text with the selected nonce
+    _NODISCARD bool encrypt(byte_type* const _Buf, const size_type _Buf_size,
+        const char_type* const _Data, const size_type _Data_size, const iv& _Iv) const noexcept;
+
+    // decrypts a UTF-8/Unicode text with the selected nonce
+    _NODISCARD bool decrypt(char_type* const _Buf, const size_type _Buf_size, const byte_type* const _Data,
+        const size_type _Data_size, const iv& _Iv, size_type* const _Count = nullptr) const noexcept;
+
+private:
+#ifdef _MSC_VER
+#pragma warning(push, 1)
+#pragma warning(disable : 4251) // C4251: _Aead_keyed_contexts requires dll-interface
+#endif // _MSC_VER
+    _Aead_keyed_contexts _Mycontexts;
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif // _MSC_VER
+};
+
+// ALIAS TEMPLATE aes256_gcm_session
+template <class _Elem>
+using aes256_gcm_session = aead_session<aes256_gcm_traits<_Elem>>;
+
+// ALIAS TEMPLATE chacha20_poly1305_session
+template <class _Elem>
+using chacha20_poly1305_session = aead_session<chacha20_poly1305_traits<_Elem>>;
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
+#endif // _SDSDLL_CRYPTOGRAPHY_CIPHER_SYMMETRIC_SESSION_HPP_
@@ -0,0 +1,109 @@
+// stream.cpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <build/sdsdll_pch.hpp>
+#include <cryptography/cipher/symmetric/stream.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+
+_SDSDLL_BEGIN
+// FUNCTION _Make_aead_segment_nonce
+_NODISCARD iv<12> _Make_aead_segment_nonce(
+    const iv<12>& _Iv, const uint64_t _Segment, const bool _Last) noexcept {
+    // Note: The segment index is XORed into the last 8 bytes of the base IV and the last segment
+    //       is marked in the first byte, so that segments cannot be reordered, dropped or appended.
+    iv<12> _Result        = _Iv;
+    const auto& _As_bytes = _SDSDLL unpack_integer(_Segment);
+    for (size_t _Off = 0; _Off < _As_bytes.size(); ++_Off) {
+        _Result.get()[4 + _Off] ^= _As_bytes[_Off];
+    }
+
+    if (_Last) {
+        _Result.get()[0] ^= 0x80;
+    }
+
+    return _Result;
+}
+
+// FUNCTION _Aead_segment_cipher constructor/destructor
+_Aead_segment_cipher::_Aead_segment_cipher(const EVP_CIPHER* const _Cipher, const bool _Encrypt,
+    const symmetric_key<32>& _Key, const iv<12>& _Iv) noexcept
+    : _Myproxy(), _Myiv(_Iv), _Mysegment(0), _Myvalid(false) {
+    // Note: The key is set only once, each segment sets its own nonce only, so the key schedule
+    //       and the context are reused for the whole stream.
+    if (_Myproxy._Ctx) {
+        _Myvalid = _Encrypt
+            ? ::EVP_EncryptInit_ex(_Myproxy._Ctx, _Cipher, nullptr, _Key.get(), nullptr) != 0
+            : ::EVP_DecryptInit_ex(_Myproxy._Ctx, _Cipher, nullptr, _Key.get(), nullptr) != 0;
+    }
+}
+
+_Aead_segment_cipher::~_Aead_segment_cipher() noexcept {}
+
+// FUNCTION _Aead_segment_cipher::_Valid
+_NODISCARD bool _Aead_segment_cipher::_Valid() const noexcept {
+    return _Myvalid;
+}
+
+// FUNCTION _Aead_segment_cipher::_Seal
+_NODISCARD bool _Aead_segment_cipher::_Seal(const byte_type* const _Data,
+    const size_type _Count, byte_type* const _Buf, const bool _Last) noexcept {
+    const iv<12>& _Nonce = _Make_aead_segment_nonce(_Myiv, _Mysegment, _Last);
+    if (::EVP_EncryptInit_ex(_Myproxy._Ctx, nullptr, nullptr, nullptr, _Nonce.get()) == 0) {
+        return false;
+    }
+
+    int _Bytes = 0; // encrypted bytes
+    if (_Count > 0
+        && ::EVP_EncryptUpdate(_Myproxy._Ctx, _Buf, &_Bytes, _Data, static_cast<int>(_Count)) == 0) {
+        return false;
+    }
+
+    int _Final_bytes = 0; // always 0 for AEAD ciphers
+    if (::EVP_EncryptFinal_ex(_Myproxy._Ctx, _Buf + _Bytes, &_Final_bytes) == 0) {
+        return false;
+    }
+
+    if (!_Get_aead_tag(_Myproxy, _Buf + _Count)) {
+        return false;
+    }
+
+    ++_Mysegment;
+    return true;
+}
+
+// FUNCTION _Aead_segment_cipher::_Open
+_NODISCARD bool _Aead_segment_cipher::_Open(const byte_type* const _Data,
+    const size_type _Count, byte_type* const _Buf, const bool _Last) noexcept {
+    if (_Count < _Tag_size) { // the tag is missing
+        return false;
+    }
+
+    const iv<12>& _Nonce = _Make_aead_segment_nonce(_Myiv, _Mysegment, _Last);
+    if (::EVP_DecryptInit_ex(_Myproxy._Ctx, nullptr, nullptr, nullptr, _Nonce.get()) == 0) {
+        return false;
+    }
+
+    const size_type _Plain_count = _Count - _Tag_size;
+    int _Bytes                   = 0; // decrypted bytes
+    if (_Plain_count > 0 && ::EVP_DecryptUpdate(
+        _Myproxy._Ctx, _Buf, &_Bytes, _Data, static_cast<int>(_Plain_count)) == 0) {
+        return false;
+    }
+
+    if (!_Set_aead_tag(_Myproxy, _Data + _Plain_count)) {
+        return false;
+    }
+
+    int _Final_bytes = 0; // always 0 for AEAD ciphers
+    if (::EVP_DecryptFinal_ex(_Myproxy._Ctx, _Buf + _Bytes, &_Final_bytes) == 0) { // authentication failed
+        return false;
+    }
+
+    ++_Mysegment;
+    return true;
+}
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
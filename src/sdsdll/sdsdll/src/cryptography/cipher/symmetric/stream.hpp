@@ -0,0 +1,296 @@
+// stream.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SDSDLL_CRYPTOGRAPHY_CIPHER_SYMMETRIC_STREAM_HPP_
+#define _SDSDLL_CRYPTOGRAPHY_CIPHER_SYMMETRIC_STREAM_HPP_
+#include <core/defs.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+#include <algorithm>
+#include <core/traits/integer.hpp>
+#include <cryptography/cipher/symmetric/aead.hpp>
+#include <cryptography/cipher/symmetric/aes256_gcm.hpp>
+#include <cryptography/cipher/symmetric/chacha20_poly1305.hpp>
+#include <cryptography/cipher/symmetric/iv.hpp>
+#include <cryptography/cipher/symmetric/symmetric_key.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem/file.hpp>
+#include <openssl/evp.h>
+#include <openssl/types.h>
+#include <string>
+
+// STD types
+using _STD basic_string;
+
+_SDSDLL_BEGIN
+// FUNCTION _Make_aead_segment_nonce
+_SDSDLL_API _NODISCARD iv<12> _Make_aead_segment_nonce(
+    const iv<12>& _Iv, const uint64_t _Segment, const bool _Last) noexcept;
+
+// CLASS _Aead_segment_cipher
+class _SDSDLL_API _Aead_segment_cipher { // encrypts/decrypts the segments with one reused cipher context
+public:
+    using byte_type = unsigned char;
+    using size_type = size_t;
+
+    static constexpr size_type _Tag_size = 16; // 16-byte authentication tag
+
+    explicit _Aead_segment_cipher(const EVP_CIPHER* const _Cipher, const bool _Encrypt,
+        const symmetric_key<32>& _Key, const iv<12>& _Iv) noexcept;
+    ~_Aead_segment_cipher() noexcept;
+
+    _Aead_segment_cipher() = delete;
+    _Aead_segment_cipher(const _Aead_segment_cipher&) = delete;
+    _Aead_segment_cipher& operator=(const _Aead_segment_cipher&) = delete;
+
+    // checks if the cipher context has been initialized
+    _NODISCARD bool _Valid() const noexcept;
+
+    // encrypts the next segment (the _Buf must be able to store _Count + 16 bytes)
+    _NODISCARD bool _Seal(const byte_type* const _Data,
+        const size_type _Count, byte_type* const _Buf, const bool _Last) noexcept;
+
+    // decrypts the next segment (the _Buf must be able to store _Count - 16 bytes)
+    _NODISCARD bool _Open(const byte_type* const _Data,
+        const size_type _Count, byte_type* const _Buf, const bool _Last) noexcept;
+
+private:
+#ifdef _MSC_VER
+#pragma warning(push, 1)
+#pragma warning(disable : 4251) // C4251: _Aead_cipher_context_proxy requires dll-interface
+#endif // _MSC_VER
+    _Aead_cipher_context_proxy _Myproxy;
+    iv<12> _Myiv; // base IV
+    uint64_t _Mysegment; // index of the next segment
+    bool _Myvalid;
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif // _MSC_VER
+};
+
+// CONSTANT aead_segment_size
+inline constexpr size_t aead_segment_size = 65536; // plain bytes in each full segment
+
+// CLASS TEMPLATE stream_encryptor
+template <class _Traits>
+class stream_encryptor { // encrypts a payload of any size into a file, segment by segment
+public:
+    using byte_type   = unsigned char;
+    using byte_string = basic_string<unsigned char>;
+    using size_type   = size_t;
+    using key         = typename _Traits::key;
+    using iv          = typename _Traits::iv;
+
+    explicit stream_encryptor(file& _Target, const key& _Key, const iv& _Iv)
+        : _Mytarget(_Target), _Mycipher(_Aead_evp_cipher<_Traits>::_Get(), true, _Key, _Iv),
+        _Myplain(), _Mybuf(aead_segment_size + _Aead_segment_cipher::_Tag_size, byte_type{}),
+        _Mycompleted(false) {
+        _Myplain.reserve(aead_segment_size);
+    }
+
+    ~stream_encryptor() noexcept {}
+
+    stream_encryptor() = delete;
+    stream_encryptor(const stream_encryptor&) = delete;
+    stream_encryptor& operator=(const stream_encryptor&) = delete;
+
+    // encrypts the next part of the payload
+    _NODISCARD bool append(const byte_type* _Data, size_type _Count) {
+        if (!_Mycipher._Valid() || _Mycompleted) {
+            return false;
+        }
+
+        // Note: The last segment is marked, so one segment is always kept until more data arrives
+        //       or complete() is called. Full segments are encrypted directly from the _Data.
+        while (_Count > 0) {
+            if (_Myplain.size() == aead_segment_size) { // more data arrived, the segment is not the last
+                if (!_Write_segment(_Myplain.c_str(), _Myplain.size(), false)) {
+                    return false;
+                }
+
+                _Myplain.clear();
+            }
+
+            if (_Myplain.empty() && _Count > aead_segment_size) {
+                if (!_Write_segment(_Data, aead_segment_size, false)) {
+                    return false;
+                }
+
+                _Data  += aead_segment_size;
+                _Count -= aead_segment_size;
+                continue;
+            }
+
+            const size_type _Part = (_STD min)(aead_segment_size - _Myplain.size(), _Count);
+            _Myplain.append(_Data, _Part);
+            _Data  += _Part;
+            _Count -= _Part;
+        }
+
+        return true;
+    }
+
+    // encrypts the last segment
+    _NODISCARD bool complete() {
+        if (!_Mycipher._Valid() || _Mycompleted) {
+            return false;
+        }
+
+        _Mycompleted = true;
+        return _Write_segment(_Myplain.c_str(), _Myplain.size(), true);
+    }
+
+private:
+    // encrypts a segment and writes it to the target file
+    _NODISCARD bool _Write_segment(const byte_type* const _Data, const size_type _Count, const bool _Last) {
+        return _Mycipher._Seal(_Data, _Count, _Mybuf.data(), _Last)
+            && _Mytarget.write(_Mybuf.c_str(), _Count + _Aead_segment_cipher::_Tag_size);
+    }
+
+    file& _Mytarget;
+    _Aead_segment_cipher _Mycipher;
+    byte_string _Myplain; // buffered plain bytes of the current segment
+    byte_string _Mybuf; // encrypted segment
+    bool _Mycompleted;
+};
+
+// CLASS TEMPLATE stream_decryptor
+template <class _Traits>
+class stream_decryptor { // decrypts a segmented payload of any size into a file
+public:
+    using byte_type   = unsigned char;
+    using byte_string = basic_string<unsigned char>;
+    using size_type   = size_t;
+    using key         = typename _Traits::key;
+    using iv          = typename _Traits::iv;
+
+    explicit stream_decryptor(file& _Target, const key& _Key, const iv& _Iv)
+        : _Mytarget(_Target), _Mycipher(_Aead_evp_cipher<_Traits>::_Get(), false, _Key, _Iv),
+        _Mycipher_buf(), _Mybuf(aead_segment_size, byte_type{}), _Mycompleted(false) {
+        _Mycipher_buf.reserve(_Segment_size);
+    }
+
+    ~stream_decryptor() noexcept {}
+
+    stream_decryptor() = delete;
+    stream_decryptor(const stream_decryptor&) = delete;
+    stream_decryptor& operator=(const stream_decryptor&) = delete;
+
+    // decrypts the next part of the encrypted payload (each authenticated segment is written at once)
+    _NODISCARD bool append(const byte_type* _Data, size_type _Count) {
+        if (!_Mycipher._Valid() || _Mycompleted) {
+            return false;
+        }
+
+        // Note: Only the last segment may be shorter, but it is not known which segment is the last
+        //       until more data arrives or complete() is called. Each segment is authenticated on its
+        //       own and its plain bytes are written to the target before the next segments are read,
+        //       so the whole payload is authenticated only by complete(). The target must be discarded
+        //       if any call fails, it may contain the beginning of a truncated or reordered payload.
+        while (_Count > 0) {
+            if (_Mycipher_buf.size() == _Segment_size) { // more data arrived, the segment is not the last
+                if (!_Read_segment(_Mycipher_buf.c_str(), _Mycipher_buf.size(), false)) {
+                    return false;
+                }
+
+                _Mycipher_buf.clear();
+            }
+
+            if (_Mycipher_buf.empty() && _Count > _Segment_size) {
+                if (!_Read_segment(_Data, _Segment_size, false)) {
+                    return false;
+                }
+
+                _Data  += _Segment_size;
+                _Count -= _Segment_size;
+                continue;
+            }
+
+            const size_type _Part = (_STD min)(_Segment_size - _Mycipher_buf.size(), _Count);
+            _Mycipher_buf.append(_Data, _Part);
+            _Data  += _Part;
+            _Count -= _Part;
+        }
+
+        return true;
+    }
+
+    // decrypts the last segment, fails if the payload has been truncated, reordered or modified
+    _NODISCARD bool complete() {
+        if (!_Mycipher._Valid() || _Mycompleted) {
+            return false;
+        }
+
+        _Mycompleted = true;
+        if (_Mycipher_buf.size() < _Aead_segment_cipher::_Tag_size) { // the last segment is incomplete
+            return false;
+        }
+
+        return _Read_segment(_Mycipher_buf.c_str(), _Mycipher_buf.size(), true);
+    }
+
+private:
+    static constexpr size_type _Segment_size = aead_segment_size + _Aead_segment_cipher::_Tag_size;
+
+    // decrypts a segment and writes it to the target file
+    _NODISCARD bool _Read_segment(const byte_type* const _Data, const size_type _Count, const bool _Last) {
+        return _Mycipher._Open(_Data, _Count, _Mybuf.data(), _Last)
+            && _Mytarget.write(_Mybuf.c_str(), _Count - _Aead_segment_cipher::_Tag_size);
+    }
+
+    file& _Mytarget;
+    _Aead_segment_cipher _Mycipher;
+    byte_string _Mycipher_buf; // buffered encrypted bytes of the current segment
+    byte_string _Mybuf; // decrypted segment
+    bool _Mycompleted;
+};
+
+// FUNCTION TEMPLATE _Transform_file
+template <class _Stream>
+_NODISCARD bool _Transform_file(file& _Source, _Stream& _Stream_obj) {
+    // Note: The source is read in blocks of several segments, so each block is passed to the stream
+    //       (and mostly encrypted/decrypted in place) without copying.
+    static constexpr size_t _Block_size = aead_segment_size * 16;
+    basic_string<unsigned char> _Block(_Block_size, static_cast<unsigned char>(0));
+    size_t _Read = 0; // read bytes, must be initialized
+    while (!_Source.eof()) {
+        if (!_Source.read(_Block.data(), _Block.size(), _Block.size(), &_Read)) {
+            return false;
+        }
+
+        if (_Read == 0) { // nothing more to read
+            break;
+        }
+
+        if (!_Stream_obj.append(_Block.c_str(), _Read)) {
+            return false;
+        }
+    }
+
+    return _Stream_obj.complete();
+}
+
+// FUNCTION TEMPLATE encrypt_file
+template <class _Traits>
+_NODISCARD bool encrypt_file(
+    file& _Source, file& _Target, const typename _Traits::key& _Key, const typename _Traits::iv& _Iv) {
+    stream_encryptor<_Traits> _Stream(_Target, _Key, _Iv);
+    return _SDSDLL _Transform_file(_Source, _Stream);
+}
+
+// FUNCTION TEMPLATE decrypt_file
+template <class _Traits>
+_NODISCARD bool decrypt_file(
+    file& _Source, file& _Target, const typename _Traits::key& _Key, const typename _Traits::iv& _Iv) {
+    // Note: The segments are written to the _Target as soon as they are authenticated, so the _Target
+    //       must be discarded if the decryption fails.
+    stream_decryptor<_Traits> _Stream(_Target, _Key, _Iv);
+    return _SDSDLL _Transform_file(_Source, _Stream);
+}
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
+#endif // _SDSDLL_CRYPTOGRAPHY_CIPHER_SYMMETRIC_STREAM_HPP_
@@ -81,8 +81,13 @@ _NODISCARD constexpr symmetric_key<_Size> make_symmetric_key() noexcept {
     using _Key_t   = symmetric_key<_Size>;
     using _Value_t = typename _Key_t::value_type;
     _Value_t _Buf[_Key_t::size];
-    ::RAND_bytes(_Buf, static_cast<int>(_Key_t::size));
-    return _Key_t{_Buf};
+    if (!_SDSDLL _Random_fill(_Buf, _Key_t::size)) { // no random bytes, return an empty key
+        return _Key_t{};
+    }
+
+    const _Key_t _Result{_Buf};
+    memory_traits::set(_Buf, 0, sizeof(_Buf));
+    return _Result;
 }
 
 template _SDSDLL_API _NODISCARD symmetric_key<32> make_symmetric_key() noexcept;
@@ -11,7 +11,7 @@
 #include <core/api.hpp>
 #include <core/container/bytes.hpp>
 #include <core/traits/string_traits.hpp>
-#include <openssl/rand.h>
+#include <cryptography/random/drbg.hpp>
 #include <type_traits>
 
 _SDSDLL_BEGIN
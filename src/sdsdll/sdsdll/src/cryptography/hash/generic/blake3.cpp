@@ -54,6 +54,34 @@ _NODISCARD constexpr bool blake3_traits<_Elem>::hash_file(byte_type* const _Buf,
         return false;
     }
 
+    state_type _State;
+    auto _Update = [&_State](const uint8_t* const _Block, const size_t _Size) noexcept {
+        ::blake3_hasher_update(_State.get(), _Block, _Size);
+        return true;
+    };
+
+    if (!_SDSDLL _Hash_file_blocks(_File, _Off, _Update)) {
+        return false;
+    }
+
+    ::blake3_hasher_finalize(_State.get(), _Buf, _Optimal_buf_size);
+    return true;
+}
+
+// FUNCTION TEMPLATE blake3_traits::hash_file_parallel
+template <class _Elem>
+_NODISCARD bool blake3_traits<_Elem>::hash_file_parallel(byte_type* const _Buf,
+    const size_type _Buf_size, file& _File, const file::off_type _Off, thread_pool& _Pool) noexcept {
+    if (!_Buf || _Buf_size < bytes_count()) {
+        return false;
+    }
+
+    // Note: The subtrees are hashed by the same SIMD code as the serial hash, so the tree pays off
+    //       as soon as a thread of the thread-pool hashes a subtree while the caller hashes another one.
+    if (_Pool.threads() == 0) { // no thread to share the work with, use the serial hash
+        return hash_file(_Buf, _Buf_size, _File, _Off);
+    }
+
     if (!_File.is_open()) {
         return false;
     }
@@ -64,23 +92,69 @@ _NODISCARD constexpr bool blake3_traits<_Elem>::hash_file(byte_type* const _Buf,
         }
     }
 
-    constexpr size_type _Chunk_size = 1024; // 1024-byte chunk
-    byte_type _Chunk[_Chunk_size];
-    size_type _Read = 0; // read bytes, must be initialized
-    state_type _State;
-    for (;;) {
-        if (!_File.read(_Chunk, _Chunk_size, _Chunk_size, &_Read)) {
+    // Note: The file is read in batches of subtrees (one subtree for each thread and the caller).
+    //       The next batch is read while the subtrees of the current batch are being hashed.
+    const size_type _Subtrees   = (_STD min)(_Pool.threads() + 1, _Blake3_max_subtrees);
+    const size_type _Batch_size = _Subtrees * _Blake3_subtree_size;
+    _Sbo_buffer<byte_type> _First(_Batch_size);
+    if (_First._Empty()) { // failed to allocate a buffer
+        return false;
+    }
+
+    size_type _Sizes[2] = {0, 0}; // read bytes, must be initialized
+    if (!_File.read(_First._Get(), _Batch_size, _Batch_size, &_Sizes[0])) {
+        return false;
+    }
+
+    if (_Sizes[0] < _Batch_size) { // the file is smaller than a batch, use the serial hash
+        state_type _State;
+        ::blake3_hasher_update(_State.get(), _First._Get(), _Sizes[0]);
+        ::blake3_hasher_finalize(_State.get(), _Buf, bytes_count());
+        return true;
+    }
+
+    _Sbo_buffer<byte_type> _Second(_Batch_size);
+    if (_Second._Empty()) { // failed to allocate a buffer
+        return false;
+    }
+
+    byte_type* const _Batches[2] = {_First._Get(), _Second._Get()};
+    vector<_Blake3_chaining_value> _Cvs;
+    size_type _Cur      = 0; // batch that is being hashed
+    size_type _First_cv = 0; // index of the first subtree in the current batch
+    bool _Read_ok       = true;
+    auto _Step = [&](const size_t _Idx) noexcept {
+        if (_Idx == 0) { // read the next batch (the current batch is not the last one if it is full)
+            if (_Sizes[_Cur] == _Batch_size) {
+                _Read_ok = _File.read(_Batches[_Cur ^ 1], _Batch_size, _Batch_size, &_Sizes[_Cur ^ 1]);
+            }
+        } else { // hash the selected subtree
+            const size_type _Pos       = (_Idx - 1) * _Blake3_subtree_size;
+            _Cvs[_First_cv + _Idx - 1] = _Blake3_subtree_cv(_Batches[_Cur] + _Pos,
+                (_STD min)(_Sizes[_Cur] - _Pos, _Blake3_subtree_size),
+                (static_cast<uint64_t>(_First_cv) * _Blake3_subtree_size + _Pos) / _Blake3_chunk_size);
+        }
+    };
+
+    while (_Sizes[_Cur] > 0) {
+        const size_type _Count = (_Sizes[_Cur] + _Blake3_subtree_size - 1) / _Blake3_subtree_size;
+        try {
+            _Cvs.resize(_First_cv + _Count);
+        } catch (...) { // failed to allocate the chaining values
             return false;
         }
 
-        if (_Read == 0) { // no more data
-            break;
+        _Sizes[_Cur ^ 1] = 0;
+        _SDSDLL parallel_for(_Pool, parallel_range{0, _Count + 1}, 1, _Step);
+        if (!_Read_ok) {
+            return false;
         }
 
-        ::blake3_hasher_update(_State.get(), _Chunk, _Read);
+        _First_cv += _Count;
+        _Cur      ^= 1;
     }
 
-    ::blake3_hasher_finalize(_State.get(), _Buf, _Optimal_buf_size);
+    _Blake3_root_hash(_Cvs.data(), _Cvs.size(), _Buf);
     return true;
 }
 
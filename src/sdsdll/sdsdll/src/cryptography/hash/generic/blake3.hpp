@@ -15,11 +15,17 @@
 #include <core/traits/string_traits.hpp>
 #include <core/traits/type_traits.hpp>
 #include <cstddef>
+#include <cryptography/hash/generic/blake3_tree.hpp>
+#include <cryptography/hash/generic/file_reader.hpp>
 #include <filesystem/file.hpp>
 #include <string>
+#include <system/execution/parallel.hpp>
+#include <system/execution/thread_pool.hpp>
+#include <vector>
 
 // STD types
 using _STD basic_string;
+using _STD vector;
 
 _SDSDLL_BEGIN
 // CLASS blake3_state
@@ -73,6 +79,11 @@ public:
     // hashes a file
     _NODISCARD static constexpr bool hash_file(byte_type* const _Buf,
         const size_type _Buf_size, file& _File, const file::off_type _Off) noexcept;
+
+    // hashes a file, the subtrees are hashed concurrently by the selected thread-pool
+    // (the file is hashed serially if the thread-pool has no threads or the file is smaller than a batch)
+    _NODISCARD static bool hash_file_parallel(byte_type* const _Buf, const size_type _Buf_size,
+        file& _File, const file::off_type _Off, thread_pool& _Pool = default_thread_pool()) noexcept;
 };
 
 // STRUCT TEMPLATE blake3_stream_traits
@@ -0,0 +1,164 @@
+// blake3_tree.cpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <build/sdsdll_pch.hpp>
+#include <cryptography/hash/generic/blake3_tree.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+
+_SDSDLL_BEGIN
+// Note: The BLAKE3 library hashes the whole tree in one hasher, so it cannot hash subtrees that
+//       start in the middle of the input. These functions build the same nodes (see the BLAKE3
+//       specification) with the SIMD code of the library, so that each subtree is hashed as fast
+//       as the library hashes the whole input, and the subtrees can be hashed on different threads.
+
+// CONSTANT _Blake3_batch_inputs
+inline constexpr size_t _Blake3_batch_inputs = 64; // inputs passed to blake3_hash_many() at once
+
+// FUNCTION _Blake3_chunk_cv
+_NODISCARD _Blake3_chaining_value _Blake3_chunk_cv(
+    const uint8_t* const _Data, const size_t _Size, const uint64_t _Chunk) noexcept {
+    // Note: The _Size is at most 1024 bytes. The last block is padded with zeros.
+    uint32_t _Cv[8];
+    memory_traits::copy(_Cv, _Blake3_iv, sizeof(_Blake3_iv));
+    const size_t _Blocks = _Size == 0 ? 1 : (_Size + 63) / 64;
+    for (size_t _Idx = 0; _Idx < _Blocks; ++_Idx) {
+        const size_t _Off   = _Idx * 64;
+        const size_t _Bytes = (_STD min)(_Size - _Off, size_t{64});
+        uint8_t _Block[64]  = {0}; // zero-padded block
+        memory_traits::copy(_Block, _Data + _Off, _Bytes);
+        uint8_t _Flags = 0;
+        if (_Idx == 0) {
+            _Flags |= _Blake3_chunk_start;
+        }
+
+        if (_Idx == _Blocks - 1) {
+            _Flags |= _Blake3_chunk_end;
+        }
+
+        ::blake3_compress_in_place(_Cv, _Block, static_cast<uint8_t>(_Bytes), _Chunk, _Flags);
+    }
+
+    _Blake3_chaining_value _Result;
+    for (size_t _Idx = 0; _Idx < 8; ++_Idx) { // store little-endian words
+        for (size_t _Byte = 0; _Byte < 4; ++_Byte) {
+            _Result[_Idx * 4 + _Byte] = static_cast<uint8_t>(_Cv[_Idx] >> (_Byte * 8));
+        }
+    }
+
+    return _Result;
+}
+
+// FUNCTION _Blake3_parent_cv
+_NODISCARD _Blake3_chaining_value _Blake3_parent_cv(const _Blake3_chaining_value& _Left,
+    const _Blake3_chaining_value& _Right, const uint8_t _Flags) noexcept {
+    uint8_t _Block[64];
+    memory_traits::copy(_Block, _Left.data(), _Left.size());
+    memory_traits::copy(_Block + 32, _Right.data(), _Right.size());
+    const uint8_t* const _Input = _Block;
+    _Blake3_chaining_value _Result;
+    ::blake3_hash_many(_SDSDLL addressof(_Input), 1, 1, _Blake3_iv, 0, false,
+        static_cast<uint8_t>(_Blake3_parent | _Flags), 0, 0, _Result.data());
+    return _Result;
+}
+
+// FUNCTION _Blake3_left_size
+_NODISCARD size_t _Blake3_left_size(const size_t _Count) noexcept {
+    // returns the largest power of 2 that is less than _Count (the _Count must be at least 2)
+    size_t _Result = 1;
+    while (_Result * 2 < _Count) {
+        _Result *= 2;
+    }
+
+    return _Result;
+}
+
+// FUNCTION _Blake3_merge_layer
+_NODISCARD size_t _Blake3_merge_layer(
+    const uint8_t* const _Cvs, const size_t _Count, uint8_t* const _Buf) noexcept {
+    // Note: Each pair of the chaining values is merged into its parent, an odd chaining value is
+    //       moved to the next layer unchanged, which keeps the tree left-balanced. The _Buf must not
+    //       overlap the _Cvs. Returns the number of the chaining values in the next layer.
+    const size_t _Pairs = _Count / 2;
+    const uint8_t* _Inputs[_Blake3_batch_inputs];
+    for (size_t _Off = 0; _Off < _Pairs; _Off += _Blake3_batch_inputs) {
+        const size_t _Size = (_STD min)(_Pairs - _Off, _Blake3_batch_inputs);
+        for (size_t _Idx = 0; _Idx < _Size; ++_Idx) {
+            _Inputs[_Idx] = _Cvs + (_Off + _Idx) * 64;
+        }
+
+        ::blake3_hash_many(_Inputs, _Size, 1, _Blake3_iv, 0, false, _Blake3_parent, 0, 0, _Buf + _Off * 32);
+    }
+
+    if (_Count % 2 != 0) { // move the last chaining value
+        memory_traits::copy(_Buf + _Pairs * 32, _Cvs + (_Count - 1) * 32, 32);
+    }
+
+    return _Pairs + _Count % 2;
+}
+
+// FUNCTION _Blake3_subtree_cv
+_NODISCARD _Blake3_chaining_value _Blake3_subtree_cv(
+    const uint8_t* const _Data, const size_t _Size, const uint64_t _First_chunk) noexcept {
+    // Note: The subtree must not be the root of the whole tree, it must start at a chunk boundary
+    //       and have _Blake3_subtree_size bytes at most. The full chunks are hashed several at once,
+    //       then each layer of the parents, the same way the library hashes a wide subtree.
+    static constexpr size_t _Max_chunks = _Blake3_subtree_size / _Blake3_chunk_size;
+    uint8_t _Cvs[_Max_chunks * 32]; // chaining values of the chunks and of every second layer
+    uint8_t _Parents[_Max_chunks / 2 * 32]; // chaining values of the other layers
+    const size_t _Full = _Size / _Blake3_chunk_size; // chunks that have all 16 blocks
+    const uint8_t* _Inputs[_Blake3_batch_inputs];
+    for (size_t _Off = 0; _Off < _Full; _Off += _Blake3_batch_inputs) {
+        const size_t _Count = (_STD min)(_Full - _Off, _Blake3_batch_inputs);
+        for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+            _Inputs[_Idx] = _Data + (_Off + _Idx) * _Blake3_chunk_size;
+        }
+
+        ::blake3_hash_many(_Inputs, _Count, _Blake3_chunk_size / 64, _Blake3_iv, _First_chunk + _Off,
+            true, 0, _Blake3_chunk_start, _Blake3_chunk_end, _Cvs + _Off * 32);
+    }
+
+    size_t _Count = _Full;
+    if (_Size % _Blake3_chunk_size != 0) { // hash the partial chunk (only the last subtree has one)
+        const _Blake3_chaining_value& _Cv = _Blake3_chunk_cv(
+            _Data + _Full * _Blake3_chunk_size, _Size % _Blake3_chunk_size, _First_chunk + _Full);
+        memory_traits::copy(_Cvs + _Full * 32, _Cv.data(), _Cv.size());
+        ++_Count;
+    }
+
+    uint8_t* _Layer = _Cvs;
+    uint8_t* _Next  = _Parents;
+    while (_Count > 1) {
+        _Count = _Blake3_merge_layer(_Layer, _Count, _Next);
+        _STD swap(_Layer, _Next);
+    }
+
+    _Blake3_chaining_value _Result;
+    memory_traits::copy(_Result.data(), _Layer, _Result.size());
+    return _Result;
+}
+
+// FUNCTION _Blake3_merge_cvs
+_NODISCARD _Blake3_chaining_value _Blake3_merge_cvs(
+    const _Blake3_chaining_value* const _Cvs, const size_t _Count, const uint8_t _Flags) noexcept {
+    if (_Count == 1) {
+        return _Cvs[0];
+    }
+
+    const size_t _Left = _Blake3_left_size(_Count);
+    return _Blake3_parent_cv(_Blake3_merge_cvs(_Cvs, _Left, 0),
+        _Blake3_merge_cvs(_Cvs + _Left, _Count - _Left, 0), _Flags);
+}
+
+// FUNCTION _Blake3_root_hash
+void _Blake3_root_hash(
+    const _Blake3_chaining_value* const _Cvs, const size_t _Count, uint8_t* const _Buf) noexcept {
+    // Note: The _Cvs are the subtrees of _Blake3_subtree_size bytes (only the last one may be shorter),
+    //       so that they form the same left-balanced tree as the chunks. The _Count must be at least 2.
+    const _Blake3_chaining_value& _Digest = _Blake3_merge_cvs(_Cvs, _Count, _Blake3_root);
+    memory_traits::copy(_Buf, _Digest.data(), _Digest.size());
+}
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
@@ -0,0 +1,88 @@
+// blake3_tree.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SDSDLL_CRYPTOGRAPHY_HASH_GENERIC_BLAKE3_TREE_HPP_
+#define _SDSDLL_CRYPTOGRAPHY_HASH_GENERIC_BLAKE3_TREE_HPP_
+#include <core/defs.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+#include <algorithm>
+#include <array>
+#include <core/api.hpp>
+#include <core/traits/memory_traits.hpp>
+#include <core/traits/type_traits.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// STD types
+using _STD array;
+
+// Note: The SIMD entry points of the BLAKE3 library are not declared in blake3.h, they are declared
+//       as in blake3_impl.h of the linked version (1.3.1). Both select the widest instruction set
+//       that the CPU supports, just like blake3_hasher_update().
+extern "C" {
+void blake3_compress_in_place(uint32_t _Cv[8], const uint8_t _Block[64],
+    uint8_t _Block_size, uint64_t _Counter, uint8_t _Flags);
+void blake3_hash_many(const uint8_t* const* _Inputs, size_t _Count, size_t _Blocks, const uint32_t _Key[8],
+    uint64_t _Counter, bool _Increment_counter, uint8_t _Flags, uint8_t _Flags_start, uint8_t _Flags_end,
+    uint8_t* _Out);
+}
+
+_SDSDLL_BEGIN
+// ALIAS _Blake3_chaining_value
+using _Blake3_chaining_value = array<uint8_t, 32>; // little-endian words, as the library stores them
+
+// CONSTANT _Blake3_chunk_size
+inline constexpr size_t _Blake3_chunk_size = 1024; // 1024-byte chunk (leaf of the tree)
+
+// CONSTANT _Blake3_subtree_size
+inline constexpr size_t _Blake3_subtree_size = 1048576; // 1 MiB subtree, hashed by one thread
+
+// CONSTANT _Blake3_max_subtrees
+inline constexpr size_t _Blake3_max_subtrees = 32; // subtrees in a batch at most (two batches are read)
+
+// CONSTANT _Blake3_iv
+inline constexpr uint32_t _Blake3_iv[8] = {
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19};
+
+// ENUM _Blake3_flags
+enum _Blake3_flags : uint8_t {
+    _Blake3_chunk_start = 1,
+    _Blake3_chunk_end   = 2,
+    _Blake3_parent      = 4,
+    _Blake3_root        = 8
+};
+
+// FUNCTION _Blake3_chunk_cv
+extern _NODISCARD _Blake3_chaining_value _Blake3_chunk_cv(
+    const uint8_t* const _Data, const size_t _Size, const uint64_t _Chunk) noexcept;
+
+// FUNCTION _Blake3_parent_cv
+extern _NODISCARD _Blake3_chaining_value _Blake3_parent_cv(const _Blake3_chaining_value& _Left,
+    const _Blake3_chaining_value& _Right, const uint8_t _Flags) noexcept;
+
+// FUNCTION _Blake3_left_size
+extern _NODISCARD size_t _Blake3_left_size(const size_t _Count) noexcept;
+
+// FUNCTION _Blake3_merge_layer
+extern _NODISCARD size_t _Blake3_merge_layer(
+    const uint8_t* const _Cvs, const size_t _Count, uint8_t* const _Buf) noexcept;
+
+// FUNCTION _Blake3_subtree_cv
+_SDSDLL_API _NODISCARD _Blake3_chaining_value _Blake3_subtree_cv(
+    const uint8_t* const _Data, const size_t _Size, const uint64_t _First_chunk) noexcept;
+
+// FUNCTION _Blake3_merge_cvs
+extern _NODISCARD _Blake3_chaining_value _Blake3_merge_cvs(
+    const _Blake3_chaining_value* const _Cvs, const size_t _Count, const uint8_t _Flags) noexcept;
+
+// FUNCTION _Blake3_root_hash
+_SDSDLL_API void _Blake3_root_hash(
+    const _Blake3_chaining_value* const _Cvs, const size_t _Count, uint8_t* const _Buf) noexcept;
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
+#endif // _SDSDLL_CRYPTOGRAPHY_HASH_GENERIC_BLAKE3_TREE_HPP_
@@ -0,0 +1,158 @@
+// file_reader.cpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <build/sdsdll_pch.hpp>
+#include <cryptography/hash/generic/file_reader.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+
+_SDSDLL_BEGIN
+// FUNCTION _Hash_file_reader constructor/destructor
+_Hash_file_reader::_Hash_file_reader(file& _File, uint8_t* const _Blocks) noexcept
+    : _Myfile(_File), _Myblocks(_Blocks), _Mysizes{0}, _Mynext(0), _Myread(0), _Myhashed(0),
+    _Myrefs(2), _Myclaimed(false), _Myinline(false), _Myfailed(false), _Myclosed(false),
+    _Mydone(false), _Myreader(), _Myhasher() {}
+
+_Hash_file_reader::~_Hash_file_reader() noexcept {
+    allocator<uint8_t>{}.deallocate(_Myblocks, _Slots * _Hash_file_block_size);
+}
+
+// FUNCTION _Hash_file_reader::_Start
+_NODISCARD _Hash_file_reader* _Hash_file_reader::_Start(file& _File) noexcept {
+    uint8_t* const _Blocks = allocator<uint8_t>{}.allocate(_Slots * _Hash_file_block_size);
+    if (!_Blocks) { // allocation failed
+        return nullptr;
+    }
+
+    void* const _Raw = allocator<void>{}.allocate(sizeof(_Hash_file_reader));
+    if (!_Raw) { // allocation failed
+        allocator<uint8_t>{}.deallocate(_Blocks, _Slots * _Hash_file_block_size);
+        return nullptr;
+    }
+
+    // Note: The reading task is submitted once for the whole file. If it cannot be submitted,
+    //       or has not started by the time the next block is needed, the hashing thread claims
+    //       the file and reads it itself, so the reader never waits for a free thread.
+    _Hash_file_reader* const _Reader = ::new (_Raw) _Hash_file_reader(_File, _Blocks);
+    if (!_SDSDLL default_thread_pool().submit_task(&_Run, _Reader)) { // the task never runs
+        _Reader->_Release();
+    }
+
+    return _Reader;
+}
+
+// FUNCTION _Hash_file_reader::_Run
+void __stdcall _Hash_file_reader::_Run(void* const _Data) noexcept {
+    _Hash_file_reader* const _Reader = static_cast<_Hash_file_reader*>(_Data);
+    if (_Reader->_Claim()) {
+        _Reader->_Read_blocks();
+        _Reader->_Mydone.store(true, _STD memory_order_release);
+        _Reader->_Myhasher._Unpark();
+    }
+
+    _Reader->_Release();
+}
+
+// FUNCTION _Hash_file_reader::_Claim
+_NODISCARD bool _Hash_file_reader::_Claim() noexcept {
+    return !_Myclaimed.exchange(true, _STD memory_order_acq_rel);
+}
+
+// FUNCTION _Hash_file_reader::_Read_block
+_NODISCARD bool _Hash_file_reader::_Read_block(const size_t _Block) noexcept {
+    const size_t _Slot = _Block % _Slots;
+    _Mysizes[_Slot]    = 0;
+    if (!_Myfile.read(_Myblocks + _Slot * _Hash_file_block_size,
+        _Hash_file_block_size, _Hash_file_block_size, _Mysizes + _Slot)) {
+        _Myfailed.store(true, _STD memory_order_relaxed); // published with the number of read blocks
+        return false;
+    }
+
+    return true;
+}
+
+// FUNCTION _Hash_file_reader::_Read_blocks
+void _Hash_file_reader::_Read_blocks() noexcept {
+    // Note: A slot is reused only after the hashing thread has released the block stored in it.
+    //       The reading stops after an empty block, which marks the end of the file.
+    for (size_t _Block = 0;; ++_Block) {
+        while (_Block >= _Myhashed.load(_STD memory_order_acquire) + _Slots) { // all slots are full
+            if (_Myclosed.load(_STD memory_order_acquire)) {
+                return;
+            }
+
+            _Myreader._Park();
+        }
+
+        if (_Myclosed.load(_STD memory_order_acquire)) {
+            return;
+        }
+
+        const bool _Read_ok = _Read_block(_Block);
+        _Myread.store(_Block + 1, _STD memory_order_release);
+        _Myhasher._Unpark();
+        if (!_Read_ok || _Mysizes[_Block % _Slots] == 0) { // read error or end of file
+            return;
+        }
+    }
+}
+
+// FUNCTION _Hash_file_reader::_Release
+void _Hash_file_reader::_Release() noexcept {
+    if (_Myrefs.fetch_sub(1, _STD memory_order_acq_rel) == 1) { // the last reference
+        this->~_Hash_file_reader();
+        allocator<void>{}.deallocate(this, sizeof(_Hash_file_reader));
+    }
+}
+
+// FUNCTION _Hash_file_reader::_Next
+_NODISCARD bool _Hash_file_reader::_Next(const uint8_t*& _Data, size_t& _Size) noexcept {
+    if (_Mynext > 0) { // the previous block has been hashed, its slot can be reused
+        _Myhashed.store(_Mynext, _STD memory_order_release);
+        _Myreader._Unpark();
+    }
+
+    if (!_Myinline && _Myread.load(_STD memory_order_acquire) <= _Mynext && _Claim()) {
+        _Myinline = true; // the task has not started yet, read the file here
+    }
+
+    if (_Myinline) {
+        if (!_Read_block(_Mynext)) {
+            return false;
+        }
+
+        _Myread.store(_Mynext + 1, _STD memory_order_relaxed);
+    } else {
+        size_t _Read = _Myread.load(_STD memory_order_acquire);
+        while (_Read <= _Mynext) { // wait for the block
+            _Myhasher._Park();
+            _Read = _Myread.load(_STD memory_order_acquire);
+        }
+
+        if (_Read == _Mynext + 1 && _Myfailed.load(_STD memory_order_relaxed)) { // failed to read the block
+            return false;
+        }
+    }
+
+    const size_t _Slot = _Mynext++ % _Slots;
+    _Data              = _Myblocks + _Slot * _Hash_file_block_size;
+    _Size              = _Mysizes[_Slot];
+    return true;
+}
+
+// FUNCTION _Hash_file_reader::_Close
+void _Hash_file_reader::_Close() noexcept {
+    _Myclosed.store(true, _STD memory_order_release);
+    _Myreader._Unpark();
+    if (!_Myinline && !_Claim()) { // the task reads the file, wait until it stops
+        while (!_Mydone.load(_STD memory_order_acquire)) {
+            _Myhasher._Park();
+        }
+    }
+
+    _Release();
+}
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
@@ -0,0 +1,140 @@
+// file_reader.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SDSDLL_CRYPTOGRAPHY_HASH_GENERIC_FILE_READER_HPP_
+#define _SDSDLL_CRYPTOGRAPHY_HASH_GENERIC_FILE_READER_HPP_
+#include <core/defs.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+#include <atomic>
+#include <core/memory/allocator.hpp>
+#include <core/optimization/sbo.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem/file.hpp>
+#include <system/execution/parker.hpp>
+#include <system/execution/thread_pool.hpp>
+
+// STD types
+using _STD atomic;
+
+_SDSDLL_BEGIN
+// CONSTANT _Hash_file_block_size
+inline constexpr size_t _Hash_file_block_size = 1048576; // 1 MiB block
+
+// CONSTANT _Hash_file_read_ahead
+inline constexpr size_t _Hash_file_read_ahead = 2; // blocks read while another one is being hashed
+
+// CLASS _Hash_file_reader
+class _Hash_file_reader { // reads the blocks of a file ahead of the hashing thread
+public:
+    _Hash_file_reader() = delete;
+    _Hash_file_reader(const _Hash_file_reader&) = delete;
+    _Hash_file_reader& operator=(const _Hash_file_reader&) = delete;
+
+    // tries to start reading the blocks from the current file position
+    _NODISCARD static _Hash_file_reader* _Start(file& _File) noexcept;
+
+    // waits for the next block, returns false on a read error (an empty block ends the file)
+    _NODISCARD bool _Next(const uint8_t*& _Data, size_t& _Size) noexcept;
+
+    // stops reading and releases the reader, the file is not accessed anymore
+    void _Close() noexcept;
+
+private:
+    static constexpr size_t _Slots = _Hash_file_read_ahead + 1; // read blocks and the hashed one
+
+    explicit _Hash_file_reader(file& _File, uint8_t* const _Blocks) noexcept;
+    ~_Hash_file_reader() noexcept;
+
+    // runs the reading on the thread-pool
+    static void __stdcall _Run(void* const _Data) noexcept;
+
+    // tries to become the only thread that reads the file
+    _NODISCARD bool _Claim() noexcept;
+
+    // reads the selected block into its slot
+    _NODISCARD bool _Read_block(const size_t _Block) noexcept;
+
+    // reads the blocks until the end of the file, a read error or _Close()
+    void _Read_blocks() noexcept;
+
+    // drops one reference, the last one destroys the reader
+    void _Release() noexcept;
+
+    file& _Myfile;
+    uint8_t* _Myblocks; // _Slots blocks of _Hash_file_block_size bytes
+    size_t _Mysizes[_Slots]; // read bytes of each slot
+    size_t _Mynext; // next block to be hashed (used only by the hashing thread)
+    atomic<size_t> _Myread; // number of read blocks
+    atomic<size_t> _Myhashed; // number of blocks released by the hashing thread
+    atomic<uint32_t> _Myrefs; // the hashing thread and the reading task
+    atomic<bool> _Myclaimed; // true if some thread reads the file
+    bool _Myinline; // true if the hashing thread reads the file itself
+    atomic<bool> _Myfailed; // true if a read failed
+    atomic<bool> _Myclosed; // true if the hashing thread does not need more blocks
+    atomic<bool> _Mydone; // true if the reading task does not access the file anymore
+    _Parker _Myreader; // parks the reading task while all slots are full
+    _Parker _Myhasher; // parks the hashing thread while the next block is not ready
+};
+
+// FUNCTION TEMPLATE _Hash_file_blocks
+template <class _Fn>
+_NODISCARD bool _Hash_file_blocks(file& _File, const file::off_type _Off, _Fn& _Update) noexcept {
+    // Note: The _Update(data, size) must return true if the block has been hashed. The file is read
+    //       in large blocks. The first block is read directly, larger files are read by a single
+    //       task that stays ahead of the hashing thread, so the blocks are never handed over
+    //       through the thread-pool one by one.
+    if (!_File.is_open()) {
+        return false;
+    }
+
+    if (_File.tell() != _Off) { // change file offset
+        if (!_File.seek(_Off)) {
+            return false;
+        }
+    }
+
+    _Sbo_buffer<uint8_t> _First(_Hash_file_block_size);
+    if (_First._Empty()) { // failed to allocate a buffer
+        return false;
+    }
+
+    size_t _Size = 0; // read bytes, must be initialized
+    if (!_File.read(_First._Get(), _Hash_file_block_size, _Hash_file_block_size, &_Size)) {
+        return false;
+    }
+
+    if (_Size < _Hash_file_block_size) { // the whole file fits in one block, nothing to overlap
+        return _Size == 0 || _Update(static_cast<const uint8_t*>(_First._Get()), _Size);
+    }
+
+    _Hash_file_reader* const _Reader = _Hash_file_reader::_Start(_File);
+    if (!_Reader) { // failed to allocate the reader
+        return false;
+    }
+
+    bool _Result          = _Update(static_cast<const uint8_t*>(_First._Get()), _Size);
+    const uint8_t* _Block = nullptr;
+    while (_Result) {
+        if (!_Reader->_Next(_Block, _Size)) {
+            _Result = false;
+            break;
+        }
+
+        if (_Size == 0) { // no more blocks
+            break;
+        }
+
+        _Result = _Update(_Block, _Size);
+    }
+
+    _Reader->_Close();
+    return _Result;
+}
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
+#endif // _SDSDLL_CRYPTOGRAPHY_HASH_GENERIC_FILE_READER_HPP_
@@ -55,16 +55,6 @@ _NODISCARD constexpr bool sha512_traits<_Elem>::hash_file(byte_type* const _Buf,
         return false;
     }
 
-    if (!_File.is_open()) {
-        return false;
-    }
-
-    if (_File.tell() != _Off) { // change file offset
-        if (!_File.seek(_Off)) {
-            return false;
-        }
-    }
-
     state_type _State;
     if (!_State.get()) {
         return false;
@@ -74,21 +64,12 @@ _NODISCARD constexpr bool sha512_traits<_Elem>::hash_file(byte_type* const _Buf,
         return false;
     }
 
-    constexpr size_type _Chunk_size = 1024; // 1024-byte chunk
-    byte_type _Chunk[_Chunk_size];
-    size_type _Read = 0; // read bytes, must be initialized
-    for (;;) {
-        if (!_File.read(_Chunk, _Chunk_size, _Chunk_size, &_Read)) {
-            return false;
-        }
-
-        if (_Read == 0) { // no more data
-            break;
-        }
-
-        if (::EVP_DigestUpdate(_State.get(), _Chunk, _Read) == 0) {
-            return false;
-        }
+    auto _Update = [&_State](const uint8_t* const _Block, const size_t _Size) noexcept {
+        return ::EVP_DigestUpdate(_State.get(), _Block, _Size) != 0;
+    };
+
+    if (!_SDSDLL _Hash_file_blocks(_File, _Off, _Update)) {
+        return false;
     }
 
     uint32_t _Bytes = 0; // hashed bytes (unused)
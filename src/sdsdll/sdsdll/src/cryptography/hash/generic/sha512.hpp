@@ -14,6 +14,7 @@
 #include <core/traits/string_traits.hpp>
 #include <core/traits/type_traits.hpp>
 #include <cstdint>
+#include <cryptography/hash/generic/file_reader.hpp>
 #include <filesystem/file.hpp>
 #include <openssl/evp.h>
 #include <openssl/types.h>
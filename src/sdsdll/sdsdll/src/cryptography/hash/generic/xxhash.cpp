@@ -59,36 +59,17 @@ _NODISCARD constexpr bool xxhash_traits<_Elem>::hash_file(byte_type* const _Buf,
         return false;
     }
 
-    if (!_File.is_open()) {
-        return false;
-    }
-
-    if (_File.tell() != _Off) { // change file offset
-        if (!_File.seek(_Off)) {
-            return false;
-        }
-    }
-
-    constexpr size_type _Chunk_size = 1024; // 1024-byte chunk
-    byte_type _Chunk[_Chunk_size];
-    size_type _Read = 0; // read bytes, must be initialized
     state_type _State;
     if (!_State.get()) {
         return false;
     }
 
-    for (;;) {
-        if (!_File.read(_Chunk, _Chunk_size, _Chunk_size, &_Read)) {
-            return false;
-        }
-
-        if (_Read == 0) { // no more data
-            break;
-        }
+    auto _Update = [&_State](const uint8_t* const _Block, const size_t _Size) noexcept {
+        return ::XXH3_64bits_update(_State.get(), _Block, _Size) == XXH_OK;
+    };
 
-        if (::XXH3_64bits_update(_State.get(), _Chunk, _Read) != XXH_OK) {
-            return false;
-        }
+    if (!_SDSDLL _Hash_file_blocks(_File, _Off, _Update)) {
+        return false;
     }
 
     const uint64_t _Num = ::XXH3_64bits_digest(_State.get());
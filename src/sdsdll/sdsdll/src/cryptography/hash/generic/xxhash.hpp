@@ -17,6 +17,7 @@
 #include <core/traits/type_traits.hpp>
 #include <cstddef>
 #include <cstdint>
+#include <cryptography/hash/generic/file_reader.hpp>
 #include <filesystem/file.hpp>
 #include <string>
 #include <xxhash.h>
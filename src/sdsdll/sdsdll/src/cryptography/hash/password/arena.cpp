@@ -0,0 +1,136 @@
+// arena.cpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <build/sdsdll_pch.hpp>
+#include <cryptography/hash/password/arena.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+
+_SDSDLL_BEGIN
+// FUNCTION password_arena constructors/destructor
+password_arena::password_arena() noexcept
+    : _Myptr(nullptr), _Mysize(0), _Mywants_large(false), _Mylarge(false) {}
+
+password_arena::password_arena(const size_t _Size, const bool _Large_pages) noexcept
+    : _Myptr(nullptr), _Mysize(0), _Mywants_large(_Large_pages), _Mylarge(false) {
+    (void) reserve(_Size);
+}
+
+password_arena::~password_arena() noexcept {
+    release();
+}
+
+// FUNCTION password_arena::_Allocate_large
+_NODISCARD bool password_arena::_Allocate_large(const size_t _Size) noexcept {
+    // Note: Large pages require the SeLockMemoryPrivilege. They are never paged out,
+    //       so they do not have to be faulted in.
+    const size_t _Large_page_size = ::GetLargePageMinimum();
+    if (_Large_page_size == 0) { // large pages are not supported
+        return false;
+    }
+
+    const size_t _Rounded = (_Size + _Large_page_size - 1) / _Large_page_size * _Large_page_size;
+    _Myptr                = ::VirtualAlloc(
+        nullptr, _Rounded, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+    if (!_Myptr) {
+        return false;
+    }
+
+    _Mysize  = _Rounded;
+    _Mylarge = true;
+    return true;
+}
+
+// FUNCTION password_arena::_Allocate_regular
+_NODISCARD bool password_arena::_Allocate_regular(const size_t _Size) noexcept {
+    const size_t _Rounded = (_Size + _Page_size - 1) / _Page_size * _Page_size;
+    _Myptr                = ::VirtualAlloc(nullptr, _Rounded, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (!_Myptr) {
+        return false;
+    }
+
+    // Note: Committed pages are materialized on the first access. Touch each of them now,
+    //       so that the page faults are not paid by the first hash.
+    volatile uint8_t* const _Bytes = static_cast<volatile uint8_t*>(_Myptr);
+    for (size_t _Off = 0; _Off < _Rounded; _Off += _Page_size) {
+        _Bytes[_Off] = 0;
+    }
+
+    _Mysize  = _Rounded;
+    _Mylarge = false;
+    return true;
+}
+
+// FUNCTION password_arena::data
+_NODISCARD void* password_arena::data() const noexcept {
+    return _Myptr;
+}
+
+// FUNCTION password_arena::size
+_NODISCARD size_t password_arena::size() const noexcept {
+    return _Mysize;
+}
+
+// FUNCTION password_arena::large_pages
+_NODISCARD bool password_arena::large_pages() const noexcept {
+    return _Mylarge;
+}
+
+// FUNCTION password_arena::reserve
+_NODISCARD bool password_arena::reserve(const size_t _Size) noexcept {
+    if (_Size <= _Mysize) { // the current memory is large enough
+        return true;
+    }
+
+    release();
+    if (_Mywants_large && _Allocate_large(_Size)) {
+        return true;
+    }
+
+    return _Allocate_regular(_Size);
+}
+
+// FUNCTION password_arena::wipe
+void password_arena::wipe(const size_t _Size) noexcept {
+    if (_Myptr) {
+        memory_traits::set(_Myptr, 0, (_STD min)(_Size, _Mysize));
+    }
+}
+
+// FUNCTION password_arena::trim
+void password_arena::trim(const size_t _Size) noexcept {
+    if (_Mysize > _Size) {
+        release();
+    }
+}
+
+// FUNCTION password_arena::release
+void password_arena::release() noexcept {
+    if (_Myptr) {
+        memory_traits::set(_Myptr, 0, _Mysize); // don't leave the hash state in memory
+        ::VirtualFree(_Myptr, 0, MEM_RELEASE);
+        _Myptr   = nullptr;
+        _Mysize  = 0;
+        _Mylarge = false;
+    }
+}
+
+// FUNCTION _Thread_local_password_arena
+_NODISCARD password_arena& _Thread_local_password_arena() noexcept {
+    // Note: Each thread (e.g. each worker that verifies passwords) keeps its own arena, which grows
+    //       to the largest memory amount it has been asked for and is reused by the next hashes.
+    thread_local password_arena _Arena;
+    return _Arena;
+}
+
+// FUNCTION _Trim_thread_local_password_arena
+void _Trim_thread_local_password_arena() noexcept {
+    // Note: The arena of a long-lived thread (e.g. a thread-pool worker) would otherwise keep the
+    //       memory of its largest hash committed until the thread exits. Arenas up to the limit
+    //       cover the usual parameters and are kept, larger ones are released after the hash.
+    _Thread_local_password_arena().trim(_Thread_password_arena_limit);
+}
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
@@ -0,0 +1,77 @@
+// arena.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SDSDLL_CRYPTOGRAPHY_HASH_PASSWORD_ARENA_HPP_
+#define _SDSDLL_CRYPTOGRAPHY_HASH_PASSWORD_ARENA_HPP_
+#include <core/defs.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+#include <algorithm>
+#include <core/api.hpp>
+#include <core/traits/memory_traits.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memoryapi.h>
+
+_SDSDLL_BEGIN
+// CLASS password_arena
+class _SDSDLL_API password_arena { // reusable memory for the memory-hard password hashes
+public:
+    password_arena() noexcept;
+    ~password_arena() noexcept;
+
+    explicit password_arena(const size_t _Size, const bool _Large_pages = false) noexcept;
+
+    password_arena(const password_arena&) = delete;
+    password_arena& operator=(const password_arena&) = delete;
+
+    // returns a pointer to the memory
+    _NODISCARD void* data() const noexcept;
+
+    // returns the memory size in bytes
+    _NODISCARD size_t size() const noexcept;
+
+    // checks if the memory is backed by large pages
+    _NODISCARD bool large_pages() const noexcept;
+
+    // makes sure that the arena has at least _Size bytes (new memory is faulted in immediately)
+    _NODISCARD bool reserve(const size_t _Size) noexcept;
+
+    // fills the first _Size bytes with zeros, the memory stays committed
+    void wipe(const size_t _Size) noexcept;
+
+    // releases the memory if the arena is larger than _Size bytes
+    void trim(const size_t _Size) noexcept;
+
+    // releases the memory
+    void release() noexcept;
+
+private:
+    static constexpr size_t _Page_size = 4096;
+
+    // tries to allocate _Size bytes backed by large pages
+    _NODISCARD bool _Allocate_large(const size_t _Size) noexcept;
+
+    // tries to allocate _Size bytes backed by regular pages and faults them in
+    _NODISCARD bool _Allocate_regular(const size_t _Size) noexcept;
+
+    void* _Myptr;
+    size_t _Mysize;
+    bool _Mywants_large; // true if large pages should be tried first
+    bool _Mylarge; // true if the memory is backed by large pages
+};
+
+// CONSTANT _Thread_password_arena_limit
+inline constexpr size_t _Thread_password_arena_limit = 67108864; // 64 MiB kept by each thread between hashes
+
+// FUNCTION _Thread_local_password_arena
+extern _NODISCARD password_arena& _Thread_local_password_arena() noexcept;
+
+// FUNCTION _Trim_thread_local_password_arena
+extern void _Trim_thread_local_password_arena() noexcept;
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
+#endif // _SDSDLL_CRYPTOGRAPHY_HASH_PASSWORD_ARENA_HPP_
@@ -0,0 +1,492 @@
+// argon2_core.cpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <build/sdsdll_pch.hpp>
+#include <cryptography/hash/password/argon2_core.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+
+_SDSDLL_BEGIN
+// FUNCTION _Argon2_store32
+void _Argon2_store32(uint8_t* const _Dest, const uint32_t _Val) noexcept {
+    _Dest[0] = static_cast<uint8_t>(_Val);
+    _Dest[1] = static_cast<uint8_t>(_Val >> 8);
+    _Dest[2] = static_cast<uint8_t>(_Val >> 16);
+    _Dest[3] = static_cast<uint8_t>(_Val >> 24);
+}
+
+// FUNCTION _Argon2_blake2b
+_NODISCARD bool _Argon2_blake2b(uint8_t* const _Buf, const uint8_t* const _Prefix,
+    const size_t _Prefix_size, const uint8_t* const _Data, const size_t _Data_size) noexcept {
+    EVP_MD_CTX* const _Ctx = ::EVP_MD_CTX_new();
+    if (!_Ctx) {
+        return false;
+    }
+
+    uint32_t _Bytes = 0; // hashed bytes (unused)
+    const bool _Ok  = ::EVP_DigestInit_ex(_Ctx, ::EVP_blake2b512(), nullptr) != 0
+        && ::EVP_DigestUpdate(_Ctx, _Prefix, _Prefix_size) != 0
+        && ::EVP_DigestUpdate(_Ctx, _Data, _Data_size) != 0
+        && ::EVP_DigestFinal_ex(_Ctx, _Buf, &_Bytes) != 0;
+    ::EVP_MD_CTX_free(_Ctx);
+    return _Ok;
+}
+
+// FUNCTION _Argon2_blake2b_sized
+_NODISCARD bool _Argon2_blake2b_sized(uint8_t* const _Buf, const size_t _Buf_size,
+    const uint8_t* const _Prefix, const size_t _Prefix_size, const uint8_t* const _Data,
+    const size_t _Data_size) noexcept {
+    if (_Buf_size == 64) { // the common case, OpenSSL computes the full digest
+        return _Argon2_blake2b(_Buf, _Prefix, _Prefix_size, _Data, _Data_size);
+    }
+
+    // Note: The digest length is a parameter of BLAKE2b, a shorter digest is not a prefix
+    //       of the full one. OpenSSL 3.0 computes only the full digest, so Botan is used.
+    try {
+        ::Botan::BLAKE2b _Hash(_Buf_size * 8);
+        _Hash.update(_Prefix, _Prefix_size);
+        _Hash.update(_Data, _Data_size);
+        _Hash.final(_Buf);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+// FUNCTION _Argon2_blake2b_long
+_NODISCARD bool _Argon2_blake2b_long(uint8_t* const _Buf, const size_t _Buf_size,
+    const uint8_t* const _Data, const size_t _Data_size) noexcept {
+    // Note: This is the variable-length hash H' from RFC 9106, section 3.3. A tag of up to
+    //       64 bytes is a single digest of that length.
+    if (_Buf_size < 4 || _Buf_size > 0xFFFF'FFFF) {
+        return false;
+    }
+
+    uint8_t _Length[4];
+    uint8_t _Digest[64];
+    _Argon2_store32(_Length, static_cast<uint32_t>(_Buf_size));
+    if (_Buf_size <= 64) {
+        return _Argon2_blake2b_sized(_Buf, _Buf_size, _Length, sizeof(_Length), _Data, _Data_size);
+    }
+
+    if (!_Argon2_blake2b(_Digest, _Length, sizeof(_Length), _Data, _Data_size)) {
+        return false;
+    }
+
+    // Note: Each intermediate digest contributes its first 32 bytes, the last one is as long
+    //       as the remaining part of the tag (between 33 and 64 bytes).
+    size_t _Off = 0;
+    while (_Buf_size - _Off > 64) {
+        memory_traits::copy(_Buf + _Off, _Digest, 32);
+        _Off += 32;
+        const size_t _Next_size = (_STD min)(_Buf_size - _Off, static_cast<size_t>(64));
+        if (!_Argon2_blake2b_sized(_Digest, _Next_size, nullptr, 0, _Digest, sizeof(_Digest))) {
+            memory_traits::set(_Digest, 0, sizeof(_Digest));
+            return false;
+        }
+    }
+
+    memory_traits::copy(_Buf + _Off, _Digest, _Buf_size - _Off);
+    memory_traits::set(_Digest, 0, sizeof(_Digest));
+    return true;
+}
+
+// FUNCTION _Argon2_blamka
+_NODISCARD uint64_t _Argon2_blamka(const uint64_t _Left, const uint64_t _Right) noexcept {
+    const uint64_t _Product = (_Left & 0xFFFF'FFFF) * (_Right & 0xFFFF'FFFF);
+    return _Left + _Right + 2 * _Product;
+}
+
+// FUNCTION _Argon2_rotate_right
+_NODISCARD uint64_t _Argon2_rotate_right(const uint64_t _Val, const int _Count) noexcept {
+    return (_Val >> _Count) | (_Val << (64 - _Count));
+}
+
+// FUNCTION _Argon2_mix
+void _Argon2_mix(uint64_t& _Ax, uint64_t& _Bx, uint64_t& _Cx, uint64_t& _Dx) noexcept {
+    _Ax = _Argon2_blamka(_Ax, _Bx);
+    _Dx = _Argon2_rotate_right(_Dx ^ _Ax, 32);
+    _Cx = _Argon2_blamka(_Cx, _Dx);
+    _Bx = _Argon2_rotate_right(_Bx ^ _Cx, 24);
+    _Ax = _Argon2_blamka(_Ax, _Bx);
+    _Dx = _Argon2_rotate_right(_Dx ^ _Ax, 16);
+    _Cx = _Argon2_blamka(_Cx, _Dx);
+    _Bx = _Argon2_rotate_right(_Bx ^ _Cx, 63);
+}
+
+// FUNCTION _Argon2_permute
+void _Argon2_permute(uint64_t* const _Words, const size_t _First, const size_t _Step) noexcept {
+    // Note: The permuted state is formed by 8 pairs of words, the pairs start at _First and are
+    //       _Step words apart. The state is copied to locals, so that the compiler can keep it
+    //       in registers, mixing the words of the block in place forces a store after each step.
+    uint64_t _State[16];
+    for (size_t _Pair = 0; _Pair < 8; ++_Pair) {
+        _State[2 * _Pair]     = _Words[_First + _Pair * _Step];
+        _State[2 * _Pair + 1] = _Words[_First + _Pair * _Step + 1];
+    }
+
+    _Argon2_mix(_State[0], _State[4], _State[8], _State[12]);
+    _Argon2_mix(_State[1], _State[5], _State[9], _State[13]);
+    _Argon2_mix(_State[2], _State[6], _State[10], _State[14]);
+    _Argon2_mix(_State[3], _State[7], _State[11], _State[15]);
+    _Argon2_mix(_State[0], _State[5], _State[10], _State[15]);
+    _Argon2_mix(_State[1], _State[6], _State[11], _State[12]);
+    _Argon2_mix(_State[2], _State[7], _State[8], _State[13]);
+    _Argon2_mix(_State[3], _State[4], _State[9], _State[14]);
+    for (size_t _Pair = 0; _Pair < 8; ++_Pair) {
+        _Words[_First + _Pair * _Step]     = _State[2 * _Pair];
+        _Words[_First + _Pair * _Step + 1] = _State[2 * _Pair + 1];
+    }
+}
+
+#if _SDSDLL_ARGON2_SSE2
+// FUNCTION _Argon2_blamka_sse2
+_NODISCARD __m128i _Argon2_blamka_sse2(const __m128i _Left, const __m128i _Right) noexcept {
+    const __m128i _Product = ::_mm_mul_epu32(_Left, _Right); // multiplies the low halves of the words
+    return ::_mm_add_epi64(::_mm_add_epi64(_Left, _Right), ::_mm_add_epi64(_Product, _Product));
+}
+
+// FUNCTION _Argon2_rotate_right_sse2
+_NODISCARD __m128i _Argon2_rotate_right_sse2(const __m128i _Val, const int _Count) noexcept {
+    if (_Count == 32) { // swap the halves of each word
+        return ::_mm_shuffle_epi32(_Val, _MM_SHUFFLE(2, 3, 0, 1));
+    } else if (_Count == 63) { // rotate left by 1
+        return ::_mm_xor_si128(::_mm_srli_epi64(_Val, 63), ::_mm_add_epi64(_Val, _Val));
+    } else {
+        return ::_mm_xor_si128(::_mm_srli_epi64(_Val, _Count), ::_mm_slli_epi64(_Val, 64 - _Count));
+    }
+}
+
+// FUNCTION _Argon2_permute_sse2
+void _Argon2_permute_sse2(__m128i* const _Regs, const size_t _First, const size_t _Step) noexcept {
+    // Note: The same as _Argon2_permute(), the 8 registers start at _First and are _Step registers
+    //       apart. The registers hold the state words as (0, 1), (2, 3), ..., (14, 15). The diagonal
+    //       step mixes the words (0, 5, 10, 15), (1, 6, 11, 12), (2, 7, 8, 13) and (3, 4, 9, 14),
+    //       so the B and D registers are rearranged to (5, 6), (7, 4) and (15, 12), (13, 14) before
+    //       it and restored after it, the C registers are only swapped.
+    //       The _Mix is the same as _Argon2_mix() for two columns at once. It is a local lambda,
+    //       so that it is inlined and the state stays in registers.
+    const auto _Mix = [](__m128i& _Ax, __m128i& _Bx, __m128i& _Cx, __m128i& _Dx) noexcept {
+        _Ax = _Argon2_blamka_sse2(_Ax, _Bx);
+        _Dx = _Argon2_rotate_right_sse2(::_mm_xor_si128(_Dx, _Ax), 32);
+        _Cx = _Argon2_blamka_sse2(_Cx, _Dx);
+        _Bx = _Argon2_rotate_right_sse2(::_mm_xor_si128(_Bx, _Cx), 24);
+        _Ax = _Argon2_blamka_sse2(_Ax, _Bx);
+        _Dx = _Argon2_rotate_right_sse2(::_mm_xor_si128(_Dx, _Ax), 16);
+        _Cx = _Argon2_blamka_sse2(_Cx, _Dx);
+        _Bx = _Argon2_rotate_right_sse2(::_mm_xor_si128(_Bx, _Cx), 63);
+    };
+    __m128i _Ax = _Regs[_First];
+    __m128i _Ay = _Regs[_First + _Step];
+    __m128i _Bx = _Regs[_First + 2 * _Step];
+    __m128i _By = _Regs[_First + 3 * _Step];
+    __m128i _Cx = _Regs[_First + 4 * _Step];
+    __m128i _Cy = _Regs[_First + 5 * _Step];
+    __m128i _Dx = _Regs[_First + 6 * _Step];
+    __m128i _Dy = _Regs[_First + 7 * _Step];
+    _Mix(_Ax, _Bx, _Cx, _Dx);
+    _Mix(_Ay, _By, _Cy, _Dy);
+
+    __m128i _Old_b = _Bx;
+    __m128i _Old_d = _Dx;
+    _Bx            = ::_mm_unpackhi_epi64(_Bx, ::_mm_unpacklo_epi64(_By, _By));
+    _By            = ::_mm_unpackhi_epi64(_By, ::_mm_unpacklo_epi64(_Old_b, _Old_b));
+    _Dx            = ::_mm_unpackhi_epi64(_Dy, ::_mm_unpacklo_epi64(_Old_d, _Old_d));
+    _Dy            = ::_mm_unpackhi_epi64(_Old_d, ::_mm_unpacklo_epi64(_Dy, _Dy));
+    _Mix(_Ax, _Bx, _Cy, _Dx);
+    _Mix(_Ay, _By, _Cx, _Dy);
+
+    _Old_b = _Bx;
+    _Old_d = _Dx;
+    _Bx    = ::_mm_unpackhi_epi64(_By, ::_mm_unpacklo_epi64(_Bx, _Bx));
+    _By    = ::_mm_unpackhi_epi64(_Old_b, ::_mm_unpacklo_epi64(_By, _By));
+    _Dx    = ::_mm_unpackhi_epi64(_Dx, ::_mm_unpacklo_epi64(_Dy, _Dy));
+    _Dy    = ::_mm_unpackhi_epi64(_Dy, ::_mm_unpacklo_epi64(_Old_d, _Old_d));
+    _Regs[_First]             = _Ax;
+    _Regs[_First + _Step]     = _Ay;
+    _Regs[_First + 2 * _Step] = _Bx;
+    _Regs[_First + 3 * _Step] = _By;
+    _Regs[_First + 4 * _Step] = _Cx;
+    _Regs[_First + 5 * _Step] = _Cy;
+    _Regs[_First + 6 * _Step] = _Dx;
+    _Regs[_First + 7 * _Step] = _Dy;
+}
+#endif // _SDSDLL_ARGON2_SSE2
+
+// FUNCTION _Argon2_fill_block
+void _Argon2_fill_block(const _Argon2_block& _Prev, const _Argon2_block& _Ref,
+    _Argon2_block& _Next, const bool _With_xor) noexcept {
+    // Note: The compression function G from RFC 9106, section 3.5. The block is viewed as
+    //       an 8x8 matrix of 16-byte registers, the permutation is applied to each row first
+    //       and then to each column. The _Next may be the same block as the _Ref.
+#if _SDSDLL_ARGON2_SSE2
+    static constexpr size_t _Regs   = _Argon2_block_words / 2;
+    const __m128i* const _Prev_regs = reinterpret_cast<const __m128i*>(_Prev._Words);
+    const __m128i* const _Ref_regs  = reinterpret_cast<const __m128i*>(_Ref._Words);
+    __m128i* const _Next_regs       = reinterpret_cast<__m128i*>(_Next._Words);
+    __m128i _Block[_Regs];
+    __m128i _Tmp[_Regs];
+    for (size_t _Reg = 0; _Reg < _Regs; ++_Reg) {
+        _Block[_Reg] =
+            ::_mm_xor_si128(::_mm_loadu_si128(_Prev_regs + _Reg), ::_mm_loadu_si128(_Ref_regs + _Reg));
+        _Tmp[_Reg] = _With_xor ? ::_mm_xor_si128(_Block[_Reg], ::_mm_loadu_si128(_Next_regs + _Reg))
+            : _Block[_Reg];
+    }
+
+    for (size_t _Row = 0; _Row < 8; ++_Row) { // 8 consecutive registers
+        _Argon2_permute_sse2(_Block, 8 * _Row, 1);
+    }
+
+    for (size_t _Column = 0; _Column < 8; ++_Column) { // one register from each row
+        _Argon2_permute_sse2(_Block, _Column, 8);
+    }
+
+    for (size_t _Reg = 0; _Reg < _Regs; ++_Reg) {
+        ::_mm_storeu_si128(_Next_regs + _Reg, ::_mm_xor_si128(_Tmp[_Reg], _Block[_Reg]));
+    }
+#else // ^^^ _SDSDLL_ARGON2_SSE2 ^^^ / vvv !_SDSDLL_ARGON2_SSE2 vvv
+    _Argon2_block _Block;
+    _Argon2_block _Tmp;
+    for (size_t _Word = 0; _Word < _Argon2_block_words; ++_Word) {
+        _Block._Words[_Word] = _Prev._Words[_Word] ^ _Ref._Words[_Word];
+        _Tmp._Words[_Word]   = _With_xor ? _Block._Words[_Word] ^ _Next._Words[_Word] : _Block._Words[_Word];
+    }
+
+    for (size_t _Row = 0; _Row < 8; ++_Row) { // 8 consecutive pairs
+        _Argon2_permute(_Block._Words, 16 * _Row, 2);
+    }
+
+    for (size_t _Column = 0; _Column < 8; ++_Column) { // one pair from each row
+        _Argon2_permute(_Block._Words, 2 * _Column, 16);
+    }
+
+    for (size_t _Word = 0; _Word < _Argon2_block_words; ++_Word) {
+        _Next._Words[_Word] = _Tmp._Words[_Word] ^ _Block._Words[_Word];
+    }
+#endif // _SDSDLL_ARGON2_SSE2
+}
+
+// FUNCTION _Argon2_next_addresses
+void _Argon2_next_addresses(_Argon2_block& _Addresses, _Argon2_block& _Input) noexcept {
+    static constexpr _Argon2_block _Zero = {};
+    ++_Input._Words[6]; // the counter
+    _Argon2_fill_block(_Zero, _Input, _Addresses, false);
+    _Argon2_fill_block(_Zero, _Addresses, _Addresses, false);
+}
+
+// FUNCTION _Argon2_reference_index
+_NODISCARD uint32_t _Argon2_reference_index(const _Argon2_instance& _Instance, const uint32_t _Pass,
+    const uint32_t _Slice, const uint32_t _Idx, const uint32_t _Rand, const bool _Same_lane) noexcept {
+    // Note: The blocks that may be referenced are the ones computed in the previous (up to 3)
+    //       segments of every lane, and the ones computed in the current segment of the current
+    //       lane (excluding the previous block). The position is biased towards the newest blocks.
+    uint32_t _Area;
+    if (_Pass == 0) {
+        if (_Slice == 0) { // only the current segment is available
+            _Area = _Idx - 1;
+        } else if (_Same_lane) {
+            _Area = _Slice * _Instance._Segment_length + _Idx - 1;
+        } else {
+            _Area = _Slice * _Instance._Segment_length + (_Idx == 0 ? static_cast<uint32_t>(-1) : 0);
+        }
+    } else {
+        if (_Same_lane) {
+            _Area = _Instance._Lane_length - _Instance._Segment_length + _Idx - 1;
+        } else {
+            _Area = _Instance._Lane_length - _Instance._Segment_length
+                + (_Idx == 0 ? static_cast<uint32_t>(-1) : 0);
+        }
+    }
+
+    uint64_t _Relative = _Rand;
+    _Relative          = (_Relative * _Relative) >> 32;
+    _Relative          = _Area - 1 - ((_Area * _Relative) >> 32);
+    const uint32_t _Start =
+        _Pass != 0 && _Slice != 3 ? (_Slice + 1) * _Instance._Segment_length : 0;
+    return static_cast<uint32_t>((_Start + _Relative) % _Instance._Lane_length);
+}
+
+// FUNCTION _Argon2_fill_segment
+void _Argon2_fill_segment(const _Argon2_instance& _Instance,
+    const uint32_t _Pass, const uint32_t _Lane, const uint32_t _Slice) noexcept {
+    // Note: Argon2i (and the first half of the first pass of Argon2id) computes the referenced
+    //       blocks from the generated address blocks, so that the memory access pattern does not
+    //       depend on the password. Argon2d uses the first word of the previous block instead.
+    const bool _Independent = _Instance._Variant == _Argon2_variant::_Argon2i
+        || (_Instance._Variant == _Argon2_variant::_Argon2id && _Pass == 0 && _Slice < 2);
+    _Argon2_block _Addresses = {};
+    _Argon2_block _Input     = {};
+    if (_Independent) {
+        _Input._Words[0] = _Pass;
+        _Input._Words[1] = _Lane;
+        _Input._Words[2] = _Slice;
+        _Input._Words[3] = static_cast<uint64_t>(_Instance._Lane_length) * _Instance._Lanes;
+        _Input._Words[4] = _Instance._Passes;
+        _Input._Words[5] = static_cast<uint64_t>(_Instance._Variant);
+    }
+
+    uint32_t _First = 0;
+    if (_Pass == 0 && _Slice == 0) { // the first two blocks of each lane are already computed
+        _First = 2;
+        if (_Independent) {
+            _Argon2_next_addresses(_Addresses, _Input);
+        }
+    }
+
+    const uint64_t _Lane_off = static_cast<uint64_t>(_Lane) * _Instance._Lane_length;
+    uint32_t _Cur            = _Slice * _Instance._Segment_length + _First; // index in the lane
+    for (uint32_t _Idx = _First; _Idx < _Instance._Segment_length; ++_Idx, ++_Cur) {
+        const uint32_t _Prev = _Cur == 0 ? _Instance._Lane_length - 1 : _Cur - 1;
+        uint64_t _Rand;
+        if (_Independent) {
+            if (_Idx % _Argon2_block_words == 0) {
+                _Argon2_next_addresses(_Addresses, _Input);
+            }
+
+            _Rand = _Addresses._Words[_Idx % _Argon2_block_words];
+        } else {
+            _Rand = _Instance._Memory[_Lane_off + _Prev]._Words[0];
+        }
+
+        uint32_t _Ref_lane = static_cast<uint32_t>((_Rand >> 32) % _Instance._Lanes);
+        if (_Pass == 0 && _Slice == 0) { // other lanes have not been computed yet
+            _Ref_lane = _Lane;
+        }
+
+        const uint32_t _Ref = _Argon2_reference_index(
+            _Instance, _Pass, _Slice, _Idx, static_cast<uint32_t>(_Rand), _Ref_lane == _Lane);
+        _Argon2_fill_block(_Instance._Memory[_Lane_off + _Prev],
+            _Instance._Memory[static_cast<uint64_t>(_Ref_lane) * _Instance._Lane_length + _Ref],
+            _Instance._Memory[_Lane_off + _Cur], _Pass != 0);
+    }
+}
+
+// FUNCTION _Argon2_initial_hash
+_NODISCARD bool _Argon2_initial_hash(uint8_t* const _Buf, const _Argon2_instance& _Instance,
+    const uint32_t _Tag_size, const uint32_t _Memory_amount, const uint8_t* const _Password,
+    const uint32_t _Password_size, const uint8_t* const _Salt, const uint32_t _Salt_size,
+    const _Argon2_extras& _Extras) noexcept {
+    // Note: H0 covers the parameters, the password, the salt, the secret key and the associated
+    //       data (each input is prefixed by its length, the optional ones may be empty).
+    EVP_MD_CTX* const _Ctx = ::EVP_MD_CTX_new();
+    if (!_Ctx) {
+        return false;
+    }
+
+    uint8_t _Params[24];
+    uint8_t _Length[4];
+    _Argon2_store32(_Params, _Instance._Lanes);
+    _Argon2_store32(_Params + 4, _Tag_size);
+    _Argon2_store32(_Params + 8, _Memory_amount);
+    _Argon2_store32(_Params + 12, _Instance._Passes);
+    _Argon2_store32(_Params + 16, 0x13); // version 1.3
+    _Argon2_store32(_Params + 20, static_cast<uint32_t>(_Instance._Variant));
+    bool _Ok = ::EVP_DigestInit_ex(_Ctx, ::EVP_blake2b512(), nullptr) != 0
+        && ::EVP_DigestUpdate(_Ctx, _Params, sizeof(_Params)) != 0;
+    _Argon2_store32(_Length, _Password_size);
+    _Ok = _Ok && ::EVP_DigestUpdate(_Ctx, _Length, sizeof(_Length)) != 0
+        && ::EVP_DigestUpdate(_Ctx, _Password, _Password_size) != 0;
+    _Argon2_store32(_Length, _Salt_size);
+    _Ok = _Ok && ::EVP_DigestUpdate(_Ctx, _Length, sizeof(_Length)) != 0
+        && ::EVP_DigestUpdate(_Ctx, _Salt, _Salt_size) != 0;
+    _Argon2_store32(_Length, _Extras._Secret_size);
+    _Ok = _Ok && ::EVP_DigestUpdate(_Ctx, _Length, sizeof(_Length)) != 0
+        && ::EVP_DigestUpdate(_Ctx, _Extras._Secret, _Extras._Secret_size) != 0;
+    _Argon2_store32(_Length, _Extras._Data_size);
+    _Ok = _Ok && ::EVP_DigestUpdate(_Ctx, _Length, sizeof(_Length)) != 0
+        && ::EVP_DigestUpdate(_Ctx, _Extras._Data, _Extras._Data_size) != 0;
+    uint32_t _Bytes = 0; // hashed bytes (unused)
+    _Ok             = _Ok && ::EVP_DigestFinal_ex(_Ctx, _Buf, &_Bytes) != 0;
+    ::EVP_MD_CTX_free(_Ctx);
+    return _Ok;
+}
+
+// FUNCTION _Argon2_hash
+_NODISCARD bool _Argon2_hash(const _Argon2_variant _Variant, uint8_t* const _Buf,
+    const size_t _Buf_size, const uint8_t* const _Password, const size_t _Password_size,
+    const uint8_t* const _Salt, const size_t _Salt_size, const size_t _Memory_amount,
+    const size_t _Iterations, const size_t _Parallelism, password_arena& _Arena,
+    const _Argon2_extras& _Extras) noexcept {
+    if (!_Buf || _Password_size > 0xFFFF'FFFF || _Salt_size < 8 || _Salt_size > 0xFFFF'FFFF) {
+        return false;
+    }
+
+    if ((!_Extras._Secret && _Extras._Secret_size > 0) || (!_Extras._Data && _Extras._Data_size > 0)) {
+        return false;
+    }
+
+    if (_Parallelism == 0 || _Parallelism > 0xFF'FFFF || _Iterations == 0 || _Iterations > 0xFFFF'FFFF) {
+        return false;
+    }
+
+    if (_Memory_amount < 8 * _Parallelism || _Memory_amount > 0xFFFF'FFFF) { // at least 8 blocks per lane
+        return false;
+    }
+
+    // Note: The memory amount (in KiB) is rounded down to a multiple of 4 * _Parallelism,
+    //       so that each lane consists of 4 segments of equal length.
+    _Argon2_instance _Instance;
+    _Instance._Variant        = _Variant;
+    _Instance._Passes         = static_cast<uint32_t>(_Iterations);
+    _Instance._Lanes          = static_cast<uint32_t>(_Parallelism);
+    _Instance._Segment_length = static_cast<uint32_t>(_Memory_amount / (4 * _Parallelism));
+    _Instance._Lane_length    = 4 * _Instance._Segment_length;
+    const size_t _Blocks      = static_cast<size_t>(_Instance._Lane_length) * _Instance._Lanes;
+    const size_t _Bytes       = _Blocks * sizeof(_Argon2_block);
+    if (!_Arena.reserve(_Bytes)) { // failed to allocate the memory
+        return false;
+    }
+
+    _Instance._Memory = static_cast<_Argon2_block*>(_Arena.data());
+    uint8_t _Seed[72]; // H0 followed by the block index and the lane index
+    if (!_Argon2_initial_hash(_Seed, _Instance, static_cast<uint32_t>(_Buf_size),
+        static_cast<uint32_t>(_Memory_amount), _Password, static_cast<uint32_t>(_Password_size),
+        _Salt, static_cast<uint32_t>(_Salt_size), _Extras)) {
+        return false;
+    }
+
+    // Note: The blocks are stored as little-endian 64-bit words, which is the native byte order
+    //       on all supported targets, so the bytes can be copied directly.
+    bool _Ok = true;
+    for (uint32_t _Lane = 0; _Ok && _Lane < _Instance._Lanes; ++_Lane) {
+        _Argon2_block* const _First = _Instance._Memory + static_cast<size_t>(_Lane) * _Instance._Lane_length;
+        _Argon2_store32(_Seed + 68, _Lane);
+        for (uint32_t _Idx = 0; _Ok && _Idx < 2; ++_Idx) {
+            _Argon2_store32(_Seed + 64, _Idx);
+            _Ok = _Argon2_blake2b_long(reinterpret_cast<uint8_t*>(_First + _Idx),
+                sizeof(_Argon2_block), _Seed, sizeof(_Seed));
+        }
+    }
+
+    memory_traits::set(_Seed, 0, sizeof(_Seed));
+    if (_Ok) {
+        for (uint32_t _Pass = 0; _Pass < _Instance._Passes; ++_Pass) {
+            for (uint32_t _Slice = 0; _Slice < 4; ++_Slice) {
+                for (uint32_t _Lane = 0; _Lane < _Instance._Lanes; ++_Lane) {
+                    _Argon2_fill_segment(_Instance, _Pass, _Lane, _Slice);
+                }
+            }
+        }
+
+        // Note: The final block is the XOR of the last blocks of all lanes.
+        _Argon2_block _Final = _Instance._Memory[_Instance._Lane_length - 1];
+        for (uint32_t _Lane = 1; _Lane < _Instance._Lanes; ++_Lane) {
+            const _Argon2_block& _Last =
+                _Instance._Memory[static_cast<size_t>(_Lane + 1) * _Instance._Lane_length - 1];
+            for (size_t _Word = 0; _Word < _Argon2_block_words; ++_Word) {
+                _Final._Words[_Word] ^= _Last._Words[_Word];
+            }
+        }
+
+        _Ok = _Argon2_blake2b_long(
+            _Buf, _Buf_size, reinterpret_cast<const uint8_t*>(_Final._Words), sizeof(_Argon2_block));
+        memory_traits::set(_Final._Words, 0, sizeof(_Final._Words));
+    }
+
+    _Arena.wipe(_Bytes); // the blocks are derived from the password, don't leave them in memory
+    return _Ok;
+}
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
@@ -0,0 +1,135 @@
+// argon2_core.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SDSDLL_CRYPTOGRAPHY_HASH_PASSWORD_ARGON2_CORE_HPP_
+#define _SDSDLL_CRYPTOGRAPHY_HASH_PASSWORD_ARGON2_CORE_HPP_
+#include <core/defs.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+#include <core/api.hpp>
+#include <core/traits/memory_traits.hpp>
+#include <cryptography/hash/password/arena.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <botan/blake2b.h>
+#include <openssl/evp.h>
+
+// SSE2 is always available on 64-bit platforms and enabled by default (/arch:SSE2) on 32-bit ones
+#ifndef _SDSDLL_ARGON2_SSE2
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define _SDSDLL_ARGON2_SSE2 1
+#else // ^^^ SSE2 ^^^ / vvv no SSE2 vvv
+#define _SDSDLL_ARGON2_SSE2 0
+#endif // defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#endif // _SDSDLL_ARGON2_SSE2
+
+#if _SDSDLL_ARGON2_SSE2
+#include <emmintrin.h>
+#endif // _SDSDLL_ARGON2_SSE2
+
+_SDSDLL_BEGIN
+// ENUM CLASS _Argon2_variant
+enum class _Argon2_variant : uint32_t {
+    _Argon2d  = 0,
+    _Argon2i  = 1,
+    _Argon2id = 2
+};
+
+// CONSTANT _Argon2_block_words
+inline constexpr size_t _Argon2_block_words = 128; // 1024-byte block as 64-bit words
+
+// STRUCT _Argon2_block
+struct _Argon2_block {
+    uint64_t _Words[_Argon2_block_words];
+};
+
+// STRUCT _Argon2_instance
+struct _Argon2_instance {
+    _Argon2_block* _Memory; // all blocks, lane after lane
+    _Argon2_variant _Variant;
+    uint32_t _Passes; // number of iterations
+    uint32_t _Lanes; // degree of parallelism
+    uint32_t _Lane_length; // blocks in a single lane
+    uint32_t _Segment_length; // blocks in a single segment (a quarter of a lane)
+};
+
+// STRUCT _Argon2_extras
+struct _Argon2_extras { // optional secret key (K) and associated data (X) from RFC 9106
+    const uint8_t* _Secret;
+    uint32_t _Secret_size;
+    const uint8_t* _Data;
+    uint32_t _Data_size;
+};
+
+// FUNCTION _Argon2_store32
+extern void _Argon2_store32(uint8_t* const _Dest, const uint32_t _Val) noexcept;
+
+// FUNCTION _Argon2_blake2b
+extern _NODISCARD bool _Argon2_blake2b(uint8_t* const _Buf, const uint8_t* const _Prefix,
+    const size_t _Prefix_size, const uint8_t* const _Data, const size_t _Data_size) noexcept;
+
+// FUNCTION _Argon2_blake2b_sized
+extern _NODISCARD bool _Argon2_blake2b_sized(uint8_t* const _Buf, const size_t _Buf_size,
+    const uint8_t* const _Prefix, const size_t _Prefix_size, const uint8_t* const _Data,
+    const size_t _Data_size) noexcept;
+
+// FUNCTION _Argon2_blake2b_long
+extern _NODISCARD bool _Argon2_blake2b_long(uint8_t* const _Buf, const size_t _Buf_size,
+    const uint8_t* const _Data, const size_t _Data_size) noexcept;
+
+// FUNCTION _Argon2_blamka
+extern _NODISCARD uint64_t _Argon2_blamka(const uint64_t _Left, const uint64_t _Right) noexcept;
+
+// FUNCTION _Argon2_rotate_right
+extern _NODISCARD uint64_t _Argon2_rotate_right(const uint64_t _Val, const int _Count) noexcept;
+
+// FUNCTION _Argon2_mix
+extern void _Argon2_mix(uint64_t& _Ax, uint64_t& _Bx, uint64_t& _Cx, uint64_t& _Dx) noexcept;
+
+// FUNCTION _Argon2_permute
+extern void _Argon2_permute(uint64_t* const _Words, const size_t _First, const size_t _Step) noexcept;
+
+#if _SDSDLL_ARGON2_SSE2
+// FUNCTION _Argon2_blamka_sse2
+extern _NODISCARD __m128i _Argon2_blamka_sse2(const __m128i _Left, const __m128i _Right) noexcept;
+
+// FUNCTION _Argon2_rotate_right_sse2
+extern _NODISCARD __m128i _Argon2_rotate_right_sse2(const __m128i _Val, const int _Count) noexcept;
+
+// FUNCTION _Argon2_permute_sse2
+extern void _Argon2_permute_sse2(__m128i* const _Regs, const size_t _First, const size_t _Step) noexcept;
+#endif // _SDSDLL_ARGON2_SSE2
+
+// FUNCTION _Argon2_fill_block
+extern void _Argon2_fill_block(const _Argon2_block& _Prev, const _Argon2_block& _Ref,
+    _Argon2_block& _Next, const bool _With_xor) noexcept;
+
+// FUNCTION _Argon2_next_addresses
+extern void _Argon2_next_addresses(_Argon2_block& _Addresses, _Argon2_block& _Input) noexcept;
+
+// FUNCTION _Argon2_reference_index
+extern _NODISCARD uint32_t _Argon2_reference_index(const _Argon2_instance& _Instance, const uint32_t _Pass,
+    const uint32_t _Slice, const uint32_t _Idx, const uint32_t _Rand, const bool _Same_lane) noexcept;
+
+// FUNCTION _Argon2_fill_segment
+extern void _Argon2_fill_segment(const _Argon2_instance& _Instance,
+    const uint32_t _Pass, const uint32_t _Lane, const uint32_t _Slice) noexcept;
+
+// FUNCTION _Argon2_initial_hash
+extern _NODISCARD bool _Argon2_initial_hash(uint8_t* const _Buf, const _Argon2_instance& _Instance,
+    const uint32_t _Tag_size, const uint32_t _Memory_amount, const uint8_t* const _Password,
+    const uint32_t _Password_size, const uint8_t* const _Salt, const uint32_t _Salt_size,
+    const _Argon2_extras& _Extras) noexcept;
+
+// FUNCTION _Argon2_hash
+_SDSDLL_API _NODISCARD bool _Argon2_hash(const _Argon2_variant _Variant, uint8_t* const _Buf,
+    const size_t _Buf_size, const uint8_t* const _Password, const size_t _Password_size,
+    const uint8_t* const _Salt, const size_t _Salt_size, const size_t _Memory_amount,
+    const size_t _Iterations, const size_t _Parallelism, password_arena& _Arena,
+    const _Argon2_extras& _Extras = _Argon2_extras{nullptr, 0, nullptr, 0}) noexcept;
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
+#endif // _SDSDLL_CRYPTOGRAPHY_HASH_PASSWORD_ARGON2_CORE_HPP_
@@ -21,40 +21,34 @@ _NODISCARD constexpr bool argon2i_traits<_Elem>::hash(
     byte_type* const _Buf, const size_type _Buf_size, const char_type* const _Data,
     const size_type _Data_size, const salt& _Salt, const size_type _Memory_amount,
     const size_type _Iterations, const size_type _Parallelism) noexcept {
+    // Note: The memory is taken from the arena of the current thread, so that it is allocated
+    //       (and faulted in) once per thread instead of once per hash, unless it exceeds the limit.
+    const bool _Result = hash(_Buf, _Buf_size, _Data, _Data_size, _Salt, _Memory_amount,
+        _Iterations, _Parallelism, _SDSDLL _Thread_local_password_arena());
+    _SDSDLL _Trim_thread_local_password_arena();
+    return _Result;
+}
+
+template <class _Elem>
+_NODISCARD bool argon2i_traits<_Elem>::hash(
+    byte_type* const _Buf, const size_type _Buf_size, const char_type* const _Data,
+    const size_type _Data_size, const salt& _Salt, const size_type _Memory_amount,
+    const size_type _Iterations, const size_type _Parallelism, password_arena& _Arena) noexcept {
     constexpr size_type _Optimal_buf_size = bytes_count();
     if (!_Buf || _Buf_size < _Optimal_buf_size) {
         return false;
     }
 
-    constexpr uint8_t _Variant = 1; // Argon2 variant (required by Botan)
     if constexpr (sizeof(_Elem) == 1) { // hash a UTF-8 password
-        if (_Data_size > 0xFFFF'FFFF) { // Argon2i can hash at most 2^32 - 1 bytes
-            return false;
-        }
-
-        try { // throws if one of the arguments is invalid
-            ::Botan::argon2(_Buf, _Optimal_buf_size, reinterpret_cast<const char*>(_Data),
-                _Data_size, _Salt.get(), _Salt.size, nullptr, 0, nullptr, 0, _Variant,
-                _Parallelism, _Memory_amount, _Iterations);
-        } catch (...) {
-            return false;
-        }
+        return _SDSDLL _Argon2_hash(_Argon2_variant::_Argon2i, _Buf, _Optimal_buf_size,
+            reinterpret_cast<const uint8_t*>(_Data), _Data_size, _Salt.get(), _Salt.size,
+            _Memory_amount, _Iterations, _Parallelism, _Arena);
     } else { // hash a Unicode password
         const utf8_string& _Narrow = utf8_string::from_utf16(_Data, _Data_size);
-        if (_Narrow.size() > 0xFFFF'FFFF) { // Argon2i can hash at most 2^32 - 1 bytes
-            return false;
-        }
-
-        try { // throws if one of the arguments is invalid
-            ::Botan::argon2(_Buf, _Optimal_buf_size, _Narrow.c_str(), _Narrow.size(),
-                _Salt.get(), _Salt.size, nullptr, 0, nullptr, 0, _Variant,
-                _Parallelism, _Memory_amount, _Iterations);
-        } catch (...) {
-            return false;
-        }
+        return _SDSDLL _Argon2_hash(_Argon2_variant::_Argon2i, _Buf, _Optimal_buf_size,
+            reinterpret_cast<const uint8_t*>(_Narrow.c_str()), _Narrow.size(), _Salt.get(), _Salt.size,
+            _Memory_amount, _Iterations, _Parallelism, _Arena);
     }
-
-    return true;
 }
 
 template struct _SDSDLL_API argon2i_traits<char>;
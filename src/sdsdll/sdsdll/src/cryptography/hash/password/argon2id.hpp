@@ -8,11 +8,12 @@
 #define _SDSDLL_CRYPTOGRAPHY_HASH_PASSWORD_ARGON2ID_HPP_
 #include <core/defs.hpp>
 #if _SDSDLL_PREPROCESSOR_GUARD
-#include <botan/argon2.h>
 #include <climits>
 #include <core/api.hpp>
 #include <core/traits/concepts.hpp>
 #include <core/traits/string_traits.hpp>
+#include <cryptography/hash/password/arena.hpp>
+#include <cryptography/hash/password/argon2_core.hpp>
 #include <cryptography/random/salt.hpp>
 #include <cstddef>
 #include <encoding/utf8.hpp>
@@ -48,6 +49,12 @@ public:
         byte_type* const _Buf, const size_type _Buf_size, const char_type* const _Data,
         const size_type _Data_size, const salt& _Salt, const size_type _Memory_amount,
         const size_type _Iterations, const size_type _Parallelism) noexcept;
+
+    // hashes a UTF-8/Unicode password, the memory is taken from the selected arena
+    _NODISCARD static bool hash(
+        byte_type* const _Buf, const size_type _Buf_size, const char_type* const _Data,
+        const size_type _Data_size, const salt& _Salt, const size_type _Memory_amount,
+        const size_type _Iterations, const size_type _Parallelism, password_arena& _Arena) noexcept;
 };
 _SDSDLL_END
 
@@ -0,0 +1,143 @@
+// calibration.cpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <build/sdsdll_pch.hpp>
+#include <cryptography/hash/password/calibration.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+
+_SDSDLL_BEGIN
+// FUNCTION operator==
+_NODISCARD bool operator==(const argon2_params& _Left, const argon2_params& _Right) noexcept {
+    return _Left.memory_amount == _Right.memory_amount && _Left.iterations == _Right.iterations
+        && _Left.parallelism == _Right.parallelism;
+}
+
+// FUNCTION operator!=
+_NODISCARD bool operator!=(const argon2_params& _Left, const argon2_params& _Right) noexcept {
+    return !(_Left == _Right);
+}
+
+// FUNCTION _Is_valid_argon2_params
+_NODISCARD bool _Is_valid_argon2_params(const argon2_params& _Params) noexcept {
+    if (_Params.parallelism == 0 || _Params.parallelism > 0xFF'FFFF || _Params.iterations == 0) {
+        return false;
+    }
+
+    return _Params.memory_amount >= 8 * _Params.parallelism; // at least 8 blocks per lane
+}
+
+// FUNCTION _Measure_argon2id
+_NODISCARD uint64_t _Measure_argon2id(
+    const argon2_params& _Params, const size_t _Runs, password_arena& _Arena) noexcept {
+    // Note: Returns the shortest of _Runs hashes in nanoseconds (0 if the hash failed). The first
+    //       run faults in the arena memory, taking the shortest run excludes that cost, just like
+    //       a verification on a warmed-up thread.
+    LARGE_INTEGER _Freq;
+    if (!::QueryPerformanceFrequency(&_Freq) || _Freq.QuadPart <= 0) {
+        return 0;
+    }
+
+    uint8_t _Password[16];
+    uint8_t _Salt[16];
+    uint8_t _Buf[64];
+    if (!_SDSDLL _Random_fill(_Password, sizeof(_Password)) || !_SDSDLL _Random_fill(_Salt, sizeof(_Salt))) {
+        return 0;
+    }
+
+    uint64_t _Result = 0;
+    for (size_t _Run = 0; _Run < _Runs; ++_Run) {
+        LARGE_INTEGER _Start;
+        LARGE_INTEGER _End;
+        ::QueryPerformanceCounter(&_Start);
+        if (!_SDSDLL _Argon2_hash(_Argon2_variant::_Argon2id, _Buf, sizeof(_Buf), _Password,
+            sizeof(_Password), _Salt, sizeof(_Salt), _Params.memory_amount, _Params.iterations,
+            _Params.parallelism, _Arena)) {
+            return 0;
+        }
+
+        ::QueryPerformanceCounter(&_End);
+        const uint64_t _Ticks   = static_cast<uint64_t>(_End.QuadPart - _Start.QuadPart);
+        const uint64_t _Elapsed = static_cast<uint64_t>(
+            static_cast<double>(_Ticks) * 1'000'000'000.0 / static_cast<double>(_Freq.QuadPart));
+        if (_Result == 0 || _Elapsed < _Result) {
+            _Result = (_STD max)(_Elapsed, uint64_t{1});
+        }
+    }
+
+    return _Result;
+}
+
+// FUNCTION calibrate_argon2id
+_NODISCARD bool calibrate_argon2id(argon2_params& _Params, const uint32_t _Target_time,
+    const uint32_t _Max_memory, const uint32_t _Parallelism) noexcept {
+    // Note: The parameters never go below 19 MiB and 2 iterations, even if a single hash already
+    //       takes longer than _Target_time (in milliseconds). Above that, the memory is raised
+    //       first, because it is what makes the hash expensive to attack with dedicated hardware,
+    //       and the iterations take the remaining time budget.
+    static constexpr uint32_t _Min_memory     = 19456;
+    static constexpr uint32_t _Min_iterations = 2;
+    static constexpr uint32_t _Max_iterations = 1024;
+    static constexpr size_t _Runs             = 3;
+    if (_Target_time == 0 || _Parallelism == 0 || _Parallelism > 0xFF'FFFF) {
+        return false;
+    }
+
+    const uint32_t _Floor = (_STD max)(_Min_memory, 8 * _Parallelism);
+    if (_Max_memory < _Floor) { // not enough memory for the minimum parameters
+        return false;
+    }
+
+    password_arena& _Arena = _SDSDLL _Thread_local_password_arena();
+    const uint64_t _Target = static_cast<uint64_t>(_Target_time) * 1'000'000; // in nanoseconds
+    argon2_params _Current = {_Floor, _Min_iterations, _Parallelism};
+    uint64_t _Elapsed      = _Measure_argon2id(_Current, _Runs, _Arena);
+    if (_Elapsed == 0) { // failed to compute a hash
+        _SDSDLL _Trim_thread_local_password_arena();
+        return false;
+    }
+
+    // Note: The time grows linearly with the memory, so it is doubled only while the doubled
+    //       time is expected to fit. A hash that fails (e.g. the memory cannot be allocated)
+    //       or turns out to be too slow ends the search.
+    while (_Elapsed * 2 <= _Target && _Current.memory_amount <= _Max_memory / 2) {
+        argon2_params _Next  = _Current;
+        _Next.memory_amount *= 2;
+        const uint64_t _Next_elapsed = _Measure_argon2id(_Next, _Runs, _Arena);
+        if (_Next_elapsed == 0 || _Next_elapsed > _Target) {
+            break;
+        }
+
+        _Current = _Next;
+        _Elapsed = _Next_elapsed;
+    }
+
+    // Note: The time grows linearly with the iterations as well, so the remaining budget is
+    //       estimated from the time of a single pass. The estimate is measured and scaled down
+    //       until it fits.
+    const uint64_t _Pass = (_STD max)(_Elapsed / _Current.iterations, uint64_t{1});
+    argon2_params _Next  = _Current;
+    _Next.iterations     = static_cast<uint32_t>((_STD min)(_Target / _Pass, uint64_t{_Max_iterations}));
+    while (_Next.iterations > _Current.iterations) {
+        const uint64_t _Next_elapsed = _Measure_argon2id(_Next, _Runs, _Arena);
+        if (_Next_elapsed == 0) { // failed to compute a hash
+            break;
+        }
+
+        if (_Next_elapsed <= _Target) {
+            _Current = _Next;
+            break;
+        }
+
+        const uint64_t _Scaled = static_cast<uint64_t>(_Next.iterations) * _Target / _Next_elapsed;
+        _Next.iterations       = (_STD min)(static_cast<uint32_t>(_Scaled), _Next.iterations - 1);
+    }
+
+    _SDSDLL _Trim_thread_local_password_arena(); // the largest measured hash may exceed the limit
+    _Params = _Current;
+    return true;
+}
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
@@ -0,0 +1,47 @@
+// calibration.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SDSDLL_CRYPTOGRAPHY_HASH_PASSWORD_CALIBRATION_HPP_
+#define _SDSDLL_CRYPTOGRAPHY_HASH_PASSWORD_CALIBRATION_HPP_
+#include <core/defs.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+#include <algorithm>
+#include <core/api.hpp>
+#include <cryptography/hash/password/arena.hpp>
+#include <cryptography/hash/password/argon2_core.hpp>
+#include <cryptography/random/drbg.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <profileapi.h>
+
+_SDSDLL_BEGIN
+// STRUCT argon2_params
+struct argon2_params { // cost parameters of the Argon2 password hashes
+    uint32_t memory_amount; // memory in KiB
+    uint32_t iterations; // number of passes over the memory
+    uint32_t parallelism; // number of lanes
+};
+
+// FUNCTION operator==
+_SDSDLL_API _NODISCARD bool operator==(const argon2_params& _Left, const argon2_params& _Right) noexcept;
+
+// FUNCTION operator!=
+_SDSDLL_API _NODISCARD bool operator!=(const argon2_params& _Left, const argon2_params& _Right) noexcept;
+
+// FUNCTION _Is_valid_argon2_params
+extern _NODISCARD bool _Is_valid_argon2_params(const argon2_params& _Params) noexcept;
+
+// FUNCTION _Measure_argon2id
+extern _NODISCARD uint64_t _Measure_argon2id(
+    const argon2_params& _Params, const size_t _Runs, password_arena& _Arena) noexcept;
+
+// FUNCTION calibrate_argon2id
+_SDSDLL_API _NODISCARD bool calibrate_argon2id(argon2_params& _Params, const uint32_t _Target_time,
+    const uint32_t _Max_memory = 1048576, const uint32_t _Parallelism = 1) noexcept;
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
+#endif // _SDSDLL_CRYPTOGRAPHY_HASH_PASSWORD_CALIBRATION_HPP_
@@ -0,0 +1,154 @@
+// scrypt_core.cpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <build/sdsdll_pch.hpp>
+#include <cryptography/hash/password/scrypt_core.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+
+_SDSDLL_BEGIN
+// FUNCTION _Scrypt_rotate_left
+_NODISCARD uint32_t _Scrypt_rotate_left(const uint32_t _Val, const int _Count) noexcept {
+    return (_Val << _Count) | (_Val >> (32 - _Count));
+}
+
+// FUNCTION _Scrypt_salsa20_8
+void _Scrypt_salsa20_8(uint32_t* const _Words) noexcept {
+    uint32_t _State[16];
+    memory_traits::copy(_State, _Words, sizeof(_State));
+    for (int _Round = 0; _Round < 8; _Round += 2) {
+        // operate on columns
+        _State[4]  ^= _Scrypt_rotate_left(_State[0] + _State[12], 7);
+        _State[8]  ^= _Scrypt_rotate_left(_State[4] + _State[0], 9);
+        _State[12] ^= _Scrypt_rotate_left(_State[8] + _State[4], 13);
+        _State[0]  ^= _Scrypt_rotate_left(_State[12] + _State[8], 18);
+        _State[9]  ^= _Scrypt_rotate_left(_State[5] + _State[1], 7);
+        _State[13] ^= _Scrypt_rotate_left(_State[9] + _State[5], 9);
+        _State[1]  ^= _Scrypt_rotate_left(_State[13] + _State[9], 13);
+        _State[5]  ^= _Scrypt_rotate_left(_State[1] + _State[13], 18);
+        _State[14] ^= _Scrypt_rotate_left(_State[10] + _State[6], 7);
+        _State[2]  ^= _Scrypt_rotate_left(_State[14] + _State[10], 9);
+        _State[6]  ^= _Scrypt_rotate_left(_State[2] + _State[14], 13);
+        _State[10] ^= _Scrypt_rotate_left(_State[6] + _State[2], 18);
+        _State[3]  ^= _Scrypt_rotate_left(_State[15] + _State[11], 7);
+        _State[7]  ^= _Scrypt_rotate_left(_State[3] + _State[15], 9);
+        _State[11] ^= _Scrypt_rotate_left(_State[7] + _State[3], 13);
+        _State[15] ^= _Scrypt_rotate_left(_State[11] + _State[7], 18);
+
+        // operate on rows
+        _State[1]  ^= _Scrypt_rotate_left(_State[0] + _State[3], 7);
+        _State[2]  ^= _Scrypt_rotate_left(_State[1] + _State[0], 9);
+        _State[3]  ^= _Scrypt_rotate_left(_State[2] + _State[1], 13);
+        _State[0]  ^= _Scrypt_rotate_left(_State[3] + _State[2], 18);
+        _State[6]  ^= _Scrypt_rotate_left(_State[5] + _State[4], 7);
+        _State[7]  ^= _Scrypt_rotate_left(_State[6] + _State[5], 9);
+        _State[4]  ^= _Scrypt_rotate_left(_State[7] + _State[6], 13);
+        _State[5]  ^= _Scrypt_rotate_left(_State[4] + _State[7], 18);
+        _State[11] ^= _Scrypt_rotate_left(_State[10] + _State[9], 7);
+        _State[8]  ^= _Scrypt_rotate_left(_State[11] + _State[10], 9);
+        _State[9]  ^= _Scrypt_rotate_left(_State[8] + _State[11], 13);
+        _State[10] ^= _Scrypt_rotate_left(_State[9] + _State[8], 18);
+        _State[12] ^= _Scrypt_rotate_left(_State[15] + _State[14], 7);
+        _State[13] ^= _Scrypt_rotate_left(_State[12] + _State[15], 9);
+        _State[14] ^= _Scrypt_rotate_left(_State[13] + _State[12], 13);
+        _State[15] ^= _Scrypt_rotate_left(_State[14] + _State[13], 18);
+    }
+
+    for (size_t _Idx = 0; _Idx < 16; ++_Idx) {
+        _Words[_Idx] += _State[_Idx];
+    }
+}
+
+// FUNCTION _Scrypt_block_mix
+void _Scrypt_block_mix(const uint32_t* const _Src, uint32_t* const _Dest, const size_t _Block_size) noexcept {
+    // Note: The even 64-byte blocks are stored in the first half of the _Dest,
+    //       the odd ones in the second half.
+    uint32_t _Words[16];
+    memory_traits::copy(_Words, _Src + (2 * _Block_size - 1) * 16, sizeof(_Words));
+    for (size_t _Idx = 0; _Idx < 2 * _Block_size; ++_Idx) {
+        for (size_t _Word = 0; _Word < 16; ++_Word) {
+            _Words[_Word] ^= _Src[_Idx * 16 + _Word];
+        }
+
+        _Scrypt_salsa20_8(_Words);
+        memory_traits::copy(_Dest + (_Idx / 2 + (_Idx % 2) * _Block_size) * 16, _Words, sizeof(_Words));
+    }
+}
+
+// FUNCTION _Scrypt_romix
+void _Scrypt_romix(uint8_t* const _Block, const size_t _Block_size,
+    const size_t _Cost, uint32_t* const _Memory) noexcept {
+    // Note: The _Memory holds _Cost blocks, followed by two working blocks. The words are stored
+    //       in little-endian order, which is the native byte order on all supported targets.
+    const size_t _Words = 32 * _Block_size; // words in a single block
+    uint32_t* const _Xx = _Memory + _Cost * _Words;
+    uint32_t* const _Yy = _Xx + _Words;
+    memory_traits::copy(_Xx, _Block, _Words * sizeof(uint32_t));
+    for (size_t _Idx = 0; _Idx < _Cost; ++_Idx) {
+        memory_traits::copy(_Memory + _Idx * _Words, _Xx, _Words * sizeof(uint32_t));
+        _Scrypt_block_mix(_Xx, _Yy, _Block_size);
+        memory_traits::copy(_Xx, _Yy, _Words * sizeof(uint32_t));
+    }
+
+    for (size_t _Idx = 0; _Idx < _Cost; ++_Idx) {
+        const uint32_t* const _Last = _Xx + (2 * _Block_size - 1) * 16; // integerify the last block
+        const uint64_t _Integer     = _Last[0] | (static_cast<uint64_t>(_Last[1]) << 32);
+        const uint32_t* const _Vj   = _Memory + static_cast<size_t>(_Integer & (_Cost - 1)) * _Words;
+        for (size_t _Word = 0; _Word < _Words; ++_Word) {
+            _Xx[_Word] ^= _Vj[_Word];
+        }
+
+        _Scrypt_block_mix(_Xx, _Yy, _Block_size);
+        memory_traits::copy(_Xx, _Yy, _Words * sizeof(uint32_t));
+    }
+
+    memory_traits::copy(_Block, _Xx, _Words * sizeof(uint32_t));
+}
+
+// FUNCTION _Scrypt_hash
+_NODISCARD bool _Scrypt_hash(uint8_t* const _Buf, const size_t _Buf_size,
+    const uint8_t* const _Password, const size_t _Password_size, const uint8_t* const _Salt,
+    const size_t _Salt_size, const size_t _Cost, const size_t _Block_size,
+    const size_t _Parallelism, password_arena& _Arena) noexcept {
+    if (!_Buf || _Password_size > 0x7FFF'FFFF || _Salt_size > 0x7FFF'FFFF || _Buf_size > 0x7FFF'FFFF) {
+        return false;
+    }
+
+    if (_Cost < 2 || (_Cost & (_Cost - 1)) != 0 || _Block_size == 0 || _Parallelism == 0) {
+        return false;
+    }
+
+    // Note: The arena holds the _Cost blocks and two working blocks used by ROMix, followed by
+    //       the _Parallelism blocks derived from the password.
+    const size_t _Bytes_per_block = 128 * _Block_size;
+    if (_Cost > static_cast<size_t>(-1) / _Bytes_per_block - 2 - _Parallelism) { // too much memory
+        return false;
+    }
+
+    const size_t _Romix_bytes = (_Cost + 2) * _Bytes_per_block;
+    const size_t _Mixed_bytes = _Parallelism * _Bytes_per_block;
+    if (_Mixed_bytes > 0x7FFF'FFFF || !_Arena.reserve(_Romix_bytes + _Mixed_bytes)) {
+        return false;
+    }
+
+    uint32_t* const _Memory = static_cast<uint32_t*>(_Arena.data());
+    uint8_t* const _Mixed   = static_cast<uint8_t*>(_Arena.data()) + _Romix_bytes;
+    const char* const _Pass = reinterpret_cast<const char*>(_Password);
+    bool _Ok                = ::PKCS5_PBKDF2_HMAC(_Pass, static_cast<int>(_Password_size), _Salt,
+        static_cast<int>(_Salt_size), 1, ::EVP_sha256(), static_cast<int>(_Mixed_bytes), _Mixed) != 0;
+    if (_Ok) {
+        for (size_t _Idx = 0; _Idx < _Parallelism; ++_Idx) {
+            _Scrypt_romix(_Mixed + _Idx * _Bytes_per_block, _Block_size, _Cost, _Memory);
+        }
+
+        _Ok = ::PKCS5_PBKDF2_HMAC(_Pass, static_cast<int>(_Password_size), _Mixed,
+            static_cast<int>(_Mixed_bytes), 1, ::EVP_sha256(), static_cast<int>(_Buf_size), _Buf) != 0;
+    }
+
+    _Arena.wipe(_Romix_bytes + _Mixed_bytes); // the blocks are derived from the password
+    return _Ok;
+}
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
@@ -0,0 +1,41 @@
+// scrypt_core.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SDSDLL_CRYPTOGRAPHY_HASH_PASSWORD_SCRYPT_CORE_HPP_
+#define _SDSDLL_CRYPTOGRAPHY_HASH_PASSWORD_SCRYPT_CORE_HPP_
+#include <core/defs.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+#include <core/api.hpp>
+#include <core/traits/memory_traits.hpp>
+#include <cryptography/hash/password/arena.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <openssl/evp.h>
+
+_SDSDLL_BEGIN
+// FUNCTION _Scrypt_rotate_left
+extern _NODISCARD uint32_t _Scrypt_rotate_left(const uint32_t _Val, const int _Count) noexcept;
+
+// FUNCTION _Scrypt_salsa20_8
+extern void _Scrypt_salsa20_8(uint32_t* const _Words) noexcept;
+
+// FUNCTION _Scrypt_block_mix
+extern void _Scrypt_block_mix(
+    const uint32_t* const _Src, uint32_t* const _Dest, const size_t _Block_size) noexcept;
+
+// FUNCTION _Scrypt_romix
+extern void _Scrypt_romix(uint8_t* const _Block, const size_t _Block_size,
+    const size_t _Cost, uint32_t* const _Memory) noexcept;
+
+// FUNCTION _Scrypt_hash
+_SDSDLL_API _NODISCARD bool _Scrypt_hash(uint8_t* const _Buf, const size_t _Buf_size,
+    const uint8_t* const _Password, const size_t _Password_size, const uint8_t* const _Salt,
+    const size_t _Salt_size, const size_t _Cost, const size_t _Block_size,
+    const size_t _Parallelism, password_arena& _Arena) noexcept;
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
+#endif // _SDSDLL_CRYPTOGRAPHY_HASH_PASSWORD_SCRYPT_CORE_HPP_
@@ -0,0 +1,135 @@
+// drbg.cpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <build/sdsdll_pch.hpp>
+#include <cryptography/random/drbg.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+
+_SDSDLL_BEGIN
+// FUNCTION _Chacha20_drbg constructor/destructor
+_Chacha20_drbg::_Chacha20_drbg() noexcept
+    : _Myctx(::EVP_CIPHER_CTX_new()), _Mybuf(), _Mypos(sizeof(_Mybuf)), _Mygenerated(0), _Myvalid(false) {
+    _Myvalid = _Myctx && _Reseed();
+}
+
+_Chacha20_drbg::~_Chacha20_drbg() noexcept {
+    memory_traits::set(_Mybuf, 0, sizeof(_Mybuf)); // don't leave the key in memory
+    if (_Myctx) {
+        ::EVP_CIPHER_CTX_free(_Myctx);
+        _Myctx = nullptr;
+    }
+}
+
+// FUNCTION _Chacha20_drbg::_Rekey
+_NODISCARD bool _Chacha20_drbg::_Rekey(const uint8_t* const _Key) noexcept {
+    // Note: Each key generates exactly one block, so the nonce (and the counter) may always be zero.
+    static constexpr uint8_t _Iv[16] = {0};
+    return ::EVP_EncryptInit_ex(_Myctx, ::EVP_chacha20(), nullptr, _Key, _Iv) != 0;
+}
+
+// FUNCTION _Chacha20_drbg::_Reseed
+_NODISCARD bool _Chacha20_drbg::_Reseed() noexcept {
+    uint8_t _Key[_Key_size];
+    if (::RAND_bytes(_Key, static_cast<int>(_Key_size)) != 1) {
+        return false;
+    }
+
+    const bool _Result = _Rekey(_Key);
+    memory_traits::set(_Key, 0, _Key_size);
+    _Mygenerated = 0;
+    return _Result;
+}
+
+// FUNCTION _Chacha20_drbg::_Refill
+_NODISCARD bool _Chacha20_drbg::_Refill() noexcept {
+    if (_Mygenerated >= _Reseed_interval) { // mix in new entropy from time to time
+        if (!_Reseed()) {
+            return false;
+        }
+    }
+
+    // Note: The keystream is obtained by encrypting zeros. Its first 32 bytes become the next key
+    //       and are erased immediately, so the bytes that have already been returned cannot be
+    //       reconstructed even if the state leaks later.
+    memory_traits::set(_Mybuf, 0, sizeof(_Mybuf));
+    int _Bytes = 0; // generated bytes (unused)
+    if (::EVP_EncryptUpdate(_Myctx, _Mybuf, &_Bytes, _Mybuf, static_cast<int>(sizeof(_Mybuf))) == 0) {
+        return false;
+    }
+
+    const bool _Result = _Rekey(_Mybuf);
+    memory_traits::set(_Mybuf, 0, _Key_size);
+    _Mypos        = _Key_size;
+    _Mygenerated += _Block_size;
+    return _Result;
+}
+
+// FUNCTION _Chacha20_drbg::_Generate
+_NODISCARD bool _Chacha20_drbg::_Generate(uint8_t* _Buf, size_t _Count) noexcept {
+    if (!_Myvalid) {
+        return false;
+    }
+
+    while (_Count > 0) {
+        if (_Mypos == sizeof(_Mybuf)) { // no more buffered bytes
+            if (!_Refill()) {
+                _Myvalid = false;
+                return false;
+            }
+        }
+
+        const size_t _Bytes = (_STD min)(sizeof(_Mybuf) - _Mypos, _Count);
+        memory_traits::copy(_Buf, _Mybuf + _Mypos, _Bytes);
+        memory_traits::set(_Mybuf + _Mypos, 0, _Bytes); // each byte is returned only once
+        _Buf   += _Bytes;
+        _Count -= _Bytes;
+        _Mypos += _Bytes;
+    }
+
+    return true;
+}
+
+// FUNCTION _Thread_local_drbg
+_NODISCARD _Chacha20_drbg& _Thread_local_drbg() noexcept {
+    thread_local _Chacha20_drbg _Drbg;
+    return _Drbg;
+}
+
+// FUNCTION _Random_fill
+_NODISCARD bool _Random_fill(uint8_t* const _Buf, const size_t _Count) noexcept {
+    // Note: The bytes are requested in chunks, so that the OpenSSL generator, which takes an int,
+    //       can be used as a fallback for any _Count. The _Buf is erased if any chunk fails.
+    _Chacha20_drbg& _Drbg = _Thread_local_drbg();
+    for (size_t _Off = 0; _Off < _Count; _Off += _Random_chunk_size) {
+        const size_t _Size = (_STD min)(_Count - _Off, _Random_chunk_size);
+        if (!_Drbg._Generate(_Buf + _Off, _Size)) { // fall back to the OpenSSL generator
+            if (::RAND_bytes(_Buf + _Off, static_cast<int>(_Size)) != 1) {
+                memory_traits::set(_Buf, 0, _Off + _Size);
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// FUNCTION _Random_below
+_NODISCARD bool _Random_below(const uint16_t _Bound, uint8_t& _Result) noexcept {
+    // Note: The _Bound must be in [1, 256]. Bytes from the incomplete last range are rejected,
+    //       so that each result is equally likely.
+    const uint16_t _Limit = static_cast<uint16_t>(256 - 256 % _Bound);
+    uint8_t _Byte;
+    do {
+        if (!_Random_fill(_SDSDLL addressof(_Byte), 1)) {
+            return false;
+        }
+    } while (_Byte >= _Limit);
+
+    _Result = static_cast<uint8_t>(_Byte % _Bound);
+    return true;
+}
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
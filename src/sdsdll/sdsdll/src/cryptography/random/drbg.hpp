@@ -0,0 +1,68 @@
+// drbg.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SDSDLL_CRYPTOGRAPHY_RANDOM_DRBG_HPP_
+#define _SDSDLL_CRYPTOGRAPHY_RANDOM_DRBG_HPP_
+#include <core/defs.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+#include <algorithm>
+#include <core/traits/memory_traits.hpp>
+#include <core/traits/type_traits.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <openssl/types.h>
+
+_SDSDLL_BEGIN
+// CLASS _Chacha20_drbg
+class _Chacha20_drbg { // buffered ChaCha20 keystream generator, reseeded from RAND_bytes()
+public:
+    _Chacha20_drbg() noexcept;
+    ~_Chacha20_drbg() noexcept;
+
+    _Chacha20_drbg(const _Chacha20_drbg&) = delete;
+    _Chacha20_drbg& operator=(const _Chacha20_drbg&) = delete;
+
+    // fills the _Buf with _Count random bytes
+    _NODISCARD bool _Generate(uint8_t* _Buf, size_t _Count) noexcept;
+
+private:
+    static constexpr size_t _Key_size        = 32; // 32-byte ChaCha20 key
+    static constexpr size_t _Block_size      = 4096; // random bytes generated with a single key
+    static constexpr size_t _Reseed_interval = 1048576; // random bytes generated between reseeds
+
+    // changes the current key
+    _NODISCARD bool _Rekey(const uint8_t* const _Key) noexcept;
+
+    // changes the current key to a new one taken from RAND_bytes()
+    _NODISCARD bool _Reseed() noexcept;
+
+    // generates the next block of random bytes and changes the current key
+    _NODISCARD bool _Refill() noexcept;
+
+    EVP_CIPHER_CTX* _Myctx;
+    uint8_t _Mybuf[_Key_size + _Block_size]; // the next key followed by the random bytes
+    size_t _Mypos; // first unused byte in the _Mybuf
+    size_t _Mygenerated; // random bytes generated since the last reseed
+    bool _Myvalid;
+};
+
+// CONSTANT _Random_chunk_size
+inline constexpr size_t _Random_chunk_size = 1048576; // random bytes requested from a generator at once
+
+// FUNCTION _Thread_local_drbg
+extern _NODISCARD _Chacha20_drbg& _Thread_local_drbg() noexcept;
+
+// FUNCTION _Random_fill
+extern _NODISCARD bool _Random_fill(uint8_t* const _Buf, const size_t _Count) noexcept;
+
+// FUNCTION _Random_below
+extern _NODISCARD bool _Random_below(const uint16_t _Bound, uint8_t& _Result) noexcept;
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
+#endif // _SDSDLL_CRYPTOGRAPHY_RANDOM_DRBG_HPP_
@@ -9,19 +9,50 @@
 
 _SDSDLL_BEGIN
 // FUNCTION _Generate_random_byte
-_NODISCARD uint8_t _Generate_random_byte(const uint8_t _Min, const uint8_t _Max) {
-    random_device _Device;
-    mt19937 _Eng(_Device());
-    return static_cast<uint8_t>(uniform_int_distribution<uint16_t>{_Min, _Max}(_Eng));
+_NODISCARD bool _Generate_random_byte(uint8_t& _Result, const uint8_t _Min, const uint8_t _Max) noexcept {
+    uint8_t _Off;
+    if (!_Random_below(static_cast<uint16_t>(_Max - _Min + 1), _Off)) {
+        return false;
+    }
+
+    _Result = static_cast<uint8_t>(_Min + _Off);
+    return true;
+}
+
+// FUNCTION _Make_random_alphabet
+_NODISCARD _Random_alphabet _Make_random_alphabet(const random_format _Fmt) noexcept {
+    _Random_alphabet _Result = {{0}, 0};
+    if (_Has_bits(_Fmt, random_format::number)) { // numbers [0, 9]
+        for (char _Ch = '0'; _Ch <= '9'; ++_Ch) {
+            _Result._Chars[_Result._Size++] = _Ch;
+        }
+    }
+
+    if (_Has_bits(_Fmt, random_format::lowercase)) { // lowercase letters [a, z]
+        for (char _Ch = 'a'; _Ch <= 'z'; ++_Ch) {
+            _Result._Chars[_Result._Size++] = _Ch;
+        }
+    }
+
+    if (_Has_bits(_Fmt, random_format::uppercase)) { // uppercase letters [A, Z]
+        for (char _Ch = 'A'; _Ch <= 'Z'; ++_Ch) {
+            _Result._Chars[_Result._Size++] = _Ch;
+        }
+    }
+
+    return _Result;
+}
+
+// FUNCTION random_fill
+_NODISCARD bool random_fill(uint8_t* const _Buf, const size_t _Count) noexcept {
+    return _Buf ? _SDSDLL _Random_fill(_Buf, _Count) : _Count == 0;
 }
 
 // FUNCTION random_string
 _NODISCARD string random_string(const size_t _Size, const random_format _Fmt) {
-    _Random_elements<char> _Elems;
     string _Result(_Size, char{});
-    for (char& _Ch : _Result) {
-        _Generate_random_elements(_Elems, _Fmt);
-        _Ch = _Choose_random_element(_Elems, _Fmt);
+    if (!_SDSDLL _Fill_random_elements(_Result.data(), _Result.size(), _Fmt)) { // no random bytes
+        return string{};
     }
 
     return _Result;
@@ -29,15 +60,13 @@ _NODISCARD string random_string(const size_t _Size, const random_format _Fmt) {
 
 // FUNCTION random_bytes
 _NODISCARD byte_string random_bytes(const size_t _Size, const random_format _Fmt) {
-    _Random_elements<uint8_t> _Elems;
     byte_string _Result(_Size, uint8_t{});
-    for (uint8_t& _Ch : _Result) {
-        _Generate_random_elements(_Elems, _Fmt);
-        _Ch = _Choose_random_element(_Elems, _Fmt);
+    if (!_SDSDLL _Fill_random_elements(_Result.data(), _Result.size(), _Fmt)) { // no random bytes
+        return byte_string{};
     }
 
     return _Result;
 }
 _SDSDLL_END
 
-#endif // _SDSDLL_PREPROCESSOR_GUARD
\ No newline at end of file
+#endif // _SDSDLL_PREPROCESSOR_GUARD
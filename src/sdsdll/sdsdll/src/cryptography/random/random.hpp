@@ -9,18 +9,16 @@
 #include <core/defs.hpp>
 #if _SDSDLL_PREPROCESSOR_GUARD
 #include <core/api.hpp>
+#include <core/traits/memory_traits.hpp>
 #include <core/traits/string_traits.hpp>
 #include <core/traits/type_traits.hpp>
+#include <cryptography/random/drbg.hpp>
 #include <cstddef>
 #include <cstdint>
-#include <random>
 #include <string>
 
 // STD types
-using _STD mt19937;
-using _STD random_device;
 using _STD string;
-using _STD uniform_int_distribution;
 
 _SDSDLL_BEGIN
 // ENUM CLASS random_format
@@ -33,54 +31,55 @@ enum class random_format : unsigned char {
 
 _BIT_OPS(random_format)
 
-// STRUCT TEMPLATE _Random_elements
-template <class _Elem>
-struct _Random_elements {
-    _Elem _Number;
-    _Elem _Lowercase;
-    _Elem _Uppercase;
+// STRUCT _Random_alphabet
+struct _Random_alphabet {
+    char _Chars[62]; // selected numbers, lowercase and uppercase letters taken from the ASCII table
+    uint8_t _Size; // number of the selected characters
 };
 
 // FUNCTION _Generate_random_byte
-extern _NODISCARD uint8_t _Generate_random_byte(const uint8_t _Min = 0, const uint8_t _Max = 0xFF);
+extern _NODISCARD bool _Generate_random_byte(
+    uint8_t& _Result, const uint8_t _Min = 0, const uint8_t _Max = 0xFF) noexcept;
+
+// FUNCTION _Make_random_alphabet
+extern _NODISCARD _Random_alphabet _Make_random_alphabet(const random_format _Fmt) noexcept;
 
-// FUNCTION TEMPLATE _Generate_random_elements
+// FUNCTION TEMPLATE _Fill_random_elements
 template <class _Elem>
-constexpr void _Generate_random_elements(_Random_elements<_Elem>& _Elems, const random_format _Fmt) {
+_NODISCARD bool _Fill_random_elements(
+    _Elem* const _Buf, const size_t _Size, const random_format _Fmt) noexcept {
+    // Note: Each element is chosen uniformly from the whole alphabet, with one random byte per element
+    //       (plus the rejected ones). Random bytes are generated in blocks to avoid per-byte calls.
     static_assert(is_any_of_v<_Elem, char, uint8_t>, "Requires 1-byte element type.");
-    if (_Has_bits(_Fmt, random_format::number)) { // random number [0, 9] taken from the ASCII table
-        _Elems._Number = static_cast<_Elem>(_Generate_random_byte(48, 57));
+    const _Random_alphabet& _Alphabet = _Make_random_alphabet(_Fmt);
+    if (_Alphabet._Size == 0) { // no characters selected
+        return true;
     }
 
-    if (_Has_bits(_Fmt, random_format::lowercase)) { // random lowercase [a, z] taken from the ASCII table
-        _Elems._Lowercase = static_cast<_Elem>(_Generate_random_byte(97, 122));
+    const uint16_t _Limit = static_cast<uint16_t>(256 - 256 % _Alphabet._Size);
+    uint8_t _Bytes[256];
+    size_t _Avail = 0; // unused random bytes
+    for (size_t _Idx = 0; _Idx < _Size;) {
+        if (_Avail == 0) {
+            if (!_Random_fill(_Bytes, sizeof(_Bytes))) {
+                return false;
+            }
+
+            _Avail = sizeof(_Bytes);
+        }
+
+        const uint8_t _Byte = _Bytes[--_Avail];
+        if (_Byte < _Limit) { // accept only bytes that keep the distribution uniform
+            _Buf[_Idx++] = static_cast<_Elem>(_Alphabet._Chars[_Byte % _Alphabet._Size]);
+        }
     }
 
-    if (_Has_bits(_Fmt, random_format::uppercase)) { // random uppercase [A, Z] taken from the ASCII table
-        _Elems._Uppercase = static_cast<_Elem>(_Generate_random_byte(65, 90));
-    }
+    memory_traits::set(_Bytes, 0, sizeof(_Bytes));
+    return true;
 }
 
-// FUNCTION TEMPLATE _Choose_random_element
-template <class _Elem>
-_NODISCARD constexpr _Elem _Choose_random_element(
-    const _Random_elements<_Elem>& _Elems, const random_format _Fmt) noexcept {
-    _Elem _Buf[3]  = {0}; // number, lowercase and uppercase
-    uint8_t _Count = 0;
-    if (_Has_bits(_Fmt, random_format::number)) {
-        _Buf[_Count++] = _Elems._Number;
-    }
-
-    if (_Has_bits(_Fmt, random_format::lowercase)) {
-        _Buf[_Count++] = _Elems._Lowercase;
-    }
-
-    if (_Has_bits(_Fmt, random_format::uppercase)) {
-        _Buf[_Count++] = _Elems._Uppercase;
-    }
-
-    return _Buf[_Generate_random_byte(0, _Count - 1)];
-}
+// FUNCTION random_fill
+_SDSDLL_API _NODISCARD bool random_fill(uint8_t* const _Buf, const size_t _Count) noexcept;
 
 // FUNCTION random_string
 _SDSDLL_API _NODISCARD string random_string(const size_t _Size, const random_format _Fmt);
@@ -90,4 +89,4 @@ _SDSDLL_API _NODISCARD byte_string random_bytes(const size_t _Size, const random
 _SDSDLL_END
 
 #endif // _SDSDLL_PREPROCESSOR_GUARD
-#endif // _SDSDLL_CRYPTOGRAPHY_RANDOM_RANDOM_HPP_
\ No newline at end of file
+#endif // _SDSDLL_CRYPTOGRAPHY_RANDOM_RANDOM_HPP_
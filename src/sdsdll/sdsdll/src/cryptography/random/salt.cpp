@@ -71,8 +71,13 @@ _NODISCARD constexpr salt<_Size> make_salt() noexcept {
     using _Salt_t  = salt<_Size>;
     using _Value_t = typename _Salt_t::value_type;
     _Value_t _Buf[_Salt_t::size];
-    ::RAND_bytes(_Buf, static_cast<int>(_Salt_t::size));
-    return _Salt_t{_Buf};
+    if (!_SDSDLL _Random_fill(_Buf, _Salt_t::size)) { // no random bytes, return an empty salt
+        return _Salt_t{};
+    }
+
+    const _Salt_t _Result{_Buf};
+    memory_traits::set(_Buf, 0, sizeof(_Buf));
+    return _Result;
 }
 
 template _SDSDLL_API _NODISCARD salt<16> make_salt() noexcept;
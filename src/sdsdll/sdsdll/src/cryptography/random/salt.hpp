@@ -12,7 +12,7 @@
 #include <core/container/bytes.hpp>
 #include <core/traits/memory_traits.hpp>
 #include <core/traits/type_traits.hpp>
-#include <openssl/rand.h>
+#include <cryptography/random/drbg.hpp>
 #include <type_traits>
 
 _SDSDLL_BEGIN
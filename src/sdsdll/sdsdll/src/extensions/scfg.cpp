@@ -40,6 +40,7 @@ _NODISCARD byte_string _Scfg_header::_To_string() const {
     byte_string _Result(_Header_size, uint8_t{});
     _Traits::copy(_Result.data(), _Signature, 4);
     _Traits::copy(_Result.data() + 4, _Magic, 4);
+    _Result[4] = _Mydata._Magic[0]; // the first byte of the magic value is the format revision
     _Traits::copy(_Result.data() + 8, _Mydata._Checksum, 32);
     _Traits::copy(_Result.data() + 40, _As_bytes.data(), _As_bytes.size());
     return _Result;
@@ -49,7 +50,17 @@ _NODISCARD byte_string _Scfg_header::_To_string() const {
 _NODISCARD bool _Scfg_header::_Valid() const noexcept {
     using _Traits = string_traits<uint8_t, int>;
     return _Traits::compare(_Mydata._Signature, _Signature, 4) == 0
-        && _Traits::compare(_Mydata._Magic, _Magic, 4) == 0;
+        && _Traits::compare(_Mydata._Magic + 1, _Magic + 1, 3) == 0
+        && _Mydata._Magic[0] <= static_cast<uint8_t>(_Scfg_revision::_Latest);
+}
+
+// FUNCTION _Scfg_header::_Revision
+_NODISCARD _Scfg_revision _Scfg_header::_Revision() const noexcept {
+    return static_cast<_Scfg_revision>(_Mydata._Magic[0]);
+}
+
+void _Scfg_header::_Revision(const _Scfg_revision _New_revision) noexcept {
+    _Mydata._Magic[0] = static_cast<uint8_t>(_New_revision);
 }
 
 // FUNCTION _Scfg_header::_Checksum
@@ -79,22 +90,40 @@ void _Scfg_header::_Reset_cache(const _Scfg_header_data& _New_data) noexcept {
     _Traits::copy(_Mydata._Checksum, _New_data._Checksum, 32);
 }
 
+// FUNCTION _Make_scfg_nonce
+_NODISCARD iv<12> _Make_scfg_nonce(const iv<12>& _Iv, const uint32_t _Idx,
+    const uint32_t _Chunk, const bool _Last, const uint32_t _Generation) noexcept {
+    // Note: The flush generation is XORed into the first 4 bytes of the base IV, the chunk index
+    //       into the next 4 bytes and the entry index into the last 4 bytes, so that each chunk
+    //       in the file is encrypted with a different nonce and can be processed independently,
+    //       and a value encrypted again by a later flush never reuses a nonce. The last chunk
+    //       of a value is marked by the highest bit of the chunk index (a value has less than
+    //       2^18 chunks), so that a truncated value cannot be authenticated.
+    iv<12> _Result           = _Iv;
+    const auto& _Gen_bytes   = _SDSDLL unpack_integer(_Generation);
+    const auto& _Chunk_bytes = _SDSDLL unpack_integer(_Last ? _Chunk | 0x8000'0000 : _Chunk);
+    const auto& _Idx_bytes   = _SDSDLL unpack_integer(_Idx);
+    for (size_t _Off = 0; _Off < 4; ++_Off) {
+        _Result.get()[_Off] ^= _Gen_bytes[_Off];
+        _Result.get()[4 + _Off] ^= _Chunk_bytes[_Off];
+        _Result.get()[8 + _Off] ^= _Idx_bytes[_Off];
+    }
+
+    return _Result;
+}
+
 // FUNCTION _Scfg_entries_loader copy constructor/destructor
-_Scfg_entries_loader::_Scfg_entries_loader(file* const _File, _Scfg_security* const _Security) noexcept
-    : _Myfile(_File), _Mysec(_Security), _Myentry() {
-    if (_Myfile && _Myfile->is_open()) { // skip the first 44 bytes (header)
-        (void) _Myfile->seek(44);
+_Scfg_entries_loader::_Scfg_entries_loader(file* const _File, const _Scfg_revision _Revision) noexcept
+    : _Myfile(_File), _Myentry(), _Myidx(0), _Myrev(_Revision) {
+    if (_Myfile && _Myfile->is_open()) { // skip the header and the generation (if stored)
+        (void) _Myfile->seek(_Revision >= _Scfg_revision::_Chunked ? 48 : 44);
     }
 }
 
 _Scfg_entries_loader::~_Scfg_entries_loader() noexcept {}
 
-// FUNCTION _Scfg_entries_loader::_Next
-_NODISCARD bool _Scfg_entries_loader::_Next() {
-    if (!_Myfile || !_Myfile->is_open()) {
-        return false;
-    }
-
+// FUNCTION _Scfg_entries_loader::_Next_fixed
+_NODISCARD bool _Scfg_entries_loader::_Next_fixed() {
     static constexpr size_t _Count_and_hash_size = 10; // 2-byte integer + 8-byte hash
     uint8_t _Count_and_hash[_Count_and_hash_size];
     size_t _Read = 0; // read bytes, must be initialized
@@ -105,21 +134,65 @@ _NODISCARD bool _Scfg_entries_loader::_Next() {
 
     memory_traits::copy(_Myentry._Id, _Count_and_hash + 2, 8);
     const uint16_t _Count = _SDSDLL pack_integer<uint16_t>({_Count_and_hash[0], _Count_and_hash[1]});
-    
+    if (_Count == 0) { // the encrypted value always contains at least the tag
+        return false;
+    }
+
     // Note: The first 10 bytes are the encrypted value length and the hashed ID. The next
-    //       n bytes are the encryped value. We must read the next n bytes and decrypt them.
-    _Sbo_buffer<uint8_t> _Buf(static_cast<size_t>(_Count));
-    if (_Buf._Empty()) { // allocation failed, break
+    //       n bytes are the encryped value. Only its location is recorded here, the value
+    //       is decrypted on the first query.
+    _Myentry._Off        = _Myfile->tell();
+    _Myentry._Size       = _Count;
+    _Myentry._Stored_idx = _Myidx++;
+    _Myentry._Stored_gen = 0;
+    _Myentry._State      = _Scfg_entry_state::_Unloaded;
+    return _Myfile->seek(static_cast<file::off_type>(_Count), file::cur);
+}
+
+// FUNCTION _Scfg_entries_loader::_Next_chunked
+_NODISCARD bool _Scfg_entries_loader::_Next_chunked() {
+    size_t _Read = 0; // read bytes, must be initialized
+    if (!_Myfile->read(_Myentry._Id, 8, 8, &_Read) || _Read != 8) {
         return false;
     }
 
-    if (!_Myfile->read(_Buf._Get(), _Buf._Size(), _Buf._Size(), &_Read) || _Read != _Buf._Size()) {
+    // Note: The first 8 bytes are the hashed ID. The next 1-5 bytes are the varint generation
+    //       of the encrypted value. The next 1-5 bytes are the varint length of the encrypted value.
+    uint32_t _Generation = 0;
+    uint32_t _Count      = 0;
+    if (!_Read_varint(_Generation) || !_Read_varint(_Count) || _Count == 0) {
+        return false;
+    }
+
+    _Myentry._Off        = _Myfile->tell();
+    _Myentry._Size       = _Count;
+    _Myentry._Stored_idx = _Myidx++;
+    _Myentry._Stored_gen = _Generation;
+    _Myentry._State      = _Scfg_entry_state::_Unloaded;
+    return _Myfile->seek(static_cast<file::off_type>(_Count), file::cur);
+}
+
+// FUNCTION _Scfg_entries_loader::_Read_varint
+_NODISCARD bool _Scfg_entries_loader::_Read_varint(uint32_t& _Value) {
+    // Note: The highest bit of each byte marks that more bytes follow.
+    uint8_t _Varint[max_varint_size<uint32_t>];
+    size_t _Varint_size = 0;
+    do {
+        if (_Varint_size == sizeof(_Varint) || !_Myfile->get(_Varint[_Varint_size])) {
+            return false;
+        }
+    } while ((_Varint[_Varint_size++] & 0x80) != 0);
+
+    return _SDSDLL decode_varint(_Varint, _Varint_size, _Value) != 0;
+}
+
+// FUNCTION _Scfg_entries_loader::_Next
+_NODISCARD bool _Scfg_entries_loader::_Next() {
+    if (!_Myfile || !_Myfile->is_open()) {
         return false;
     }
 
-    _Myentry._Value = _SDSDLL decrypt_aes256_gcm<wchar_t>(
-        _Buf._Get(), _Buf._Size(), _Mysec->_Key, _Mysec->_Iv);
-    return !_Myentry._Value.empty();
+    return _Myrev >= _Scfg_revision::_Chunked ? _Next_chunked() : _Next_fixed();
 }
 
 // FUNCTION _Scfg_entries_loader::_Get
@@ -129,8 +202,9 @@ _NODISCARD const _Scfg_entry& _Scfg_entries_loader::_Get() const noexcept {
 
 // FUNCTION scfg_file copy constructors/destructor
 scfg_file::scfg_file(const path& _Target, const aes_key<32>& _Key, const iv<12>& _Iv)
-    : _Myfile(_Target), _Myheader(), _Myentries(), _Mysec{_Key, _Iv},
-    _Myok(_Load_file()), _Mychanges(false) {}
+    : _Myfile(_Target), _Myheader(), _Myentries(), _Mysec{_Key, _Iv}, _Myarena(),
+    _Mycache_limit(static_cast<size_t>(-1)), _Mygeneration(0), _Mycached(0), _Myhand(0),
+    _Myok(_Load_file()), _Mychanges(false), _Mylock() {}
 
 scfg_file::~scfg_file() noexcept {
     (void) flush();
@@ -156,16 +230,31 @@ _NODISCARD bool scfg_file::_Load_header() {
 _NODISCARD bool scfg_file::_Load_entries() {
     // Note: We do not need to check here if the file is open, because this function
     //       is only called if the _Load_header() succeeded.
+    _Myentries.clear();
+    _Mycached       = 0;
+    _Myhand         = 0;
+    _Mygeneration   = 0;
     uint32_t _Count = _Myheader._Entries();
-    if (_Count == 0) { // no entries to load
-        return true;
-    }
-
     if (!_Myfile.seek(44, file::beg)) {
         return false;
     }
 
-    _Scfg_entries_loader _Loader(_SDSDLL addressof(_Myfile), _SDSDLL addressof(_Mysec));
+    if (_Myheader._Revision() >= _Scfg_revision::_Chunked) { // 4-byte generation after the header
+        uint8_t _As_bytes[4]; // 4-byte integer in bytes
+        size_t _Read = 0; // read bytes, must be initialized
+        if (!_Myfile.read(_As_bytes, sizeof(_As_bytes), sizeof(_As_bytes), &_Read) || _Read != 4) {
+            return false;
+        }
+
+        _Mygeneration = _SDSDLL pack_integer<uint32_t>(_As_bytes);
+    }
+
+    if (_Count == 0) { // no entries to load
+        return true;
+    }
+
+    _Myentries.reserve(static_cast<size_t>(_Count));
+    _Scfg_entries_loader _Loader(_SDSDLL addressof(_Myfile), _Myheader._Revision());
     while (_Count-- > 0) {
         if (!_Loader._Next()) {
             _Myentries.clear();
@@ -217,57 +306,460 @@ _NODISCARD size_t scfg_file::_Find_entry(const wchar_t* const _Id, const size_t
     return static_cast<size_t>(-1);
 }
 
+// FUNCTION scfg_file::_Decrypt_value
+_NODISCARD wstring scfg_file::_Decrypt_value(const uint8_t* const _Cipher, const size_t _Size,
+    const uint32_t _Idx, const uint32_t _Generation) const {
+    if (_Myheader._Revision() == _Scfg_revision::_Shared_iv) { // one IV for all values
+        return _SDSDLL decrypt_aes256_gcm<wchar_t>(_Cipher, _Size, _Mysec._Key, _Mysec._Iv);
+    } else {
+        return _Decrypt_chunks(_Cipher, _Size, _Idx, _Generation);
+    }
+}
+
+// FUNCTION scfg_file::_Decrypt_chunks
+_NODISCARD wstring scfg_file::_Decrypt_chunks(const uint8_t* const _Cipher, const size_t _Size,
+    const uint32_t _Idx, const uint32_t _Generation) const {
+    // Note: Each chunk is prefixed with its varint length and authenticated separately,
+    //       so only one chunk has to be decrypted at a time.
+    wstring _Result;
+    size_t _Off     = 0;
+    uint32_t _Chunk = 0;
+    while (_Off < _Size) {
+        uint32_t _Count        = 0;
+        const size_t _Len_size = _SDSDLL decode_varint(_Cipher + _Off, _Size - _Off, _Count);
+        if (_Len_size == 0 || _Count > _Size - _Off - _Len_size) { // invalid or too long chunk
+            return wstring{};
+        }
+
+        _Off                += _Len_size;
+        const wstring& _Part = _Decrypt_chunk(
+            _Cipher + _Off, _Count, _Idx, _Chunk++, _Off + _Count == _Size, _Generation);
+        if (_Part.empty()) { // failed to decrypt the chunk
+            return wstring{};
+        }
+
+        _Result.append(_Part);
+        _Off += _Count;
+    }
+
+    return _Result;
+}
+
+// FUNCTION scfg_file::_Decrypt_chunk
+_NODISCARD wstring scfg_file::_Decrypt_chunk(const uint8_t* const _Cipher, const size_t _Size,
+    const uint32_t _Idx, const uint32_t _Chunk, const bool _Last, const uint32_t _Generation) const {
+    return _SDSDLL decrypt_aes256_gcm<wchar_t>(
+        _Cipher, _Size, _Mysec._Key, _Make_scfg_nonce(_Mysec._Iv, _Idx, _Chunk, _Last, _Generation));
+}
+
+// FUNCTION scfg_file::_Read_chunks
+_NODISCARD wstring scfg_file::_Read_chunks(const _Scfg_entry& _Entry) const {
+    // Note: The chunks are read from the file one at a time into a buffer that holds at most
+    //       the largest chunk cipher, so only the decrypted value grows with the value size.
+    //       A chunk longer than that cannot have been written by _Encrypt_value().
+    _Sbo_buffer<uint8_t> _Buf((_STD min)(static_cast<size_t>(_Entry._Size), _Scfg_max_chunk_cipher));
+    if (_Buf._Empty() || !_Myfile.seek(_Entry._Off)) { // allocation or seek failed
+        return wstring{};
+    }
+
+    wstring _Result;
+    size_t _Off     = 0;
+    uint32_t _Chunk = 0;
+    while (_Off < _Entry._Size) {
+        uint8_t _Len[max_varint_size<uint32_t>];
+        size_t _Len_size = 0;
+        do {
+            if (_Len_size == sizeof(_Len) || _Off + _Len_size == _Entry._Size
+                || !_Myfile.get(_Len[_Len_size])) {
+                return wstring{};
+            }
+        } while ((_Len[_Len_size++] & 0x80) != 0);
+
+        uint32_t _Count = 0;
+        if (_SDSDLL decode_varint(_Len, _Len_size, _Count) == 0) {
+            return wstring{};
+        }
+
+        _Off += _Len_size;
+        if (_Count > _Buf._Size() || _Count > _Entry._Size - _Off) { // invalid or too long chunk
+            return wstring{};
+        }
+
+        size_t _Read = 0; // read bytes, must be initialized
+        if (!_Myfile.read(_Buf._Get(), _Buf._Size(), _Count, &_Read) || _Read != _Count) {
+            return wstring{};
+        }
+
+        _Off                += _Count;
+        const wstring& _Part = _Decrypt_chunk(
+            _Buf._Get(), _Count, _Entry._Stored_idx, _Chunk++, _Off == _Entry._Size, _Entry._Stored_gen);
+        if (_Part.empty()) { // failed to decrypt the chunk
+            return wstring{};
+        }
+
+        _Result.append(_Part);
+    }
+
+    return _Result;
+}
+
+// FUNCTION scfg_file::_Encrypt_value
+_NODISCARD byte_string scfg_file::_Encrypt_value(
+    const wstring& _Value, const uint32_t _Idx, const uint32_t _Generation) const {
+    // Note: Values are always encrypted with the latest revision, older files are upgraded by flush().
+    //       The value is split into chunks of at most _Scfg_chunk_size characters, each chunk is
+    //       prefixed with its varint length. A chunk never ends between a surrogate pair.
+    byte_string _Result;
+    size_t _Off     = 0;
+    uint32_t _Chunk = 0;
+    uint8_t _Len[max_varint_size<uint32_t>];
+    do {
+        size_t _Count = (_STD min)(_Scfg_chunk_size, _Value.size() - _Off);
+        if (_Off + _Count < _Value.size() && (_Value[_Off + _Count - 1] & 0xFC00) == 0xD800) {
+            --_Count; // high surrogate, keep it with the low surrogate in the next chunk
+        }
+
+        const bool _Last         = _Off + _Count == _Value.size();
+        const byte_string& _Part = _SDSDLL encrypt_aes256_gcm(_Value.substr(_Off, _Count),
+            _Mysec._Key, _Make_scfg_nonce(_Mysec._Iv, _Idx, _Chunk++, _Last, _Generation));
+        if (_Part.empty() || _Part.size() > 0xFFFF'FFFF) { // failed to compute a cipher or it is too long
+            return byte_string{};
+        }
+
+        _Result.append(_Len, _SDSDLL encode_varint(static_cast<uint32_t>(_Part.size()), _Len));
+        _Result.append(_Part);
+        _Off += _Count;
+    } while (_Off < _Value.size());
+
+    return _Result;
+}
+
+// FUNCTION scfg_file::_Read_stored_values
+_NODISCARD bool scfg_file::_Read_stored_values(byte_string& _Stored) const {
+    uint64_t _Stored_end = 44;
+    for (const _Scfg_entry& _Entry : _Myentries) {
+        if (_Entry._State != _Scfg_entry_state::_Modified && _Entry._Off + _Entry._Size > _Stored_end) {
+            _Stored_end = _Entry._Off + _Entry._Size;
+        }
+    }
+
+    if (_Stored_end == 44) { // all values are modified, nothing to read
+        _Stored.clear();
+        return true;
+    }
+
+    size_t _Stored_size = static_cast<size_t>(_Stored_end - 44);
+    _Stored.resize(_Stored_size);
+    return _Myfile.seek(44) && _Myfile.read(_Stored, _Stored_size, &_Stored_size)
+        && _Stored_size == _Stored.size();
+}
+
+// FUNCTION scfg_file::_Load_value
+_NODISCARD bool scfg_file::_Load_value(const size_t _Pos) const {
+    // Note: The values are decrypted on demand by the const functions too, which changes
+    //       the cached values and the file position, so the caller must hold the exclusive lock.
+    _Scfg_entry& _Entry = _Myentries[_Pos];
+    if (_Entry._State != _Scfg_entry_state::_Unloaded) { // already decrypted
+        return true;
+    }
+
+    wstring _Value;
+    if (_Myheader._Revision() >= _Scfg_revision::_Chunked) { // read one chunk at a time
+        _Value = _Read_chunks(_Entry);
+    } else { // a value of the first revision is shorter than 64 KiB, read it at once
+        _Sbo_buffer<uint8_t> _Buf(static_cast<size_t>(_Entry._Size));
+        if (_Buf._Empty()) { // allocation failed
+            return false;
+        }
+
+        size_t _Read = 0; // read bytes, must be initialized
+        if (!_Myfile.seek(_Entry._Off)
+            || !_Myfile.read(_Buf._Get(), _Buf._Size(), _Buf._Size(), &_Read) || _Read != _Buf._Size()) {
+            return false;
+        }
+
+        _Value = _Decrypt_value(_Buf._Get(), _Buf._Size(), _Entry._Stored_idx, _Entry._Stored_gen);
+    }
+
+    if (_Value.empty()) { // failed to decrypt the value
+        return false;
+    }
+
+    _Entry._Value.swap(_Value);
+    _Entry._State = _Scfg_entry_state::_Cached;
+    ++_Mycached;
+    return true;
+}
+
+// FUNCTION scfg_file::_Load_all_values
+_NODISCARD bool scfg_file::_Load_all_values() noexcept {
+    // Note: Once the key or IV is changed, the stored values can no longer be decrypted,
+    //       so all of them must be decrypted with the old key and IV and encrypted again.
+    //       The stored values are read at once and decrypted in parallel. If any value cannot
+    //       be decrypted, the values decrypted so far are dropped and the entries stay unchanged.
+    byte_string _Stored;
+    try {
+        if (!_Read_stored_values(_Stored)) {
+            return false;
+        }
+    } catch (...) { // failed to allocate the stored values
+        return false;
+    }
+
+    atomic<bool> _Failed(false);
+    auto _Decrypt = [&](const size_t _Idx) noexcept {
+        _Scfg_entry& _Entry = _Myentries[_Idx];
+        if (_Entry._State == _Scfg_entry_state::_Unloaded) {
+            try {
+                _Entry._Value = _Decrypt_value(_Stored.c_str() + (_Entry._Off - 44),
+                    _Entry._Size, _Entry._Stored_idx, _Entry._Stored_gen);
+            } catch (...) { // failed to allocate the value
+                _Entry._Value.clear();
+            }
+
+            if (_Entry._Value.empty()) { // failed to decrypt the value
+                _Failed.store(true, _STD memory_order_relaxed);
+            }
+        }
+    };
+    _SDSDLL parallel_for(parallel_range{0, _Myentries.size()}, 1, _Decrypt);
+    if (_Failed.load(_STD memory_order_relaxed)) {
+        for (_Scfg_entry& _Entry : _Myentries) {
+            if (_Entry._State == _Scfg_entry_state::_Unloaded) {
+                wstring{}.swap(_Entry._Value); // release the memory
+            }
+        }
+
+        return false;
+    }
+
+    for (_Scfg_entry& _Entry : _Myentries) {
+        _Entry._State = _Scfg_entry_state::_Modified;
+    }
+
+    _Mycached = 0; // all values are modified now
+    return true;
+}
+
+// FUNCTION scfg_file::_Evict_cached_values
+void scfg_file::_Evict_cached_values() const noexcept {
+    // Note: Values that have not been modified can always be decrypted again, so drop them
+    //       in a round-robin order until the cache limit is satisfied.
+    while (_Mycached > _Mycache_limit) {
+        if (_Myhand >= _Myentries.size()) {
+            _Myhand = 0;
+        }
+
+        _Scfg_entry& _Entry = _Myentries[_Myhand++];
+        if (_Entry._State == _Scfg_entry_state::_Cached) {
+            wstring{}.swap(_Entry._Value); // release the memory
+            _Entry._State = _Scfg_entry_state::_Unloaded;
+            --_Mycached;
+        }
+    }
+}
+
+// FUNCTION scfg_file::_Query_entry
+_NODISCARD wstring scfg_file::_Query_entry(const wchar_t* const _Id, const size_t _Size) const {
+    // Note: A decrypted value is copied under the shared lock, so concurrent queries do not wait
+    //       for each other. The lock cannot be upgraded, so if the value must be decrypted first,
+    //       the shared lock is released and the entry is searched again under the exclusive lock,
+    //       because it might have been changed or erased in the meantime.
+    {
+        shared_lock_guard _Guard(_Mylock);
+        if (!_Myok || _Myentries.empty()) {
+            return wstring{};
+        }
+
+        const size_t _Pos = _Find_entry(_Id, _Size);
+        if (_Pos == static_cast<size_t>(-1)) {
+            return wstring{};
+        }
+
+        const _Scfg_entry& _Entry = _Myentries[_Pos];
+        if (_Entry._State != _Scfg_entry_state::_Unloaded) { // already decrypted
+            return _Entry._Value;
+        }
+    }
+
+    exclusive_lock_guard _Guard(_Mylock);
+    if (!_Myok || _Myentries.empty()) {
+        return wstring{};
+    }
+
+    const size_t _Pos = _Find_entry(_Id, _Size);
+    if (_Pos == static_cast<size_t>(-1) || !_Load_value(_Pos)) {
+        return wstring{};
+    }
+
+    wstring _Result = _Myentries[_Pos]._Value;
+    _Evict_cached_values();
+    return _Result;
+}
+
+// FUNCTION scfg_file::_Set_value
+void scfg_file::_Set_value(const size_t _Pos, const wstring_view _New_value) {
+    // Note: An unloaded value is not decrypted just to be compared, it is always replaced.
+    _Scfg_entry& _Entry = _Myentries[_Pos];
+    if (_Entry._State != _Scfg_entry_state::_Unloaded
+        && wstring_view{_Entry._Value.c_str(), _Entry._Value.size()} == _New_value) {
+        return;
+    }
+
+    if (_Entry._State == _Scfg_entry_state::_Cached) {
+        --_Mycached;
+    }
+
+    _Entry._Value.assign(_New_value.data(), _New_value.size());
+    _Entry._State = _Scfg_entry_state::_Modified;
+    _Mychanges    = true; // save changes
+}
+
+// FUNCTION scfg_file::_Erase_entry
+void scfg_file::_Erase_entry(const size_t _Pos) noexcept {
+    if (_Myentries[_Pos]._State == _Scfg_entry_state::_Cached) {
+        --_Mycached;
+    }
+
+    _Myentries.erase(_Myentries.cbegin() + _Pos);
+    _Mychanges = true; // save changes
+}
+
 // FUNCTION scfg_file::_Write_entry
-_NODISCARD bool scfg_file::_Write_entry(const _Scfg_entry& _Entry) {
-    using _Traits              = string_traits<uint8_t, size_t>;
-    const byte_string& _Cipher = _SDSDLL encrypt_aes256_gcm(_Entry._Value, _Mysec._Key, _Mysec._Iv);
-    if (_Cipher.empty()) { // failed to compute a cipher
+_NODISCARD bool scfg_file::_Write_entry(const _Scfg_entry& _Entry, const byte_string_view _Cipher,
+    const uint32_t _Generation, stream_hash<blake3_stream_traits<uint8_t>>& _Checksum) {
+    if (_Cipher.empty() || _Cipher.size() > 0xFFFF'FFFF) { // no cipher or it is too long
         return false;
     }
 
-    const auto& _Len = _SDSDLL unpack_integer(static_cast<uint16_t>(_Cipher.size()));
-    byte_string _Data(10 + _Cipher.size(), uint8_t{}); // 2-byte length + 8-byte hash + n-byte cipher
-    _Traits::copy(_Data.data(), _Len.data(), _Len.size());
-    _Traits::copy(_Data.data() + 2, _Entry._Id, 8);
-    _Traits::copy(_Data.data() + 10, _Cipher.c_str(), _Cipher.size());
-    return _Myfile.write(_Data);
+    // Note: The first 8 bytes are the xxHash hash of the entry ID. The next 1-5 bytes are the varint
+    //       generation of the encrypted entry value and the next 1-5 bytes are its varint length.
+    //       The last n bytes are the encrypted entry value.
+    const size_t _Off = _Myarena.size();
+    uint8_t _Len[max_varint_size<uint32_t>];
+    _Myarena.append(_Entry._Id, 8);
+    _Myarena.append(_Len, _SDSDLL encode_varint(_Generation, _Len));
+    _Myarena.append(_Len, _SDSDLL encode_varint(static_cast<uint32_t>(_Cipher.size()), _Len));
+    _Myarena.append(_Cipher.data(), _Cipher.size());
+    return _Checksum.append(_Myarena.c_str() + _Off, _Myarena.size() - _Off);
 }
 
 // FUNCTION scfg_file::_Flush_buffers
 bool scfg_file::_Flush_buffers() {
-    // Note: The first step is to write the entries count (4-byte integer in bytes).
-    //       Try to write it after the file checksum (40-byte offset).
-    if (!_Myfile.resize(40)) {
+    // Note: The stored ciphers of the unmodified values are read at once, before the file
+    //       is overwritten. The file is rewritten in place with a single write, so unlike a query,
+    //       which reads one chunk at a time, a flush holds all stored ciphers and the new file content.
+    byte_string _Stored;
+    if (!_Read_stored_values(_Stored)) {
+        return false;
+    }
+
+    // Note: Each value is encrypted with a nonce derived from its index and the flush generation,
+    //       so the values do not depend on each other and are encrypted in parallel. A stored cipher
+    //       is reused only if it was encrypted with the nonce of its current index (and the latest
+    //       revision). The generation is consumed before anything is written, so that a value
+    //       encrypted again, even after a failed flush, never reuses a nonce.
+    if (_Mygeneration == 0xFFFF'FFFF) { // no generation left
         return false;
     }
 
+    const uint32_t _Generation = ++_Mygeneration;
+    const bool _Upgrade        = _Myheader._Revision() != _Scfg_revision::_Latest;
+    vector<byte_string> _Ciphers(_Myentries.size());
+    atomic<bool> _Failed(false);
+    auto _Encrypt = [&](const size_t _Idx) {
+        const _Scfg_entry& _Entry = _Myentries[_Idx];
+        if (!_Upgrade && _Entry._State != _Scfg_entry_state::_Modified && _Entry._Stored_idx == _Idx) {
+            return;
+        }
+
+        byte_string& _Cipher = _Ciphers[_Idx];
+        if (_Entry._State == _Scfg_entry_state::_Unloaded) { // decrypt the stored value first
+            const wstring& _Value = _Decrypt_value(_Stored.c_str() + (_Entry._Off - 44),
+                _Entry._Size, _Entry._Stored_idx, _Entry._Stored_gen);
+            if (!_Value.empty()) {
+                _Cipher = _Encrypt_value(_Value, static_cast<uint32_t>(_Idx), _Generation);
+            }
+        } else {
+            _Cipher = _Encrypt_value(_Entry._Value, static_cast<uint32_t>(_Idx), _Generation);
+        }
+
+        if (_Cipher.empty()) { // failed to compute a cipher
+            _Failed.store(true, _STD memory_order_relaxed);
+        }
+    };
+    _SDSDLL parallel_for(parallel_range{0, _Myentries.size()}, 1, _Encrypt);
+    if (_Failed.load(_STD memory_order_relaxed)) {
+        return false;
+    }
+
+    // Note: Serialize the entries count and the generation (4-byte integers in bytes) and all entries
+    //       into the arena, which keeps its capacity between flushes. The entries are serialized
+    //       in order, so the result does not depend on how the values were encrypted. The checksum
+    //       is computed while serializing, so the file does not have to be read again.
+    stream_hash<blake3_stream_traits<uint8_t>> _Checksum;
     const auto& _Count = _SDSDLL unpack_integer(static_cast<uint32_t>(_Myentries.size()));
-    if (!_Myfile.write(_Count.data(), _Count.size())) {
+    const auto& _Gen   = _SDSDLL unpack_integer(_Generation);
+    _Myarena.clear();
+    _Myarena.append(_Count.data(), _Count.size());
+    _Myarena.append(_Gen.data(), _Gen.size());
+    if (!_Checksum.append(_Myarena.c_str(), _Myarena.size())) {
         return false;
     }
 
-    // Note: The second step is to write all entries. The first 2 bytes are the length of the
-    //       encrypted entry value. The next 8 bytes are the xxHash hash of the entry ID.
-    //       The last n bytes are the encrypted entry value. Try to write it after the
-    //       entries count (44-byte offset).
-    for (const _Scfg_entry& _Entry : _Myentries) {
-        if (!_Write_entry(_Entry)) {
+    for (size_t _Idx = 0; _Idx < _Myentries.size(); ++_Idx) {
+        const _Scfg_entry& _Entry       = _Myentries[_Idx];
+        byte_string& _Cipher            = _Ciphers[_Idx];
+        const byte_string_view _As_view = !_Cipher.empty() ? byte_string_view{_Cipher}
+            : byte_string_view{_Stored.c_str() + (_Entry._Off - 44), _Entry._Size};
+        const uint32_t _Entry_gen       = !_Cipher.empty() ? _Generation : _Entry._Stored_gen;
+        if (!_Write_entry(_Entry, _As_view, _Entry_gen, _Checksum)) {
             return false;
         }
+
+        byte_string{}.swap(_Cipher); // the cipher is in the arena now, release it
+    }
+
+    const byte_string& _Digest = _Checksum.complete();
+    if (_Digest.empty()) { // failed to compute a checksum
+        return false;
     }
 
-    // Note: The last step is to write the file checksum. Try to write it after
-    //       the file signature and magic value (8-byte offset).
-    const byte_string& _Checksum = _SDSDLL blake3_file(_Myfile, 40); // skip the first 40 bytes
-    if (_Checksum.empty()) { // failed to compute a checksum
+    // Note: Write the whole arena after the file checksum (40-byte offset) at once, then write
+    //       the magic value (with the latest revision) and the checksum after the file signature.
+    if (!_Myfile.resize(40) || !_Myfile.write(_Myarena)) {
         return false;
     }
 
-    if (!_Myfile.seek(8)) {
+    _Myheader._Revision(_Scfg_revision::_Latest);
+    _Myheader._Checksum(_Digest.c_str());
+    const byte_string& _Header = _Myheader._To_string();
+    if (!_Myfile.seek(4) || !_Myfile.write(_Header.c_str() + 4, 36)) { // 4-byte magic + 32-byte checksum
         return false;
     }
 
-    return _Myfile.write(_Checksum.c_str(), _Checksum.size());
+    // Note: The arena starts at the 40-byte offset, so the new location of each encrypted value
+    //       can be read back from it. Encrypted values are now stored, so keep them as cached.
+    size_t _Off = 8; // skip the entries count and the generation
+    for (size_t _Idx = 0; _Idx < _Myentries.size(); ++_Idx) {
+        _Scfg_entry& _Entry   = _Myentries[_Idx];
+        const size_t _Gen_off = _Off + 8; // skip the hashed ID
+        const size_t _Len_off = _Gen_off + _SDSDLL decode_varint(
+            _Myarena.c_str() + _Gen_off, _Myarena.size() - _Gen_off, _Entry._Stored_gen);
+        _Off = _Len_off + _SDSDLL decode_varint(
+            _Myarena.c_str() + _Len_off, _Myarena.size() - _Len_off, _Entry._Size);
+        _Entry._Off        = 40 + _Off;
+        _Entry._Stored_idx = static_cast<uint32_t>(_Idx);
+        if (_Entry._State == _Scfg_entry_state::_Modified) {
+            _Entry._State = _Scfg_entry_state::_Cached;
+            ++_Mycached;
+        }
+
+        _Off += _Entry._Size;
+    }
+
+    _Evict_cached_values();
+    return true;
 }
 
 // FUNCTION scfg_file::make_storage
@@ -291,40 +783,68 @@ _NODISCARD bool scfg_file::make_storage(const path& _Target) {
         }
     }
 
+    // Note: The header is followed by the 4-byte generation, the checksum covers both the entries
+    //       count and the generation.
+    static constexpr uint8_t _Generation[4] = {0x00, 0x00, 0x00, 0x00};
     _Scfg_header _Header;
-    const byte_string& _Checksum = _SDSDLL blake3("\x00\x00\x00\x00", 4); // 4-byte integer in bytes
+    _Header._Revision(_Scfg_revision::_Latest);
+    const byte_string& _Checksum = _SDSDLL blake3("\x00\x00\x00\x00\x00\x00\x00\x00", 8); // zero integers
     _Header._Checksum(_Checksum.c_str());
-    return _File.write(_Header._To_string());
+    return _File.write(_Header._To_string()) && _File.write(_Generation, sizeof(_Generation));
 }
 
 // FUNCTION scfg_file::ok
 _NODISCARD const bool scfg_file::ok() const noexcept {
+    shared_lock_guard _Guard(_Mylock);
     return _Myok;
 }
 
 // FUNCTION scfg_file::set_key
-void scfg_file::set_key(const aes_key<32>& _New_key) noexcept {
-    _Mysec._Key = _New_key;
+_NODISCARD bool scfg_file::set_key(const aes_key<32>& _New_key) noexcept {
+    exclusive_lock_guard _Guard(_Mylock);
     if (_Myok) {
+        if (!_Load_all_values()) { // values must be decrypted with the old key
+            return false;
+        }
+
         _Mychanges = true; // encrypt data with a new key
     }
+
+    _Mysec._Key = _New_key;
+    return true;
 }
 
 // FUNCTION scfg_file::set_iv
-void scfg_file::set_iv(const iv<12>& _New_iv) noexcept {
-    _Mysec._Iv = _New_iv;
+_NODISCARD bool scfg_file::set_iv(const iv<12>& _New_iv) noexcept {
+    exclusive_lock_guard _Guard(_Mylock);
     if (_Myok) {
+        if (!_Load_all_values()) { // values must be decrypted with the old IV
+            return false;
+        }
+
         _Mychanges = true; // encrypt data with a new IV
     }
+
+    _Mysec._Iv = _New_iv;
+    return true;
+}
+
+// FUNCTION scfg_file::set_cache_limit
+void scfg_file::set_cache_limit(const size_t _New_limit) noexcept {
+    exclusive_lock_guard _Guard(_Mylock);
+    _Mycache_limit = _New_limit;
+    _Evict_cached_values();
 }
 
 // FUNCTION scfg_file::refresh
 void scfg_file::refresh() noexcept {
+    exclusive_lock_guard _Guard(_Mylock);
     _Myok = _Load_file();
 }
 
 // FUNCTION scfg_file::flush
 _NODISCARD bool scfg_file::flush() noexcept {
+    exclusive_lock_guard _Guard(_Mylock);
     if (!_Myok) {
         return false;
     }
@@ -343,6 +863,7 @@ _NODISCARD bool scfg_file::flush() noexcept {
 
 // FUNCTION scfg_file::has_entry
 _NODISCARD bool scfg_file::has_entry(const wchar_t* const _Id) const {
+    shared_lock_guard _Guard(_Mylock);
     if (!_Myok || _Myentries.empty()) {
         return false;
     }
@@ -352,6 +873,7 @@ _NODISCARD bool scfg_file::has_entry(const wchar_t* const _Id) const {
 }
 
 _NODISCARD bool scfg_file::has_entry(const wstring_view _Id) const {
+    shared_lock_guard _Guard(_Mylock);
     if (!_Myok || _Myentries.empty()) {
         return false;
     }
@@ -360,6 +882,7 @@ _NODISCARD bool scfg_file::has_entry(const wstring_view _Id) const {
 }
 
 _NODISCARD bool scfg_file::has_entry(const wstring& _Id) const {
+    shared_lock_guard _Guard(_Mylock);
     if (!_Myok || _Myentries.empty()) {
         return false;
     }
@@ -369,35 +892,21 @@ _NODISCARD bool scfg_file::has_entry(const wstring& _Id) const {
 
 // FUNCTION scfg_file::query_entry
 _NODISCARD wstring scfg_file::query_entry(const wchar_t* const _Id) const {
-    if (!_Myok || _Myentries.empty()) {
-        return wstring{};
-    }
-
-    using _Traits     = string_traits<wchar_t, size_t>;
-    const size_t _Pos = _Find_entry(_Id, _Traits::length(_Id));
-    return _Pos != static_cast<size_t>(-1) ? _Myentries[_Pos]._Value : wstring{};
+    using _Traits = string_traits<wchar_t, size_t>;
+    return _Query_entry(_Id, _Traits::length(_Id));
 }
 
 _NODISCARD wstring scfg_file::query_entry(const wstring_view _Id) const {
-    if (!_Myok || _Myentries.empty()) {
-        return wstring{};
-    }
-
-    const size_t _Pos = _Find_entry(_Id.data(), _Id.size());
-    return _Pos != static_cast<size_t>(-1) ? _Myentries[_Pos]._Value : wstring{};
+    return _Query_entry(_Id.data(), _Id.size());
 }
 
 _NODISCARD wstring scfg_file::query_entry(const wstring& _Id) const {
-    if (!_Myok || _Myentries.empty()) {
-        return wstring{};
-    }
-
-    const size_t _Pos = _Find_entry(_Id.c_str(), _Id.size());
-    return _Pos != static_cast<size_t>(-1) ? _Myentries[_Pos]._Value : wstring{};
+    return _Query_entry(_Id.c_str(), _Id.size());
 }
 
 // FUNCTION scfg_file::modify_entry
 _NODISCARD bool scfg_file::modify_entry(const wchar_t* const _Id, const wchar_t* const _New_value) {
+    exclusive_lock_guard _Guard(_Mylock);
     if (!_Myok || _Myentries.empty()) {
         return false;
     }
@@ -408,15 +917,12 @@ _NODISCARD bool scfg_file::modify_entry(const wchar_t* const _Id, const wchar_t*
         return false;
     }
 
-    if (_Myentries[_Pos]._Value != _New_value) {
-        _Myentries[_Pos]._Value = _New_value;
-        _Mychanges              = true; // save changes
-    }
-
+    _Set_value(_Pos, _New_value);
     return true;
 }
 
 _NODISCARD bool scfg_file::modify_entry(const wstring_view _Id, const wstring_view _New_value) {
+    exclusive_lock_guard _Guard(_Mylock);
     if (!_Myok || _Myentries.empty()) {
         return false;
     }
@@ -426,16 +932,12 @@ _NODISCARD bool scfg_file::modify_entry(const wstring_view _Id, const wstring_vi
         return false;
     }
 
-    if (wstring_view{_Myentries[_Pos]._Value.c_str(), _Myentries[_Pos]._Value.size()}
-        != _New_value) {
-        _Myentries[_Pos]._Value = _New_value;
-        _Mychanges              = true; // save changes
-    }
-
+    _Set_value(_Pos, _New_value);
     return true;
 }
 
 _NODISCARD bool scfg_file::modify_entry(const wstring& _Id, const wstring& _New_value) {
+    exclusive_lock_guard _Guard(_Mylock);
     if (!_Myok || _Myentries.empty()) {
         return false;
     }
@@ -445,16 +947,13 @@ _NODISCARD bool scfg_file::modify_entry(const wstring& _Id, const wstring& _New_
         return false;
     }
 
-    if (_Myentries[_Pos]._Value != _New_value) {
-        _Myentries[_Pos]._Value = _New_value;
-        _Mychanges              = true; // save changes
-    }
-
+    _Set_value(_Pos, _New_value);
     return true;
 }
 
 // FUNCTION scfg_file::modify_entry_id
 _NODISCARD bool scfg_file::modify_entry_id(const wchar_t* const _Id, const wchar_t* const _New_id) {
+    exclusive_lock_guard _Guard(_Mylock);
     if (!_Myok || _Myentries.empty()) {
         return false;
     }
@@ -479,6 +978,7 @@ _NODISCARD bool scfg_file::modify_entry_id(const wchar_t* const _Id, const wchar
 }
 
 _NODISCARD bool scfg_file::modify_entry_id(const wstring_view _Id, const wstring_view _New_id) {
+    exclusive_lock_guard _Guard(_Mylock);
     if (!_Myok) {
         return false;
     }
@@ -502,6 +1002,7 @@ _NODISCARD bool scfg_file::modify_entry_id(const wstring_view _Id, const wstring
 }
 
 _NODISCARD bool scfg_file::modify_entry_id(const wstring& _Id, const wstring& _New_id) {
+    exclusive_lock_guard _Guard(_Mylock);
     if (!_Myok) {
         return false;
     }
@@ -526,7 +1027,10 @@ _NODISCARD bool scfg_file::modify_entry_id(const wstring& _Id, const wstring& _N
 
 // FUNCTION scfg_file::append_entry
 _NODISCARD bool scfg_file::append_entry(const wchar_t* const _Id, const wchar_t* const _Value) {
-    if (has_entry(_Id) || _Myentries.size() >= 0xFFFF'FFFF) {
+    exclusive_lock_guard _Guard(_Mylock);
+    using _Traits = string_traits<wchar_t, size_t>;
+    if (!_Myok || _Find_entry(_Id, _Traits::length(_Id)) != static_cast<size_t>(-1)
+        || _Myentries.size() >= 0xFFFF'FFFF) {
         return false;
     }
 
@@ -535,16 +1039,17 @@ _NODISCARD bool scfg_file::append_entry(const wchar_t* const _Id, const wchar_t*
         return false;
     }
 
-    _Scfg_entry _Entry;
+    _Scfg_entry _Entry{{}, _Value, 0, 0, 0, 0, _Scfg_entry_state::_Modified};
     _Hash.copy(_Entry._Id, 8); // copy a 8-byte xxHash hash
-    _Entry._Value = _Value;
-    _Myentries.push_back(_Entry);
+    _Myentries.push_back(_STD move(_Entry));
     _Mychanges = true; // save changes
     return true;
 }
 
 _NODISCARD bool scfg_file::append_entry(const wstring_view _Id, const wstring_view _Value) {
-    if (has_entry(_Id) || _Myentries.size() >= 0xFFFF'FFFF) {
+    exclusive_lock_guard _Guard(_Mylock);
+    if (!_Myok || _Find_entry(_Id.data(), _Id.size()) != static_cast<size_t>(-1)
+        || _Myentries.size() >= 0xFFFF'FFFF) {
         return false;
     }
 
@@ -553,16 +1058,17 @@ _NODISCARD bool scfg_file::append_entry(const wstring_view _Id, const wstring_vi
         return false;
     }
 
-    _Scfg_entry _Entry;
+    _Scfg_entry _Entry{{}, wstring{_Value}, 0, 0, 0, 0, _Scfg_entry_state::_Modified};
     _Hash.copy(_Entry._Id, 8); // copy 8-byte xxHash hash
-    _Entry._Value = _Value;
-    _Myentries.push_back(_Entry);
+    _Myentries.push_back(_STD move(_Entry));
     _Mychanges = true; // save changes
     return true;
 }
 
 _NODISCARD bool scfg_file::append_entry(const wstring& _Id, const wstring& _Value) {
-    if (has_entry(_Id) || _Myentries.size() >= 0xFFFF'FFFF) {
+    exclusive_lock_guard _Guard(_Mylock);
+    if (!_Myok || _Find_entry(_Id.c_str(), _Id.size()) != static_cast<size_t>(-1)
+        || _Myentries.size() >= 0xFFFF'FFFF) {
         return false;
     }
 
@@ -571,16 +1077,16 @@ _NODISCARD bool scfg_file::append_entry(const wstring& _Id, const wstring& _Valu
         return false;
     }
 
-    _Scfg_entry _Entry;
+    _Scfg_entry _Entry{{}, wstring{_Value}, 0, 0, 0, 0, _Scfg_entry_state::_Modified};
     _Hash.copy(_Entry._Id, 8); // copy 8-byte xxHash hash
-    _Entry._Value = _Value;
-    _Myentries.push_back(_Entry);
+    _Myentries.push_back(_STD move(_Entry));
     _Mychanges = true; // save changes
     return true;
 }
 
 // FUNCTION scfg_file::erase_entry
 void scfg_file::erase_entry(const wchar_t* const _Id) {
+    exclusive_lock_guard _Guard(_Mylock);
     if (!_Myok || _Myentries.empty()) {
         return;
     }
@@ -588,42 +1094,44 @@ void scfg_file::erase_entry(const wchar_t* const _Id) {
     using _Traits     = string_traits<wchar_t, size_t>;
     const size_t _Pos = _Find_entry(_Id, _Traits::length(_Id));
     if (_Pos != static_cast<size_t>(-1)) { // entry found, erase it
-        _Myentries.erase(_Myentries.cbegin() + _Pos);
-        _Mychanges = true; // save changes
+        _Erase_entry(_Pos);
     }
 }
 
 void scfg_file::erase_entry(const wstring_view _Id) {
+    exclusive_lock_guard _Guard(_Mylock);
     if (!_Myok || _Myentries.empty()) {
         return;
     }
 
     const size_t _Pos = _Find_entry(_Id.data(), _Id.size());
     if (_Pos != static_cast<size_t>(-1)) { // entry found, erase it
-        _Myentries.erase(_Myentries.cbegin() + _Pos);
-        _Mychanges = true; // save changes
+        _Erase_entry(_Pos);
     }
 }
 
 void scfg_file::erase_entry(const wstring& _Id) {
+    exclusive_lock_guard _Guard(_Mylock);
     if (!_Myok || _Myentries.empty()) {
         return;
     }
 
     const size_t _Pos = _Find_entry(_Id.c_str(), _Id.size());
     if (_Pos != static_cast<size_t>(-1)) { // entry found, erase it
-        _Myentries.erase(_Myentries.cbegin() + _Pos);
-        _Mychanges = true; // save changes
+        _Erase_entry(_Pos);
     }
 }
 
 // FUNCTION scfg_file::erase_all_entries
 void scfg_file::erase_all_entries() noexcept {
+    exclusive_lock_guard _Guard(_Mylock);
     if (!_Myok || _Myentries.empty()) {
         return;
     }
 
     _Myentries.clear();
+    _Mycached  = 0;
+    _Myhand    = 0;
     _Mychanges = true; // save changes
 }
 _SDSDLL_END
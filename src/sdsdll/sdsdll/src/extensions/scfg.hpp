@@ -20,12 +20,16 @@
 #include <cryptography/cipher/symmetric/iv.hpp>
 #include <cryptography/hash/generic/blake3.hpp>
 #include <cryptography/hash/generic/xxhash.hpp>
+#include <cryptography/hash/stream.hpp>
 #include <cstddef>
 #include <cstdint>
 #include <filesystem/file.hpp>
 #include <filesystem/path.hpp>
 #include <filesystem/status.hpp>
 #include <string>
+#include <system/execution/parallel.hpp>
+#include <system/execution/shared_lock.hpp>
+#include <utility>
 #include <vector>
 
 // STD types
@@ -43,6 +47,20 @@ struct _Scfg_header_data {
     uint32_t _Count; // entries count
 };
 
+// ENUM CLASS _Scfg_revision
+enum class _Scfg_revision : uint8_t {
+    _Shared_iv = 0, // all values are encrypted with the same IV
+    _Chunked   = 1, // values are split into chunks, each chunk is encrypted with its own nonce
+    _Latest    = _Chunked
+};
+
+// CONSTANT _Scfg_chunk_size
+inline constexpr size_t _Scfg_chunk_size = 16384; // maximum number of characters in one chunk
+
+// CONSTANT _Scfg_max_chunk_cipher
+inline constexpr size_t _Scfg_max_chunk_cipher = // longest encoded chunk (UTF-8 or wide) + 16-byte tag
+    _Scfg_chunk_size * (sizeof(wchar_t) > 3 ? sizeof(wchar_t) : 3) + 16;
+
 // FUNCTION _Extract_scfg_header_from_bytes
 extern _NODISCARD _Scfg_header_data _Extract_scfg_header_from_bytes(const byte_string& _Bytes);
 
@@ -60,9 +78,15 @@ public:
     // constructs the header from the data
     _NODISCARD byte_string _To_string() const;
 
-    // checks if the signature and the magic are valid
+    // checks if the signature, the magic and the revision are valid
     _NODISCARD bool _Valid() const noexcept;
 
+    // returns the format revision
+    _NODISCARD _Scfg_revision _Revision() const noexcept;
+
+    // changes the format revision
+    void _Revision(const _Scfg_revision _New_revision) noexcept;
+
     // returns a file checksum
     _NODISCARD const uint8_t* _Checksum() const noexcept;
 
@@ -80,15 +104,28 @@ public:
 
 private:
     static constexpr uint8_t _Signature[] = {0x4D, 0x4A, 0x00, 0x00}; // correct signature
-    static constexpr uint8_t _Magic[]     = {0x00, 0x5D, 0x5C, 0xF6}; // correct magic value
+    static constexpr uint8_t _Magic[]     = {0x00, 0x5D, 0x5C, 0xF6}; // correct magic value (the first
+                                                                      // byte is the format revision)
 
     _Scfg_header_data _Mydata;
 };
 
+// ENUM CLASS _Scfg_entry_state
+enum class _Scfg_entry_state : uint8_t {
+    _Unloaded, // the value has not been decrypted yet
+    _Cached, // the value has been decrypted and matches the stored one
+    _Modified // the value has been changed and must be encrypted
+};
+
 // STRUCT _Scfg_entry
 struct _Scfg_entry {
     uint8_t _Id[8]; // 8-byte entry ID xxHash hash
-    wstring _Value; // decrypted entry value
+    wstring _Value; // decrypted entry value (empty if unloaded)
+    uint64_t _Off; // offset of the encrypted value in the file
+    uint32_t _Size; // length of the encrypted value
+    uint32_t _Stored_idx; // index whose nonce was used to encrypt the stored value
+    uint32_t _Stored_gen; // generation whose nonce was used to encrypt the stored value
+    _Scfg_entry_state _State; // state of the value
 };
 
 // STRUCT _Scfg_security
@@ -97,10 +134,14 @@ struct _Scfg_security {
     iv<12> _Iv;
 };
 
+// FUNCTION _Make_scfg_nonce
+_SDSDLL_API _NODISCARD iv<12> _Make_scfg_nonce(const iv<12>& _Iv, const uint32_t _Idx,
+    const uint32_t _Chunk, const bool _Last, const uint32_t _Generation) noexcept;
+
 // CLASS _Scfg_entries_loader
 class _Scfg_entries_loader {
 public:
-    _Scfg_entries_loader(file* const _File, _Scfg_security* const _Security) noexcept;
+    explicit _Scfg_entries_loader(file* const _File, const _Scfg_revision _Revision) noexcept;
     ~_Scfg_entries_loader() noexcept;
 
     _Scfg_entries_loader() = delete;
@@ -114,9 +155,19 @@ public:
     _NODISCARD const _Scfg_entry& _Get() const noexcept;
 
 private:
+    // tries to load the next entry with a 2-byte length
+    _NODISCARD bool _Next_fixed();
+
+    // tries to load the next entry with a varint length
+    _NODISCARD bool _Next_chunked();
+
+    // tries to read a single varint
+    _NODISCARD bool _Read_varint(uint32_t& _Value);
+
     file* const _Myfile;
-    _Scfg_security* const _Mysec;
     _Scfg_entry _Myentry;
+    uint32_t _Myidx; // index of the next entry
+    _Scfg_revision _Myrev; // format revision
 };
 
 // CLASS scfg_file
@@ -135,11 +186,14 @@ public:
     // checks if everything is ok
     _NODISCARD const bool ok() const noexcept;
 
-    // changes the current AES-256 GCM key
-    void set_key(const aes_key<32>& _New_key) noexcept;
+    // changes the current AES-256 GCM key (the key is kept if a stored value cannot be decrypted)
+    _NODISCARD bool set_key(const aes_key<32>& _New_key) noexcept;
+
+    // changes the current IV (the IV is kept if a stored value cannot be decrypted)
+    _NODISCARD bool set_iv(const iv<12>& _New_iv) noexcept;
 
-    // changes the current IV
-    void set_iv(const iv<12>& _New_iv) noexcept;
+    // changes the maximum number of decrypted values kept in memory
+    void set_cache_limit(const size_t _New_limit) noexcept;
 
     // loads the file again
     void refresh() noexcept;
@@ -196,23 +250,70 @@ private:
     // returns the selected entry position, -1 if not found
     _NODISCARD size_t _Find_entry(const wchar_t* const _Id, const size_t _Size) const;
 
-    // writes a single entry
-    _NODISCARD bool _Write_entry(const _Scfg_entry& _Entry);
+    // decrypts a stored value that was encrypted with the selected index and generation
+    _NODISCARD wstring _Decrypt_value(const uint8_t* const _Cipher, const size_t _Size, const uint32_t _Idx,
+        const uint32_t _Generation) const;
+
+    // decrypts a stored value that was split into chunks
+    _NODISCARD wstring _Decrypt_chunks(const uint8_t* const _Cipher, const size_t _Size, const uint32_t _Idx,
+        const uint32_t _Generation) const;
+
+    // decrypts a single chunk of a stored value
+    _NODISCARD wstring _Decrypt_chunk(const uint8_t* const _Cipher, const size_t _Size, const uint32_t _Idx,
+        const uint32_t _Chunk, const bool _Last, const uint32_t _Generation) const;
+
+    // reads and decrypts the chunks of a stored value one at a time
+    _NODISCARD wstring _Read_chunks(const _Scfg_entry& _Entry) const;
+
+    // encrypts a value with the nonce of the selected index and generation (splits it into chunks)
+    _NODISCARD byte_string _Encrypt_value(
+        const wstring& _Value, const uint32_t _Idx, const uint32_t _Generation) const;
+
+    // reads all stored values that have not been modified at once
+    _NODISCARD bool _Read_stored_values(byte_string& _Stored) const;
+
+    // decrypts the selected entry value (if not decrypted yet)
+    _NODISCARD bool _Load_value(const size_t _Pos) const;
+
+    // decrypts all values, so that they can be encrypted with a new key or IV
+    _NODISCARD bool _Load_all_values() noexcept;
+
+    // drops decrypted values that exceed the cache limit
+    void _Evict_cached_values() const noexcept;
+
+    // returns the selected entry value, decrypts it under the exclusive lock if needed
+    _NODISCARD wstring _Query_entry(const wchar_t* const _Id, const size_t _Size) const;
+
+    // changes the selected entry value
+    void _Set_value(const size_t _Pos, const wstring_view _New_value);
+
+    // erases the selected entry
+    void _Erase_entry(const size_t _Pos) noexcept;
+
+    // serializes a single entry into the arena
+    _NODISCARD bool _Write_entry(const _Scfg_entry& _Entry, const byte_string_view _Cipher,
+        const uint32_t _Generation, stream_hash<blake3_stream_traits<uint8_t>>& _Checksum);
 
     // saves changes into the file
     bool _Flush_buffers();
 
 #ifdef _MSC_VER
 #pragma warning(push, 1)
-#pragma warning(disable : 4251) // C4251: file, _Scfg_header, std::vector and _Scfg_security
-                                //        require dll-interface
+#pragma warning(disable : 4251) // C4251: file, _Scfg_header, std::vector, _Scfg_security and
+                                //        std::basic_string require dll-interface
 #endif // _MSC_VER
-    file _Myfile;
+    mutable file _Myfile; // values are decrypted on demand, even by the const functions
     _Scfg_header _Myheader;
-    vector<_Scfg_entry> _Myentries;
+    mutable vector<_Scfg_entry> _Myentries;
     _Scfg_security _Mysec; // AES-256 GCM key and IV
+    byte_string _Myarena; // serialized entries, reused by each flush
+    size_t _Mycache_limit; // maximum number of cached values
+    uint32_t _Mygeneration; // generation of the last flush
+    mutable size_t _Mycached; // number of cached values
+    mutable size_t _Myhand; // next entry to be checked by the eviction
     bool _Myok; // true if everything is ok
     bool _Mychanges; // true if any data has been changed
+    mutable shared_lock _Mylock; // guards the entries, the cached values and the file position
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif // _MSC_VER
@@ -40,6 +40,7 @@ _NODISCARD byte_string _Sudb_header::_To_string() const {
     byte_string _Result(_Header_size, uint8_t{});
     _Traits::copy(_Result.data(), _Signature, 4);
     _Traits::copy(_Result.data() + 4, _Magic, 4);
+    _Result[4] = _Mydata._Magic[0]; // the first byte of the magic value is the format revision
     _Traits::copy(_Result.data() + 8, _Mydata._Checksum, 32);
     _Traits::copy(_Result.data() + 40, _As_bytes.data(), _As_bytes.size());
     return _Result;
@@ -49,7 +50,17 @@ _NODISCARD byte_string _Sudb_header::_To_string() const {
 _NODISCARD bool _Sudb_header::_Valid() const noexcept {
     using _Traits = string_traits<uint8_t, int>;
     return _Traits::compare(_Mydata._Signature, _Signature, 4) == 0
-        && _Traits::compare(_Mydata._Magic, _Magic, 4) == 0;
+        && _Traits::compare(_Mydata._Magic + 1, _Magic + 1, 3) == 0
+        && _Mydata._Magic[0] <= static_cast<uint8_t>(_Sudb_revision::_Latest);
+}
+
+// FUNCTION _Sudb_header::_Revision
+_NODISCARD _Sudb_revision _Sudb_header::_Revision() const noexcept {
+    return static_cast<_Sudb_revision>(_Mydata._Magic[0]);
+}
+
+void _Sudb_header::_Revision(const _Sudb_revision _New_revision) noexcept {
+    _Mydata._Magic[0] = static_cast<uint8_t>(_New_revision);
 }
 
 // FUNCTION _Sudb_header::_Checksum
@@ -80,8 +91,123 @@ void _Sudb_header::_Reset_cache(const _Sudb_header_data& _New_data) noexcept {
     _Traits::copy(_Mydata._Checksum, _New_data._Checksum, 32);
 }
 
+// FUNCTION _Sudb_entry_size
+_NODISCARD size_t _Sudb_entry_size(const _Sudb_revision _Revision) noexcept {
+    return _Revision == _Sudb_revision::_Fixed_params ? 152 : 164;
+}
+
+// FUNCTION _Sudb_record_size
+_NODISCARD size_t _Sudb_record_size(const _Sudb_revision _Revision) noexcept {
+    return 8 + _Sudb_entry_size(_Revision) + 32; // operation, position, entry and checksum
+}
+
+// FUNCTION _Sudb_entry_to_bytes
+void _Sudb_entry_to_bytes(
+    const _Sudb_entry& _Entry, uint8_t* const _Bytes, const _Sudb_revision _Revision) noexcept {
+    // Note: The first 8 bytes are the account name xxHash hash. The next 64 bytes are the
+    //       password Argon2id hash. The next 16 bytes are the unique salt. The next 64 bytes
+    //       are the ARC SHA-512 hash. Since the second revision, the last 12 bytes are
+    //       the Argon2id memory amount, iterations and parallelism (4-byte integers).
+    memory_traits::copy(_Bytes, _Entry._Account, 8);
+    memory_traits::copy(_Bytes + 8, _Entry._Password, 64);
+    memory_traits::copy(_Bytes + 72, _Entry._Salt, 16);
+    memory_traits::copy(_Bytes + 88, _Entry._Arc, 64);
+    if (_Revision != _Sudb_revision::_Fixed_params) {
+        memory_traits::copy(_Bytes + 152, _SDSDLL unpack_integer(_Entry._Params.memory_amount).data(), 4);
+        memory_traits::copy(_Bytes + 156, _SDSDLL unpack_integer(_Entry._Params.iterations).data(), 4);
+        memory_traits::copy(_Bytes + 160, _SDSDLL unpack_integer(_Entry._Params.parallelism).data(), 4);
+    }
+}
+
+// FUNCTION _Sudb_entry_from_bytes
+void _Sudb_entry_from_bytes(
+    _Sudb_entry& _Entry, const uint8_t* const _Bytes, const _Sudb_revision _Revision) noexcept {
+    memory_traits::copy(_Entry._Account, _Bytes, 8);
+    memory_traits::copy(_Entry._Password, _Bytes + 8, 64);
+    memory_traits::copy(_Entry._Salt, _Bytes + 72, 16);
+    memory_traits::copy(_Entry._Arc, _Bytes + 88, 64);
+    if (_Revision == _Sudb_revision::_Fixed_params) { // hashed with the default engine
+        _Entry._Params = {0, 0, 0};
+    } else {
+        uint8_t _As_bytes[4]; // 4-byte integer in bytes
+        memory_traits::copy(_As_bytes, _Bytes + 152, 4);
+        _Entry._Params.memory_amount = _SDSDLL pack_integer<uint32_t>(_As_bytes);
+        memory_traits::copy(_As_bytes, _Bytes + 156, 4);
+        _Entry._Params.iterations = _SDSDLL pack_integer<uint32_t>(_As_bytes);
+        memory_traits::copy(_As_bytes, _Bytes + 160, 4);
+        _Entry._Params.parallelism = _SDSDLL pack_integer<uint32_t>(_As_bytes);
+    }
+}
+
+// FUNCTION _Hash_sudb_password
+_NODISCARD bool _Hash_sudb_password(uint8_t* const _Buf, const wstring_view _Password,
+    const uint8_t* const _Salt, const argon2_params& _Params) noexcept {
+    // Note: The entries that do not store their parameters were hashed with the default engine.
+    //       The others are hashed with their own parameters, so that the parameters can change
+    //       without invalidating the stored passwords.
+    try {
+        if (_Params.memory_amount == 0) {
+            const salt<_Argon2id_default_engine<wchar_t>> _Unique_salt(_Salt);
+            const byte_string& _Hash = _SDSDLL argon2id(_Password, _Unique_salt);
+            if (_Hash.size() != 64) { // failed to compute a hash
+                return false;
+            }
+
+            memory_traits::copy(_Buf, _Hash.c_str(), _Hash.size());
+            return true;
+        }
+
+        using _Traits = argon2id_traits<wchar_t>;
+        return _Traits::hash(_Buf, 64, _Password.data(), _Password.size(), _Traits::salt{_Salt},
+            _Params.memory_amount, _Params.iterations, _Params.parallelism);
+    } catch (...) {
+        return false;
+    }
+}
+
+// FUNCTION _Append_sudb_journal_record
+void _Append_sudb_journal_record(
+    byte_string& _Bytes, const _Sudb_journal_record& _Record, const _Sudb_revision _Revision) {
+    // Note: The first byte of each record is the operation, followed by 3 reserved bytes.
+    //       The next 4 bytes are the entry position, followed by the entry (152 or 164 bytes,
+    //       depending on the revision). The last 32 bytes are the BLAKE3 checksum of the rest.
+    const size_t _Record_size = _Sudb_record_size(_Revision);
+    uint8_t _Buf[204]         = {0}; // the largest record
+    const auto& _As_bytes     = _SDSDLL unpack_integer(_Record._Pos);
+    _Buf[0]                   = static_cast<uint8_t>(_Record._Op);
+    memory_traits::copy(_Buf + 4, _As_bytes.data(), _As_bytes.size());
+    _Sudb_entry_to_bytes(_Record._Entry, _Buf + 8, _Revision);
+    const byte_string& _Checksum = _SDSDLL hash<blake3_traits<uint8_t>>(_Buf, _Record_size - 32);
+    memory_traits::copy(_Buf + _Record_size - 32, _Checksum.c_str(), _Checksum.size());
+    _Bytes.append(_Buf, _Record_size);
+}
+
+// FUNCTION _Extract_sudb_journal_record
+_NODISCARD bool _Extract_sudb_journal_record(
+    const uint8_t* const _Bytes, _Sudb_journal_record& _Record, const _Sudb_revision _Revision) {
+    const size_t _Checked        = _Sudb_record_size(_Revision) - 32;
+    const byte_string& _Checksum = _SDSDLL hash<blake3_traits<uint8_t>>(_Bytes, _Checked);
+    if (_Checksum.empty()
+        || memory_traits::compare(_Bytes + _Checked, _Checksum.c_str(), _Checksum.size()) != 0) {
+        return false; // damaged or incomplete record
+    }
+
+    if (_Bytes[0] < static_cast<uint8_t>(_Sudb_journal_op::_Append)
+        || _Bytes[0] > static_cast<uint8_t>(_Sudb_journal_op::_Erase)) { // unknown operation
+        return false;
+    }
+
+    uint8_t _As_bytes[4]; // 4-byte integer in bytes
+    memory_traits::copy(_As_bytes, _Bytes + 4, 4);
+    _Record._Op  = static_cast<_Sudb_journal_op>(_Bytes[0]);
+    _Record._Pos = _SDSDLL pack_integer<uint32_t>(_As_bytes);
+    _Sudb_entry_from_bytes(_Record._Entry, _Bytes + 8, _Revision);
+    return true;
+}
+
 // FUNCTION _Sudb_entries_loader copy constructor/destructor
-_Sudb_entries_loader::_Sudb_entries_loader(file* const _File) noexcept : _Myfile(_File), _Myentry() {}
+_Sudb_entries_loader::_Sudb_entries_loader(file* const _File, const _Sudb_revision _Revision) noexcept
+    : _Myfile(_File), _Myrevision(_Revision), _Myentry() {}
 
 _Sudb_entries_loader::~_Sudb_entries_loader() noexcept {}
 
@@ -92,19 +218,17 @@ _NODISCARD bool _Sudb_entries_loader::_Next() {
     }
 
     // Note: The first 8 bytes are the account name xxHash hash. The next 64 bytes are the
-    //       password Argon2ID hash. The next 16 bytes are the unique salt. The last 64 bytes
-    //       are the account ARC SHA-512 hash. We need to read 152 bytes to fill all the data.
-    static constexpr size_t _Buf_size = 152; // always 152 bytes
-    uint8_t _Buf[_Buf_size];
+    //       password Argon2ID hash. The next 16 bytes are the unique salt. The next 64 bytes
+    //       are the account ARC SHA-512 hash. Since the second revision, the entry ends with
+    //       the 12-byte Argon2id parameters.
+    const size_t _Buf_size = _Sudb_entry_size(_Myrevision);
+    uint8_t _Buf[164]; // the largest entry
     size_t _Read = 0; // read bytes, must be initialized
-    if (!_Myfile->read(_Buf, _Buf_size, _Buf_size, &_Read) || _Read != _Buf_size) {
+    if (!_Myfile->read(_Buf, sizeof(_Buf), _Buf_size, &_Read) || _Read != _Buf_size) {
         return false;
     }
 
-    memory_traits::copy(_Myentry._Account, _Buf, 8);
-    memory_traits::copy(_Myentry._Password, _Buf + 8, 64);
-    memory_traits::copy(_Myentry._Salt, _Buf + 72, 16);
-    memory_traits::copy(_Myentry._Arc, _Buf + 88, 64);
+    _Sudb_entry_from_bytes(_Myentry, _Buf, _Myrevision);
     return true;
 }
 
@@ -115,7 +239,9 @@ _NODISCARD const _Sudb_entry& _Sudb_entries_loader::_Get() const noexcept {
 
 // FUNCTION sudb_file copy constructor/destructor
 sudb_file::sudb_file(const path& _Target)
-    : _Myfile(_Target), _Myheader(), _Myentries(), _Myok(_Load_file()), _Mychanges(false) {}
+    : _Myfile(_Target), _Myheader(), _Myentries(), _Myaccounts(), _Myarcs(), _Mysalts(), _Mypending(),
+    _Myjournal_end(0), _Myjournal_records(0), _Myparams{0, 0, 0}, _Mycompact(false), _Myok(_Load_file()),
+    _Mychanges(false) {}
 
 sudb_file::~sudb_file() noexcept {
     (void) flush();
@@ -123,10 +249,10 @@ sudb_file::~sudb_file() noexcept {
 
 // FUNCTION sudb_file::_Load_header
 _NODISCARD bool sudb_file::_Load_header() {
-    if (!_Myfile.is_open()) {
+    if (!_Myfile.is_open() || !_Myfile.seek(0, file::beg)) { // the header may be reloaded by refresh()
         return false;
     }
-    
+
     size_t _Buf_size = 44; // 44-byte header
     byte_string _Buf(_Buf_size, uint8_t{});
     if (!_Myfile.read(_Buf, _Buf_size, &_Buf_size) || _Buf_size != _Buf.size()) {
@@ -140,337 +266,408 @@ _NODISCARD bool sudb_file::_Load_header() {
 // FUNCTION sudb_file::_Load_entries
 _NODISCARD bool sudb_file::_Load_entries() {
     // Note: We do not need to check here if the file is open, because this function
-    //       is only called if the _Load_header() succeeded.
+    //       is only called if the _Load_header() succeeded. The checksum covers the entries
+    //       count and the entries only, the journal records have their own checksums.
     uint32_t _Count = _Myheader._Entries();
-    if (_Count == 0) { // no entries to load
-        return true;
+    stream_hash<blake3_stream_traits<uint8_t>> _Checksum;
+    const auto& _As_bytes = _SDSDLL unpack_integer(_Count);
+    if (!_Checksum.append(_As_bytes.data(), _As_bytes.size())) {
+        return false;
     }
 
     if (!_Myfile.seek(44, file::beg)) {
         return false;
     }
 
-    _Sudb_entries_loader _Loader(_SDSDLL addressof(_Myfile));
+    _Myentries.reserve(_Count);
+    _Myaccounts._Reserve(_Count);
+    _Myarcs._Reserve(_Count);
+    _Mysalts._Reserve(_Count);
+    const _Sudb_revision _Revision = _Myheader._Revision();
+    const size_t _Entry_size       = _Sudb_entry_size(_Revision);
+    _Sudb_entries_loader _Loader(_SDSDLL addressof(_Myfile), _Revision);
+    uint8_t _Buf[164]; // the largest entry
     while (_Count-- > 0) {
         if (!_Loader._Next()) {
-            _Myentries.clear();
+            _Clear_entries();
             return false;
         }
 
-        _Myentries.push_back(_Loader._Get());
-    }
-
-    return true;
-}
-
-// FUNCTION sudb_file::_Validate_checksum
-_NODISCARD bool sudb_file::_Validate_checksum() noexcept {
-    const byte_string_view _As_bytes(_Myheader._Checksum(), 32);
-    return _As_bytes == _SDSDLL blake3_file(_Myfile, 40); // skip the first 40 bytes
-}
+        _Sudb_entry_to_bytes(_Loader._Get(), _Buf, _Revision);
+        if (!_Checksum.append(_Buf, _Entry_size)) {
+            _Clear_entries();
+            return false;
+        }
 
-// FUNCTION sudb_file::_Load_file
-_NODISCARD bool sudb_file::_Load_file() noexcept {
-    if (!_Load_header()) {
-        return false;
+        _Insert_entry(_Loader._Get());
     }
 
-    if (_Validate_checksum()) {
-        return _Load_entries();
-    } else {
+    if (byte_string_view{_Myheader._Checksum(), 32} != _Checksum.complete()) { // invalid checksum
+        _Clear_entries();
         return false;
     }
-}
-
-// FUNCTION sudb_file::_Find_entry_by_account_name
-_NODISCARD size_t sudb_file::_Find_entry_by_account_name(
-    const wchar_t* const _Name, const size_t _Size) const {
-    if (!_Myok || _Myentries.empty()) {
-        return static_cast<size_t>(-1);
-    }
 
-    const byte_string& _Hash = _SDSDLL xxhash(_Name, _Size);
-    if (_Hash.empty()) { // failed to compute a hash
-        return static_cast<size_t>(-1);
-    }
+    _Myjournal_end = 44 + static_cast<uint64_t>(_Myentries.size()) * _Entry_size;
+    return true;
+}
 
-    for (size_t _Idx = 0; _Idx < _Myentries.size(); ++_Idx) {
-        if (memory_traits::compare(
-            _Hash.c_str(), _Myentries[_Idx]._Account, _Hash.size()) == 0) { // entry found
-            return _Idx;
+// FUNCTION sudb_file::_Load_journal
+_NODISCARD bool sudb_file::_Load_journal() {
+    // Note: The journal starts right after the entries and consists of records of the same
+    //       revision as the entries. Only the last record may be incomplete or have an invalid
+    //       checksum, it was not fully written, so it terminates the journal and will be overwritten
+    //       by the next flush. A damaged record followed by other records means that the file
+    //       is corrupted, ignoring it would make the next flush discard all the records after it.
+    const _Sudb_revision _Revision = _Myheader._Revision();
+    const size_t _Record_size      = _Sudb_record_size(_Revision);
+    uint8_t _Buf[204]; // the largest record
+    _Sudb_journal_record _Record;
+    while (!_Myfile.eof()) {
+        size_t _Read = 0; // read bytes, must be initialized
+        if (!_Myfile.read(_Buf, sizeof(_Buf), _Record_size, &_Read)) { // failed to read the record
+            return false;
         }
-    }
-
-    return static_cast<size_t>(-1);
-}
 
-// FUNCTION sudb_file::_Find_entry_by_arc
-_NODISCARD size_t sudb_file::_Find_entry_by_arc(const arc& _Arc) const {
-    if (!_Myok || _Myentries.empty()) {
-        return static_cast<size_t>(-1);
-    }
+        if (_Read != _Record_size) { // incomplete last record
+            break;
+        }
 
-    const byte_string& _Hash = _SDSDLL sha512(_Arc.to_string());
-    if (_Hash.empty()) { // failed to compute a hash
-        return static_cast<size_t>(-1);
-    }
+        if (!_Extract_sudb_journal_record(_Buf, _Record, _Revision)) {
+            if (_Myfile.eof()) { // damaged last record
+                break;
+            }
 
-    for (size_t _Idx = 0; _Idx < _Myentries.size(); ++_Idx) {
-        if (memory_traits::compare(_Hash.c_str(), _Myentries[_Idx]._Arc, _Hash.size()) == 0) { // entry found
-            return _Idx;
+            return false;
         }
-    }
 
-    return static_cast<size_t>(-1);
-}
-
-// FUNCTION sudb_file::_Is_unique_arc
-_NODISCARD bool sudb_file::_Is_unique_arc(const arc& _Arc) const noexcept {
-    for (const _Sudb_entry& _Entry : _Myentries) {
-        if (memory_traits::compare(_Entry._Arc, _Arc.get(), arc::size) == 0) { // entry found
+        if (!_Apply_journal_record(_Record)) { // valid record that does not match the entries
             return false;
         }
+
+        _Myjournal_end += _Record_size;
+        ++_Myjournal_records;
     }
 
     return true;
 }
 
-// FUNCTION sudb_file::_Is_unique_salt
-_NODISCARD bool sudb_file::_Is_unique_salt(const _Unique_salt& _Salt) const noexcept {
-    for (const _Sudb_entry& _Entry : _Myentries) {
-        if (memory_traits::compare(_Entry._Salt, _Salt.get(), _Unique_salt::size) == 0) {
-            return false;
-        }
+// FUNCTION sudb_file::_Load_file
+_NODISCARD bool sudb_file::_Load_file() noexcept {
+    _Clear_entries(); // discard previously loaded entries
+    if (!_Load_header()) {
+        return false;
     }
-    
+
+    if (!_Load_entries() || !_Load_journal()) {
+        return false;
+    }
+
+    // Note: The records appended to the journal must have the same revision as the entries,
+    //       so a file of an older revision is rewritten (upgraded) by the next flush instead.
+    _Mycompact = _Myheader._Revision() != _Sudb_revision::_Latest;
     return true;
 }
 
-// FUNCTION sudb_file::_Generate_unique_arc
-_NODISCARD arc sudb_file::_Generate_unique_arc() const noexcept {
-    arc _Result;
-    do { // keep doing this until the ARC is unique
-        _Result = _SDSDLL make_arc();
-    } while (!_Is_unique_arc(_Result));
-
-    return _Result;
+// FUNCTION sudb_file::_Clear_entries
+void sudb_file::_Clear_entries() noexcept {
+    _Myentries.clear();
+    _Myaccounts._Clear();
+    _Myarcs._Clear();
+    _Mysalts._Clear();
+    _Mypending.clear();
+    _Myjournal_end     = 0;
+    _Myjournal_records = 0;
+    _Mycompact         = false;
 }
 
-// FUNCTION sudb_file::_Generate_unique_salt
-_NODISCARD typename sudb_file::_Unique_salt sudb_file::_Generate_unique_salt() const noexcept {
-    _Unique_salt _Result;
-    do { // keep doing this until the salt is unique
-        ::RAND_bytes(_Result.get(), static_cast<int>(_Unique_salt::size));
-    } while (!_Is_unique_salt(_Result));
-    
-    return _Result;
+// FUNCTION sudb_file::_Insert_entry
+void sudb_file::_Insert_entry(const _Sudb_entry& _Entry) {
+    const uint32_t _Pos = static_cast<uint32_t>(_Myentries.size());
+    _Myentries.push_back(_Entry);
+    _Myaccounts._Insert(_Entry._Account, _Pos);
+    _Myarcs._Insert(_Entry._Arc, _Pos);
+    _Mysalts._Insert(_Entry._Salt, _Pos);
 }
 
-// FUNCTION sudb_file::_Write_entry
-_NODISCARD bool sudb_file::_Write_entry(const _Sudb_entry& _Entry) {
-    byte_string _Data(152, uint8_t{});
-    memory_traits::copy(_Data.data(), _Entry._Account, 8);
-    memory_traits::copy(_Data.data() + 8, _Entry._Password, 64);
-    memory_traits::copy(_Data.data() + 72, _Entry._Salt, 16);
-    memory_traits::copy(_Data.data() + 88, _Entry._Arc, 64);
-    return _Myfile.write(_Data);
+// FUNCTION sudb_file::_Erase_entry
+void sudb_file::_Erase_entry(const size_t _Pos) noexcept {
+    const uint32_t _Last = static_cast<uint32_t>(_Myentries.size() - 1);
+    _Sudb_entry& _Entry  = _Myentries[_Pos];
+    _Myaccounts._Erase(_Entry._Account, static_cast<uint32_t>(_Pos));
+    _Myarcs._Erase(_Entry._Arc, static_cast<uint32_t>(_Pos));
+    _Mysalts._Erase(_Entry._Salt, static_cast<uint32_t>(_Pos));
+    if (_Pos != _Last) {
+        // Note: The order of entries is not meaningful, so move the last entry into the hole
+        //       instead of shifting all the following entries. This way only one entry
+        //       has to be re-indexed.
+        const _Sudb_entry& _Moved = _Myentries[_Last];
+        _Myaccounts._Relocate(_Moved._Account, _Last, static_cast<uint32_t>(_Pos));
+        _Myarcs._Relocate(_Moved._Arc, _Last, static_cast<uint32_t>(_Pos));
+        _Mysalts._Relocate(_Moved._Salt, _Last, static_cast<uint32_t>(_Pos));
+        _Entry = _Moved;
+    }
+
+    _Myentries.pop_back();
 }
 
-// FUNCTION sudb_file::_Flush_buffers
-_NODISCARD bool sudb_file::_Flush_buffers() {
-    // Note: The first step is to write the entries count (4-byte integer in bytes).
-    //       Try to write it after the file checksum (40-byte offset).
-    if (!_Myfile.resize(40)) {
-        return false;
+// FUNCTION sudb_file::_Change_entry_account
+_NODISCARD bool sudb_file::_Change_entry_account(const size_t _Pos, const uint8_t* const _Hash) noexcept {
+    _Sudb_entry& _Entry = _Myentries[_Pos];
+    if (memory_traits::compare(_Entry._Account, _Hash, 8) == 0) { // nothing has changed
+        return true;
     }
 
-    const auto& _Count = _SDSDLL unpack_integer(static_cast<uint32_t>(_Myentries.size()));
-    if (!_Myfile.write(_Count.data(), _Count.size())) {
+    const auto _Key_at = [this](const uint32_t _Idx) noexcept {
+        return _Myentries[_Idx]._Account;
+    };
+    if (_Myaccounts._Find(_Hash, _Key_at) != _Digest_index<8>::npos) { // name already used
         return false;
     }
 
-    // Note: The second step is to write all entries. The first 8 bytes are the account name
-    //       xxHash hash. The next 64 bytes are the password Argon2id hash. The next 16 bytes
-    //       are the unique salt. The last 64-bytes are the ARC SHA-512 hash. Try to write it
-    //       after the entries count (44-byte offset).
-    for (const _Sudb_entry& _Entry : _Myentries) {
-        if (!_Write_entry(_Entry)) {
-            return false;
-        }
-    }
-
-    // Note: The last step is to write the file checksum. Try to write it after
-    //       the file signature and magic value (8-byte offset).
-    const byte_string& _Checksum = _SDSDLL blake3_file(_Myfile, 40); // skip the first 40 bytes
-    if (_Checksum.empty()) { // failed to compute a checksum
+    // Note: The erased key frees a slot, so inserting the new key never grows the index.
+    //       The same holds when the old key is restored because no journal record was scheduled.
+    uint8_t _Old[8];
+    memory_traits::copy(_Old, _Entry._Account, 8);
+    _Myaccounts._Erase(_Entry._Account, static_cast<uint32_t>(_Pos));
+    memory_traits::copy(_Entry._Account, _Hash, 8);
+    _Myaccounts._Insert(_Entry._Account, static_cast<uint32_t>(_Pos));
+    try {
+        _Journal_entry(_Sudb_journal_op::_Modify, _Pos);
+    } catch (...) { // failed to schedule a journal record, restore the old name
+        _Myaccounts._Erase(_Entry._Account, static_cast<uint32_t>(_Pos));
+        memory_traits::copy(_Entry._Account, _Old, 8);
+        _Myaccounts._Insert(_Entry._Account, static_cast<uint32_t>(_Pos));
         return false;
     }
 
-    if (!_Myfile.seek(8)) {
+    _Mychanges = true; // save changes
+    return true;
+}
+
+// FUNCTION sudb_file::_Change_entry_arc
+_NODISCARD bool sudb_file::_Change_entry_arc(const size_t _Pos, const uint8_t* const _Hash) noexcept {
+    _Sudb_entry& _Entry = _Myentries[_Pos];
+    uint8_t _Old[64];
+    memory_traits::copy(_Old, _Entry._Arc, 64);
+    _Myarcs._Erase(_Entry._Arc, static_cast<uint32_t>(_Pos));
+    memory_traits::copy(_Entry._Arc, _Hash, 64);
+    _Myarcs._Insert(_Entry._Arc, static_cast<uint32_t>(_Pos));
+    try {
+        _Journal_entry(_Sudb_journal_op::_Modify, _Pos);
+    } catch (...) { // failed to schedule a journal record, restore the old ARC
+        _Myarcs._Erase(_Entry._Arc, static_cast<uint32_t>(_Pos));
+        memory_traits::copy(_Entry._Arc, _Old, 64);
+        _Myarcs._Insert(_Entry._Arc, static_cast<uint32_t>(_Pos));
         return false;
     }
 
-    return _Myfile.write(_Checksum.c_str(), _Checksum.size());
+    _Mychanges = true; // save changes
+    return true;
 }
 
-// FUNCTION sudb_file::make_storage
-_NODISCARD bool sudb_file::make_storage(const path& _Target) {
-    file _File;
-    if (_SDSDLL exists(_Target)) { // use an existing file
-        if (!_File.open(_Target)) {
-            return false;
-        }
+// FUNCTION sudb_file::_Replace_entry
+void sudb_file::_Replace_entry(const size_t _Pos, const _Sudb_entry& _Entry) noexcept {
+    _Sudb_entry& _Old = _Myentries[_Pos];
+    _Myaccounts._Erase(_Old._Account, static_cast<uint32_t>(_Pos));
+    _Myarcs._Erase(_Old._Arc, static_cast<uint32_t>(_Pos));
+    _Mysalts._Erase(_Old._Salt, static_cast<uint32_t>(_Pos));
+    _Old = _Entry;
+    _Myaccounts._Insert(_Old._Account, static_cast<uint32_t>(_Pos));
+    _Myarcs._Insert(_Old._Arc, static_cast<uint32_t>(_Pos));
+    _Mysalts._Insert(_Old._Salt, static_cast<uint32_t>(_Pos));
+}
 
-        if (!_File.clear()) { // file must be empty
-            return false;
-        }
-    } else { // create a new file
-        if (!_SDSDLL create_file(_Target)) {
+// FUNCTION sudb_file::_Apply_journal_record
+_NODISCARD bool sudb_file::_Apply_journal_record(const _Sudb_journal_record& _Record) {
+    // Note: Erasing moves the last entry into the freed slot, so the records must be replayed
+    //       in the same order they were written to reproduce the same positions.
+    switch (_Record._Op) {
+    case _Sudb_journal_op::_Append:
+        if (_Record._Pos != _Myentries.size() || _Myentries.size() >= 0xFFFF'FFFF) {
             return false;
         }
 
-        if (!_File.open(_Target)) {
+        _Insert_entry(_Record._Entry);
+        return true;
+    case _Sudb_journal_op::_Modify:
+        if (_Record._Pos >= _Myentries.size()) {
             return false;
         }
-    }
-
-    _Sudb_header _Header;
-    const byte_string& _Checksum = _SDSDLL blake3("\x00\x00\x00\x00", 4); // 4-byte integer in bytes
-    _Header._Checksum(_Checksum.c_str());
-    return _File.write(_Header._To_string());
-}
-
-// FUNCTION sudb_file::ok
-_NODISCARD const bool sudb_file::ok() const noexcept {
-    return _Myok;
-}
-
-// FUNCTION sudb_file::refresh
-void sudb_file::refresh() noexcept {
-    _Myok = _Load_file();
-}
 
-// FUNCTION sudb_file::flush
-_NODISCARD bool sudb_file::flush() noexcept {
-    if (!_Myok) {
-        return false;
-    }
-    
-    if (!_Mychanges) { // nothing has changed
+        _Replace_entry(_Record._Pos, _Record._Entry);
         return true;
-    }
+    case _Sudb_journal_op::_Erase:
+        if (_Record._Pos >= _Myentries.size()) {
+            return false;
+        }
 
-    if (_Flush_buffers()) {
-        _Mychanges = false; // reset changes
+        _Erase_entry(_Record._Pos);
         return true;
-    } else {
+    default:
         return false;
     }
 }
 
-// FUNCTION sudb_file::has_entry
-_NODISCARD bool sudb_file::has_entry(const wchar_t* const _Account) const {
-    if (!_Myok || _Myentries.empty()) {
-        return false;
+// FUNCTION sudb_file::_Journal_entry
+void sudb_file::_Journal_entry(const _Sudb_journal_op _Op, const size_t _Pos) const {
+    if (_Mycompact) { // the entries will be rewritten anyway
+        return;
     }
 
-    using _Traits = string_traits<wchar_t, size_t>;
-    return _Find_entry_by_account_name(_Account, _Traits::length(_Account)) != static_cast<size_t>(-1);
+    _Sudb_journal_record _Record;
+    _Record._Op    = _Op;
+    _Record._Pos   = static_cast<uint32_t>(_Pos);
+    _Record._Entry = _Myentries[_Pos];
+    _Append_sudb_journal_record(_Mypending, _Record, _Myheader._Revision());
 }
 
-_NODISCARD bool sudb_file::has_entry(const wstring_view _Account) const {
+// FUNCTION sudb_file::_Find_entry_by_account_name
+_NODISCARD size_t sudb_file::_Find_entry_by_account_name(
+    const wchar_t* const _Name, const size_t _Size) const {
     if (!_Myok || _Myentries.empty()) {
-        return false;
+        return static_cast<size_t>(-1);
     }
 
-    return _Find_entry_by_account_name(_Account.data(), _Account.size()) != static_cast<size_t>(-1);
-}
-
-_NODISCARD bool sudb_file::has_entry(const wstring& _Account) const {
-    if (!_Myok || _Myentries.empty()) {
-        return false;
+    const byte_string& _Hash = _SDSDLL xxhash(_Name, _Size);
+    if (_Hash.empty()) { // failed to compute a hash
+        return static_cast<size_t>(-1);
     }
 
-    return _Find_entry_by_account_name(_Account.c_str(), _Account.size()) != static_cast<size_t>(-1);
+    const auto _Key_at = [this](const uint32_t _Idx) noexcept {
+        return _Myentries[_Idx]._Account;
+    };
+    const uint32_t _Pos = _Myaccounts._Find(_Hash.c_str(), _Key_at);
+    return _Pos != _Digest_index<8>::npos ? static_cast<size_t>(_Pos) : static_cast<size_t>(-1);
 }
 
-_NODISCARD bool sudb_file::has_entry(const arc& _Arc) const {
+// FUNCTION sudb_file::_Find_entry_by_arc
+_NODISCARD size_t sudb_file::_Find_entry_by_arc(const arc& _Arc) const {
     if (!_Myok || _Myentries.empty()) {
-        return false;
+        return static_cast<size_t>(-1);
     }
 
-    return _Find_entry_by_arc(_Arc) != static_cast<size_t>(-1);
+    const byte_string& _Hash = _SDSDLL sha512(_Arc.to_string());
+    if (_Hash.empty()) { // failed to compute a hash
+        return static_cast<size_t>(-1);
+    }
+
+    const auto _Key_at = [this](const uint32_t _Idx) noexcept {
+        return _Myentries[_Idx]._Arc;
+    };
+    const uint32_t _Pos = _Myarcs._Find(_Hash.c_str(), _Key_at);
+    return _Pos != _Digest_index<64>::npos ? static_cast<size_t>(_Pos) : static_cast<size_t>(-1);
 }
 
-// FUNCTION sudb_file::compare_passwords
-_NODISCARD bool sudb_file::compare_passwords(
-    const wchar_t* const _Account, const wchar_t* const _Password) const {
-    if (!_Myok || _Myentries.empty()) {
-        return false;
+// FUNCTION sudb_file::_Find_entry_by_copy
+_NODISCARD size_t sudb_file::_Find_entry_by_copy(const _Sudb_entry& _Copy) const noexcept {
+    // Note: The salts are unique and never change, so an entry that has the same account name
+    //       and the same salt as the copy is the copied entry, even if it was moved in the meantime.
+    const auto _Key_at = [this](const uint32_t _Idx) noexcept {
+        return _Myentries[_Idx]._Account;
+    };
+    const uint32_t _Pos = _Myaccounts._Find(_Copy._Account, _Key_at);
+    if (_Pos == _Digest_index<8>::npos
+        || memory_traits::compare(_Myentries[_Pos]._Salt, _Copy._Salt, sizeof(_Copy._Salt)) != 0) {
+        return static_cast<size_t>(-1);
     }
 
-    using _Traits     = string_traits<wchar_t, size_t>;
-    const size_t _Pos = _Find_entry_by_account_name(_Account, _Traits::length(_Account));
+    return static_cast<size_t>(_Pos);
+}
+
+// FUNCTION sudb_file::_Copy_entry
+_NODISCARD bool sudb_file::_Copy_entry(const wchar_t* const _Name, const size_t _Size,
+    _Sudb_entry& _Entry, argon2_params& _Params) const {
+    shared_lock_guard _Guard(_Mylock);
+    const size_t _Pos = _Find_entry_by_account_name(_Name, _Size);
     if (_Pos == static_cast<size_t>(-1)) { // entry not found
         return false;
     }
 
-    const _Unique_salt _Salt(_Myentries[_Pos]._Salt);
-    const byte_string& _Hash = _SDSDLL argon2id(_Password, _Salt);
-    if (_Hash.empty()) { // failed to compute a hash
+    _Entry  = _Myentries[_Pos];
+    _Params = _Myparams;
+    return true;
+}
+
+// FUNCTION sudb_file::_Compare_password
+_NODISCARD bool sudb_file::_Compare_password(
+    const _Sudb_entry& _Entry, const wstring_view _Password) noexcept {
+    uint8_t _Hash[64];
+    if (!_Hash_sudb_password(_Hash, _Password, _Entry._Salt, _Entry._Params)) { // failed to compute a hash
         return false;
     }
 
-    return memory_traits::compare(_Myentries[_Pos]._Password, _Hash.c_str(), _Hash.size()) == 0;
+    return memory_traits::compare(_Entry._Password, _Hash, sizeof(_Hash)) == 0;
 }
 
-_NODISCARD bool sudb_file::compare_passwords(
-    const wstring_view _Account, const wstring_view _Password) const {
-    if (!_Myok || _Myentries.empty()) {
-        return false;
+// FUNCTION sudb_file::_Needs_rehash
+_NODISCARD bool sudb_file::_Needs_rehash(const _Sudb_entry& _Entry, const argon2_params& _Params) noexcept {
+    // Note: The default engine parameters mean that no parameters were selected, in that case
+    //       the passwords keep the parameters they were hashed with.
+    return _Params.memory_amount != 0 && _Entry._Params != _Params;
+}
+
+// FUNCTION sudb_file::_Rehash_password
+void sudb_file::_Rehash_password(
+    const _Sudb_entry& _Copy, const argon2_params& _Params, const uint8_t* const _Hash) const noexcept {
+    // Note: The new hash was computed without holding the lock, so it is applied only if the entry
+    //       still has the verified password and the parameters have not been changed since.
+    //       Otherwise the entry is left as it is, the next verification will re-hash it if necessary.
+    if (_Params != _Myparams) {
+        return;
     }
 
-    const size_t _Pos = _Find_entry_by_account_name(_Account.data(), _Account.size());
-    if (_Pos == static_cast<size_t>(-1)) { // entry not found
-        return false;
+    const size_t _Pos = _Find_entry_by_copy(_Copy);
+    if (_Pos == static_cast<size_t>(-1)
+        || memory_traits::compare(_Myentries[_Pos]._Password, _Copy._Password, sizeof(_Copy._Password)) != 0
+        || _Myentries[_Pos]._Params != _Copy._Params) {
+        return;
     }
 
-    const _Unique_salt _Salt(_Myentries[_Pos]._Salt);
-    const byte_string& _Hash = _SDSDLL argon2id(_Password, _Salt);
-    if (_Hash.empty()) { // failed to compute a hash
-        return false;
+    _Sudb_entry& _Entry    = _Myentries[_Pos];
+    const _Sudb_entry _Old = _Entry;
+    memory_traits::copy(_Entry._Password, _Hash, 64);
+    _Entry._Params = _Params;
+    try {
+        _Journal_entry(_Sudb_journal_op::_Modify, _Pos);
+    } catch (...) { // failed to schedule a journal record, keep the old hash
+        _Entry = _Old;
+        return;
     }
 
-    return memory_traits::compare(_Myentries[_Pos]._Password, _Hash.c_str(), _Hash.size()) == 0;
+    _Mychanges = true; // save changes
 }
 
-_NODISCARD bool sudb_file::compare_passwords(const wstring& _Account, const wstring& _Password) const {
-    if (!_Myok || _Myentries.empty()) {
-        return false;
-    }
-
-    const size_t _Pos = _Find_entry_by_account_name(_Account.c_str(), _Account.size());
-    if (_Pos == static_cast<size_t>(-1)) { // entry not found
+// FUNCTION sudb_file::_Verify_password
+_NODISCARD bool sudb_file::_Verify_password(const wchar_t* const _Name, const size_t _Size,
+    const wstring_view _Password) const {
+    // Note: Only the copying of the entry holds the (shared) lock, the password is hashed
+    //       with the copy. This way any number of threads can verify passwords at once
+    //       and a writer never waits for a hash to be computed.
+    _Sudb_entry _Entry;
+    argon2_params _Params;
+    if (!_Copy_entry(_Name, _Size, _Entry, _Params) || !_Compare_password(_Entry, _Password)) {
         return false;
     }
 
-    const _Unique_salt _Salt(_Myentries[_Pos]._Salt);
-    const byte_string& _Hash = _SDSDLL argon2id(_Password, _Salt);
-    if (_Hash.empty()) { // failed to compute a hash
-        return false;
+    // Note: The password is known only while it is being verified, so this is the only moment
+    //       it can be re-hashed with the current parameters. A failed re-hash is not an error,
+    //       the password will be re-hashed by the next successful verification.
+    if (_Needs_rehash(_Entry, _Params)) {
+        uint8_t _Hash[64];
+        if (_Hash_sudb_password(_Hash, _Password, _Entry._Salt, _Params)) {
+            exclusive_lock_guard _Guard(_Mylock);
+            _Rehash_password(_Entry, _Params, _Hash);
+        }
     }
 
-    return memory_traits::compare(_Myentries[_Pos]._Password, _Hash.c_str(), _Hash.size()) == 0;
+    return true;
 }
 
-// FUNCTION sudb_file::compare_arcs
-_NODISCARD bool sudb_file::compare_arcs(const wchar_t* const _Account, const arc& _Arc) const {
-    if (!_Myok || _Myentries.empty()) {
-        return false;
-    }
-
-    using _Traits     = string_traits<wchar_t, size_t>;
-    const size_t _Pos = _Find_entry_by_account_name(_Account, _Traits::length(_Account));
+// FUNCTION sudb_file::_Compare_arc
+_NODISCARD bool sudb_file::_Compare_arc(
+    const wchar_t* const _Name, const size_t _Size, const arc& _Arc) const {
+    shared_lock_guard _Guard(_Mylock);
+    const size_t _Pos = _Find_entry_by_account_name(_Name, _Size);
     if (_Pos == static_cast<size_t>(-1)) { // entry not found
         return false;
     }
@@ -483,118 +680,466 @@ _NODISCARD bool sudb_file::compare_arcs(const wchar_t* const _Account, const arc
     return memory_traits::compare(_Myentries[_Pos]._Arc, _Hash.c_str(), _Hash.size()) == 0;
 }
 
-_NODISCARD bool sudb_file::compare_arcs(const wstring_view _Account, const arc& _Arc) const {
-    if (!_Myok || _Myentries.empty()) {
+// FUNCTION sudb_file::_Modify_entry_password
+_NODISCARD bool sudb_file::_Modify_entry_password(const wchar_t* const _Name, const size_t _Size,
+    const wstring_view _New_password) {
+    _Sudb_entry _Entry;
+    argon2_params _Params;
+    if (!_Copy_entry(_Name, _Size, _Entry, _Params)) { // entry not found
         return false;
     }
 
-    const size_t _Pos = _Find_entry_by_account_name(_Account.data(), _Account.size());
-    if (_Pos == static_cast<size_t>(-1)) { // entry not found
+    uint8_t _Hash[64];
+    if (!_Hash_sudb_password(_Hash, _New_password, _Entry._Salt, _Params)) { // failed to compute a hash
         return false;
     }
 
-    const byte_string& _Hash = _SDSDLL sha512(_Arc.to_string());
-    if (_Hash.empty()) { // failed to compute a hash
+    // Note: The hash was computed without holding the lock, so the entry must be looked up again.
+    //       If it has been erased in the meantime, the password cannot be modified.
+    exclusive_lock_guard _Guard(_Mylock);
+    const size_t _Pos = _Find_entry_by_copy(_Entry);
+    if (_Pos == static_cast<size_t>(-1)) { // entry not found
         return false;
     }
 
-    return memory_traits::compare(_Myentries[_Pos]._Arc, _Hash.c_str(), _Hash.size()) == 0;
+    _Sudb_entry& _Target = _Myentries[_Pos];
+    if (memory_traits::compare(_Target._Password, _Hash, sizeof(_Hash)) != 0 || _Target._Params != _Params) {
+        const _Sudb_entry _Old = _Target;
+        memory_traits::copy(_Target._Password, _Hash, sizeof(_Hash));
+        _Target._Params = _Params;
+        try {
+            _Journal_entry(_Sudb_journal_op::_Modify, _Pos);
+        } catch (...) { // failed to schedule a journal record, keep the old password
+            _Target = _Old;
+            throw;
+        }
+
+        _Mychanges = true; // save changes
+    }
+
+    return true;
 }
 
-_NODISCARD bool sudb_file::compare_arcs(const wstring& _Account, const arc& _Arc) const {
-    if (!_Myok || _Myentries.empty()) {
-        return false;
+// FUNCTION sudb_file::_Append_entry
+_NODISCARD bool sudb_file::_Append_entry(const wchar_t* const _Account, const size_t _Size,
+    const wstring_view _Password, arc* const _Arc) {
+    _Sudb_entry _Entry;
+    { // hash an account name
+        const byte_string& _Hash = _SDSDLL xxhash(_Account, _Size);
+        if (_Hash.empty()) { // failed to compute a hash
+            return false;
+        }
+
+        memory_traits::copy(_Entry._Account, _Hash.c_str(), _Hash.size());
     }
 
-    const size_t _Pos = _Find_entry_by_account_name(_Account.c_str(), _Account.size());
-    if (_Pos == static_cast<size_t>(-1)) { // entry not found
+    _Unique_salt _Salt;
+    arc _Unique_arc;
+    argon2_params _Params;
+    { // generate a unique salt and a unique ARC
+        shared_lock_guard _Guard(_Mylock);
+        if (!_Myok || _Find_entry_by_account_name(_Account, _Size) != static_cast<size_t>(-1)
+            || _Myentries.size() >= 0xFFFF'FFFF) {
+            return false;
+        }
+
+        if (!_Generate_unique_salt(_Salt) || !_Generate_unique_arc(_Unique_arc)) { // no random bytes
+            return false;
+        }
+
+        _Params = _Myparams;
+    }
+
+    { // hash a password with the current parameters (without holding the lock)
+        if (!_Hash_sudb_password(_Entry._Password, _Password, _Salt.get(), _Params)) {
+            return false; // failed to compute a hash
+        }
+
+        memory_traits::copy(_Entry._Salt, _Salt.get(), _Unique_salt::size);
+        _Entry._Params = _Params;
+    }
+
+    { // hash a unique ARC
+        const byte_string& _Hash = _SDSDLL sha512(_Unique_arc.to_string());
+        if (_Hash.empty()) { // failed to compute a hash
+            return false;
+        }
+
+        memory_traits::copy(_Entry._Arc, _Hash.c_str(), _Hash.size());
+    }
+
+    // Note: Another thread may have appended the same account, or (very unlikely) the same salt
+    //       or ARC, while the password was being hashed, so everything must be checked again.
+    exclusive_lock_guard _Guard(_Mylock);
+    if (!_Myok || _Find_entry_by_account_name(_Account, _Size) != static_cast<size_t>(-1)
+        || _Myentries.size() >= 0xFFFF'FFFF || !_Is_unique_salt(_Salt) || !_Is_unique_arc(_Unique_arc)) {
         return false;
     }
 
+    _Insert_entry(_Entry);
+    try {
+        _Journal_entry(_Sudb_journal_op::_Append, _Myentries.size() - 1);
+    } catch (...) { // failed to schedule a journal record, discard the entry
+        _Erase_entry(_Myentries.size() - 1);
+        throw;
+    }
+
+    _Mychanges = true; // save changes
+    if (_Arc) { // save a new ARC
+        *_Arc = _Unique_arc;
+    }
+
+    return true;
+}
+
+// FUNCTION sudb_file::_Is_unique_arc
+_NODISCARD bool sudb_file::_Is_unique_arc(const arc& _Arc) const noexcept {
+    // Note: The entries store the ARC SHA-512 hashes, not the raw ARCs, so the selected ARC
+    //       must be hashed before it can be compared.
     const byte_string& _Hash = _SDSDLL sha512(_Arc.to_string());
-    if (_Hash.empty()) { // failed to compute a hash
-        return false;
+    if (_Hash.empty()) { // failed to compute a hash, let the caller report an error
+        return true;
     }
 
-    return memory_traits::compare(_Myentries[_Pos]._Arc, _Hash.c_str(), _Hash.size()) == 0;
+    const auto _Key_at = [this](const uint32_t _Idx) noexcept {
+        return _Myentries[_Idx]._Arc;
+    };
+    return _Myarcs._Find(_Hash.c_str(), _Key_at) == _Digest_index<64>::npos;
 }
 
-// FUNCTION sudb_file::modify_entry_account_name
-_NODISCARD bool sudb_file::modify_entry_account_name(
-    const wchar_t* const _Account, const wchar_t* const _New_name) {
-    if (!_Myok || _Myentries.empty()) {
+// FUNCTION sudb_file::_Is_unique_salt
+_NODISCARD bool sudb_file::_Is_unique_salt(const _Unique_salt& _Salt) const noexcept {
+    const auto _Key_at = [this](const uint32_t _Idx) noexcept {
+        return _Myentries[_Idx]._Salt;
+    };
+    return _Mysalts._Find(_Salt.get(), _Key_at) == _Digest_index<16>::npos;
+}
+
+// FUNCTION sudb_file::_Generate_unique_arc
+_NODISCARD bool sudb_file::_Generate_unique_arc(arc& _Arc) const noexcept {
+    do { // keep doing this until the ARC is unique
+        _Arc = _SDSDLL make_arc();
+        if (_Arc.empty()) { // failed to generate random bytes
+            return false;
+        }
+    } while (!_Is_unique_arc(_Arc));
+
+    return true;
+}
+
+// FUNCTION sudb_file::_Generate_unique_salt
+_NODISCARD bool sudb_file::_Generate_unique_salt(_Unique_salt& _Salt) const noexcept {
+    do { // keep doing this until the salt is unique
+        if (!_SDSDLL _Random_fill(_Salt.get(), _Unique_salt::size)) {
+            return false;
+        }
+    } while (!_Is_unique_salt(_Salt));
+
+    return true;
+}
+
+// FUNCTION sudb_file::_Should_compact
+_NODISCARD bool sudb_file::_Should_compact() const noexcept {
+    // Note: Fold the journal into the entries once it is larger than the entries themselves
+    //       (but not before it has at least 1024 records), so that loading the file never
+    //       replays more records than it reads entries.
+    static constexpr size_t _Min_records = 1024;
+    const _Sudb_revision _Revision = _Myheader._Revision();
+    const size_t _Records          = _Myjournal_records + _Mypending.size() / _Sudb_record_size(_Revision);
+    return _Mycompact || (_Records > _Min_records
+        && _Records * _Sudb_record_size(_Revision) > _Myentries.size() * _Sudb_entry_size(_Revision));
+}
+
+// FUNCTION sudb_file::_Append_journal
+_NODISCARD bool sudb_file::_Append_journal() {
+    // Note: Resizing to the end of the journal discards a record that was not fully written
+    //       before and moves the position there, so all scheduled records can be written at once.
+    if (!_Myfile.resize(_Myjournal_end)) {
         return false;
     }
 
-    using _Traits     = string_traits<wchar_t, size_t>;
-    const size_t _Pos = _Find_entry_by_account_name(_Account, _Traits::length(_Account));
-    if (_Pos == static_cast<size_t>(-1)) { // entry not found
+    if (!_Myfile.write(_Mypending)) {
         return false;
     }
 
-    const byte_string& _Hash = _SDSDLL xxhash(_New_name);
-    if (_Hash.empty()) { // failed to compute a hash
+    _Myjournal_end += _Mypending.size();
+    _Myjournal_records += _Mypending.size() / _Sudb_record_size(_Myheader._Revision());
+    _Mypending.clear();
+    return true;
+}
+
+// FUNCTION sudb_file::_Compact
+_NODISCARD bool sudb_file::_Compact() {
+    // Note: Serialize the entries count (4-byte integer in bytes) and all entries into a single
+    //       buffer, so that they can be written at once and the checksum can be computed
+    //       without reading the file again. The entries are always written in the latest revision.
+    static constexpr _Sudb_revision _Revision = _Sudb_revision::_Latest;
+    const size_t _Entry_size                  = _Sudb_entry_size(_Revision);
+    const uint32_t _Count                     = static_cast<uint32_t>(_Myentries.size());
+    const auto& _As_bytes                     = _SDSDLL unpack_integer(_Count);
+    byte_string _Data(4 + static_cast<size_t>(_Count) * _Entry_size, uint8_t{});
+    memory_traits::copy(_Data.data(), _As_bytes.data(), _As_bytes.size());
+    auto _Serialize = [&](const size_t _Idx) noexcept {
+        _Sudb_entry_to_bytes(_Myentries[_Idx], _Data.data() + 4 + _Idx * _Entry_size, _Revision);
+    };
+    _SDSDLL parallel_for(parallel_range{0, _Myentries.size()}, _Sudb_serialize_grain, _Serialize);
+
+    const byte_string& _Checksum = _SDSDLL hash<blake3_traits<uint8_t>>(_Data.c_str(), _Data.size());
+    if (_Checksum.empty()) { // failed to compute a checksum
         return false;
     }
 
-    if (memory_traits::compare(_Myentries[_Pos]._Account, _Hash.c_str(), _Hash.size()) != 0) {
-        memory_traits::copy(_Myentries[_Pos]._Account, _Hash.c_str(), _Hash.size());
-        _Mychanges = true; // save changes
+    // Note: Write the entries after the file checksum (40-byte offset) and drop the journal.
+    //       Then write the signature, the magic value (with the revision) and the checksum.
+    if (!_Myfile.resize(40) || !_Myfile.write(_Data)) {
+        return false;
+    }
+
+    _Myheader._Revision(_Revision);
+    _Myheader._Checksum(_Checksum.c_str());
+    _Myheader._Entries(_Count);
+    const byte_string& _Header = _Myheader._To_string();
+    if (!_Myfile.seek(0) || !_Myfile.write(_Header.c_str(), 40)) {
+        return false;
     }
 
+    _Mypending.clear();
+    _Myjournal_end     = 40 + _Data.size();
+    _Myjournal_records = 0;
+    _Mycompact         = false;
     return true;
 }
 
-_NODISCARD bool sudb_file::modify_entry_account_name(
-    const wstring_view _Account, const wstring_view _New_name) {
-    if (!_Myok || _Myentries.empty()) {
-        return false;
+// FUNCTION sudb_file::_Flush_buffers
+_NODISCARD bool sudb_file::_Flush_buffers() {
+    return _Should_compact() ? _Compact() : _Append_journal();
+}
+
+// FUNCTION sudb_file::make_storage
+_NODISCARD bool sudb_file::make_storage(const path& _Target) {
+    file _File;
+    if (_SDSDLL exists(_Target)) { // use an existing file
+        if (!_File.open(_Target)) {
+            return false;
+        }
+
+        if (!_File.clear()) { // file must be empty
+            return false;
+        }
+    } else { // create a new file
+        if (!_SDSDLL create_file(_Target)) {
+            return false;
+        }
+
+        if (!_File.open(_Target)) {
+            return false;
+        }
     }
 
-    const size_t _Pos = _Find_entry_by_account_name(_Account.data(), _Account.size());
-    if (_Pos == static_cast<size_t>(-1)) { // entry not found
+    _Sudb_header _Header;
+    _Header._Revision(_Sudb_revision::_Latest);
+    const byte_string& _Checksum = _SDSDLL blake3("\x00\x00\x00\x00", 4); // 4-byte integer in bytes
+    _Header._Checksum(_Checksum.c_str());
+    return _File.write(_Header._To_string());
+}
+
+// FUNCTION sudb_file::ok
+_NODISCARD const bool sudb_file::ok() const noexcept {
+    shared_lock_guard _Guard(_Mylock);
+    return _Myok;
+}
+
+// FUNCTION sudb_file::refresh
+void sudb_file::refresh() noexcept {
+    exclusive_lock_guard _Guard(_Mylock);
+    _Myok = _Load_file();
+}
+
+// FUNCTION sudb_file::flush
+_NODISCARD bool sudb_file::flush() noexcept {
+    exclusive_lock_guard _Guard(_Mylock);
+    if (!_Myok) {
         return false;
     }
+    
+    if (!_Mychanges) { // nothing has changed
+        return true;
+    }
 
-    const byte_string& _Hash = _SDSDLL xxhash(_New_name);
-    if (_Hash.empty()) { // failed to compute a hash
+    if (_Flush_buffers()) {
+        _Mychanges = false; // reset changes
+        return true;
+    } else {
         return false;
     }
+}
 
-    if (memory_traits::compare(_Myentries[_Pos]._Account, _Hash.c_str(), _Hash.size()) != 0) {
-        memory_traits::copy(_Myentries[_Pos]._Account, _Hash.c_str(), _Hash.size());
-        _Mychanges = true; // save changes
+// FUNCTION sudb_file::password_params
+_NODISCARD argon2_params sudb_file::password_params() const noexcept {
+    shared_lock_guard _Guard(_Mylock);
+    return _Myparams;
+}
+
+_NODISCARD bool sudb_file::password_params(const argon2_params& _New_params) noexcept {
+    if (_New_params != argon2_params{0, 0, 0} && !_Is_valid_argon2_params(_New_params)) {
+        return false;
     }
 
+    exclusive_lock_guard _Guard(_Mylock);
+    _Myparams = _New_params;
     return true;
 }
 
-_NODISCARD bool sudb_file::modify_entry_account_name(const wstring& _Account, const wstring& _New_name) {
+// FUNCTION sudb_file::has_entry
+_NODISCARD bool sudb_file::has_entry(const wchar_t* const _Account) const {
+    shared_lock_guard _Guard(_Mylock);
     if (!_Myok || _Myentries.empty()) {
         return false;
     }
 
-    const size_t _Pos = _Find_entry_by_account_name(_Account.c_str(), _Account.size());
-    if (_Pos == static_cast<size_t>(-1)) { // entry not found
+    using _Traits = string_traits<wchar_t, size_t>;
+    return _Find_entry_by_account_name(_Account, _Traits::length(_Account)) != static_cast<size_t>(-1);
+}
+
+_NODISCARD bool sudb_file::has_entry(const wstring_view _Account) const {
+    shared_lock_guard _Guard(_Mylock);
+    if (!_Myok || _Myentries.empty()) {
         return false;
     }
 
-    const byte_string& _Hash = _SDSDLL xxhash(_New_name);
-    if (_Hash.empty()) { // failed to compute a hash
+    return _Find_entry_by_account_name(_Account.data(), _Account.size()) != static_cast<size_t>(-1);
+}
+
+_NODISCARD bool sudb_file::has_entry(const wstring& _Account) const {
+    shared_lock_guard _Guard(_Mylock);
+    if (!_Myok || _Myentries.empty()) {
         return false;
     }
 
-    if (memory_traits::compare(_Myentries[_Pos]._Account, _Hash.c_str(), _Hash.size()) != 0) {
-        memory_traits::copy(_Myentries[_Pos]._Account, _Hash.c_str(), _Hash.size());
-        _Mychanges = true; // save changes
+    return _Find_entry_by_account_name(_Account.c_str(), _Account.size()) != static_cast<size_t>(-1);
+}
+
+_NODISCARD bool sudb_file::has_entry(const arc& _Arc) const {
+    shared_lock_guard _Guard(_Mylock);
+    if (!_Myok || _Myentries.empty()) {
+        return false;
+    }
+
+    return _Find_entry_by_arc(_Arc) != static_cast<size_t>(-1);
+}
+
+// FUNCTION sudb_file::compare_passwords
+_NODISCARD bool sudb_file::compare_passwords(
+    const wchar_t* const _Account, const wchar_t* const _Password) const {
+    using _Traits = string_traits<wchar_t, size_t>;
+    return _Verify_password(
+        _Account, _Traits::length(_Account), wstring_view{_Password, _Traits::length(_Password)});
+}
+
+_NODISCARD bool sudb_file::compare_passwords(
+    const wstring_view _Account, const wstring_view _Password) const {
+    return _Verify_password(_Account.data(), _Account.size(), _Password);
+}
+
+_NODISCARD bool sudb_file::compare_passwords(const wstring& _Account, const wstring& _Password) const {
+    return _Verify_password(_Account.c_str(), _Account.size(), wstring_view{_Password});
+}
+
+_NODISCARD bool sudb_file::compare_passwords(const sudb_credentials* const _Credentials, const size_t _Count,
+    bool* const _Results, const size_t _Concurrency, thread_pool& _Pool) const {
+    bool _Rehash;
+    { // the entries may be modified by other threads, hold the lock only to read the state
+        shared_lock_guard _Guard(_Mylock);
+        if (!_Myok || (_Count > 0 && (!_Credentials || !_Results))) {
+            return false;
+        }
+
+        for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+            _Results[_Idx] = false;
+        }
+
+        if (_Count == 0 || _Myentries.empty()) { // nothing to compare
+            return true;
+        }
+
+        _Rehash = _Myparams.memory_amount != 0;
+    }
+
+    // Note: Each Argon2id hash uses the memory arena of the thread that computes it, so the number
+    //       of hashes computed at once must be limited. Instead of one task for each credential,
+    //       only _Workers tasks are started and each of them claims the next credential until none
+    //       is left.
+    //       Each worker holds the shared lock only to copy the entry, the hashes are computed
+    //       with the copies, so they run concurrently with each other and with other lookups.
+    //       The passwords that must be re-hashed are re-hashed by the workers as well, but the new
+    //       hashes are applied afterwards, on the calling thread.
+    //       The verification is interactive (someone waits to log in), so the workers are submitted
+    //       with task_priority::high and do not queue behind bulk tasks (e.g. an SCFG flush).
+    const size_t _Limit   = _Concurrency > 0 ? _Concurrency : _Pool.threads() + 1;
+    const size_t _Workers = (_STD min)(_Limit, _Count);
+    vector<_Sudb_entry> _Copies(_Rehash ? _Count : 0);
+    vector<argon2_params> _Params(_Rehash ? _Count : 0);
+    vector<uint8_t> _Rehashed(_Rehash ? _Count : 0, uint8_t{0});
+    byte_string _Hashes(_Rehash ? _Count * 64 : 0, uint8_t{});
+    atomic<size_t> _Next(0);
+    auto _Step = [&](const size_t) noexcept {
+        _Sudb_entry _Entry;
+        argon2_params _Current;
+        for (;;) {
+            const size_t _Idx = _Next.fetch_add(1, _STD memory_order_relaxed);
+            if (_Idx >= _Count) { // no more credentials to claim
+                break;
+            }
+
+            const sudb_credentials& _Item = _Credentials[_Idx];
+            try {
+                _Results[_Idx] = _Copy_entry(_Item.account.data(), _Item.account.size(), _Entry, _Current)
+                    && _Compare_password(_Entry, _Item.password);
+                if (_Rehash && _Results[_Idx] && _Needs_rehash(_Entry, _Current) && _Hash_sudb_password(
+                    _Hashes.data() + _Idx * 64, _Item.password, _Entry._Salt, _Current)) {
+                    _Copies[_Idx]   = _Entry;
+                    _Params[_Idx]   = _Current;
+                    _Rehashed[_Idx] = 1;
+                }
+            } catch (...) { // failed to compute a hash, report a mismatch
+                _Results[_Idx] = false;
+            }
+        }
+    };
+
+    _SDSDLL parallel_for(_Pool, parallel_range{0, _Workers}, 1, _Step, task_priority::high);
+    if (_Rehash) {
+        // Note: The same account may be verified more than once, it is re-hashed only once,
+        //       because the following re-hashes no longer find the verified password.
+        exclusive_lock_guard _Guard(_Mylock);
+        for (size_t _Idx = 0; _Idx < _Rehashed.size(); ++_Idx) {
+            if (_Rehashed[_Idx] != 0) {
+                _Rehash_password(_Copies[_Idx], _Params[_Idx], _Hashes.c_str() + _Idx * 64);
+            }
+        }
     }
 
     return true;
 }
 
-// FUNCTION sudb_file::modify_entry_password
-_NODISCARD bool sudb_file::modify_entry_password(
-    const wchar_t* const _Account, const wchar_t* const _New_password) {
+// FUNCTION sudb_file::compare_arcs
+_NODISCARD bool sudb_file::compare_arcs(const wchar_t* const _Account, const arc& _Arc) const {
+    using _Traits = string_traits<wchar_t, size_t>;
+    return _Compare_arc(_Account, _Traits::length(_Account), _Arc);
+}
+
+_NODISCARD bool sudb_file::compare_arcs(const wstring_view _Account, const arc& _Arc) const {
+    return _Compare_arc(_Account.data(), _Account.size(), _Arc);
+}
+
+_NODISCARD bool sudb_file::compare_arcs(const wstring& _Account, const arc& _Arc) const {
+    return _Compare_arc(_Account.c_str(), _Account.size(), _Arc);
+}
+
+// FUNCTION sudb_file::modify_entry_account_name
+_NODISCARD bool sudb_file::modify_entry_account_name(
+    const wchar_t* const _Account, const wchar_t* const _New_name) {
+    exclusive_lock_guard _Guard(_Mylock);
     if (!_Myok || _Myentries.empty()) {
         return false;
     }
@@ -605,22 +1150,17 @@ _NODISCARD bool sudb_file::modify_entry_password(
         return false;
     }
 
-    const _Unique_salt _Salt(_Myentries[_Pos]._Salt);
-    const byte_string& _Hash = _SDSDLL argon2id(_New_password, _Salt);
+    const byte_string& _Hash = _SDSDLL xxhash(_New_name);
     if (_Hash.empty()) { // failed to compute a hash
         return false;
     }
 
-    if (memory_traits::compare(_Myentries[_Pos]._Password, _Hash.c_str(), _Hash.size()) != 0) {
-        memory_traits::copy(_Myentries[_Pos]._Password, _Hash.c_str(), _Hash.size());
-        _Mychanges = true; // save changes
-    }
-
-    return true;
+    return _Change_entry_account(_Pos, _Hash.c_str());
 }
 
-_NODISCARD bool sudb_file::modify_entry_password(
-    const wstring_view _Account, const wstring_view _New_password) {
+_NODISCARD bool sudb_file::modify_entry_account_name(
+    const wstring_view _Account, const wstring_view _New_name) {
+    exclusive_lock_guard _Guard(_Mylock);
     if (!_Myok || _Myentries.empty()) {
         return false;
     }
@@ -630,21 +1170,16 @@ _NODISCARD bool sudb_file::modify_entry_password(
         return false;
     }
 
-    const _Unique_salt _Salt(_Myentries[_Pos]._Salt);
-    const byte_string& _Hash = _SDSDLL argon2id(_New_password, _Salt);
+    const byte_string& _Hash = _SDSDLL xxhash(_New_name);
     if (_Hash.empty()) { // failed to compute a hash
         return false;
     }
 
-    if (memory_traits::compare(_Myentries[_Pos]._Password, _Hash.c_str(), _Hash.size()) != 0) {
-        memory_traits::copy(_Myentries[_Pos]._Password, _Hash.c_str(), _Hash.size());
-        _Mychanges = true; // save changes
-    }
-
-    return true;
+    return _Change_entry_account(_Pos, _Hash.c_str());
 }
 
-_NODISCARD bool sudb_file::modify_entry_password(const wstring& _Account, const wstring& _New_password) {
+_NODISCARD bool sudb_file::modify_entry_account_name(const wstring& _Account, const wstring& _New_name) {
+    exclusive_lock_guard _Guard(_Mylock);
     if (!_Myok || _Myentries.empty()) {
         return false;
     }
@@ -654,22 +1189,34 @@ _NODISCARD bool sudb_file::modify_entry_password(const wstring& _Account, const
         return false;
     }
 
-    const _Unique_salt _Salt(_Myentries[_Pos]._Salt);
-    const byte_string& _Hash = _SDSDLL argon2id(_New_password, _Salt);
+    const byte_string& _Hash = _SDSDLL xxhash(_New_name);
     if (_Hash.empty()) { // failed to compute a hash
         return false;
     }
 
-    if (memory_traits::compare(_Myentries[_Pos]._Password, _Hash.c_str(), _Hash.size()) != 0) {
-        memory_traits::copy(_Myentries[_Pos]._Password, _Hash.c_str(), _Hash.size());
-        _Mychanges = true; // save changes
-    }
+    return _Change_entry_account(_Pos, _Hash.c_str());
+}
 
-    return true;
+// FUNCTION sudb_file::modify_entry_password
+_NODISCARD bool sudb_file::modify_entry_password(
+    const wchar_t* const _Account, const wchar_t* const _New_password) {
+    using _Traits = string_traits<wchar_t, size_t>;
+    return _Modify_entry_password(
+        _Account, _Traits::length(_Account), wstring_view{_New_password, _Traits::length(_New_password)});
+}
+
+_NODISCARD bool sudb_file::modify_entry_password(
+    const wstring_view _Account, const wstring_view _New_password) {
+    return _Modify_entry_password(_Account.data(), _Account.size(), _New_password);
+}
+
+_NODISCARD bool sudb_file::modify_entry_password(const wstring& _Account, const wstring& _New_password) {
+    return _Modify_entry_password(_Account.c_str(), _Account.size(), wstring_view{_New_password});
 }
 
 // FUNCTION sudb_file::modify_entry_arc
 _NODISCARD bool sudb_file::modify_entry_arc(const wchar_t* const _Account) noexcept {
+    exclusive_lock_guard _Guard(_Mylock);
     if (!_Myok || _Myentries.empty()) {
         return false;
     }
@@ -680,18 +1227,21 @@ _NODISCARD bool sudb_file::modify_entry_arc(const wchar_t* const _Account) noexc
         return false;
     }
 
-    const arc& _Arc          = _Generate_unique_arc();
+    arc _Arc;
+    if (!_Generate_unique_arc(_Arc)) { // failed to generate random bytes
+        return false;
+    }
+
     const byte_string& _Hash = _SDSDLL sha512(_Arc.to_string());
     if (_Hash.empty()) { // failed to compute a hash
         return false;
     }
 
-    memory_traits::copy(_Myentries[_Pos]._Arc, _Hash.c_str(), _Hash.size());
-    _Mychanges = true; // save changes
-    return true;
+    return _Change_entry_arc(_Pos, _Hash.c_str());
 }
 
 _NODISCARD bool sudb_file::modify_entry_arc(const wstring_view _Account) noexcept {
+    exclusive_lock_guard _Guard(_Mylock);
     if (!_Myok || _Myentries.empty()) {
         return false;
     }
@@ -701,13 +1251,21 @@ _NODISCARD bool sudb_file::modify_entry_arc(const wstring_view _Account) noexcep
         return false;
     }
 
-    const arc& _Arc = _Generate_unique_arc();
-    memory_traits::copy(_Myentries[_Pos]._Arc, _Arc.get(), _Arc.size);
-    _Mychanges = true; // save changes
-    return true;
+    arc _Arc;
+    if (!_Generate_unique_arc(_Arc)) { // failed to generate random bytes
+        return false;
+    }
+
+    const byte_string& _Hash = _SDSDLL sha512(_Arc.to_string());
+    if (_Hash.empty()) { // failed to compute a hash
+        return false;
+    }
+
+    return _Change_entry_arc(_Pos, _Hash.c_str());
 }
 
 _NODISCARD bool sudb_file::modify_entry_arc(const wstring& _Account) {
+    exclusive_lock_guard _Guard(_Mylock);
     if (!_Myok || _Myentries.empty()) {
         return false;
     }
@@ -717,199 +1275,388 @@ _NODISCARD bool sudb_file::modify_entry_arc(const wstring& _Account) {
         return false;
     }
 
-    const arc& _Arc          = _Generate_unique_arc();
+    arc _Arc;
+    if (!_Generate_unique_arc(_Arc)) { // failed to generate random bytes
+        return false;
+    }
+
     const byte_string& _Hash = _SDSDLL sha512(_Arc.to_string());
     if (_Hash.empty()) { // failed to compute a hash
         return false;
     }
 
-    memory_traits::copy(_Myentries[_Pos]._Arc, _Hash.c_str(), _Hash.size());
-    _Mychanges = true; // save changes
-    return true;
+    return _Change_entry_arc(_Pos, _Hash.c_str());
 }
 
 // FUNCTION sudb_file::append_entry
 _NODISCARD bool sudb_file::append_entry(
     const wchar_t* const _Account, const wchar_t* const _Password, arc* const _Arc) {
-    if (has_entry(_Account) || _Myentries.size() >= 0xFFFF'FFFF) {
-        return false;
+    using _Traits = string_traits<wchar_t, size_t>;
+    return _Append_entry(
+        _Account, _Traits::length(_Account), wstring_view{_Password, _Traits::length(_Password)}, _Arc);
+}
+
+_NODISCARD bool sudb_file::append_entry(
+    const wstring_view _Account, const wstring_view _Password, arc* const _Arc) {
+    return _Append_entry(_Account.data(), _Account.size(), _Password, _Arc);
+}
+
+_NODISCARD bool sudb_file::append_entry(
+    const wstring& _Account, const wstring& _Password, arc* const _Arc) {
+    return _Append_entry(_Account.c_str(), _Account.size(), wstring_view{_Password}, _Arc);
+}
+
+// FUNCTION sudb_file::erase_entry
+void sudb_file::erase_entry(const wchar_t* const _Account) {
+    exclusive_lock_guard _Guard(_Mylock);
+    if (!_Myok || _Myentries.empty()) {
+        return;
     }
 
-    _Sudb_entry _Entry;
-    { // hash an account name
-        const byte_string& _Hash = _SDSDLL xxhash(_Account);
-        if (_Hash.empty()) { // failed to compute a hash
-            return false;
-        }
+    using _Traits     = string_traits<wchar_t, size_t>;
+    const size_t _Pos = _Find_entry_by_account_name(_Account, _Traits::length(_Account));
+    if (_Pos != static_cast<size_t>(-1)) { // entry not found
+        _Journal_entry(_Sudb_journal_op::_Erase, _Pos);
+        _Erase_entry(_Pos);
+        _Mychanges = true; // save changes
+    }
+}
 
-        memory_traits::copy(_Entry._Account, _Hash.c_str(), _Hash.size());
+void sudb_file::erase_entry(const wstring_view _Account) {
+    exclusive_lock_guard _Guard(_Mylock);
+    if (!_Myok || _Myentries.empty()) {
+        return;
     }
 
-    { // generate a unique salt and hash a password 
-        const _Unique_salt _Salt = _Generate_unique_salt();
-        const byte_string& _Hash = _SDSDLL argon2id(_Password, _Salt);
-        if (_Hash.empty()) { // failed to compute a hash
-            return false;
-        }
+    const size_t _Pos = _Find_entry_by_account_name(_Account.data(), _Account.size());
+    if (_Pos != static_cast<size_t>(-1)) { // entry not found
+        _Journal_entry(_Sudb_journal_op::_Erase, _Pos);
+        _Erase_entry(_Pos);
+        _Mychanges = true; // save changes
+    }
+}
 
-        memory_traits::copy(_Entry._Password, _Hash.c_str(), _Hash.size());
-        memory_traits::copy(_Entry._Salt, _Salt.get(), _Unique_salt::size);
+void sudb_file::erase_entry(const wstring& _Account) {
+    exclusive_lock_guard _Guard(_Mylock);
+    if (!_Myok || _Myentries.empty()) {
+        return;
     }
 
-    { // hash a unique ARC
-        const arc& _Unique_arc   = _Generate_unique_arc();
-        const byte_string& _Hash = _SDSDLL sha512(_Unique_arc.to_string());
-        if (_Hash.empty()) { // failed to compute a hash
-            return false;
-        }
-    
-        memory_traits::copy(_Entry._Arc, _Hash.c_str(), _Hash.size());
-        if (_Arc) { // save a new ARC
-            *_Arc = _Unique_arc;
-        }
+    const size_t _Pos = _Find_entry_by_account_name(_Account.c_str(), _Account.size());
+    if (_Pos != static_cast<size_t>(-1)) { // entry not found
+        _Journal_entry(_Sudb_journal_op::_Erase, _Pos);
+        _Erase_entry(_Pos);
+        _Mychanges = true; // save changes
     }
-    
-    _Myentries.push_back(_Entry);
+}
+
+// FUNCTION sudb_file::erase_all_entries
+void sudb_file::erase_all_entries() noexcept {
+    exclusive_lock_guard _Guard(_Mylock);
+    if (!_Myok || _Myentries.empty()) {
+        return;
+    }
+
+    _Myentries.clear();
+    _Myaccounts._Clear();
+    _Myarcs._Clear();
+    _Mysalts._Clear();
+    _Mypending.clear();
+    _Mycompact = true; // nothing to keep, rewrite the file
     _Mychanges = true; // save changes
-    return true;
 }
 
-_NODISCARD bool sudb_file::append_entry(
-    const wstring_view _Account, const wstring_view _Password, arc* const _Arc) {
-    if (has_entry(_Account) || _Myentries.size() >= 0xFFFF'FFFF) {
+// FUNCTION sudb_view constructor/destructor
+sudb_view::sudb_view(const path& _Target)
+    : _Mypath(_Target), _Myfile(), _Mybase(nullptr), _Mycount(0), _Myrevision(_Sudb_revision::_Latest),
+    _Myrecords(), _Myaccounts(), _Myarcs(), _Mylock(), _Myverified(false), _Myindexed(false),
+    _Myvalid(false), _Myok(_Map_file()) {}
+
+sudb_view::~sudb_view() noexcept {}
+
+// FUNCTION sudb_view::_Map_file
+_NODISCARD bool sudb_view::_Map_file() noexcept {
+    _Myfile.close();
+    _Mybase  = nullptr;
+    _Mycount = 0;
+    _Myrecords.clear();
+    _Myaccounts._Clear();
+    _Myarcs._Clear();
+    _Myverified.store(false, _STD memory_order_relaxed);
+    _Myindexed.store(false, _STD memory_order_relaxed);
+    _Myvalid = false;
+    if (!_Myfile.open(_Mypath)) {
         return false;
     }
 
-    _Sudb_entry _Entry;
-    { // hash an account name
-        const byte_string& _Hash = _SDSDLL xxhash(_Account);
-        if (_Hash.empty()) { // failed to compute a hash
-            return false;
-        }
-
-        memory_traits::copy(_Entry._Account, _Hash.c_str(), _Hash.size());
+    static constexpr size_t _Header_size = 44; // 44-byte header
+    const uint8_t* const _Data           = _Myfile.data();
+    const size_t _Size                   = _Myfile.size();
+    if (_Size < _Header_size) { // incomplete header
+        return false;
     }
 
-    { // generate a unique salt and hash a password 
-        const _Unique_salt _Salt = _Generate_unique_salt();
-        const byte_string& _Hash = _SDSDLL argon2id(_Password, _Salt);
-        if (_Hash.empty()) { // failed to compute a hash
+    try {
+        const _Sudb_header _Header(byte_string{_Data, _Header_size});
+        if (!_Header._Valid()) {
             return false;
         }
 
-        memory_traits::copy(_Entry._Password, _Hash.c_str(), _Hash.size());
-        memory_traits::copy(_Entry._Salt, _Salt.get(), _Unique_salt::size);
-    }
-
-    { // hash a unique ARC
-        const arc& _Unique_arc   = _Generate_unique_arc();
-        const byte_string& _Hash = _SDSDLL sha512(_Unique_arc.to_string());
-        if (_Hash.empty()) { // failed to compute a hash
+        const size_t _Count      = _Header._Entries();
+        const size_t _Entry_size = _Sudb_entry_size(_Header._Revision());
+        if ((_Size - _Header_size) / _Entry_size < _Count) { // incomplete entries
             return false;
         }
-    
-        memory_traits::copy(_Entry._Arc, _Hash.c_str(), _Hash.size());
-        if (_Arc) { // save a new ARC
-            *_Arc = _Unique_arc;
-        }
+
+        // Note: Only the header is validated here, so that opening a view does not depend
+        //       on the number of entries. The entries are verified by the first call that needs them.
+        _Mybase     = _Data + _Header_size;
+        _Mycount    = _Count;
+        _Myrevision = _Header._Revision();
+        return true;
+    } catch (...) {
+        return false;
     }
-    
-    _Myentries.push_back(_Entry);
-    _Mychanges = true; // save changes
-    return true;
 }
 
-_NODISCARD bool sudb_file::append_entry(
-    const wstring& _Account, const wstring& _Password, arc* const _Arc) {
-    if (has_entry(_Account) || _Myentries.size() >= 0xFFFF'FFFF) {
-        return false;
+// FUNCTION sudb_view::_Verify
+_NODISCARD bool sudb_view::_Verify() const noexcept {
+    if (_Myverified.load(_STD memory_order_acquire)) { // already verified
+        return _Myvalid;
     }
 
-    _Sudb_entry _Entry;
-    { // hash an account name
-        const byte_string& _Hash = _SDSDLL xxhash(_Account);
-        if (_Hash.empty()) { // failed to compute a hash
-            return false;
-        }
+    exclusive_lock_guard _Guard(_Mylock);
+    if (_Myverified.load(_STD memory_order_relaxed)) { // verified by another thread
+        return _Myvalid;
+    }
 
-        memory_traits::copy(_Entry._Account, _Hash.c_str(), _Hash.size());
+    // Note: The checksum covers the entries count and the entries, so it is computed directly
+    //       over the mapped bytes (40-byte offset). The entries are never copied.
+    static constexpr size_t _Header_size = 44; // 44-byte header
+    const uint8_t* const _Data           = _Myfile.data();
+    const size_t _Base_end               = _Header_size + _Mycount * _Sudb_entry_size(_Myrevision);
+    try {
+        const _Sudb_header _Header(byte_string{_Data, _Header_size});
+        const byte_string& _Checksum = _SDSDLL hash<blake3_traits<uint8_t>>(_Data + 40, _Base_end - 40);
+        _Myvalid = byte_string_view{_Header._Checksum(), 32} == _Checksum
+            && _Load_journal(_Data + _Base_end, _Myfile.size() - _Base_end);
+    } catch (...) {
+        _Myvalid = false;
     }
 
-    { // generate a unique salt and hash a password 
-        const _Unique_salt _Salt = _Generate_unique_salt();
-        const byte_string& _Hash = _SDSDLL argon2id(_Password, _Salt);
-        if (_Hash.empty()) { // failed to compute a hash
-            return false;
-        }
+    if (!_Myvalid) { // nothing can be found in invalid entries
+        _Myrecords.clear();
+        _Mycount = 0;
+    }
 
-        memory_traits::copy(_Entry._Password, _Hash.c_str(), _Hash.size());
-        memory_traits::copy(_Entry._Salt, _Salt.get(), _Unique_salt::size);
+    _Myverified.store(true, _STD memory_order_release);
+    return _Myvalid;
+}
+
+// FUNCTION sudb_view::_Load_journal
+_NODISCARD bool sudb_view::_Load_journal(const uint8_t* const _First, const size_t _Size) const {
+    // Note: Without the journal, the entries are addressed directly in the mapped file.
+    //       Otherwise, a table of pointers to the mapped entries is built and the journal
+    //       records are replayed on it the same way as sudb_file does. Only the last record
+    //       may be incomplete or damaged, any other damaged record rejects the file.
+    const size_t _Record_size = _Sudb_record_size(_Myrevision);
+    const size_t _Records     = _Size / _Record_size;
+    if (_Records == 0) { // no journal
+        return true;
     }
 
-    { // hash a unique ARC
-        const arc& _Unique_arc   = _Generate_unique_arc();
-        const byte_string& _Hash = _SDSDLL sha512(_Unique_arc.to_string());
-        if (_Hash.empty()) { // failed to compute a hash
+    _Myrecords.reserve(_Mycount + _Records);
+    const size_t _Entry_size = _Sudb_entry_size(_Myrevision);
+    for (size_t _Idx = 0; _Idx < _Mycount; ++_Idx) {
+        _Myrecords.push_back(_Mybase + _Idx * _Entry_size);
+    }
+
+    _Sudb_journal_record _Record;
+    for (size_t _Idx = 0; _Idx < _Records; ++_Idx) {
+        const uint8_t* const _Bytes = _First + _Idx * _Record_size;
+        if (!_Extract_sudb_journal_record(_Bytes, _Record, _Myrevision)) {
+            if ((_Idx + 1) * _Record_size == _Size) { // damaged last record
+                break;
+            }
+
             return false;
         }
-    
-        memory_traits::copy(_Entry._Arc, _Hash.c_str(), _Hash.size());
-        if (_Arc) { // save a new ARC
-            *_Arc = _Unique_arc;
+
+        if (_Record._Op == _Sudb_journal_op::_Append) {
+            if (_Record._Pos != _Myrecords.size()) {
+                return false;
+            }
+
+            _Myrecords.push_back(_Bytes + 8); // the entry is stored after the position
+        } else {
+            if (_Record._Pos >= _Myrecords.size()) {
+                return false;
+            }
+
+            if (_Record._Op == _Sudb_journal_op::_Modify) {
+                _Myrecords[_Record._Pos] = _Bytes + 8;
+            } else { // move the last entry into the freed slot
+                _Myrecords[_Record._Pos] = _Myrecords.back();
+                _Myrecords.pop_back();
+            }
         }
     }
-    
-    _Myentries.push_back(_Entry);
-    _Mychanges = true; // save changes
+
+    _Mycount = _Myrecords.size();
     return true;
 }
 
-// FUNCTION sudb_file::erase_entry
-void sudb_file::erase_entry(const wchar_t* const _Account) {
-    if (!_Myok || _Myentries.empty()) {
+// FUNCTION sudb_view::_Entry_at
+_NODISCARD const uint8_t* sudb_view::_Entry_at(const size_t _Pos) const noexcept {
+    return _Myrecords.empty() ? _Mybase + _Pos * _Sudb_entry_size(_Myrevision) : _Myrecords[_Pos];
+}
+
+// FUNCTION sudb_view::_Build_indexes
+void sudb_view::_Build_indexes() const {
+    if (_Myindexed.load(_STD memory_order_acquire)) { // already built
         return;
     }
 
-    using _Traits     = string_traits<wchar_t, size_t>;
-    const size_t _Pos = _Find_entry_by_account_name(_Account, _Traits::length(_Account));
-    if (_Pos != static_cast<size_t>(-1)) { // entry not found
-        _Myentries.erase(_Myentries.cbegin() + _Pos);
-        _Mychanges = true; // save changes
+    exclusive_lock_guard _Guard(_Mylock);
+    if (_Myindexed.load(_STD memory_order_relaxed)) { // built by another thread
+        return;
     }
+
+    // Note: The indexes store only the positions of the mapped entries, the digests
+    //       are compared directly with the mapped bytes.
+    _Myaccounts._Reserve(_Mycount);
+    _Myarcs._Reserve(_Mycount);
+    for (size_t _Idx = 0; _Idx < _Mycount; ++_Idx) {
+        const uint8_t* const _Entry = _Entry_at(_Idx);
+        _Myaccounts._Insert(_Entry, static_cast<uint32_t>(_Idx));
+        _Myarcs._Insert(_Entry + 88, static_cast<uint32_t>(_Idx));
+    }
+
+    _Myindexed.store(true, _STD memory_order_release);
 }
 
-void sudb_file::erase_entry(const wstring_view _Account) {
-    if (!_Myok || _Myentries.empty()) {
-        return;
+// FUNCTION sudb_view::_Find_entry_by_account_name
+_NODISCARD size_t sudb_view::_Find_entry_by_account_name(const wchar_t* const _Name, const size_t _Size) const {
+    if (!_Myok || !_Verify() || _Mycount == 0) {
+        return static_cast<size_t>(-1);
     }
 
-    const size_t _Pos = _Find_entry_by_account_name(_Account.data(), _Account.size());
-    if (_Pos != static_cast<size_t>(-1)) { // entry not found
-        _Myentries.erase(_Myentries.cbegin() + _Pos);
-        _Mychanges = true; // save changes
+    const byte_string& _Hash = _SDSDLL xxhash(_Name, _Size);
+    if (_Hash.empty()) { // failed to compute a hash
+        return static_cast<size_t>(-1);
     }
+
+    _Build_indexes();
+    const auto _Key_at = [this](const uint32_t _Idx) noexcept {
+        return _Entry_at(_Idx);
+    };
+    const uint32_t _Pos = _Myaccounts._Find(_Hash.c_str(), _Key_at);
+    return _Pos != _Digest_index<8>::npos ? static_cast<size_t>(_Pos) : static_cast<size_t>(-1);
 }
 
-void sudb_file::erase_entry(const wstring& _Account) {
-    if (!_Myok || _Myentries.empty()) {
-        return;
+// FUNCTION sudb_view::_Find_entry_by_arc
+_NODISCARD size_t sudb_view::_Find_entry_by_arc(const arc& _Arc) const {
+    if (!_Myok || !_Verify() || _Mycount == 0) {
+        return static_cast<size_t>(-1);
     }
 
-    const size_t _Pos = _Find_entry_by_account_name(_Account.c_str(), _Account.size());
-    if (_Pos != static_cast<size_t>(-1)) { // entry not found
-        _Myentries.erase(_Myentries.cbegin() + _Pos);
-        _Mychanges = true; // save changes
+    const byte_string& _Hash = _SDSDLL sha512(_Arc.to_string());
+    if (_Hash.empty()) { // failed to compute a hash
+        return static_cast<size_t>(-1);
     }
+
+    _Build_indexes();
+    const auto _Key_at = [this](const uint32_t _Idx) noexcept {
+        return _Entry_at(_Idx) + 88;
+    };
+    const uint32_t _Pos = _Myarcs._Find(_Hash.c_str(), _Key_at);
+    return _Pos != _Digest_index<64>::npos ? static_cast<size_t>(_Pos) : static_cast<size_t>(-1);
 }
 
-// FUNCTION sudb_file::erase_all_entries
-void sudb_file::erase_all_entries() noexcept {
-    if (!_Myok || _Myentries.empty()) {
-        return;
+// FUNCTION sudb_view::ok
+_NODISCARD const bool sudb_view::ok() const noexcept {
+    return _Myok && _Verify();
+}
+
+// FUNCTION sudb_view::refresh
+void sudb_view::refresh() noexcept {
+    _Myok = _Map_file();
+}
+
+// FUNCTION sudb_view::size
+_NODISCARD size_t sudb_view::size() const noexcept {
+    return _Myok && _Verify() ? _Mycount : 0;
+}
+
+// FUNCTION sudb_view::has_entry
+_NODISCARD bool sudb_view::has_entry(const wchar_t* const _Account) const {
+    using _Traits = string_traits<wchar_t, size_t>;
+    return has_entry(wstring_view{_Account, _Traits::length(_Account)});
+}
+
+_NODISCARD bool sudb_view::has_entry(const wstring_view _Account) const {
+    return _Find_entry_by_account_name(_Account.data(), _Account.size()) != static_cast<size_t>(-1);
+}
+
+_NODISCARD bool sudb_view::has_entry(const wstring& _Account) const {
+    return has_entry(wstring_view{_Account});
+}
+
+_NODISCARD bool sudb_view::has_entry(const arc& _Arc) const {
+    return _Find_entry_by_arc(_Arc) != static_cast<size_t>(-1);
+}
+
+// FUNCTION sudb_view::compare_passwords
+_NODISCARD bool sudb_view::compare_passwords(
+    const wchar_t* const _Account, const wchar_t* const _Password) const {
+    using _Traits = string_traits<wchar_t, size_t>;
+    return compare_passwords(wstring_view{_Account, _Traits::length(_Account)},
+        wstring_view{_Password, _Traits::length(_Password)});
+}
+
+_NODISCARD bool sudb_view::compare_passwords(const wstring_view _Account, const wstring_view _Password) const {
+    const size_t _Pos = _Find_entry_by_account_name(_Account.data(), _Account.size());
+    if (_Pos == static_cast<size_t>(-1)) { // entry not found
+        return false;
     }
 
-    _Myentries.clear();
-    _Mychanges = true; // save changes
+    // Note: The view is read-only, so the passwords are never re-hashed here.
+    _Sudb_entry _Entry;
+    _Sudb_entry_from_bytes(_Entry, _Entry_at(_Pos), _Myrevision);
+    uint8_t _Hash[64];
+    if (!_Hash_sudb_password(_Hash, _Password, _Entry._Salt, _Entry._Params)) { // failed to compute a hash
+        return false;
+    }
+
+    return memory_traits::compare(_Entry._Password, _Hash, sizeof(_Hash)) == 0;
+}
+
+_NODISCARD bool sudb_view::compare_passwords(const wstring& _Account, const wstring& _Password) const {
+    return compare_passwords(wstring_view{_Account}, wstring_view{_Password});
+}
+
+// FUNCTION sudb_view::compare_arcs
+_NODISCARD bool sudb_view::compare_arcs(const wchar_t* const _Account, const arc& _Arc) const {
+    using _Traits = string_traits<wchar_t, size_t>;
+    return compare_arcs(wstring_view{_Account, _Traits::length(_Account)}, _Arc);
+}
+
+_NODISCARD bool sudb_view::compare_arcs(const wstring_view _Account, const arc& _Arc) const {
+    const size_t _Pos = _Find_entry_by_account_name(_Account.data(), _Account.size());
+    if (_Pos == static_cast<size_t>(-1)) { // entry not found
+        return false;
+    }
+
+    const byte_string& _Hash = _SDSDLL sha512(_Arc.to_string());
+    if (_Hash.empty()) { // failed to compute a hash
+        return false;
+    }
+
+    return memory_traits::compare(_Entry_at(_Pos) + 88, _Hash.c_str(), _Hash.size()) == 0;
+}
+
+_NODISCARD bool sudb_view::compare_arcs(const wstring& _Account, const arc& _Arc) const {
+    return compare_arcs(wstring_view{_Account}, _Arc);
 }
 _SDSDLL_END
 
@@ -9,35 +9,53 @@
 #include <core/defs.hpp>
 #if _SDSDLL_PREPROCESSOR_GUARD
 #include <array>
+#include <atomic>
 #include <core/api.hpp>
+#include <core/container/digest_index.hpp>
 #include <core/optimization/sbo.hpp>
 #include <core/optimization/string_view.hpp>
 #include <core/traits/integer.hpp>
 #include <core/traits/memory_traits.hpp>
 #include <core/traits/string_traits.hpp>
 #include <core/traits/type_traits.hpp>
+#include <cryptography/hash/generic.hpp>
 #include <cryptography/hash/generic/blake3.hpp>
 #include <cryptography/hash/generic/sha512.hpp>
 #include <cryptography/hash/generic/xxhash.hpp>
 #include <cryptography/hash/password/argon2id.hpp>
+#include <cryptography/hash/password/calibration.hpp>
+#include <cryptography/hash/stream.hpp>
+#include <cryptography/random/drbg.hpp>
 #include <cryptography/random/salt.hpp>
 #include <cstddef>
 #include <cstdint>
 #include <filesystem/file.hpp>
+#include <filesystem/mapped_file.hpp>
 #include <filesystem/path.hpp>
 #include <filesystem/status.hpp>
-#include <openssl/rand.h>
 #include <recovery/arc.hpp>
 #include <string>
+#include <system/execution/distributed_lock.hpp>
+#include <system/execution/parallel.hpp>
+#include <system/execution/shared_lock.hpp>
+#include <system/execution/thread_pool.hpp>
 #include <vector>
 
 // STD types
 using _STD array;
+using _STD atomic;
 using _STD string;
 using _STD wstring;
 using _STD vector;
 
 _SDSDLL_BEGIN
+// ENUM CLASS _Sudb_revision
+enum class _Sudb_revision : uint8_t {
+    _Fixed_params = 0, // all passwords are hashed with the default Argon2id engine
+    _Entry_params = 1, // each entry stores the Argon2id parameters of its password
+    _Latest       = _Entry_params
+};
+
 // STRUCT _Sudb_header_data
 struct _Sudb_header_data {
     uint8_t _Signature[4]; // 4-byte signature
@@ -66,6 +84,12 @@ public:
     // checks if the signature and the magic are valid
     _NODISCARD bool _Valid() const noexcept;
 
+    // returns the format revision
+    _NODISCARD _Sudb_revision _Revision() const noexcept;
+
+    // changes the format revision
+    void _Revision(const _Sudb_revision _New_revision) noexcept;
+
     // returns a file checksum
     _NODISCARD const uint8_t* _Checksum() const noexcept;
 
@@ -94,12 +118,56 @@ struct _Sudb_entry {
     uint8_t _Password[64]; // 64-byte Argon2id password
     uint8_t _Salt[16]; // 16-byte unique salt
     uint8_t _Arc[64]; // 64-byte SHA-512 Account Recovery Code
+    argon2_params _Params; // Argon2id parameters of the password ({0, 0, 0} for the default engine)
+};
+
+// FUNCTION _Sudb_entry_size
+extern _NODISCARD size_t _Sudb_entry_size(const _Sudb_revision _Revision) noexcept;
+
+// FUNCTION _Sudb_record_size
+extern _NODISCARD size_t _Sudb_record_size(const _Sudb_revision _Revision) noexcept;
+
+// CONSTANT _Sudb_serialize_grain
+inline constexpr size_t _Sudb_serialize_grain = 4096; // entries serialized by one task at least
+
+// FUNCTION _Sudb_entry_to_bytes
+extern void _Sudb_entry_to_bytes(
+    const _Sudb_entry& _Entry, uint8_t* const _Bytes, const _Sudb_revision _Revision) noexcept;
+
+// FUNCTION _Sudb_entry_from_bytes
+extern void _Sudb_entry_from_bytes(
+    _Sudb_entry& _Entry, const uint8_t* const _Bytes, const _Sudb_revision _Revision) noexcept;
+
+// FUNCTION _Hash_sudb_password
+extern _NODISCARD bool _Hash_sudb_password(uint8_t* const _Buf, const wstring_view _Password,
+    const uint8_t* const _Salt, const argon2_params& _Params) noexcept;
+
+// ENUM CLASS _Sudb_journal_op
+enum class _Sudb_journal_op : uint8_t {
+    _Append = 1,
+    _Modify = 2,
+    _Erase  = 3
 };
 
+// STRUCT _Sudb_journal_record
+struct _Sudb_journal_record {
+    _Sudb_journal_op _Op; // operation to replay
+    uint32_t _Pos; // position of the affected entry
+    _Sudb_entry _Entry; // entry after the operation (ignored by _Erase)
+};
+
+// FUNCTION _Append_sudb_journal_record
+extern void _Append_sudb_journal_record(
+    byte_string& _Bytes, const _Sudb_journal_record& _Record, const _Sudb_revision _Revision);
+
+// FUNCTION _Extract_sudb_journal_record
+extern _NODISCARD bool _Extract_sudb_journal_record(
+    const uint8_t* const _Bytes, _Sudb_journal_record& _Record, const _Sudb_revision _Revision);
+
 // CLASS _Sudb_entries_loader
 class _Sudb_entries_loader {
 public:
-    _Sudb_entries_loader(file* const _File) noexcept;
+    explicit _Sudb_entries_loader(file* const _File, const _Sudb_revision _Revision) noexcept;
     ~_Sudb_entries_loader() noexcept;
 
     _Sudb_entries_loader() = delete;
@@ -114,11 +182,18 @@ public:
 
 private:
     file* const _Myfile;
+    _Sudb_revision _Myrevision;
     _Sudb_entry _Myentry;
 };
 
+// STRUCT sudb_credentials
+struct sudb_credentials { // account name and password to be verified
+    wstring_view account;
+    wstring_view password;
+};
+
 // CLASS sudb_file
-class _SDSDLL_API sudb_file { // manages SUDB file reading/writing
+class _SDSDLL_API sudb_file { // manages SUDB file reading/writing, safe to share between threads
 private:
     using _Unique_salt = salt<_Argon2id_default_engine<wchar_t>>;
 
@@ -142,17 +217,28 @@ public:
     // saves the changes
     _NODISCARD bool flush() noexcept;
 
+    // returns the Argon2id parameters of new and re-hashed passwords
+    _NODISCARD argon2_params password_params() const noexcept;
+
+    // changes the Argon2id parameters of new and re-hashed passwords ({0, 0, 0} for the default engine)
+    _NODISCARD bool password_params(const argon2_params& _New_params) noexcept;
+
     // checks if the storage has the selected entry
     _NODISCARD bool has_entry(const wchar_t* const _Account) const;
     _NODISCARD bool has_entry(const wstring_view _Account) const;
     _NODISCARD bool has_entry(const wstring& _Account) const;
     _NODISCARD bool has_entry(const arc& _Arc) const;
 
-    // checks if the selected password is correct
+    // checks if the selected password is correct (re-hashes it if the parameters have changed)
     _NODISCARD bool compare_passwords(const wchar_t* const _Account, const wchar_t* const _Password) const;
     _NODISCARD bool compare_passwords(const wstring_view _Account, const wstring_view _Password) const;
     _NODISCARD bool compare_passwords(const wstring& _Account, const wstring& _Password) const;
 
+    // checks if the selected passwords are correct (at most _Concurrency hashes are computed at once)
+    _NODISCARD bool compare_passwords(const sudb_credentials* const _Credentials, const size_t _Count,
+        bool* const _Results, const size_t _Concurrency = 0,
+        thread_pool& _Pool = default_thread_pool()) const;
+
     // checks if the selected ARC is correct
     _NODISCARD bool compare_arcs(const wchar_t* const _Account, const arc& _Arc) const;
     _NODISCARD bool compare_arcs(const wstring_view _Account, const arc& _Arc) const;
@@ -193,48 +279,202 @@ private:
     // loads the header from a file
     _NODISCARD bool _Load_header();
 
-    // loads the entries from a file
+    // loads the entries from a file and validates their checksum
     _NODISCARD bool _Load_entries();
 
-    // validates the checksum from a file
-    _NODISCARD bool _Validate_checksum() noexcept;
+    // replays the journal that follows the entries
+    _NODISCARD bool _Load_journal();
 
     // loads the file header and the entries
     _NODISCARD bool _Load_file() noexcept;
 
+    // removes all entries and their indexes
+    void _Clear_entries() noexcept;
+
+    // appends a new entry and indexes it
+    void _Insert_entry(const _Sudb_entry& _Entry);
+
+    // erases the selected entry and updates the indexes
+    void _Erase_entry(const size_t _Pos) noexcept;
+
+    // changes the selected entry account name hash (fails if the name is already used)
+    _NODISCARD bool _Change_entry_account(const size_t _Pos, const uint8_t* const _Hash) noexcept;
+
+    // changes the selected entry ARC hash
+    _NODISCARD bool _Change_entry_arc(const size_t _Pos, const uint8_t* const _Hash) noexcept;
+
+    // replaces the selected entry and updates the indexes
+    void _Replace_entry(const size_t _Pos, const _Sudb_entry& _Entry) noexcept;
+
+    // applies a single journal record
+    _NODISCARD bool _Apply_journal_record(const _Sudb_journal_record& _Record);
+
+    // schedules a journal record for the selected entry
+    void _Journal_entry(const _Sudb_journal_op _Op, const size_t _Pos) const;
+
     // returns the selected entry position (-1 if not found), searches by account name
     _NODISCARD size_t _Find_entry_by_account_name(const wchar_t* const _Name, const size_t _Size) const;
 
     // returns the selected entry position (-1 if not found), searches by ARC
     _NODISCARD size_t _Find_entry_by_arc(const arc& _Arc) const;
 
+    // returns the position of the entry that still has the account name and the salt of the copy
+    _NODISCARD size_t _Find_entry_by_copy(const _Sudb_entry& _Copy) const noexcept;
+
+    // copies the selected entry and the current parameters (false if not found), takes the shared lock
+    _NODISCARD bool _Copy_entry(const wchar_t* const _Name, const size_t _Size,
+        _Sudb_entry& _Entry, argon2_params& _Params) const;
+
+    // checks if the selected password matches the selected entry
+    _NODISCARD static bool _Compare_password(
+        const _Sudb_entry& _Entry, const wstring_view _Password) noexcept;
+
+    // checks if the selected entry password must be re-hashed with the selected parameters
+    _NODISCARD static bool _Needs_rehash(const _Sudb_entry& _Entry, const argon2_params& _Params) noexcept;
+
+    // replaces the password hash of an unchanged entry, the exclusive lock must be held
+    void _Rehash_password(
+        const _Sudb_entry& _Copy, const argon2_params& _Params, const uint8_t* const _Hash) const noexcept;
+
+    // checks if the selected password matches the selected entry and re-hashes it if necessary
+    _NODISCARD bool _Verify_password(const wchar_t* const _Name, const size_t _Size,
+        const wstring_view _Password) const;
+
+    // checks if the selected ARC matches the selected entry
+    _NODISCARD bool _Compare_arc(const wchar_t* const _Name, const size_t _Size, const arc& _Arc) const;
+
+    // modifies the selected entry password, hashes it without holding the lock
+    _NODISCARD bool _Modify_entry_password(const wchar_t* const _Name, const size_t _Size,
+        const wstring_view _New_password);
+
+    // appends a new entry, hashes its password without holding the lock
+    _NODISCARD bool _Append_entry(const wchar_t* const _Account, const size_t _Size,
+        const wstring_view _Password, arc* const _Arc);
+
     // checks if the selected ARC is unique
     _NODISCARD bool _Is_unique_arc(const arc& _Arc) const noexcept;
 
     // checks if the selected salt is unique
     _NODISCARD bool _Is_unique_salt(const _Unique_salt& _Salt) const noexcept;
 
-    // generates a new ARC
-    _NODISCARD arc _Generate_unique_arc() const noexcept;
+    // tries to generate a new ARC
+    _NODISCARD bool _Generate_unique_arc(arc& _Arc) const noexcept;
+
+    // tries to generate a new salt
+    _NODISCARD bool _Generate_unique_salt(_Unique_salt& _Salt) const noexcept;
 
-    // generates a new salt
-    _NODISCARD _Unique_salt _Generate_unique_salt() const noexcept;
+    // checks if the journal should be folded into the entries
+    _NODISCARD bool _Should_compact() const noexcept;
 
-    // writes a single entry
-    _NODISCARD bool _Write_entry(const _Sudb_entry& _Entry);
+    // appends the scheduled journal records to the file
+    _NODISCARD bool _Append_journal();
+
+    // rewrites the entries and discards the journal
+    _NODISCARD bool _Compact();
 
     // saves changes into the file
     _NODISCARD bool _Flush_buffers();
 
 #ifdef _MSC_VER
 #pragma warning(push, 1)
-#pragma warning(disable : 4251) // C4251: file, _Sudb_header and std::vector require dll-interface
+#pragma warning(disable : 4251) // C4251: file, _Sudb_header, std::vector and _Digest_index require dll-interface
 #endif // _MSC_VER
     file _Myfile;
     _Sudb_header _Myheader;
-    vector<_Sudb_entry> _Myentries;
+    mutable vector<_Sudb_entry> _Myentries; // mutable, verified passwords are re-hashed
+    _Digest_index<8> _Myaccounts; // account name hash -> entry position
+    _Digest_index<64> _Myarcs; // ARC hash -> entry position
+    _Digest_index<16> _Mysalts; // salt -> entry position
+    mutable byte_string _Mypending; // journal records that have not been written yet
+    uint64_t _Myjournal_end; // offset just past the last valid journal record
+    size_t _Myjournal_records; // number of journal records stored in the file
+    argon2_params _Myparams; // parameters of new and re-hashed passwords
+    bool _Mycompact; // true if the entries must be rewritten on the next flush
     bool _Myok; // true if everything is ok
-    bool _Mychanges; // true if any data has been changed
+    mutable bool _Mychanges; // true if any data has been changed
+    mutable distributed_shared_lock _Mylock; // shared by lookups, exclusive for modifications
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif // _MSC_VER
+};
+
+// CLASS sudb_view
+class _SDSDLL_API sudb_view { // read-only SUDB file view that serves lookups from the mapped file
+private:
+    using _Unique_salt = salt<_Argon2id_default_engine<wchar_t>>;
+
+public:
+    explicit sudb_view(const path& _Target);
+    ~sudb_view() noexcept;
+
+    sudb_view() = delete;
+    sudb_view(const sudb_view&) = delete;
+    sudb_view& operator=(const sudb_view&) = delete;
+
+    // checks if everything is ok (the first call verifies the entries)
+    _NODISCARD const bool ok() const noexcept;
+
+    // maps the file again, the view must be refreshed to see the changes made by sudb_file
+    void refresh() noexcept;
+
+    // returns the number of entries
+    _NODISCARD size_t size() const noexcept;
+
+    // checks if the storage has the selected entry
+    _NODISCARD bool has_entry(const wchar_t* const _Account) const;
+    _NODISCARD bool has_entry(const wstring_view _Account) const;
+    _NODISCARD bool has_entry(const wstring& _Account) const;
+    _NODISCARD bool has_entry(const arc& _Arc) const;
+
+    // checks if the selected password is correct
+    _NODISCARD bool compare_passwords(const wchar_t* const _Account, const wchar_t* const _Password) const;
+    _NODISCARD bool compare_passwords(const wstring_view _Account, const wstring_view _Password) const;
+    _NODISCARD bool compare_passwords(const wstring& _Account, const wstring& _Password) const;
+
+    // checks if the selected ARC is correct
+    _NODISCARD bool compare_arcs(const wchar_t* const _Account, const arc& _Arc) const;
+    _NODISCARD bool compare_arcs(const wstring_view _Account, const arc& _Arc) const;
+    _NODISCARD bool compare_arcs(const wstring& _Account, const arc& _Arc) const;
+
+private:
+    // maps the file and validates the header
+    _NODISCARD bool _Map_file() noexcept;
+
+    // verifies the entries and replays the journal (once)
+    _NODISCARD bool _Verify() const noexcept;
+
+    // replays the journal on top of the mapped entries
+    _NODISCARD bool _Load_journal(const uint8_t* const _First, const size_t _Size) const;
+
+    // returns the selected entry
+    _NODISCARD const uint8_t* _Entry_at(const size_t _Pos) const noexcept;
+
+    // builds the lookup indexes (once)
+    void _Build_indexes() const;
+
+    // returns the selected entry position (-1 if not found), searches by account name
+    _NODISCARD size_t _Find_entry_by_account_name(const wchar_t* const _Name, const size_t _Size) const;
+
+    // returns the selected entry position (-1 if not found), searches by ARC
+    _NODISCARD size_t _Find_entry_by_arc(const arc& _Arc) const;
+
+#ifdef _MSC_VER
+#pragma warning(push, 1)
+#pragma warning(disable : 4251) // C4251: path, std::vector, _Digest_index and std::atomic require dll-interface
+#endif // _MSC_VER
+    path _Mypath;
+    mapped_file _Myfile;
+    const uint8_t* _Mybase; // first mapped entry
+    mutable size_t _Mycount; // number of entries
+    _Sudb_revision _Myrevision; // format revision of the mapped file
+    mutable vector<const uint8_t*> _Myrecords; // entries after replaying the journal (empty if no journal)
+    mutable _Digest_index<8> _Myaccounts; // account name hash -> entry position
+    mutable _Digest_index<64> _Myarcs; // ARC hash -> entry position
+    mutable shared_lock _Mylock; // guards the verification and building the indexes
+    mutable atomic<bool> _Myverified; // true if the entries have been verified
+    mutable atomic<bool> _Myindexed; // true if the indexes have been built
+    mutable bool _Myvalid; // true if the entries and the journal are valid (set once verified)
+    bool _Myok; // true if the header is ok
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif // _MSC_VER
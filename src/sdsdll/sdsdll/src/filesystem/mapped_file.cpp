@@ -0,0 +1,102 @@
+// mapped_file.cpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <build/sdsdll_pch.hpp>
+#include <filesystem/mapped_file.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+
+_SDSDLL_BEGIN
+// FUNCTION mapped_file constructors/destructor
+mapped_file::mapped_file() noexcept
+    : _Myhandle(), _Mymapping(nullptr), _Mydata(nullptr), _Mysize(0), _Myopen(false) {}
+
+mapped_file::mapped_file(const path& _Target) noexcept
+    : _Myhandle(), _Mymapping(nullptr), _Mydata(nullptr), _Mysize(0), _Myopen(false) {
+    (void) open(_Target);
+}
+
+mapped_file::~mapped_file() noexcept {
+    close();
+}
+
+// FUNCTION mapped_file::open
+_NODISCARD bool mapped_file::open(const path& _Target) noexcept {
+    if (_Myopen) { // some file is already mapped
+        return false;
+    }
+
+    // Note: The file is shared for reading only, other handles cannot write to it while it is mapped.
+    //       Sharing it with a writer would not help, a mapped file cannot be truncated and the mapped
+    //       size is fixed, so the file must be mapped again to see any changes.
+    _Myhandle = _Open_file_handle(_Target, file_access::read, file_share::read,
+        file_disposition::only_if_exists, file_attributes::normal, file_flags::none);
+    if (!_Myhandle) {
+        return false;
+    }
+
+    uintmax_t _Size;
+    if (!_File_size(_Myhandle, _Size) || _Size > static_cast<uintmax_t>(static_cast<size_type>(-1))) {
+        _Myhandle.close();
+        return false;
+    }
+
+    if (_Size == 0) { // empty files cannot be mapped, but there is nothing to read anyway
+        _Myopen = true;
+        return true;
+    }
+
+    _Mymapping = ::CreateFileMappingW(_Myhandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!_Mymapping) {
+        _Myhandle.close();
+        return false;
+    }
+
+    _Mydata = static_cast<const byte_type*>(::MapViewOfFile(_Mymapping, FILE_MAP_READ, 0, 0, 0));
+    if (!_Mydata) {
+        ::CloseHandle(_Mymapping);
+        _Mymapping = nullptr;
+        _Myhandle.close();
+        return false;
+    }
+
+    _Mysize = static_cast<size_type>(_Size);
+    _Myopen = true;
+    return true;
+}
+
+// FUNCTION mapped_file::is_open
+_NODISCARD bool mapped_file::is_open() const noexcept {
+    return _Myopen;
+}
+
+// FUNCTION mapped_file::close
+void mapped_file::close() noexcept {
+    if (_Mydata) {
+        ::UnmapViewOfFile(_Mydata);
+        _Mydata = nullptr;
+    }
+
+    if (_Mymapping) {
+        ::CloseHandle(_Mymapping);
+        _Mymapping = nullptr;
+    }
+
+    _Myhandle.close();
+    _Mysize = 0;
+    _Myopen = false;
+}
+
+// FUNCTION mapped_file::data
+_NODISCARD const typename mapped_file::byte_type* mapped_file::data() const noexcept {
+    return _Mydata;
+}
+
+// FUNCTION mapped_file::size
+_NODISCARD typename mapped_file::size_type mapped_file::size() const noexcept {
+    return _Mysize;
+}
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
@@ -0,0 +1,67 @@
+// mapped_file.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SDSDLL_FILESYSTEM_MAPPED_FILE_HPP_
+#define _SDSDLL_FILESYSTEM_MAPPED_FILE_HPP_
+#include <core/defs.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+#include <core/api.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem/file.hpp>
+#include <filesystem/path.hpp>
+#include <filesystem/status.hpp>
+#include <memoryapi.h>
+#include <system/handle/generic_handle.hpp>
+
+_SDSDLL_BEGIN
+// CLASS mapped_file
+class _SDSDLL_API mapped_file { // read-only view of a whole file mapped into memory
+public:
+    using byte_type = uint8_t;
+    using size_type = size_t;
+
+    mapped_file() noexcept;
+    ~mapped_file() noexcept;
+
+    explicit mapped_file(const path& _Target) noexcept;
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    // tries to map a new file (shared for reading only)
+    _NODISCARD bool open(const path& _Target) noexcept;
+
+    // checks if any file is mapped
+    _NODISCARD bool is_open() const noexcept;
+
+    // unmaps the current file (if is mapped)
+    void close() noexcept;
+
+    // returns a pointer to the mapped bytes (null if the file is empty)
+    _NODISCARD const byte_type* data() const noexcept;
+
+    // returns the size of the mapped file
+    _NODISCARD size_type size() const noexcept;
+
+private:
+#ifdef _MSC_VER
+#pragma warning(push, 1)
+#pragma warning(disable : 4251) // C4251: generic_handle_wrapper requires dll-interface
+#endif // _MSC_VER
+    generic_handle_wrapper _Myhandle; // handle to the file
+    void* _Mymapping; // handle to the file mapping (null if not mapped)
+    const byte_type* _Mydata; // first mapped byte
+    size_type _Mysize; // size of the mapped file
+    bool _Myopen; // true if the file is mapped
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif // _MSC_VER
+};
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
+#endif // _SDSDLL_FILESYSTEM_MAPPED_FILE_HPP_
@@ -52,10 +52,17 @@ _NODISCARD bool operator!=(const arc& _Left, const arc& _Right) noexcept {
 
 // FUNCTION make_arc
 _NODISCARD arc make_arc() {
+    // Note: All 20 characters are generated at once and the '-' separators are inserted
+    //       between the 5-character blocks afterwards.
+    const byte_string& _Chars = _SDSDLL random_bytes(20, random_format::number | random_format::uppercase);
+    if (_Chars.size() != 20) { // no random bytes, return an empty ARC
+        return arc{};
+    }
+
     byte_string _Bytes;
     _Bytes.reserve(arc::size);
     for (uint8_t _Blocks = 0; _Blocks < 4; ++_Blocks) {
-        _Bytes.append(_SDSDLL random_bytes(5, random_format::number | random_format::uppercase));
+        _Bytes.append(_Chars, _Blocks * 5, 5);
         if (_Blocks < 3) { // skip '-' after thel last block
             _Bytes.push_back(uint8_t{0x2D});
         }
@@ -0,0 +1,106 @@
+// distributed_lock.cpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <build/sdsdll_pch.hpp>
+#include <system/execution/distributed_lock.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+
+_SDSDLL_BEGIN
+// FUNCTION _Distributed_lock_slot
+_NODISCARD size_t _Distributed_lock_slot() noexcept {
+    // Note: The threads get the slots in turns, so that up to _Distributed_lock_slots threads
+    //       never share a counter. A thread keeps its slot, so it unlocks the counter it has locked.
+    static atomic<size_t> _Next(0);
+    thread_local const size_t _Slot = _Next.fetch_add(1, _STD memory_order_relaxed)
+                                    & (_Distributed_lock_slots - 1);
+    return _Slot;
+}
+
+// FUNCTION distributed_shared_lock constructor/destructor
+distributed_shared_lock::distributed_shared_lock() noexcept : _Myslots(), _Mywriter(_Free) {}
+
+distributed_shared_lock::~distributed_shared_lock() noexcept {}
+
+// FUNCTION distributed_shared_lock::_Wait_for_writer
+void distributed_shared_lock::_Wait_for_writer() noexcept {
+    size_t _Spin = 0;
+    for (;;) {
+        uint32_t _State = _Mywriter.load(_STD memory_order_acquire);
+        if (_State == _Free) {
+            return;
+        }
+
+        if (_Spin < _Parker_spin_count) {
+            ++_Spin;
+            ::YieldProcessor();
+        } else if (_State == _Busy || _Mywriter.compare_exchange_strong(_State, _Busy)) {
+            _SDSDLL _Futex_wait(_Mywriter, _Busy);
+        }
+    }
+}
+
+// FUNCTION distributed_shared_lock::lock_exclusive
+void distributed_shared_lock::lock_exclusive() noexcept {
+    for (;;) { // one writer at a time
+        uint32_t _Expected = _Free;
+        if (_Mywriter.compare_exchange_strong(_Expected, _Locked)) {
+            break;
+        }
+
+        _Wait_for_writer();
+    }
+
+    // Note: New readers see the writer and step back, so only the readers that are already inside
+    //       have to be drained. A counter that drops to zero while the writer is blocked wakes it.
+    for (_Slot& _Target : _Myslots) {
+        size_t _Spin = 0;
+        for (uint32_t _Readers = _Target._Readers.load(); _Readers != 0; _Readers = _Target._Readers.load()) {
+            if (_Spin < _Parker_spin_count) {
+                ++_Spin;
+                ::YieldProcessor();
+            } else {
+                _SDSDLL _Futex_wait(_Target._Readers, _Readers);
+            }
+        }
+    }
+}
+
+// FUNCTION distributed_shared_lock::unlock_exclusive
+void distributed_shared_lock::unlock_exclusive() noexcept {
+    if (_Mywriter.exchange(_Free, _STD memory_order_release) == _Busy) {
+        _SDSDLL _Futex_wake_all(_Mywriter);
+    }
+}
+
+// FUNCTION distributed_shared_lock::lock_shared
+void distributed_shared_lock::lock_shared() noexcept {
+    // Note: A reader only touches its own counter, the writer's word is just read. Both operations
+    //       are sequentially consistent, so either the reader sees the writer, or the writer sees
+    //       the reader's counter while draining. Waiting writers stop new readers, so they never starve.
+    _Slot& _Target = _Myslots[_SDSDLL _Distributed_lock_slot()];
+    for (;;) {
+        _Target._Readers.fetch_add(1);
+        if (_Mywriter.load() == _Free) {
+            return;
+        }
+
+        if (_Target._Readers.fetch_sub(1) == 1) { // step back, the writer may be draining this slot
+            _SDSDLL _Futex_wake_all(_Target._Readers);
+        }
+
+        _Wait_for_writer();
+    }
+}
+
+// FUNCTION distributed_shared_lock::unlock_shared
+void distributed_shared_lock::unlock_shared() noexcept {
+    _Slot& _Target = _Myslots[_SDSDLL _Distributed_lock_slot()];
+    if (_Target._Readers.fetch_sub(1) == 1 && _Mywriter.load() != _Free) { // the writer is draining
+        _SDSDLL _Futex_wake_all(_Target._Readers);
+    }
+}
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
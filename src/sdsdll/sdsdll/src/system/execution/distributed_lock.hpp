@@ -0,0 +1,72 @@
+// distributed_lock.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SDSDLL_SYSTEM_EXECUTION_DISTRIBUTED_LOCK_HPP_
+#define _SDSDLL_SYSTEM_EXECUTION_DISTRIBUTED_LOCK_HPP_
+#include <core/defs.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+#include <atomic>
+#include <core/api.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <system/execution/futex_lock.hpp>
+
+// STD types
+using _STD atomic;
+
+_SDSDLL_BEGIN
+// CONSTANT _Distributed_lock_slots
+inline constexpr size_t _Distributed_lock_slots = 16; // reader counters per lock, must be a power of 2
+
+// FUNCTION _Distributed_lock_slot
+extern _NODISCARD size_t _Distributed_lock_slot() noexcept;
+
+// CLASS distributed_shared_lock
+class _SDSDLL_API distributed_shared_lock { // shared/exclusive lock for read-mostly data
+public:
+    distributed_shared_lock() noexcept;
+    ~distributed_shared_lock() noexcept;
+
+    distributed_shared_lock(const distributed_shared_lock&) = delete;
+    distributed_shared_lock& operator=(const distributed_shared_lock&) = delete;
+
+    // locks the code segment (exclusive mode)
+    void lock_exclusive() noexcept;
+
+    // unlocks the code segment (exclusive mode)
+    void unlock_exclusive() noexcept;
+
+    // locks the code segment (shared mode), the same thread must unlock it
+    void lock_shared() noexcept;
+
+    // unlocks the code segment (shared mode)
+    void unlock_shared() noexcept;
+
+private:
+    enum _Writer_state : uint32_t {
+        _Free   = 0, // no writer
+        _Locked = 1, // a writer holds the lock or drains the readers
+        _Busy   = 2 // a writer holds the lock and some threads may be blocked
+    };
+
+    // Note: Each counter takes a whole cache line, so readers that use different slots never
+    //       touch the same line. The lock is not over-aligned, so that it can be embedded anywhere,
+    //       the stride alone keeps the counters apart.
+    struct _Slot {
+        atomic<uint32_t> _Readers;
+        unsigned char _Padding[64 - sizeof(atomic<uint32_t>)];
+    };
+
+    // waits until no writer holds the lock
+    void _Wait_for_writer() noexcept;
+
+    _Slot _Myslots[_Distributed_lock_slots];
+    atomic<uint32_t> _Mywriter; // read by every reader, written only by writers
+};
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
+#endif // _SDSDLL_SYSTEM_EXECUTION_DISTRIBUTED_LOCK_HPP_
@@ -0,0 +1,109 @@
+// futex_lock.cpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <build/sdsdll_pch.hpp>
+#include <system/execution/futex_lock.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+
+_SDSDLL_BEGIN
+// FUNCTION _Futex_wait
+void _Futex_wait(atomic<uint32_t>& _Word, const uint32_t _Expected) noexcept {
+    // Note: The WaitOnAddress() is the futex of Windows, it returns immediately if the word no longer
+    //       holds the expected value. All waits and wake-ups of the locks go through these functions.
+    uint32_t _Compare = _Expected;
+    ::WaitOnAddress(_SDSDLL addressof(_Word), &_Compare, sizeof(uint32_t), INFINITE);
+}
+
+// FUNCTION _Futex_wake_all
+void _Futex_wake_all(atomic<uint32_t>& _Word) noexcept {
+    ::WakeByAddressAll(_SDSDLL addressof(_Word));
+}
+
+// FUNCTION futex_shared_lock constructor/destructor
+futex_shared_lock::futex_shared_lock() noexcept : _Mystate(0) {}
+
+futex_shared_lock::~futex_shared_lock() noexcept {}
+
+// FUNCTION futex_shared_lock::_Sleep
+void futex_shared_lock::_Sleep(uint32_t _State) noexcept {
+    // Note: The sleeper announces itself in the word, so that the thread that releases the lock
+    //       knows that it has to wake somebody up. If the word changes in the meantime, the caller
+    //       tries to take the lock again instead.
+    if ((_State & _Sleepers) == 0) {
+        if (!_Mystate.compare_exchange_strong(_State, _State | _Sleepers, _STD memory_order_relaxed)) {
+            return;
+        }
+
+        _State |= _Sleepers;
+    }
+
+    _SDSDLL _Futex_wait(_Mystate, _State);
+}
+
+// FUNCTION futex_shared_lock::lock_exclusive
+void futex_shared_lock::lock_exclusive() noexcept {
+    size_t _Spin = 0;
+    for (;;) {
+        uint32_t _State = _Mystate.load(_STD memory_order_relaxed);
+        if ((_State & ~_Sleepers) == 0) { // neither readers nor a writer
+            if (_Mystate.compare_exchange_weak(_State, _State | _Exclusive, _STD memory_order_acquire)) {
+                return;
+            }
+
+            continue;
+        }
+
+        if (_Spin < _Parker_spin_count) {
+            ++_Spin;
+            ::YieldProcessor();
+        } else {
+            _Sleep(_State);
+        }
+    }
+}
+
+// FUNCTION futex_shared_lock::unlock_exclusive
+void futex_shared_lock::unlock_exclusive() noexcept {
+    if (_Mystate.exchange(0, _STD memory_order_release) & _Sleepers) {
+        _SDSDLL _Futex_wake_all(_Mystate);
+    }
+}
+
+// FUNCTION futex_shared_lock::lock_shared
+void futex_shared_lock::lock_shared() noexcept {
+    // Note: Readers enter as long as no writer holds the lock, a waiting writer does not stop them.
+    //       Use the distributed_shared_lock if writers must not starve behind a stream of readers.
+    size_t _Spin = 0;
+    for (;;) {
+        uint32_t _State = _Mystate.load(_STD memory_order_relaxed);
+        if ((_State & _Exclusive) == 0) {
+            if (_Mystate.compare_exchange_weak(_State, _State + 1, _STD memory_order_acquire)) {
+                return;
+            }
+
+            continue;
+        }
+
+        if (_Spin < _Parker_spin_count) {
+            ++_Spin;
+            ::YieldProcessor();
+        } else {
+            _Sleep(_State);
+        }
+    }
+}
+
+// FUNCTION futex_shared_lock::unlock_shared
+void futex_shared_lock::unlock_shared() noexcept {
+    // Note: Only writers may be blocked while readers hold the lock. The last reader clears
+    //       the announcement and wakes them, unless another thread has changed the word first.
+    uint32_t _State = _Mystate.fetch_sub(1, _STD memory_order_release) - 1;
+    if (_State == _Sleepers && _Mystate.compare_exchange_strong(_State, 0, _STD memory_order_relaxed)) {
+        _SDSDLL _Futex_wake_all(_Mystate);
+    }
+}
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
@@ -0,0 +1,62 @@
+// futex_lock.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SDSDLL_SYSTEM_EXECUTION_FUTEX_LOCK_HPP_
+#define _SDSDLL_SYSTEM_EXECUTION_FUTEX_LOCK_HPP_
+#include <core/defs.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+#include <atomic>
+#include <core/api.hpp>
+#include <core/traits/type_traits.hpp>
+#include <cstdint>
+#include <synchapi.h>
+#include <system/execution/parker.hpp>
+#include <WinBase.h>
+
+// STD types
+using _STD atomic;
+
+_SDSDLL_BEGIN
+// FUNCTION _Futex_wait
+extern void _Futex_wait(atomic<uint32_t>& _Word, const uint32_t _Expected) noexcept;
+
+// FUNCTION _Futex_wake_all
+extern void _Futex_wake_all(atomic<uint32_t>& _Word) noexcept;
+
+// CLASS futex_shared_lock
+class _SDSDLL_API futex_shared_lock { // shared/exclusive lock that fits in a single 32-bit word
+public:
+    futex_shared_lock() noexcept;
+    ~futex_shared_lock() noexcept;
+
+    futex_shared_lock(const futex_shared_lock&) = delete;
+    futex_shared_lock& operator=(const futex_shared_lock&) = delete;
+
+    // locks the code segment (exclusive mode)
+    void lock_exclusive() noexcept;
+
+    // unlocks the code segment (exclusive mode)
+    void unlock_exclusive() noexcept;
+
+    // locks the code segment (shared mode)
+    void lock_shared() noexcept;
+
+    // unlocks the code segment (shared mode)
+    void unlock_shared() noexcept;
+
+private:
+    static constexpr uint32_t _Exclusive = 0x8000'0000; // set while a writer holds the lock
+    static constexpr uint32_t _Sleepers  = 0x4000'0000; // set if some thread may be blocked
+
+    // blocks until the word changes, unless it has already changed
+    void _Sleep(uint32_t _State) noexcept;
+
+    atomic<uint32_t> _Mystate; // _Exclusive, _Sleepers and the number of readers
+};
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
+#endif // _SDSDLL_SYSTEM_EXECUTION_FUTEX_LOCK_HPP_
@@ -0,0 +1,130 @@
+// parallel.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SDSDLL_SYSTEM_EXECUTION_PARALLEL_HPP_
+#define _SDSDLL_SYSTEM_EXECUTION_PARALLEL_HPP_
+#include <core/defs.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+#include <cstddef>
+#include <iterator>
+#include <system/execution/shared_lock.hpp>
+#include <system/execution/thread_pool.hpp>
+#include <type_traits>
+#include <utility>
+
+_SDSDLL_BEGIN
+// STRUCT parallel_range
+struct parallel_range { // half-open range of indexes [first, last)
+    size_t first;
+    size_t last;
+};
+
+// CLASS TEMPLATE _Parallel_reduction
+template <class _Ty, class _Fn, class _Combine>
+class _Parallel_reduction { // accumulates the partial results of parallel_reduce()
+public:
+    _Parallel_reduction(const _Ty& _Identity, _Fn& _Func, _Combine& _Comb)
+        : _Myidentity(_Identity), _Myresult(_Identity), _Myfunc(_Func), _Mycomb(_Comb), _Mylock() {}
+
+    // reduces [_First, _Last) and merges it into the result
+    void _Reduce(const size_t _First, const size_t _Last) noexcept {
+        // Note: Each claimed range is reduced locally, so the lock is taken once per range,
+        //       not once per index. There are only a few ranges for each participant.
+        _Ty _Partial = _Myidentity;
+        for (size_t _Idx = _First; _Idx < _Last; ++_Idx) {
+            _Partial = _Mycomb(_STD move(_Partial), _Myfunc(_Idx));
+        }
+
+        exclusive_lock_guard _Guard(_Mylock);
+        _Myresult = _Mycomb(_STD move(_Myresult), _STD move(_Partial));
+    }
+
+    _NODISCARD _Ty _Result() noexcept {
+        return _STD move(_Myresult);
+    }
+
+private:
+    const _Ty& _Myidentity;
+    _Ty _Myresult;
+    _Fn& _Myfunc;
+    _Combine& _Mycomb;
+    shared_lock _Mylock;
+};
+
+// FUNCTION TEMPLATE parallel_for
+template <class _Fn>
+void parallel_for(thread_pool& _Pool, const parallel_range _Range, const size_t _Grain, _Fn&& _Func,
+    const task_priority _Priority = task_priority::normal) noexcept {
+    // Note: The _Func(idx) is invoked exactly once for each index in the range, the calling thread
+    //       takes part in the work. The range is split adaptively, but never into pieces smaller
+    //       than _Grain indexes (except the last one). The _Func must not throw. The helper tasks
+    //       are submitted with _Priority, interactive callers should select task_priority::high.
+    using _Func_t = _STD remove_reference_t<_Fn>;
+    _SDSDLL _Parallel_invoke_range(_Pool, _Range.first, _Range.last, _Grain,
+        [](const size_t _First, const size_t _Last, void* const _Data) noexcept {
+            _Func_t& _Func = *static_cast<_Func_t*>(_Data);
+            for (size_t _Idx = _First; _Idx < _Last; ++_Idx) {
+                _Func(_Idx);
+            }
+        }, const_cast<void*>(static_cast<const void*>(_SDSDLL addressof(_Func))), _Priority
+    );
+}
+
+template <class _Fn>
+void parallel_for(const parallel_range _Range, const size_t _Grain, _Fn&& _Func) noexcept {
+    _SDSDLL parallel_for(_SDSDLL default_thread_pool(), _Range, _Grain, _STD forward<_Fn>(_Func));
+}
+
+// FUNCTION TEMPLATE parallel_reduce
+template <class _Ty, class _Fn, class _Combine>
+_NODISCARD _Ty parallel_reduce(thread_pool& _Pool, const parallel_range _Range, const size_t _Grain,
+    const _Ty& _Identity, _Fn&& _Func, _Combine&& _Comb) {
+    // Note: Returns _Identity combined with _Func(idx) for each index in the range. The _Comb(a, b)
+    //       must be associative and commutative, the order in which the partial results are
+    //       combined is not specified. Neither the _Func nor the _Comb may throw.
+    using _Reduction_t =
+        _Parallel_reduction<_Ty, _STD remove_reference_t<_Fn>, _STD remove_reference_t<_Combine>>;
+    _Reduction_t _Reduction(_Identity, _Func, _Comb);
+    _SDSDLL _Parallel_invoke_range(_Pool, _Range.first, _Range.last, _Grain,
+        [](const size_t _First, const size_t _Last, void* const _Data) noexcept {
+            static_cast<_Reduction_t*>(_Data)->_Reduce(_First, _Last);
+        }, _SDSDLL addressof(_Reduction)
+    );
+    return _Reduction._Result();
+}
+
+template <class _Ty, class _Fn, class _Combine>
+_NODISCARD _Ty parallel_reduce(
+    const parallel_range _Range, const size_t _Grain, const _Ty& _Identity, _Fn&& _Func, _Combine&& _Comb) {
+    return _SDSDLL parallel_reduce(_SDSDLL default_thread_pool(), _Range, _Grain,
+        _Identity, _STD forward<_Fn>(_Func), _STD forward<_Combine>(_Comb));
+}
+
+// FUNCTION TEMPLATE parallel_transform
+template <class _InIt, class _OutIt, class _Fn>
+_OutIt parallel_transform(thread_pool& _Pool, const _InIt _First, const _InIt _Last,
+    const _OutIt _Dest, const size_t _Grain, _Fn&& _Func) noexcept {
+    // Note: Stores _Func(_First[idx]) in _Dest[idx], both iterators must be random-access.
+    //       Returns the end of the destination range. The _Func must not throw.
+    const size_t _Count = static_cast<size_t>(_STD distance(_First, _Last));
+    auto _Transform     = [&](const size_t _Idx) noexcept {
+        using _Diff_t = typename _STD iterator_traits<_InIt>::difference_type;
+        _Dest[static_cast<_Diff_t>(_Idx)] = _Func(_First[static_cast<_Diff_t>(_Idx)]);
+    };
+    _SDSDLL parallel_for(_Pool, parallel_range{0, _Count}, _Grain, _Transform);
+    return _STD next(_Dest, static_cast<typename _STD iterator_traits<_OutIt>::difference_type>(_Count));
+}
+
+template <class _InIt, class _OutIt, class _Fn>
+_OutIt parallel_transform(
+    const _InIt _First, const _InIt _Last, const _OutIt _Dest, const size_t _Grain, _Fn&& _Func) noexcept {
+    return _SDSDLL parallel_transform(
+        _SDSDLL default_thread_pool(), _First, _Last, _Dest, _Grain, _STD forward<_Fn>(_Func));
+}
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
+#endif // _SDSDLL_SYSTEM_EXECUTION_PARALLEL_HPP_
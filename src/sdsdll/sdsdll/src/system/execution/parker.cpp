@@ -0,0 +1,84 @@
+// parker.cpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <build/sdsdll_pch.hpp>
+#include <system/execution/parker.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+
+_SDSDLL_BEGIN
+// FUNCTION _Parker constructor/destructor
+_Parker::_Parker() noexcept : _Mystate(_Empty) {}
+
+_Parker::~_Parker() noexcept {}
+
+// FUNCTION _Parker::_Try_consume
+_NODISCARD bool _Parker::_Try_consume() noexcept {
+    uint32_t _Expected = _Notified;
+    return _Mystate.compare_exchange_strong(_Expected, _Empty, _STD memory_order_acquire);
+}
+
+// FUNCTION _Parker::_Park
+void _Parker::_Park() noexcept {
+    (void) _Park_for(INFINITE);
+}
+
+// FUNCTION _Parker::_Park_for
+_NODISCARD bool _Parker::_Park_for(const DWORD _Timeout) noexcept {
+    // Note: A wake-up that arrives shortly after the thread ran out of work is caught while
+    //       spinning, so that the thread does not have to block and wake up again.
+    for (size_t _Spin = 0; _Spin < _Parker_spin_count; ++_Spin) {
+        if (_Mystate.load(_STD memory_order_relaxed) == _Notified && _Try_consume()) {
+            return true;
+        }
+
+        ::YieldProcessor();
+    }
+
+    uint32_t _Expected = _Empty;
+    if (!_Mystate.compare_exchange_strong(_Expected, _Parked, _STD memory_order_acquire)) {
+        // Note: The only other state is _Notified, the wake-up arrived in the meantime.
+        _Mystate.store(_Empty, _STD memory_order_relaxed);
+        return true;
+    }
+
+    // Note: WaitOnAddress() returns immediately if the state has already changed, so a wake-up
+    //       that happens right before blocking is never lost. It may also return spuriously,
+    //       hence the loop.
+    const ULONGLONG _Start = ::GetTickCount64();
+    DWORD _Remaining       = _Timeout;
+    for (;;) {
+        uint32_t _Compare = _Parked;
+        ::WaitOnAddress(_SDSDLL addressof(_Mystate), &_Compare, sizeof(uint32_t), _Remaining);
+        if (_Try_consume()) {
+            return true;
+        }
+
+        if (_Timeout != INFINITE) {
+            const ULONGLONG _Elapsed = ::GetTickCount64() - _Start;
+            if (_Elapsed >= _Timeout) { // give up, unless a wake-up arrives right now
+                _Expected = _Parked;
+                if (_Mystate.compare_exchange_strong(_Expected, _Empty, _STD memory_order_acquire)) {
+                    return false;
+                }
+
+                _Mystate.store(_Empty, _STD memory_order_relaxed); // consume the wake-up
+                return true;
+            }
+
+            _Remaining = static_cast<DWORD>(_Timeout - _Elapsed);
+        }
+    }
+}
+
+// FUNCTION _Parker::_Unpark
+void _Parker::_Unpark() noexcept {
+    // Note: The kernel is entered only if the owner is actually blocked.
+    if (_Mystate.exchange(_Notified, _STD memory_order_release) == _Parked) {
+        ::WakeByAddressSingle(_SDSDLL addressof(_Mystate));
+    }
+}
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
@@ -0,0 +1,61 @@
+// parker.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SDSDLL_SYSTEM_EXECUTION_PARKER_HPP_
+#define _SDSDLL_SYSTEM_EXECUTION_PARKER_HPP_
+#include <core/defs.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+#include <atomic>
+#include <core/traits/type_traits.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <minwindef.h>
+#include <synchapi.h>
+#include <sysinfoapi.h>
+#include <WinBase.h>
+#include <winnt.h>
+
+// STD types
+using _STD atomic;
+
+_SDSDLL_BEGIN
+// CONSTANT _Parker_spin_count
+inline constexpr size_t _Parker_spin_count = 1024; // spins before the thread blocks
+
+// CLASS _Parker
+class _Parker { // parks a single thread until another thread unparks it
+public:
+    _Parker() noexcept;
+    ~_Parker() noexcept;
+
+    _Parker(const _Parker&) = delete;
+    _Parker& operator=(const _Parker&) = delete;
+
+    // waits until unparked (returns immediately if already unparked)
+    void _Park() noexcept;
+
+    // waits until unparked or _Timeout (in milliseconds) has elapsed, returns false on timeout
+    _NODISCARD bool _Park_for(const DWORD _Timeout) noexcept;
+
+    // wakes the parked thread, or makes its next _Park() return immediately
+    void _Unpark() noexcept;
+
+private:
+    enum _State : uint32_t {
+        _Empty    = 0, // no pending wake-up
+        _Parked   = 1, // the owner is blocked (or about to block)
+        _Notified = 2 // a wake-up is pending
+    };
+
+    // tries to consume a pending wake-up
+    _NODISCARD bool _Try_consume() noexcept;
+
+    atomic<uint32_t> _Mystate;
+};
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
+#endif // _SDSDLL_SYSTEM_EXECUTION_PARKER_HPP_
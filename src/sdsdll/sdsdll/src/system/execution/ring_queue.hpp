@@ -0,0 +1,343 @@
+// ring_queue.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SDSDLL_SYSTEM_EXECUTION_RING_QUEUE_HPP_
+#define _SDSDLL_SYSTEM_EXECUTION_RING_QUEUE_HPP_
+#include <core/defs.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+#include <algorithm>
+#include <atomic>
+#include <core/memory/allocator.hpp>
+#include <core/traits/type_traits.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+// STD types
+using _STD atomic;
+
+_SDSDLL_BEGIN
+// CONSTANT _Ring_queue_cache_line
+inline constexpr size_t _Ring_queue_cache_line = 64;
+
+// FUNCTION _Ring_queue_capacity
+inline constexpr size_t _Ring_queue_capacity(const size_t _Requested) noexcept {
+    // Note: The capacity is rounded up to a power of 2, so that an index can be masked instead
+    //       of divided. The largest power of 2 that fits in size_t is the upper limit.
+    size_t _Capacity = 2;
+    while (_Capacity < _Requested && _Capacity <= (static_cast<size_t>(-1) >> 1)) {
+        _Capacity <<= 1;
+    }
+
+    return _Capacity;
+}
+
+// STRUCT TEMPLATE _Ring_queue_index
+template <class _Ty>
+struct _Ring_queue_index { // index that occupies its own cache line
+    atomic<_Ty> _Value;
+    unsigned char _Padding[_Ring_queue_cache_line - sizeof(atomic<_Ty>)];
+};
+
+// CLASS TEMPLATE mpmc_ring_queue
+template <class _Ty>
+class mpmc_ring_queue { // bounded lock-free queue for any number of producers and consumers
+public:
+    static_assert(is_nothrow_move_constructible_v<_Ty> && is_nothrow_destructible_v<_Ty>,
+        "mpmc_ring_queue<T> requires T to be nothrow move constructible and nothrow destructible.");
+
+    using value_type = _Ty;
+    using size_type  = size_t;
+
+    explicit mpmc_ring_queue(const size_type _Capacity) noexcept
+        : _Mycells(nullptr), _Mymask(0), _Myenqueue(), _Mydequeue() {
+        // Note: The cells are allocated once, the queue never allocates afterwards. If the allocation
+        //       fails, the queue has no capacity and every push fails.
+        const size_type _Count = _Ring_queue_capacity(_Capacity);
+        _Mycells               = allocator<_Cell>{}.allocate(_Count);
+        if (_Mycells) {
+            _Mymask = _Count - 1;
+            for (size_type _Idx = 0; _Idx < _Count; ++_Idx) {
+                ::new (static_cast<void*>(_Mycells + _Idx)) _Cell;
+                _Mycells[_Idx]._Sequence.store(_Idx, _STD memory_order_relaxed);
+            }
+        }
+
+        _Myenqueue._Value.store(0, _STD memory_order_relaxed);
+        _Mydequeue._Value.store(0, _STD memory_order_relaxed);
+    }
+
+    ~mpmc_ring_queue() noexcept {
+        if (_Mycells) {
+            clear();
+            allocator<_Cell>{}.deallocate(_Mycells, _Mymask + 1);
+        }
+    }
+
+    mpmc_ring_queue(const mpmc_ring_queue&) = delete;
+    mpmc_ring_queue& operator=(const mpmc_ring_queue&) = delete;
+
+    _NODISCARD size_type capacity() const noexcept {
+        return _Mycells ? _Mymask + 1 : 0;
+    }
+
+    _NODISCARD size_type size() const noexcept {
+        // Note: Only a snapshot, both indexes may change at any time.
+        const size_type _Dequeue = _Mydequeue._Value.load(_STD memory_order_acquire);
+        const size_type _Enqueue = _Myenqueue._Value.load(_STD memory_order_acquire);
+        return _Enqueue > _Dequeue ? (_STD min)(_Enqueue - _Dequeue, capacity()) : 0;
+    }
+
+    _NODISCARD bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    _NODISCARD bool full() const noexcept {
+        return size() == capacity();
+    }
+
+    void clear() noexcept {
+        _Ty _Val;
+        while (try_pop(_Val)) {
+        }
+    }
+
+    _NODISCARD bool try_push(const _Ty& _Val) noexcept(is_nothrow_copy_constructible_v<_Ty>) {
+        _Ty _Copy = _Val;
+        return try_push(_STD move(_Copy));
+    }
+
+    _NODISCARD bool try_push(_Ty&& _Val) noexcept {
+        return _Push_range(_SDSDLL addressof(_Val), 1) == 1;
+    }
+
+    _NODISCARD bool try_pop(_Ty& _Val) noexcept {
+        return _Pop_range(_SDSDLL addressof(_Val), 1) == 1;
+    }
+
+    _NODISCARD size_type try_push_bulk(_Ty* const _First, const size_type _Count) noexcept {
+        // Note: Moves at most _Count values from [_First, _First + _Count) using a single claim,
+        //       returns the number of moved values.
+        return _Push_range(_First, _Count);
+    }
+
+    _NODISCARD size_type try_pop_bulk(_Ty* const _First, const size_type _Count) noexcept {
+        // Note: Moves at most _Count values to [_First, _First + _Count) using a single claim,
+        //       returns the number of moved values.
+        return _Pop_range(_First, _Count);
+    }
+
+private:
+    struct _Cell {
+        atomic<size_type> _Sequence; // the cell is free for the enqueue position _Sequence,
+                                     // and filled for the dequeue position _Sequence - 1
+        alignas(_Ty) unsigned char _Storage[sizeof(_Ty)];
+
+        _NODISCARD _Ty* _Get() noexcept {
+            return reinterpret_cast<_Ty*>(_Storage);
+        }
+    };
+
+    _NODISCARD size_type _Claim(_Ring_queue_index<size_type>& _Index,
+        const size_type _Count, const size_type _Offset, size_type& _Position) noexcept {
+        // Note: Claims up to _Count consecutive cells whose sequence is equal to the position
+        //       (plus _Offset). A ready cell can only change once it is claimed, and the claim
+        //       requires the position to be advanced, so the cells stay ready until the CAS below.
+        if (!_Mycells || _Count == 0) {
+            return 0;
+        }
+
+        size_type _Pos = _Index._Value.load(_STD memory_order_relaxed);
+        for (;;) {
+            size_type _Ready = 0;
+            intptr_t _Diff   = 0;
+            for (; _Ready < _Count; ++_Ready) {
+                const size_type _Sequence =
+                    _Mycells[(_Pos + _Ready) & _Mymask]._Sequence.load(_STD memory_order_acquire);
+                _Diff = static_cast<intptr_t>(_Sequence) - static_cast<intptr_t>(_Pos + _Ready + _Offset);
+                if (_Diff != 0) {
+                    break;
+                }
+            }
+
+            if (_Ready == 0) {
+                if (_Diff < 0) { // full (push) or empty (pop)
+                    return 0;
+                }
+
+                _Pos = _Index._Value.load(_STD memory_order_relaxed); // another thread was faster, retry
+                continue;
+            }
+
+            if (_Index._Value.compare_exchange_weak(
+                _Pos, _Pos + _Ready, _STD memory_order_relaxed, _STD memory_order_relaxed)) {
+                _Position = _Pos;
+                return _Ready;
+            }
+        }
+    }
+
+    _NODISCARD size_type _Push_range(_Ty* const _First, const size_type _Count) noexcept {
+        size_type _Pos         = 0;
+        const size_type _Ready = _Claim(_Myenqueue, _Count, 0, _Pos);
+        for (size_type _Idx = 0; _Idx < _Ready; ++_Idx) {
+            _Cell& _Target = _Mycells[(_Pos + _Idx) & _Mymask];
+            ::new (static_cast<void*>(_Target._Storage)) _Ty(_STD move(_First[_Idx]));
+            _Target._Sequence.store(_Pos + _Idx + 1, _STD memory_order_release);
+        }
+
+        return _Ready;
+    }
+
+    _NODISCARD size_type _Pop_range(_Ty* const _First, const size_type _Count) noexcept {
+        size_type _Pos         = 0;
+        const size_type _Ready = _Claim(_Mydequeue, _Count, 1, _Pos);
+        for (size_type _Idx = 0; _Idx < _Ready; ++_Idx) {
+            _Cell& _Source = _Mycells[(_Pos + _Idx) & _Mymask];
+            _First[_Idx]   = _STD move(*_Source._Get());
+            _Source._Get()->~_Ty();
+            _Source._Sequence.store(_Pos + _Idx + _Mymask + 1, _STD memory_order_release);
+        }
+
+        return _Ready;
+    }
+
+    _Cell* _Mycells;
+    size_type _Mymask;
+    unsigned char _Padding[_Ring_queue_cache_line - sizeof(_Cell*) - sizeof(size_type)];
+    _Ring_queue_index<size_type> _Myenqueue; // next position to be filled
+    _Ring_queue_index<size_type> _Mydequeue; // next position to be emptied
+};
+
+// CLASS TEMPLATE spsc_ring_queue
+template <class _Ty>
+class spsc_ring_queue { // bounded lock-free queue for one producer and one consumer
+public:
+    static_assert(is_nothrow_move_constructible_v<_Ty> && is_nothrow_destructible_v<_Ty>,
+        "spsc_ring_queue<T> requires T to be nothrow move constructible and nothrow destructible.");
+
+    using value_type = _Ty;
+    using size_type  = size_t;
+
+    explicit spsc_ring_queue(const size_type _Capacity) noexcept
+        : _Myslots(nullptr), _Mymask(0), _Myhead(), _Mycached_tail(0), _Mytail(), _Mycached_head(0) {
+        // Note: The slots are allocated once, the queue never allocates afterwards. If the allocation
+        //       fails, the queue has no capacity and every push fails.
+        const size_type _Count = _Ring_queue_capacity(_Capacity);
+        _Myslots               = allocator<_Slot>{}.allocate(_Count);
+        if (_Myslots) {
+            _Mymask = _Count - 1;
+        }
+
+        _Myhead._Value.store(0, _STD memory_order_relaxed);
+        _Mytail._Value.store(0, _STD memory_order_relaxed);
+    }
+
+    ~spsc_ring_queue() noexcept {
+        if (_Myslots) {
+            clear();
+            allocator<_Slot>{}.deallocate(_Myslots, _Mymask + 1);
+        }
+    }
+
+    spsc_ring_queue(const spsc_ring_queue&) = delete;
+    spsc_ring_queue& operator=(const spsc_ring_queue&) = delete;
+
+    _NODISCARD size_type capacity() const noexcept {
+        return _Myslots ? _Mymask + 1 : 0;
+    }
+
+    _NODISCARD size_type size() const noexcept {
+        const size_type _Head = _Myhead._Value.load(_STD memory_order_acquire);
+        const size_type _Tail = _Mytail._Value.load(_STD memory_order_acquire);
+        return _Tail > _Head ? _Tail - _Head : 0;
+    }
+
+    _NODISCARD bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    _NODISCARD bool full() const noexcept {
+        return size() == capacity();
+    }
+
+    void clear() noexcept { // consumer only
+        _Ty _Val;
+        while (try_pop(_Val)) {
+        }
+    }
+
+    _NODISCARD bool try_push(const _Ty& _Val) noexcept(is_nothrow_copy_constructible_v<_Ty>) {
+        _Ty _Copy = _Val;
+        return try_push(_STD move(_Copy));
+    }
+
+    _NODISCARD bool try_push(_Ty&& _Val) noexcept { // producer only
+        return try_push_bulk(_SDSDLL addressof(_Val), 1) == 1;
+    }
+
+    _NODISCARD bool try_pop(_Ty& _Val) noexcept { // consumer only
+        return try_pop_bulk(_SDSDLL addressof(_Val), 1) == 1;
+    }
+
+    _NODISCARD size_type try_push_bulk(_Ty* const _First, size_type _Count) noexcept { // producer only
+        // Note: The consumer's index is read again only if the cached one says that the queue is full.
+        const size_type _Tail = _Mytail._Value.load(_STD memory_order_relaxed);
+        if (_Tail - _Mycached_head + _Count > capacity()) {
+            _Mycached_head = _Myhead._Value.load(_STD memory_order_acquire);
+        }
+
+        _Count = (_STD min)(_Count, capacity() - (_Tail - _Mycached_head));
+        for (size_type _Idx = 0; _Idx < _Count; ++_Idx) {
+            _Slot& _Target = _Myslots[(_Tail + _Idx) & _Mymask];
+            ::new (static_cast<void*>(_Target._Storage)) _Ty(_STD move(_First[_Idx]));
+        }
+
+        _Mytail._Value.store(_Tail + _Count, _STD memory_order_release);
+        return _Count;
+    }
+
+    _NODISCARD size_type try_pop_bulk(_Ty* const _First, size_type _Count) noexcept { // consumer only
+        // Note: The producer's index is read again only if the cached one says that the queue is empty.
+        const size_type _Head = _Myhead._Value.load(_STD memory_order_relaxed);
+        if (_Mycached_tail - _Head < _Count) {
+            _Mycached_tail = _Mytail._Value.load(_STD memory_order_acquire);
+        }
+
+        _Count = (_STD min)(_Count, _Mycached_tail - _Head);
+        for (size_type _Idx = 0; _Idx < _Count; ++_Idx) {
+            _Ty* const _Source = _Myslots[(_Head + _Idx) & _Mymask]._Get();
+            _First[_Idx]       = _STD move(*_Source);
+            _Source->~_Ty();
+        }
+
+        _Myhead._Value.store(_Head + _Count, _STD memory_order_release);
+        return _Count;
+    }
+
+private:
+    struct _Slot {
+        alignas(_Ty) unsigned char _Storage[sizeof(_Ty)];
+
+        _NODISCARD _Ty* _Get() noexcept {
+            return reinterpret_cast<_Ty*>(_Storage);
+        }
+    };
+
+    _Slot* _Myslots;
+    size_type _Mymask;
+    unsigned char _Padding[_Ring_queue_cache_line - sizeof(_Slot*) - sizeof(size_type)];
+    _Ring_queue_index<size_type> _Myhead; // next position to be emptied (written by the consumer)
+    size_type _Mycached_tail; // consumer's copy of the tail
+    unsigned char _Head_padding[_Ring_queue_cache_line - sizeof(size_type)];
+    _Ring_queue_index<size_type> _Mytail; // next position to be filled (written by the producer)
+    size_type _Mycached_head; // producer's copy of the head
+};
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
+#endif // _SDSDLL_SYSTEM_EXECUTION_RING_QUEUE_HPP_
@@ -35,23 +35,8 @@ void shared_lock::unlock_shared() noexcept {
     ::ReleaseSRWLockShared(_SDSDLL addressof(_Myhandle));
 }
 
-// FUNCTION shared_lock_guard copy constructor/destructor
-shared_lock_guard::shared_lock_guard(shared_lock& _Lock) noexcept : _Mylock(_Lock) {
-    _Mylock.lock_shared();
-}
-
-shared_lock_guard::~shared_lock_guard() noexcept {
-    _Mylock.unlock_shared();
-}
-
-// FUNCTION exclusive_lock_guard copy constructor/destructor
-exclusive_lock_guard::exclusive_lock_guard(shared_lock& _Lock) noexcept : _Mylock(_Lock) {
-    _Mylock.lock_exclusive();
-}
-
-exclusive_lock_guard::~exclusive_lock_guard() noexcept {
-    _Mylock.unlock_exclusive();
-}
+template class _SDSDLL_API shared_lock_guard<shared_lock>;
+template class _SDSDLL_API exclusive_lock_guard<shared_lock>;
 _SDSDLL_END
 
 #endif // _SDSDLL_PREPROCESSOR_GUARD
\ No newline at end of file
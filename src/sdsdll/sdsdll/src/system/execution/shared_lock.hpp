@@ -38,33 +38,50 @@ private:
     SRWLOCK _Myhandle;
 };
 
-// CLASS shared_lock_guard
-class _SDSDLL_API shared_lock_guard { // locks the code segment for multiple threads
+// CLASS TEMPLATE shared_lock_guard
+template <class _Lock = shared_lock>
+class shared_lock_guard { // locks the code segment for multiple threads
 public:
-    shared_lock_guard(shared_lock& _Lock) noexcept;
-    ~shared_lock_guard() noexcept;
+    shared_lock_guard(_Lock& _Lock_ref) noexcept : _Mylock(_Lock_ref) {
+        _Mylock.lock_shared();
+    }
+
+    ~shared_lock_guard() noexcept {
+        _Mylock.unlock_shared();
+    }
 
     shared_lock_guard() = delete;
     shared_lock_guard(const shared_lock_guard&) = delete;
     shared_lock_guard& operator=(const shared_lock_guard&) = delete;
 
 private:
-    shared_lock& _Mylock;
+    _Lock& _Mylock;
 };
 
-// CLASS exclusive_lock_guard
-class _SDSDLL_API exclusive_lock_guard { // locks the code segment for exactly one thread
+// CLASS TEMPLATE exclusive_lock_guard
+template <class _Lock = shared_lock>
+class exclusive_lock_guard { // locks the code segment for exactly one thread
 public:
-    exclusive_lock_guard(shared_lock& _Lock) noexcept;
-    ~exclusive_lock_guard() noexcept;
+    exclusive_lock_guard(_Lock& _Lock_ref) noexcept : _Mylock(_Lock_ref) {
+        _Mylock.lock_exclusive();
+    }
+
+    ~exclusive_lock_guard() noexcept {
+        _Mylock.unlock_exclusive();
+    }
 
     exclusive_lock_guard() = delete;
     exclusive_lock_guard(const exclusive_lock_guard&) = delete;
     exclusive_lock_guard& operator=(const exclusive_lock_guard&) = delete;
 
 private:
-    shared_lock& _Mylock;
+    _Lock& _Mylock;
 };
+
+#ifndef SDSDLL_EXPORTS // the guards of shared_lock are instantiated and exported by the library
+extern template class _SDSDLL_API shared_lock_guard<shared_lock>;
+extern template class _SDSDLL_API exclusive_lock_guard<shared_lock>;
+#endif // SDSDLL_EXPORTS
 _SDSDLL_END
 
 #endif // _SDSDLL_PREPROCESSOR_GUARD
@@ -19,13 +19,14 @@ using _STD list;
 
 _SDSDLL_BEGIN
 // CLASS TEMPLATE shared_queue
-template <class _Ty, class _Cont = list<_Ty>>
+template <class _Ty, class _Cont = list<_Ty>, class _Lock = shared_lock>
 class shared_queue {
 public:
     using value_type      = _Ty;
     using size_type       = typename _Cont::size_type;
     using difference_type = typename _Cont::difference_type;
     using container_type  = _Cont;
+    using lock_type       = _Lock;
 
     shared_queue() noexcept(is_nothrow_default_constructible_v<_Cont>) : _Mycont(), _Mylock() {}
 
@@ -112,7 +113,7 @@ public:
 
 private:
     _Cont _Mycont;
-    mutable shared_lock _Mylock;
+    mutable _Lock _Mylock;
 };
 _SDSDLL_END
 
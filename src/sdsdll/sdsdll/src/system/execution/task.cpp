@@ -0,0 +1,138 @@
+// task.cpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <build/sdsdll_pch.hpp>
+#include <system/execution/task.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+
+_SDSDLL_BEGIN
+// FUNCTION _Task_block_pool constructor/destructor
+_Task_block_pool::_Task_block_pool() noexcept : _Myblocks(_Task_block_cache_size) {}
+
+_Task_block_pool::~_Task_block_pool() noexcept {
+    void* _Block;
+    while (_Myblocks.try_pop(_Block)) {
+        allocator<void>{}.deallocate(_Block, _Task_block_size);
+    }
+}
+
+// FUNCTION _Task_block_pool::_Allocate
+_NODISCARD void* _Task_block_pool::_Allocate() noexcept {
+    void* _Block;
+    return _Myblocks.try_pop(_Block) ? _Block : allocator<void>{}.allocate(_Task_block_size);
+}
+
+// FUNCTION _Task_block_pool::_Free
+void _Task_block_pool::_Free(void* const _Block) noexcept {
+    if (!_Myblocks.try_push(_Block)) { // the cache is full
+        allocator<void>{}.deallocate(_Block, _Task_block_size);
+    }
+}
+
+// FUNCTION _Global_task_block_pool
+_NODISCARD _Task_block_pool& _Global_task_block_pool() noexcept {
+    // Note: The pool is never destroyed, because a task may finish during the static destruction,
+    //       after a function-local static would have been destroyed.
+    alignas(_Task_block_pool) static unsigned char _Storage[sizeof(_Task_block_pool)];
+    static _Task_block_pool* const _Pool = ::new (static_cast<void*>(_Storage)) _Task_block_pool;
+    return *_Pool;
+}
+
+// FUNCTION _Task_state_base constructor/destructor
+_Task_state_base::_Task_state_base(const _Destroy_t _Destroy) noexcept
+    : _Mystatus(_Pending), _Myrefs(2), _Mydestroy(_Destroy) {}
+
+_Task_state_base::~_Task_state_base() noexcept {}
+
+// FUNCTION _Task_state_base::_Ready
+_NODISCARD bool _Task_state_base::_Ready() const noexcept {
+    return _Mystatus.load(_STD memory_order_acquire) >= _Completed;
+}
+
+// FUNCTION _Task_state_base::_Expired
+_NODISCARD bool _Task_state_base::_Expired() const noexcept {
+    return _Mystatus.load(_STD memory_order_acquire) == _Dropped;
+}
+
+// FUNCTION _Task_state_base::_Block
+void _Task_state_base::_Block(const DWORD _Timeout) noexcept {
+    // Note: The status is switched to _Awaited first, so that _Complete() knows that it has to wake
+    //       somebody up. WaitOnAddress() returns immediately if the status has already changed.
+    uint32_t _Expected = _Pending;
+    if (!_Mystatus.compare_exchange_strong(_Expected, _Awaited) && _Expected >= _Completed) {
+        return;
+    }
+
+    uint32_t _Compare = _Awaited;
+    ::WaitOnAddress(_SDSDLL addressof(_Mystatus), &_Compare, sizeof(uint32_t), _Timeout);
+}
+
+// FUNCTION _Task_state_base::_Wait
+void _Task_state_base::_Wait() noexcept {
+    for (size_t _Spin = 0; _Spin < _Parker_spin_count; ++_Spin) {
+        if (_Ready()) {
+            return;
+        }
+
+        ::YieldProcessor();
+    }
+
+    // Note: A worker of a work-stealing thread-pool keeps running other tasks while it waits,
+    //       the awaited task may be sitting in its own deque. Likewise, a thread of a per-thread
+    //       thread-pool runs the tasks queued on it, the awaited task may have been assigned to it.
+    //       Both block only briefly, because new tasks do not wake them up.
+    const _Work_stealing_context& _Context = _SDSDLL _Current_work_stealing_context();
+    _Thread_task_storage* const _Storage   = _SDSDLL _Current_thread_task_storage();
+    while (!_Ready()) {
+        if (_Context._Scheduler) {
+            if (!_Context._Scheduler->_Run_one(*_Context._Worker)) {
+                _Block(1);
+            }
+        } else if (_Storage) {
+            if (!_SDSDLL _Run_thread_task(*_Storage)) {
+                _Block(1);
+            }
+        } else {
+            _Block(INFINITE);
+        }
+    }
+}
+
+// FUNCTION _Task_state_base::_Finish
+void _Task_state_base::_Finish(const _Status _New_status) noexcept {
+    if (_Mystatus.exchange(_New_status, _STD memory_order_acq_rel) == _Awaited) {
+        ::WakeByAddressAll(_SDSDLL addressof(_Mystatus));
+    }
+}
+
+// FUNCTION _Task_state_base::_Complete
+void _Task_state_base::_Complete() noexcept {
+    _Finish(_Completed);
+}
+
+// FUNCTION _Task_state_base::_Expire
+void _Task_state_base::_Expire() noexcept {
+    _Finish(_Dropped);
+}
+
+// FUNCTION _Task_state_base::_Release
+void _Task_state_base::_Release() noexcept {
+    if (_Myrefs.fetch_sub(1, _STD memory_order_acq_rel) == 1) { // last owner, destroy the state
+        (*_Mydestroy)(this);
+    }
+}
+
+// FUNCTION _Task_state_base::_Allocate_block
+_NODISCARD void* _Task_state_base::_Allocate_block() noexcept {
+    return _SDSDLL _Global_task_block_pool()._Allocate();
+}
+
+// FUNCTION _Task_state_base::_Free_block
+void _Task_state_base::_Free_block(void* const _Block) noexcept {
+    _SDSDLL _Global_task_block_pool()._Free(_Block);
+}
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
@@ -0,0 +1,359 @@
+// task.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SDSDLL_SYSTEM_EXECUTION_TASK_HPP_
+#define _SDSDLL_SYSTEM_EXECUTION_TASK_HPP_
+#include <core/defs.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+#include <atomic>
+#include <core/api.hpp>
+#include <core/memory/allocator.hpp>
+#include <core/traits/type_traits.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <minwindef.h>
+#include <new>
+#include <synchapi.h>
+#include <system/execution/parker.hpp>
+#include <system/execution/ring_queue.hpp>
+#include <system/execution/work_stealing.hpp>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <WinBase.h>
+#include <winnt.h>
+
+// STD types
+using _STD atomic;
+
+_SDSDLL_BEGIN
+// CONSTANT _Task_block_size
+inline constexpr size_t _Task_block_size = 128; // task states that fit in a block are never heap-allocated
+
+// CONSTANT _Task_block_cache_size
+inline constexpr size_t _Task_block_cache_size = 1024; // free blocks kept for reuse
+
+// CLASS _Task_block_pool
+class _Task_block_pool { // recycles the memory blocks of small task states
+public:
+    _Task_block_pool() noexcept;
+    ~_Task_block_pool() noexcept;
+
+    _Task_block_pool(const _Task_block_pool&) = delete;
+    _Task_block_pool& operator=(const _Task_block_pool&) = delete;
+
+    // returns a free block (allocates one only if none is cached)
+    _NODISCARD void* _Allocate() noexcept;
+
+    // caches the block (frees it only if the cache is full)
+    void _Free(void* const _Block) noexcept;
+
+private:
+    mpmc_ring_queue<void*> _Myblocks; // free blocks
+};
+
+// FUNCTION _Global_task_block_pool
+extern _NODISCARD _Task_block_pool& _Global_task_block_pool() noexcept;
+
+// CLASS _Task_state_base
+class _SDSDLL_API _Task_state_base { // completion state shared by a task and its future
+public:
+    using _Destroy_t = void(__stdcall*)(_Task_state_base* const) noexcept;
+
+    explicit _Task_state_base(const _Destroy_t _Destroy) noexcept;
+    ~_Task_state_base() noexcept;
+
+    _Task_state_base(const _Task_state_base&) = delete;
+    _Task_state_base& operator=(const _Task_state_base&) = delete;
+
+    // checks if the task has finished (or expired)
+    _NODISCARD bool _Ready() const noexcept;
+
+    // checks if the task was dropped without running
+    _NODISCARD bool _Expired() const noexcept;
+
+    // waits until the task has finished (or expired)
+    void _Wait() noexcept;
+
+    // marks the task as finished and wakes the waiting threads
+    void _Complete() noexcept;
+
+    // marks the task as dropped and wakes the waiting threads
+    void _Expire() noexcept;
+
+    // drops one reference, the last one destroys the state
+    void _Release() noexcept;
+
+    // returns a block of _Task_block_size bytes
+    _NODISCARD static void* _Allocate_block() noexcept;
+
+    // returns the block to the pool
+    static void _Free_block(void* const _Block) noexcept;
+
+private:
+    enum _Status : uint32_t {
+        _Pending   = 0, // the task has not finished yet
+        _Awaited   = 1, // the task has not finished yet, some thread is blocked on it
+        _Completed = 2, // the task has finished
+        _Dropped   = 3 // the task was dropped without running
+    };
+
+    // sets the final status and wakes the waiting threads
+    void _Finish(const _Status _New_status) noexcept;
+
+    // blocks until the task has finished or _Timeout (in milliseconds) has elapsed
+    void _Block(const DWORD _Timeout) noexcept;
+
+    atomic<uint32_t> _Mystatus;
+    atomic<uint32_t> _Myrefs; // the task and its future
+    _Destroy_t _Mydestroy;
+};
+
+// CLASS TEMPLATE _Task_result_state
+template <class _Ty>
+class _Task_result_state : public _Task_state_base { // stores the result of a task
+public:
+    explicit _Task_result_state(const _Destroy_t _Destroy) noexcept
+        : _Task_state_base(_Destroy), _Myhas_value(false) {}
+
+    ~_Task_result_state() noexcept {
+        if (_Myhas_value) {
+            reinterpret_cast<_Ty*>(_Mystorage)->~_Ty();
+        }
+    }
+
+    template <class _Val>
+    void _Set_value(_Val&& _Value) noexcept {
+        ::new (static_cast<void*>(_Mystorage)) _Ty(_STD forward<_Val>(_Value));
+        _Myhas_value = true;
+    }
+
+    _NODISCARD _Ty _Take_value() noexcept {
+        return _STD move(*reinterpret_cast<_Ty*>(_Mystorage));
+    }
+
+private:
+    alignas(_Ty) unsigned char _Mystorage[sizeof(_Ty)];
+    bool _Myhas_value;
+};
+
+template <>
+class _Task_result_state<void> : public _Task_state_base { // no result to store
+public:
+    explicit _Task_result_state(const _Destroy_t _Destroy) noexcept : _Task_state_base(_Destroy) {}
+
+    ~_Task_result_state() noexcept {}
+
+    void _Take_value() noexcept {}
+};
+
+// CLASS TEMPLATE _Task_state
+template <class _Ty, class _Fn, class... _Types>
+class _Task_state : public _Task_result_state<_Ty> { // stores the callable, its arguments and the result
+public:
+    template <class _Fx, class... _Args>
+    explicit _Task_state(_Fx&& _Func, _Args&&... _Vals)
+        : _Task_result_state<_Ty>(&_Destroy),
+          _Mycall(_STD forward<_Fx>(_Func), _STD forward<_Args>(_Vals)...) {}
+
+    ~_Task_state() noexcept {}
+
+    // the small states share fixed-size blocks, the large ones are allocated on their own
+    static constexpr bool _Small = sizeof(_Task_state) <= _Task_block_size
+                                && alignof(_Task_state) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    template <class... _Args>
+    _NODISCARD static _Task_state* _Create(_Args&&... _Vals) {
+        void* const _Raw = _Small ? _Task_state_base::_Allocate_block()
+                                  : static_cast<void*>(allocator<_Task_state>{}.allocate(1));
+        if (!_Raw) { // allocation failed
+            return nullptr;
+        }
+
+        try {
+            return ::new (_Raw) _Task_state(_STD forward<_Args>(_Vals)...);
+        } catch (...) {
+            _Free(_Raw);
+            throw;
+        }
+    }
+
+    static void __stdcall _Run(void* const _Data) noexcept {
+        // Note: The callable must not throw, an exception that escapes it terminates the program,
+        //       just like one that escapes a plain task.
+        _Task_state* const _State = static_cast<_Task_state*>(_Data);
+        if constexpr (_STD is_void_v<_Ty>) {
+            _STD apply(_Invoke, _State->_Mycall);
+        } else {
+            _State->_Set_value(_STD apply(_Invoke, _State->_Mycall));
+        }
+
+        _State->_Complete();
+        _State->_Release();
+    }
+
+    static void __stdcall _Drop(void* const _Data) noexcept {
+        // Note: The task will never run, so its reference is dropped here.
+        _Task_state* const _State = static_cast<_Task_state*>(_Data);
+        _State->_Expire();
+        _State->_Release();
+    }
+
+private:
+    static constexpr auto _Invoke = [](_Fn& _Func, _Types&... _Vals) -> _Ty {
+        return _STD invoke(_STD move(_Func), _STD move(_Vals)...);
+    };
+
+    static void _Free(void* const _Raw) noexcept {
+        if constexpr (_Small) {
+            _Task_state_base::_Free_block(_Raw);
+        } else {
+            allocator<_Task_state>{}.deallocate(static_cast<_Task_state*>(_Raw), 1);
+        }
+    }
+
+    static void __stdcall _Destroy(_Task_state_base* const _Base) noexcept {
+        _Task_state* const _State = static_cast<_Task_state*>(_Base);
+        _State->~_Task_state();
+        _Free(_State);
+    }
+
+    _STD tuple<_Fn, _Types...> _Mycall;
+};
+
+// ALIAS TEMPLATE _Task_result_t
+template <class _Fn, class... _Types>
+using _Task_result_t = _STD invoke_result_t<_STD decay_t<_Fn>, _STD decay_t<_Types>...>;
+
+class thread_pool;
+
+// CLASS TEMPLATE task_future
+template <class _Ty>
+class task_future { // move-only handle to the result of a submitted task
+public:
+    task_future() noexcept : _Mystate(nullptr) {}
+
+    task_future(task_future&& _Other) noexcept : _Mystate(_Other._Mystate) {
+        _Other._Mystate = nullptr;
+    }
+
+    ~task_future() noexcept {
+        _Tidy();
+    }
+
+    task_future& operator=(task_future&& _Other) noexcept {
+        if (this != _SDSDLL addressof(_Other)) {
+            _Tidy();
+            _Mystate        = _Other._Mystate;
+            _Other._Mystate = nullptr;
+        }
+
+        return *this;
+    }
+
+    task_future(const task_future&) = delete;
+    task_future& operator=(const task_future&) = delete;
+
+    // checks if the future refers to a task
+    _NODISCARD bool valid() const noexcept {
+        return _Mystate != nullptr;
+    }
+
+    // checks if the task has finished (or expired)
+    _NODISCARD bool ready() const noexcept {
+        return _Mystate && _Mystate->_Ready();
+    }
+
+    // checks if the task was dropped without running (its deadline had passed or the thread-pool closed)
+    _NODISCARD bool expired() const noexcept {
+        return _Mystate && _Mystate->_Expired();
+    }
+
+    // waits until the task has finished (or expired)
+    void wait() const noexcept {
+        if (_Mystate) {
+            _Mystate->_Wait();
+        }
+    }
+
+    // waits until the task has finished and returns its result (the future becomes invalid)
+    _Ty get() noexcept {
+        // Note: The future must be valid, use valid() if the submission might have failed.
+        //       A dropped task has no result, so get() terminates the program if the task was
+        //       dropped. Use try_get() if the task has a deadline or the thread-pool may be closed
+        //       before it runs.
+        _Mystate->_Wait();
+        if (_Mystate->_Expired()) { // no result to return
+            _STD terminate();
+        }
+
+        return _Take();
+    }
+
+    // waits until the task has finished and stores its result in _Result (the future becomes invalid),
+    // fails if the task was dropped (_Result is left untouched)
+    template <class _Uty = _Ty, _STD enable_if_t<!_STD is_void_v<_Uty>, int> = 0>
+    _NODISCARD bool try_get(_Uty& _Result) noexcept {
+        if (!_Mystate) {
+            return false;
+        }
+
+        _Mystate->_Wait();
+        if (_Mystate->_Expired()) { // no result to store
+            _Tidy();
+            return false;
+        }
+
+        _Result = _Take();
+        return true;
+    }
+
+    // waits until the task has finished (the future becomes invalid), fails if the task was dropped
+    template <class _Uty = _Ty, _STD enable_if_t<_STD is_void_v<_Uty>, int> = 0>
+    _NODISCARD bool try_get() noexcept {
+        if (!_Mystate) {
+            return false;
+        }
+
+        _Mystate->_Wait();
+        const bool _Completed = !_Mystate->_Expired();
+        _Tidy();
+        return _Completed;
+    }
+
+private:
+    friend thread_pool;
+
+    explicit task_future(_Task_result_state<_Ty>* const _State) noexcept : _Mystate(_State) {}
+
+    _Ty _Take() noexcept {
+        // Note: The task has completed, so a non-void result has been stored.
+        _Task_result_state<_Ty>* const _State = _Mystate;
+        _Mystate                              = nullptr;
+        if constexpr (_STD is_void_v<_Ty>) {
+            _State->_Release();
+        } else {
+            _Ty _Result = _State->_Take_value();
+            _State->_Release();
+            return _Result;
+        }
+    }
+
+    void _Tidy() noexcept {
+        if (_Mystate) {
+            _Mystate->_Release();
+            _Mystate = nullptr;
+        }
+    }
+
+    _Task_result_state<_Ty>* _Mystate;
+};
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
+#endif // _SDSDLL_SYSTEM_EXECUTION_TASK_HPP_
@@ -0,0 +1,154 @@
+// telemetry.cpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <build/sdsdll_pch.hpp>
+#include <system/execution/telemetry.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+
+_SDSDLL_BEGIN
+// FUNCTION _Telemetry_ticks
+_NODISCARD uint64_t _Telemetry_ticks() noexcept {
+    LARGE_INTEGER _Now;
+    ::QueryPerformanceCounter(&_Now);
+    return static_cast<uint64_t>(_Now.QuadPart);
+}
+
+// FUNCTION _Telemetry_ticks_to_ns
+_NODISCARD uint64_t _Telemetry_ticks_to_ns(const uint64_t _Ticks) noexcept {
+    static const double _Ns_per_tick = []() noexcept {
+        LARGE_INTEGER _Freq;
+        if (!::QueryPerformanceFrequency(&_Freq) || _Freq.QuadPart <= 0) {
+            return 0.0;
+        }
+
+        return 1'000'000'000.0 / static_cast<double>(_Freq.QuadPart);
+    }();
+    return static_cast<uint64_t>(static_cast<double>(_Ticks) * _Ns_per_tick);
+}
+
+// FUNCTION _Telemetry_ns_to_ticks
+_NODISCARD uint64_t _Telemetry_ns_to_ticks(const uint64_t _Ns) noexcept {
+    static const double _Ticks_per_ns = []() noexcept {
+        LARGE_INTEGER _Freq;
+        if (!::QueryPerformanceFrequency(&_Freq) || _Freq.QuadPart <= 0) {
+            return 0.0;
+        }
+
+        return static_cast<double>(_Freq.QuadPart) / 1'000'000'000.0;
+    }();
+    return static_cast<uint64_t>(static_cast<double>(_Ns) * _Ticks_per_ns);
+}
+
+// FUNCTION _Telemetry_wait_bucket
+_NODISCARD size_t _Telemetry_wait_bucket(const uint64_t _Ns) noexcept {
+    uint64_t _Us  = _Ns / 1000;
+    size_t _Index = 0;
+    while (_Us > 0 && _Index < worker_wait_buckets - 1) {
+        _Us >>= 1;
+        ++_Index;
+    }
+
+    return _Index;
+}
+
+// FUNCTION _Merge_worker_stats
+void _Merge_worker_stats(worker_stats& _Target, const worker_stats& _Source) noexcept {
+    _Target.tasks   += _Source.tasks;
+    _Target.busy_ns += _Source.busy_ns;
+    _Target.idle_ns += _Source.idle_ns;
+    _Target.steals  += _Source.steals;
+    _Target.parks   += _Source.parks;
+    _Target.wakes   += _Source.wakes;
+    _Target.wait_ns += _Source.wait_ns;
+    _Target.expired += _Source.expired;
+    for (size_t _Idx = 0; _Idx < worker_wait_buckets; ++_Idx) {
+        _Target.wait_histogram[_Idx] += _Source.wait_histogram[_Idx];
+    }
+}
+
+// FUNCTION _Worker_telemetry constructor/destructor
+_Worker_telemetry::_Worker_telemetry() noexcept
+    : _Mytasks(0), _Mybusy(0), _Myidle(0), _Mysteals(0), _Myparks(0),
+      _Mywakes(0), _Mywait(0), _Myexpired(0), _Myhistogram(), _Mylast(0), _Mydepth(0) {}
+
+_Worker_telemetry::~_Worker_telemetry() noexcept {}
+
+// FUNCTION _Worker_telemetry::_Add
+void _Worker_telemetry::_Add(atomic<uint64_t>& _Counter, const uint64_t _Value) noexcept {
+    _Counter.store(_Counter.load(_STD memory_order_relaxed) + _Value, _STD memory_order_relaxed);
+}
+
+// FUNCTION _Worker_telemetry::_Task_started
+_NODISCARD uint64_t _Worker_telemetry::_Task_started(const uint64_t _Queued) noexcept {
+    // Note: A busy worker takes its next task right after the previous one has finished, so the time
+    //       at which that task has finished (or the worker woke up) is reused as the start time.
+    //       That saves one clock read per task, only the time spent looking for the task is lost.
+    //       A task submitted later than that could not have been taken right away, so it reads the clock.
+    const bool _Reuse    = _Mydepth == 0 && _Mylast != 0 && _Queued <= _Mylast;
+    const uint64_t _Now  = _Reuse ? _Mylast : _SDSDLL _Telemetry_ticks();
+    const uint64_t _Wait = _Now > _Queued ? _Now - _Queued : 0;
+    _Add(_Mywait, _Wait);
+    _Add(_Myhistogram[_SDSDLL _Telemetry_wait_bucket(_SDSDLL _Telemetry_ticks_to_ns(_Wait))], 1);
+    ++_Mydepth;
+    return _Now;
+}
+
+// FUNCTION _Worker_telemetry::_Task_finished
+void _Worker_telemetry::_Task_finished(const uint64_t _Started) noexcept {
+    // Note: A task that runs inside another task (while it waits) is already covered
+    //       by the busy time of the outer task.
+    _Add(_Mytasks, 1);
+    if (--_Mydepth == 0) {
+        _Mylast = _SDSDLL _Telemetry_ticks();
+        _Add(_Mybusy, _Mylast - _Started);
+    }
+}
+
+// FUNCTION _Worker_telemetry::_Task_stolen
+void _Worker_telemetry::_Task_stolen() noexcept {
+    _Add(_Mysteals, 1);
+}
+
+// FUNCTION _Worker_telemetry::_Task_expired
+void _Worker_telemetry::_Task_expired() noexcept {
+    _Add(_Myexpired, 1);
+}
+
+// FUNCTION _Worker_telemetry::_Parking
+_NODISCARD uint64_t _Worker_telemetry::_Parking() noexcept {
+    _Add(_Myparks, 1);
+    return _SDSDLL _Telemetry_ticks();
+}
+
+// FUNCTION _Worker_telemetry::_Unparked
+void _Worker_telemetry::_Unparked(const uint64_t _Parked) noexcept {
+    _Mylast = _SDSDLL _Telemetry_ticks();
+    _Add(_Myidle, _Mylast - _Parked);
+}
+
+// FUNCTION _Worker_telemetry::_Woken
+void _Worker_telemetry::_Woken() noexcept {
+    _Mywakes.fetch_add(1, _STD memory_order_relaxed);
+}
+
+// FUNCTION _Worker_telemetry::_Snapshot
+void _Worker_telemetry::_Snapshot(worker_stats& _Stats) const noexcept {
+    // Note: The counters are read one by one while the worker keeps running, so the snapshot
+    //       is not atomic as a whole. Each counter on its own is exact.
+    _Stats.tasks   = _Mytasks.load(_STD memory_order_relaxed);
+    _Stats.busy_ns = _SDSDLL _Telemetry_ticks_to_ns(_Mybusy.load(_STD memory_order_relaxed));
+    _Stats.idle_ns = _SDSDLL _Telemetry_ticks_to_ns(_Myidle.load(_STD memory_order_relaxed));
+    _Stats.steals  = _Mysteals.load(_STD memory_order_relaxed);
+    _Stats.parks   = _Myparks.load(_STD memory_order_relaxed);
+    _Stats.wakes   = _Mywakes.load(_STD memory_order_relaxed);
+    _Stats.wait_ns = _SDSDLL _Telemetry_ticks_to_ns(_Mywait.load(_STD memory_order_relaxed));
+    _Stats.expired = _Myexpired.load(_STD memory_order_relaxed);
+    for (size_t _Idx = 0; _Idx < worker_wait_buckets; ++_Idx) {
+        _Stats.wait_histogram[_Idx] = _Myhistogram[_Idx].load(_STD memory_order_relaxed);
+    }
+}
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
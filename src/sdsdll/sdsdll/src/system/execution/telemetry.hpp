@@ -0,0 +1,116 @@
+// telemetry.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SDSDLL_SYSTEM_EXECUTION_TELEMETRY_HPP_
+#define _SDSDLL_SYSTEM_EXECUTION_TELEMETRY_HPP_
+#include <core/defs.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+#include <atomic>
+#include <core/api.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <profileapi.h>
+#include <vector>
+
+// STD types
+using _STD atomic;
+using _STD vector;
+
+_SDSDLL_BEGIN
+// CONSTANT worker_wait_buckets
+inline constexpr size_t worker_wait_buckets = 16; // buckets of the queue-wait histogram
+
+// STRUCT worker_stats
+struct worker_stats {
+    uint64_t tasks; // number of executed tasks
+    uint64_t busy_ns; // time spent running tasks
+    uint64_t idle_ns; // time spent parked
+    uint64_t steals; // number of tasks taken from other workers
+    uint64_t parks; // number of times the worker parked
+    uint64_t wakes; // number of times a submission woke the worker up
+    uint64_t wait_ns; // total time that the executed tasks spent in the queues
+    uint64_t expired; // number of tasks dropped because their deadline had passed
+
+    // queue-wait latencies, the bucket 0 counts waits below 1 microsecond, the bucket N
+    // counts waits in [2^(N-1), 2^N) microseconds and the last bucket counts all longer waits
+    uint64_t wait_histogram[worker_wait_buckets];
+};
+
+// STRUCT thread_pool_stats
+struct thread_pool_stats {
+    size_t queued; // number of tasks waiting in the queues
+    worker_stats total; // sum of all workers
+    vector<worker_stats> workers;
+};
+
+// FUNCTION _Telemetry_ticks
+extern _NODISCARD uint64_t _Telemetry_ticks() noexcept;
+
+// FUNCTION _Telemetry_ticks_to_ns
+extern _NODISCARD uint64_t _Telemetry_ticks_to_ns(const uint64_t _Ticks) noexcept;
+
+// FUNCTION _Telemetry_ns_to_ticks
+extern _NODISCARD uint64_t _Telemetry_ns_to_ticks(const uint64_t _Ns) noexcept;
+
+// FUNCTION _Telemetry_wait_bucket
+extern _NODISCARD size_t _Telemetry_wait_bucket(const uint64_t _Ns) noexcept;
+
+// FUNCTION _Merge_worker_stats
+extern void _Merge_worker_stats(worker_stats& _Target, const worker_stats& _Source) noexcept;
+
+// CLASS _Worker_telemetry
+class _SDSDLL_API _Worker_telemetry { // counters of a single worker
+public:
+    _Worker_telemetry() noexcept;
+    ~_Worker_telemetry() noexcept;
+
+    _Worker_telemetry(const _Worker_telemetry&) = delete;
+    _Worker_telemetry& operator=(const _Worker_telemetry&) = delete;
+
+    // records the queue-wait of a task that is about to run, returns the current time
+    _NODISCARD uint64_t _Task_started(const uint64_t _Queued) noexcept;
+
+    // records a finished task that was started at _Started
+    void _Task_finished(const uint64_t _Started) noexcept;
+
+    // records a stolen task
+    void _Task_stolen() noexcept;
+
+    // records a task that was dropped because its deadline had passed
+    void _Task_expired() noexcept;
+
+    // records that the worker is going to park, returns the current time
+    _NODISCARD uint64_t _Parking() noexcept;
+
+    // records that the worker, parked at _Parked, is running again
+    void _Unparked(const uint64_t _Parked) noexcept;
+
+    // records that a submission woke the worker up (any thread)
+    void _Woken() noexcept;
+
+    // copies the counters
+    void _Snapshot(worker_stats& _Stats) const noexcept;
+
+private:
+    // increments the counter, only the worker writes to it, so no atomic RMW is needed
+    static void _Add(atomic<uint64_t>& _Counter, const uint64_t _Value) noexcept;
+
+    atomic<uint64_t> _Mytasks;
+    atomic<uint64_t> _Mybusy; // in ticks
+    atomic<uint64_t> _Myidle; // in ticks
+    atomic<uint64_t> _Mysteals;
+    atomic<uint64_t> _Myparks;
+    atomic<uint64_t> _Mywakes; // the only counter written by other threads
+    atomic<uint64_t> _Mywait; // in ticks
+    atomic<uint64_t> _Myexpired;
+    atomic<uint64_t> _Myhistogram[worker_wait_buckets];
+    uint64_t _Mylast; // time of the last finished task or wake-up (0 if unknown)
+    size_t _Mydepth; // nested tasks, a worker may run tasks while it waits for another one
+};
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
+#endif // _SDSDLL_SYSTEM_EXECUTION_TELEMETRY_HPP_
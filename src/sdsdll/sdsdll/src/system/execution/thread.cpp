@@ -15,54 +15,157 @@ _NODISCARD size_t _Hardware_concurrency() noexcept {
     return static_cast<size_t>(_Info.dwNumberOfProcessors);
 }
 
-// FUNCTION _Suspend_current_thread
-void _Suspend_current_thread() noexcept {
-    ::SuspendThread(::GetCurrentThread());
+// FUNCTION _Make_thread_task_data
+_NODISCARD _Thread_task_data _Make_thread_task_data(
+    const _Thread_task_t _Task, void* const _Data, const task_options& _Options) noexcept {
+    const uint64_t _Now = _SDSDLL _Telemetry_ticks();
+    if (_Options.deadline == 0) { // the task never expires
+        return _Thread_task_data{_Task, _Data, _Now, 0, _Options.expired};
+    }
+
+    const uint64_t _Timeout = _SDSDLL _Telemetry_ns_to_ticks(uint64_t{_Options.deadline} * 1'000'000);
+    return _Thread_task_data{_Task, _Data, _Now, _Now + (_Timeout > 0 ? _Timeout : 1), _Options.expired};
+}
+
+// FUNCTION _Drop_expired_task
+_NODISCARD bool _Drop_expired_task(const _Thread_task_data& _Task) noexcept {
+    // Note: Only the tasks with a deadline read the clock here. An expired task never runs,
+    //       its owner is notified instead, so that it can release the task's data.
+    if (_Task._Deadline == 0 || _SDSDLL _Telemetry_ticks() <= _Task._Deadline) {
+        return false;
+    }
+
+    if (_Task._Expired) {
+        (*_Task._Expired)(_Task._Data);
+    }
+
+    return true;
+}
+
+// FUNCTION _Thread_task_queue constructor/destructor
+_Thread_task_queue::_Thread_task_queue() noexcept
+    : _Myring(_Thread_task_queue_capacity), _Myspill(), _Myspilled(0) {}
+
+_Thread_task_queue::~_Thread_task_queue() noexcept {}
+
+// FUNCTION _Thread_task_queue::_Empty
+_NODISCARD bool _Thread_task_queue::_Empty() const noexcept {
+    return _Myring.empty() && _Myspilled.load(_STD memory_order_acquire) == 0;
+}
+
+// FUNCTION _Thread_task_queue::_Size
+_NODISCARD size_t _Thread_task_queue::_Size() const noexcept {
+    return _Myring.size() + _Myspilled.load(_STD memory_order_relaxed);
 }
 
-// FUNCTION _Suspend_thread
-_NODISCARD bool _Suspend_thread(void* const _Handle) noexcept {
-    return ::SuspendThread(_Handle) != static_cast<DWORD>(-1);
+// FUNCTION _Thread_task_queue::_Push
+void _Thread_task_queue::_Push(const _Thread_task_data& _Task) noexcept {
+    // Note: Once a task spills, the following tasks spill as well until the list is drained,
+    //       so that they do not overtake the spilled one. Only the spill allocates.
+    if (_Myspilled.load(_STD memory_order_acquire) == 0 && _Myring.try_push(_Task)) {
+        return;
+    }
+
+    _Myspilled.fetch_add(1, _STD memory_order_acq_rel);
+    _Myspill.push(_Task);
+}
+
+// FUNCTION _Thread_task_queue::_Pop
+_NODISCARD bool _Thread_task_queue::_Pop(_Thread_task_data& _Task) noexcept {
+    if (_Myring.try_pop(_Task)) {
+        return true;
+    }
+
+    // Note: The counter is raised before the task is pushed to the list, so the list may still
+    //       be empty here. The caller sees that as a failed pop and tries again later.
+    if (_Myspilled.load(_STD memory_order_acquire) == 0) {
+        return false;
+    }
+
+    _Task = _Myspill.pop();
+    if (!_Task._Task) {
+        return false;
+    }
+
+    _Myspilled.fetch_sub(1, _STD memory_order_acq_rel);
+    return true;
 }
 
-// FUNCTION _Resume_thread
-_NODISCARD bool _Resume_thread(void* const _Handle) noexcept {
-    return ::ResumeThread(_Handle) != static_cast<DWORD>(-1);
+// FUNCTION _Thread_task_queue::_Clear
+void _Thread_task_queue::_Clear() noexcept {
+    // Note: The discarded tasks never run, but their owners still have to be notified.
+    _Thread_task_data _Task = {nullptr, nullptr, 0, 0, nullptr};
+    while (_Pop(_Task)) {
+        if (_Task._Expired) {
+            (*_Task._Expired)(_Task._Data);
+        }
+    }
 }
 
 // FUNCTION _Thread_task_storage copy constructor
 _Thread_task_storage::_Thread_task_storage(const thread_state _State) noexcept
-    : _State(_State), _Queue() {}
+    : _State(_State), _Suspended(false), _Queue(), _Urgent(), _Wakeup(), _Telemetry() {}
+
+// FUNCTION _Current_thread_task_storage
+_NODISCARD _Thread_task_storage*& _Current_thread_task_storage() noexcept {
+    thread_local _Thread_task_storage* _Storage = nullptr; // storage of the thread that runs the caller
+    return _Storage;
+}
+
+// FUNCTION _Run_thread_task
+_NODISCARD bool _Run_thread_task(_Thread_task_storage& _Storage) noexcept {
+    // Note: The urgent tasks always go first, the normal ones run only when there are none.
+    _Thread_task_data _Task = {nullptr, nullptr, 0, 0, nullptr};
+    if (_Storage._Suspended.load(_STD memory_order_acquire)
+        || (!_Storage._Urgent._Pop(_Task) && !_Storage._Queue._Pop(_Task))) {
+        return false;
+    }
+
+    if (_SDSDLL _Drop_expired_task(_Task)) {
+        _Storage._Telemetry._Task_expired();
+        return true;
+    }
+
+    const uint64_t _Started = _Storage._Telemetry._Task_started(_Task._Queued);
+    (*_Task._Task)(_Task._Data);
+    _Storage._Telemetry._Task_finished(_Started);
+    return true;
+}
+
+// FUNCTION _Process_detaching
+_NODISCARD atomic<bool>& _Process_detaching() noexcept {
+    static atomic<bool> _Detaching(false); // set by DllMain() once the library is being unloaded
+    return _Detaching;
+}
 
 // FUNCTION _Thread_task
 DWORD __stdcall _Thread_task(void* const _Data) noexcept {
     // Note: The CreateThread() requires the thread routine to return a DWORD.
     _Thread_task_storage* _Storage = static_cast<_Thread_task_storage*>(_Data);
+    _SDSDLL _Current_thread_task_storage() = _Storage; // lets a waiting task run the queued ones
     for (;;) {
-        switch (_Storage->_State.load(_STD memory_order_relaxed)) {
-        case thread_state::terminated:
-            ::ExitThread(0); // terminate itself
-            break;
-        case thread_state::waiting: // suspend itself
-            _Suspend_current_thread();
+        if (_Storage->_State.load(_STD memory_order_acquire) == thread_state::terminated) {
             break;
-        case thread_state::working: // perform task
-            if (!_Storage->_Queue.empty()) {
-                const _Thread_task_data& _Data = _Storage->_Queue.pop();
-                (*_Data._Task)(_Data._Data);
-            } else { // nothing to do, wait for any task
-                _Storage->_State.store(thread_state::waiting, _STD memory_order_relaxed);
-            }
+        }
 
-            break;
-        default:
-#if _HAS_CXX23
-            // Note: The std::unreachable() may optimize impossible code branches.
-            _STD unreachable();
-#endif // _HAS_CXX23
+        if (_SDSDLL _Run_thread_task(*_Storage)) {
+            continue;
         }
+
+        // Note: Nothing to do, announce that the thread is waiting and park it. The state is changed
+        //       only if it is still thread_state::working, so that the termination is never overwritten.
+        //       A task that is submitted after the queue was checked unparks the thread, so the next
+        //       _Park() returns immediately and the queue is checked again.
+        thread_state _Expected = thread_state::working;
+        (void) _Storage->_State.compare_exchange_strong(_Expected, thread_state::waiting);
+        const uint64_t _Parked = _Storage->_Telemetry._Parking();
+        _Storage->_Wakeup._Park();
+        _Storage->_Telemetry._Unparked(_Parked);
+        _Expected = thread_state::waiting;
+        (void) _Storage->_State.compare_exchange_strong(_Expected, thread_state::working);
     }
 
+    _SDSDLL _Current_thread_task_storage() = nullptr;
     return 0;
 }
 
@@ -73,10 +176,10 @@ thread::thread() noexcept : _Myid(0), _Mystorage(thread_state::waiting), _Mycbs(
 
 thread::thread(const task _Task, void* const _Data) noexcept
     : _Myid(0), _Mystorage(thread_state::working), _Mycbs() {
-    _Mystorage._Queue.push(_Thread_task_data{_Task, _Data});
+    _Mystorage._Queue._Push(_SDSDLL _Make_thread_task_data(_Task, _Data, default_task_options));
     _Start();
     if (_Myid == 0) {
-        _Mystorage._Queue.clear();
+        _Mystorage._Queue._Clear();
     }
 }
 
@@ -101,7 +204,8 @@ void thread::_Set_state(const thread_state _New_state) noexcept {
 // FUNCTION thread::_Clear_cached_data
 void thread::_Clear_cached_data() noexcept {
     _Set_state(thread_state::terminated);
-    _Mystorage._Queue.clear(); // clear task queue
+    _Mystorage._Urgent._Clear(); // clear task queues
+    _Mystorage._Queue._Clear();
     _Mycbs.clear(); // clear event callbacks
     ::CloseHandle(_Myhandle);
     _Myhandle = nullptr;
@@ -120,16 +224,11 @@ void thread::_Start() noexcept {
 
 // FUNCTION thread::_Tidy
 void thread::_Tidy() noexcept {
-    if (state() != thread_state::waiting) {
-        (void) suspend(); // must be suspended
-    }
-
-    _Set_state(thread_state::terminated);
+    // Note: The thread finishes its current task (if any), notices the new state and terminates
+    //       itself. Unparking it makes sure that it notices the new state even if it is waiting.
+    _Mystorage._State.store(thread_state::terminated, _STD memory_order_release);
     _Invoke_callbacks(terminate_event);
-    
-    // Note: We cannot use resume() here, because it will set the state to thread_state::working.
-    //       The thread would continue doing its task.
-    (void) _Resume_thread(_Myhandle); // the thread will terminate itself
+    _Mystorage._Wakeup._Unpark();
 }
 
 // FUNCTION thread::hardware_concurrency
@@ -166,21 +265,44 @@ _NODISCARD thread_state thread::state() const noexcept {
 
 // FUNCTION thread::tasks
 _NODISCARD size_t thread::tasks() const noexcept {
-    return _Mystorage._Queue.size();
+    return _Mystorage._Urgent._Size() + _Mystorage._Queue._Size();
+}
+
+// FUNCTION thread::stats
+_NODISCARD worker_stats thread::stats() const noexcept {
+    worker_stats _Stats;
+    _Mystorage._Telemetry._Snapshot(_Stats);
+    return _Stats;
 }
 
 // FUNCTION thread::submit_task
 _NODISCARD bool thread::submit_task(const task _Task, void* const _Data) noexcept {
+    return submit_task(_Task, _Data, default_task_options);
+}
+
+_NODISCARD bool thread::submit_task(
+    const task _Task, void* const _Data, const task_options& _Options) noexcept {
     const thread_state _State = state();
-    if (_State == thread_state::terminated || _Mystorage._Queue.full()) {
+    if (_State == thread_state::terminated) {
         return false;
     }
 
-    _Mystorage._Queue.push(_Thread_task_data{_Task, _Data});
-    if (_State != thread_state::working) { // notify waiting thread
-        (void) resume();
+    // Note: Claim the waiting thread, so that the next submission selects a different waiting thread
+    //       instead of waking this one again. The thread is unparked even if it seems to be working,
+    //       because it may have checked its queue just before the task was pushed.
+    const _Thread_task_data _Item = _SDSDLL _Make_thread_task_data(_Task, _Data, _Options);
+    if (_Options.priority == task_priority::high) {
+        _Mystorage._Urgent._Push(_Item);
+    } else {
+        _Mystorage._Queue._Push(_Item);
+    }
+
+    thread_state _Expected = thread_state::waiting;
+    if (_Mystorage._State.compare_exchange_strong(_Expected, thread_state::working)) {
+        _Mystorage._Telemetry._Woken();
     }
 
+    _Mystorage._Wakeup._Unpark();
     return true;
 }
 
@@ -209,35 +331,24 @@ _NODISCARD bool thread::terminate_and_wait() noexcept {
 
 // FUNCTION thread::suspend
 _NODISCARD bool thread::suspend() noexcept {
-    const thread_state _State = state();
-    if (_State != thread_state::working) {
+    // Note: The thread is never stopped in the middle of a task, it parks itself once the current
+    //       task is finished. The submitted tasks stay in the queue until the thread is resumed.
+    if (!joinable() || _Mystorage._Suspended.exchange(true, _STD memory_order_acq_rel)) {
         return false;
     }
 
     _Invoke_callbacks(suspend_event);
-    _Set_state(thread_state::waiting);
-    if (!_Suspend_thread(_Myhandle)) { // failed to suspend thread, restore an old state
-        _Set_state(_State);
-        return false;
-    }
-
     return true;
 }
 
 // FUNCTION thread::resume
 _NODISCARD bool thread::resume() noexcept {
-    const thread_state _State = state();
-    if (_State != thread_state::waiting) {
+    if (!joinable() || !_Mystorage._Suspended.exchange(false, _STD memory_order_acq_rel)) {
         return false;
     }
 
     _Invoke_callbacks(resume_event);
-    _Set_state(thread_state::working);
-    if (!_Resume_thread(_Myhandle)) { // failed to resume the thread, restore an old state
-        _Set_state(_State);
-        return false;
-    }
-
+    _Mystorage._Wakeup._Unpark();
     return true;
 }
 _SDSDLL_END
@@ -12,11 +12,15 @@
 #include <core/api.hpp>
 #include <core/traits/type_traits.hpp>
 #include <cstddef>
+#include <cstdint>
 #include <minwindef.h>
 #include <processthreadsapi.h>
 #include <synchapi.h>
 #include <sysinfoapi.h>
+#include <system/execution/parker.hpp>
+#include <system/execution/ring_queue.hpp>
 #include <system/execution/shared_queue.hpp>
+#include <system/execution/telemetry.hpp>
 #include <utility>
 #include <vector>
 #include <WinBase.h>
@@ -29,15 +33,6 @@ _SDSDLL_BEGIN
 // FUNCTION _Hardware_concurrency
 extern _NODISCARD size_t _Hardware_concurrency() noexcept;
 
-// FUNCTION _Suspend_current_thread
-extern void _Suspend_current_thread() noexcept;
-
-// FUNCTION _Suspend_thread
-extern _NODISCARD bool _Suspend_thread(void* const _Handle) noexcept;
-
-// FUNCTION _Resume_thread
-extern _NODISCARD bool _Resume_thread(void* const _Handle) noexcept;
-
 // ALIAS _Thread_task_t
 using _Thread_task_t = void(__stdcall*)(void*) noexcept;
 
@@ -48,10 +43,69 @@ enum class thread_state : unsigned char {
     working
 };
 
+// ENUM CLASS task_priority
+enum class task_priority : unsigned char {
+    high, // interactive tasks, they always run before the normal ones
+    normal // bulk tasks
+};
+
+// STRUCT task_options
+struct task_options {
+    task_priority priority;
+    uint32_t deadline; // milliseconds after the submission after which the task is dropped (0 = never)
+    _Thread_task_t expired; // invoked with the task's data if it is dropped without running (may be null)
+};
+
+// CONSTANT default_task_options
+inline constexpr task_options default_task_options = {task_priority::normal, 0, nullptr};
+
 // STRUCT _Thread_task_data
 struct _Thread_task_data {
     _Thread_task_t _Task;
     void* _Data;
+    uint64_t _Queued; // submission time (see _Telemetry_ticks())
+    uint64_t _Deadline; // time after which the task is dropped (0 = never)
+    _Thread_task_t _Expired; // invoked instead of the task if it is dropped (may be null)
+};
+
+// FUNCTION _Make_thread_task_data
+extern _NODISCARD _Thread_task_data _Make_thread_task_data(
+    const _Thread_task_t _Task, void* const _Data, const task_options& _Options) noexcept;
+
+// FUNCTION _Drop_expired_task
+extern _NODISCARD bool _Drop_expired_task(const _Thread_task_data& _Task) noexcept;
+
+// CONSTANT _Thread_task_queue_capacity
+inline constexpr size_t _Thread_task_queue_capacity = 1024; // tasks that fit in the ring
+
+// CLASS _Thread_task_queue
+class _Thread_task_queue { // lock-free ring of tasks that spills into a locked list when full
+public:
+    _Thread_task_queue() noexcept;
+    ~_Thread_task_queue() noexcept;
+
+    _Thread_task_queue(const _Thread_task_queue&) = delete;
+    _Thread_task_queue& operator=(const _Thread_task_queue&) = delete;
+
+    // checks if the queue seems to be empty
+    _NODISCARD bool _Empty() const noexcept;
+
+    // returns the approximate number of tasks
+    _NODISCARD size_t _Size() const noexcept;
+
+    // pushes a new task
+    void _Push(const _Thread_task_data& _Task) noexcept;
+
+    // tries to pop the oldest task
+    _NODISCARD bool _Pop(_Thread_task_data& _Task) noexcept;
+
+    // discards all tasks
+    void _Clear() noexcept;
+
+private:
+    mpmc_ring_queue<_Thread_task_data> _Myring;
+    shared_queue<_Thread_task_data> _Myspill; // tasks that did not fit in the ring
+    atomic<size_t> _Myspilled; // number of tasks in _Myspill
 };
 
 // STRUCT _Thread_task_storage
@@ -59,9 +113,22 @@ struct _Thread_task_storage {
     explicit _Thread_task_storage(const thread_state _State) noexcept;
 
     atomic<thread_state> _State;
-    shared_queue<_Thread_task_data> _Queue;
+    atomic<bool> _Suspended; // true if the thread must not start new tasks
+    _Thread_task_queue _Queue;
+    _Thread_task_queue _Urgent; // tasks with task_priority::high
+    _Parker _Wakeup; // parks the thread while it has nothing to do
+    _Worker_telemetry _Telemetry;
 };
 
+// FUNCTION _Current_thread_task_storage
+extern _NODISCARD _Thread_task_storage*& _Current_thread_task_storage() noexcept;
+
+// FUNCTION _Run_thread_task
+extern _NODISCARD bool _Run_thread_task(_Thread_task_storage& _Storage) noexcept;
+
+// FUNCTION _Process_detaching
+extern _NODISCARD atomic<bool>& _Process_detaching() noexcept;
+
 // FUNCTION _Thread_task
 extern DWORD __stdcall _Thread_task(void* const _Data) noexcept;
 
@@ -109,16 +176,22 @@ public:
     // returns the tasks count
     _NODISCARD size_t tasks() const noexcept;
 
+    // returns the telemetry counters
+    _NODISCARD worker_stats stats() const noexcept;
+
     // tries to submit a new task
     _NODISCARD bool submit_task(const task _Task, void* const _Data) noexcept;
 
+    // tries to submit a new task with the selected priority and deadline
+    _NODISCARD bool submit_task(const task _Task, void* const _Data, const task_options& _Options) noexcept;
+
     // tries to terminate the thread
     _NODISCARD bool terminate() noexcept;
 
     // tries to terminate the thread and wait for its completion
     _NODISCARD bool terminate_and_wait() noexcept;
 
-    // tries to suspend the thread
+    // tries to suspend the thread (it finishes the current task first)
     _NODISCARD bool suspend() noexcept;
 
     // tries to resume the thread
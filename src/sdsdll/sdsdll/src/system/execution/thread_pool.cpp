@@ -4,7 +4,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <build/sdsdll_pch.hpp>
-#include <system/execution/thread.hpp>
+#include <system/execution/thread_pool.hpp>
 #if _SDSDLL_PREPROCESSOR_GUARD
 
 _SDSDLL_BEGIN
@@ -290,9 +290,27 @@ _NODISCARD const thread* _Thread_list::_Select_thread_by_tasks() const noexcept
 }
 
 // FUNCTION thread_pool copy constructor/destructor
-thread_pool::thread_pool(const size_t _Count) noexcept : _Mylist(0), _Mystate(_Working) {
-    if (_Count < thread::hardware_concurrency()) {
-        (void) _Mylist._Grow(_Count);
+thread_pool::thread_pool(const size_t _Count, const thread_pool_mode _Mode) noexcept
+    : _Mylist(0), _Mystate(_Working), _Mysched(nullptr) {
+    (void) _Mylist._Grow((_STD min)(_Count, thread::hardware_concurrency()));
+    const size_t _Size = _Mylist._Size();
+    if (_Mode == thread_pool_mode::work_stealing && _Size > 0) { // stays per-thread on failure
+        (void) _Start_scheduler(_Size, _Work_stealing_elasticity{_Size, INFINITE, 0, 0});
+    }
+}
+
+thread_pool::thread_pool(const thread_pool_limits& _Limits) noexcept
+    : _Mylist(0), _Mystate(_Working), _Mysched(nullptr) {
+    // Note: The threads above min_threads are started and retired by the work-stealing scheduler.
+    //       The per-thread queues pin each task to the thread that it was submitted to, so a newly
+    //       started thread could not take over any of the waiting tasks.
+    const size_t _Hardware = thread::hardware_concurrency();
+    const size_t _Max      = (_STD min)((_STD max)(_Limits.max_threads, size_t{1}), _Hardware);
+    (void) _Mylist._Grow((_STD min)((_STD max)(_Limits.min_threads, size_t{1}), _Max));
+    const size_t _Size = _Mylist._Size();
+    if (_Size > 0) { // the threads that failed to start are covered by the elastic ones
+        (void) _Start_scheduler(_Max, _Work_stealing_elasticity{_Size,
+            _Limits.idle_timeout, uint64_t{_Limits.wait_threshold} * 1000, _Limits.depth_threshold});
     }
 }
 
@@ -300,9 +318,56 @@ thread_pool::~thread_pool() noexcept {
     close();
 }
 
+// FUNCTION thread_pool::_Start_scheduler
+_NODISCARD bool thread_pool::_Start_scheduler(
+    const size_t _Workers, const _Work_stealing_elasticity& _Elasticity) noexcept {
+    void* const _Raw = allocator<void>{}.allocate(sizeof(_Work_stealing_scheduler));
+    if (!_Raw) { // allocation failed
+        return false;
+    }
+
+    _Mysched = ::new (_Raw) _Work_stealing_scheduler;
+    if (!_Mysched->_Create(_Workers)) {
+        _Release_scheduler();
+        return false;
+    }
+
+    _Mysched->_Make_elastic(_Elasticity);
+
+    // Note: Each thread gets a single task that runs the worker loop until the thread-pool is closed.
+    //       A thread that failed to start never runs its worker, which is harmless, because only
+    //       the worker itself pushes to its deque.
+    size_t _Idx = 0;
+    _Mylist._For_each_thread(
+        [](thread& _Thread, _Work_stealing_scheduler* const _Sched, size_t& _Idx) noexcept {
+            (void) _Thread.submit_task(_Work_stealing_worker_task, _Sched->_Worker(_Idx++));
+        }, _Mysched, _Idx
+    );
+    return true;
+}
+
+// FUNCTION thread_pool::_Release_scheduler
+void thread_pool::_Release_scheduler() noexcept {
+    if (_Mysched) {
+        _Mysched->~_Work_stealing_scheduler();
+        allocator<void>{}.deallocate(_Mysched, sizeof(_Work_stealing_scheduler));
+        _Mysched = nullptr;
+    }
+}
+
 // FUNCTION thread_pool::threads
 _NODISCARD size_t thread_pool::threads() const noexcept {
-    return _Mylist._Size();
+    return _Mysched ? _Mysched->_Running() : _Mylist._Size();
+}
+
+// FUNCTION thread_pool::is_elastic
+_NODISCARD bool thread_pool::is_elastic() const noexcept {
+    return _Mysched && _Mysched->_Elastic();
+}
+
+// FUNCTION thread_pool::mode
+_NODISCARD thread_pool_mode thread_pool::mode() const noexcept {
+    return _Mysched ? thread_pool_mode::work_stealing : thread_pool_mode::per_thread;
 }
 
 // FUNCTION thread_pool::is_open
@@ -322,7 +387,12 @@ _NODISCARD bool thread_pool::is_waiting() const noexcept {
 
 // FUNCTION thread_pool::increase_threads
 _NODISCARD bool thread_pool::increase_threads(const size_t _Count) noexcept {
-    if (_Mylist._Size() + _Count > thread::hardware_concurrency() - 1) { // not enough resources
+    if (_Mysched) { // the workers are fixed once the scheduler is started
+        return false;
+    }
+
+    // Note: The same bound as in the constructors, at most one thread per core.
+    if (_Count > thread::hardware_concurrency() - _Mylist._Size()) { // not enough resources
         return false;
     }
 
@@ -331,6 +401,10 @@ _NODISCARD bool thread_pool::increase_threads(const size_t _Count) noexcept {
 
 // FUNCTION thread_pool::decrease_threads
 _NODISCARD bool thread_pool::decrease_threads(const size_t _Count) noexcept {
+    if (_Mysched) { // the workers are fixed once the scheduler is started
+        return false;
+    }
+
     const size_t _Size = _Mylist._Size();
     if (_Size < _Count) { // not enough threads
         return false;
@@ -343,17 +417,58 @@ _NODISCARD bool thread_pool::decrease_threads(const size_t _Count) noexcept {
     return _Mylist._Reduce(_Count);
 }
 
+// FUNCTION thread_pool::stats
+_NODISCARD thread_pool_stats thread_pool::stats() const {
+    // Note: Each worker has its own counters, they are merged here, so the workers never
+    //       write to a shared cache line. The pool keeps running while the snapshot is taken.
+    thread_pool_stats _Stats = {};
+    if (_Mysched) { // the threads only host the workers of the scheduler
+        _Stats.queued = _Mysched->_Queued();
+        _Stats.workers.resize(_Mysched->_Workers());
+        for (size_t _Idx = 0; _Idx < _Stats.workers.size(); ++_Idx) {
+            _Mysched->_Worker(_Idx)->_Telemetry._Snapshot(_Stats.workers[_Idx]);
+        }
+    } else {
+        _Stats.workers.resize(_Mylist._Size());
+        size_t _Idx = 0;
+        _Mylist._For_each_thread(
+            [&](const thread& _Thread) noexcept {
+                if (_Idx < _Stats.workers.size()) {
+                    _Stats.queued += _Thread.tasks();
+                    _Stats.workers[_Idx++] = _Thread.stats();
+                }
+            }
+        );
+    }
+
+    for (const worker_stats& _Worker : _Stats.workers) {
+        _SDSDLL _Merge_worker_stats(_Stats.total, _Worker);
+    }
+
+    return _Stats;
+}
+
 // FUNCTION thread_pool::submit_task
 _NODISCARD bool thread_pool::submit_task(const thread::task _Task, void* const _Data) noexcept {
+    return submit_task(_Task, _Data, default_task_options);
+}
+
+_NODISCARD bool thread_pool::submit_task(
+    const thread::task _Task, void* const _Data, const task_options& _Options) noexcept {
     if (_Mystate != _Working) {
         return false;
     }
 
+    if (_Mysched) { // let the scheduler decide which thread runs the task
+        return _Mysched->_Submit(_Task, _Data, _Options);
+    }
+
     thread* const _Waiting_thread = _Mylist._Select_thread_by_state(thread_state::waiting);
     if (_Waiting_thread) { // give this task to the first waiting thread
-        return _Waiting_thread->submit_task(_Task, _Data);
-    } else { // give this task to the thread with the fewest tasks
-        return _Mylist._Select_thread_by_tasks()->submit_task(_Task, _Data);
+        return _Waiting_thread->submit_task(_Task, _Data, _Options);
+    } else { // give this task to the thread with the fewest tasks (if any)
+        thread* const _Thread = _Mylist._Select_thread_by_tasks();
+        return _Thread ? _Thread->submit_task(_Task, _Data, _Options) : false;
     }
 }
 
@@ -364,6 +479,11 @@ _NODISCARD bool thread_pool::suspend() noexcept {
     }
 
     _Mystate = _Waiting;
+    if (_Mysched) {
+        _Mysched->_Suspend();
+        return true;
+    }
+
     _Mylist._For_each_thread(
         [](thread& _Thread) noexcept {
             (void) _Thread.suspend();
@@ -379,6 +499,11 @@ _NODISCARD bool thread_pool::resume() noexcept {
     }
     
     _Mystate = _Working;
+    if (_Mysched) {
+        _Mysched->_Resume();
+        return true;
+    }
+
     _Mylist._For_each_thread(
         [](thread& _Thread) noexcept {
             (void) _Thread.resume();
@@ -390,15 +515,119 @@ _NODISCARD bool thread_pool::resume() noexcept {
 // FUNCTION thread_pool::close
 void thread_pool::close() noexcept {
     _Mystate = _Closed;
+    if (_Mysched) { // let the worker loops return, so that the threads can terminate
+        _Mysched->_Stop();
+    }
+
     _Mylist._Release();
+    _Release_scheduler(); // no thread refers to the scheduler anymore
 }
 
 // FUNCTION default_thread_pool
 _NODISCARD thread_pool& default_thread_pool() noexcept {
-    // Note: Use 25% of all threads by default.
-    static thread_pool _Pool(thread::hardware_concurrency() / 4);
+    // Note: Keep 25% of all threads when idle and use all of them under load. The threads
+    //       above the minimum retire after 10 seconds without any task.
+    static constexpr uint32_t _Idle_timeout   = 10'000; // 10 s
+    static constexpr uint32_t _Wait_threshold = 1'000; // 1 ms
+    static constexpr size_t _Depth_threshold  = 4;
+    const size_t _Hardware                    = thread::hardware_concurrency();
+    static thread_pool _Pool(thread_pool_limits{(_STD max)(_Hardware / 4, size_t{1}),
+        _Hardware, _Idle_timeout, _Wait_threshold, _Depth_threshold});
     return _Pool;
 }
+
+// FUNCTION _Release_parallel_job
+void _Release_parallel_job(_Parallel_job* const _Job) noexcept {
+    if (_Job->_Refs.fetch_sub(1, _STD memory_order_acq_rel) == 1) { // last owner, free the job
+        _Job->~_Parallel_job();
+        allocator<void>{}.deallocate(_Job, sizeof(_Parallel_job));
+    }
+}
+
+// FUNCTION _Claim_parallel_range
+_NODISCARD bool _Claim_parallel_range(_Parallel_job* const _Job, size_t& _First, size_t& _Last) noexcept {
+    // Note: The claimed ranges shrink as the job progresses (guided scheduling). The first claims are
+    //       large, so that the shared index is rarely touched, and the last ones are small, so that
+    //       the participants finish at about the same time.
+    size_t _Next = _Job->_Next.load(_STD memory_order_relaxed);
+    for (;;) {
+        if (_Next >= _Job->_Last) { // no more indexes to claim
+            return false;
+        }
+
+        const size_t _Remaining = _Job->_Last - _Next;
+        size_t _Size            = _Remaining / (2 * _Job->_Participants);
+        if (_Size < _Job->_Grain) {
+            _Size = (_STD min)(_Job->_Grain, _Remaining);
+        }
+
+        if (_Job->_Next.compare_exchange_weak(_Next, _Next + _Size, _STD memory_order_relaxed)) {
+            _First = _Next;
+            _Last  = _Next + _Size;
+            return true;
+        }
+    }
+}
+
+// FUNCTION _Run_parallel_job
+void _Run_parallel_job(_Parallel_job* const _Job) noexcept {
+    const size_t _Count = _Job->_Last - _Job->_First;
+    size_t _First;
+    size_t _Last;
+    while (_Claim_parallel_range(_Job, _First, _Last)) {
+        (*_Job->_Task)(_First, _Last, _Job->_Data);
+        if (_Job->_Done.fetch_add(_Last - _First, _STD memory_order_acq_rel) + (_Last - _First) == _Count) {
+            ::WakeByAddressAll(_SDSDLL addressof(_Job->_Done)); // notify the caller
+        }
+    }
+}
+
+// FUNCTION _Parallel_job_task
+void __stdcall _Parallel_job_task(void* const _Data) noexcept {
+    _Parallel_job* const _Job = static_cast<_Parallel_job*>(_Data);
+    _Run_parallel_job(_Job);
+    _Release_parallel_job(_Job);
+}
+
+// FUNCTION _Parallel_invoke_range
+void _Parallel_invoke_range(thread_pool& _Pool, const size_t _First, const size_t _Last,
+    const size_t _Grain, const _Parallel_range_task_t _Task, void* const _Data,
+    const task_priority _Priority) noexcept {
+    if (_First >= _Last) { // nothing to do
+        return;
+    }
+
+    const size_t _Grain_or_one = _Grain > 0 ? _Grain : 1;
+    const size_t _Chunks       = (_Last - _First - 1) / _Grain_or_one + 1;
+    const size_t _Helpers      = (_STD min)(_Pool.threads(), _Chunks - 1);
+    void* const _Raw           = _Helpers > 0 ? allocator<void>{}.allocate(sizeof(_Parallel_job)) : nullptr;
+    if (!_Raw) { // no helpers or allocation failed, invoke the task in the current thread
+        (*_Task)(_First, _Last, _Data);
+        return;
+    }
+
+    // Note: The job is shared by the caller and the submitted tasks, it is freed by its last owner.
+    //       Because the caller claims indexes as well, the job completes even if the submitted tasks
+    //       start late (or never), and the caller only waits for indexes that are already claimed.
+    _Parallel_job* const _Job = ::new (_Raw) _Parallel_job{
+        _Task, _Data, _First, _Last, _Grain_or_one, _Helpers + 1, _First, 0, _Helpers + 1};
+    const task_options _Options = {_Priority, 0, nullptr};
+    for (size_t _Submitted = 0; _Submitted < _Helpers; ++_Submitted) {
+        if (!_Pool.submit_task(_Parallel_job_task, _Job, _Options)) { // never runs, drop its ownership
+            _Release_parallel_job(_Job);
+        }
+    }
+
+    _Run_parallel_job(_Job);
+    const size_t _Count = _Last - _First;
+    size_t _Done        = _Job->_Done.load(_STD memory_order_acquire);
+    while (_Done != _Count) { // wait for the indexes claimed by other threads
+        ::WaitOnAddress(_SDSDLL addressof(_Job->_Done), &_Done, sizeof(size_t), INFINITE);
+        _Done = _Job->_Done.load(_STD memory_order_acquire);
+    }
+
+    _Release_parallel_job(_Job);
+}
 _SDSDLL_END
 
 #endif // _SDSDLL_PREPROCESSOR_GUARD
\ No newline at end of file
@@ -8,15 +8,23 @@
 #define _SDSDLL_SYSTEM_EXECUTION_THREAD_POOL_HPP_
 #include <core/defs.hpp>
 #if _SDSDLL_PREPROCESSOR_GUARD
+#include <atomic>
 #include <core/api.hpp>
 #include <core/memory/allocator.hpp>
 #include <core/optimization/ebco.hpp>
 #include <core/traits/type_traits.hpp>
 #include <cstddef>
+#include <cstdint>
 #include <synchapi.h>
+#include <system/execution/task.hpp>
+#include <system/execution/telemetry.hpp>
 #include <system/execution/thread.hpp>
+#include <system/execution/work_stealing.hpp>
 #include <WinBase.h>
 
+// STD types
+using _STD atomic;
+
 _SDSDLL_BEGIN
 // STRUCT _Thread_list_node
 struct _Thread_list_node {
@@ -91,6 +99,18 @@ public:
         }
     }
 
+    template <class _Fn, class... _Types>
+    void _For_each_thread(_Fn&& _Func, _Types&&... _Args) const noexcept {
+        const _Thread_list_storage& _Storage = _Mypair._Val1;
+        if (_Storage._Size > 0) {
+            const _Thread_list_node* _Node = _Storage._First;
+            while (_Node) {
+                (void) _Func(_Node->_Thread, _STD forward<_Types>(_Args)...);
+                _Node = _Node->_Next;
+            }
+        }
+    }
+
 private:
     using _Alloc = allocator<void>;
     
@@ -106,19 +126,42 @@ private:
     mutable _Ebco_pair<_Thread_list_storage, _Alloc> _Mypair;
 };
 
+// ENUM CLASS thread_pool_mode
+enum class thread_pool_mode : unsigned char {
+    per_thread, // each thread has its own queue, tasks are assigned on submission
+    work_stealing // tasks are shared, idle threads steal from busy ones
+};
+
+// STRUCT thread_pool_limits
+struct thread_pool_limits {
+    size_t min_threads; // threads that never retire (at least 1)
+    size_t max_threads; // upper bound of the threads (at most thread::hardware_concurrency())
+    uint32_t idle_timeout; // milliseconds after which an idle thread above min_threads retires
+    uint32_t wait_threshold; // microseconds a task may wait before another thread is started
+    size_t depth_threshold; // waiting tasks per running thread that start another thread
+};
+
 // CLASS thread_pool
 class _SDSDLL_API thread_pool {
 public:
-    explicit thread_pool(const size_t _Count) noexcept;
+    explicit thread_pool(
+        const size_t _Count, const thread_pool_mode _Mode = thread_pool_mode::per_thread) noexcept;
+    explicit thread_pool(const thread_pool_limits& _Limits) noexcept; // elastic, always work-stealing
     ~thread_pool() noexcept;
 
     thread_pool() = delete;
     thread_pool(const thread_pool&) = delete;
     thread_pool& operator=(const thread_pool&) = delete;
 
-    // returns threads count
+    // returns threads count (the running threads if the thread-pool is elastic)
     _NODISCARD size_t threads() const noexcept;
 
+    // checks if the thread-pool starts and retires threads on its own
+    _NODISCARD bool is_elastic() const noexcept;
+
+    // returns the scheduling mode
+    _NODISCARD thread_pool_mode mode() const noexcept;
+
     // checks if the thread-pool is still open
     _NODISCARD bool is_open() const noexcept;
 
@@ -128,15 +171,57 @@ public:
     // checks if the thread-pool is waiting
     _NODISCARD bool is_waiting() const noexcept;
 
-    // tries to release at most _Count threads from the thread-pool
+    // tries to hire _Count threads to the thread-pool (at most thread::hardware_concurrency() in total)
     _NODISCARD bool increase_threads(const size_t _Count) noexcept;
 
-    // tries to hire _Count threads to the thread-pool
+    // tries to release _Count threads from the thread-pool (at least 1 thread remains)
     _NODISCARD bool decrease_threads(const size_t _Count) noexcept;
 
+    // returns a snapshot of the telemetry counters of all threads
+    _NODISCARD thread_pool_stats stats() const;
+
     // tries to submit a new task
     _NODISCARD bool submit_task(const thread::task _Task, void* const _Data) noexcept;
 
+    // tries to submit a new task with the selected priority and deadline
+    _NODISCARD bool submit_task(
+        const thread::task _Task, void* const _Data, const task_options& _Options) noexcept;
+
+    // tries to submit _Func(_Args...), the returned future is invalid on failure
+    template <class _Fn, class... _Types>
+    _NODISCARD task_future<_Task_result_t<_Fn, _Types...>> submit(_Fn&& _Func, _Types&&... _Args) {
+        return submit(default_task_options, _STD forward<_Fn>(_Func), _STD forward<_Types>(_Args)...);
+    }
+
+    // tries to submit _Func(_Args...) with the selected priority and deadline, the returned future
+    // is invalid on failure and expired if the task was dropped (_Options.expired is ignored)
+    template <class _Fn, class... _Types>
+    _NODISCARD task_future<_Task_result_t<_Fn, _Types...>> submit(
+        const task_options& _Options, _Fn&& _Func, _Types&&... _Args) {
+        // Note: The callable and its arguments are decay-copied into the task state, which also
+        //       holds the result. Small states reuse pooled blocks, so they never hit the heap
+        //       once the pool is warm. The state is shared by the task and the future.
+        using _Result = _Task_result_t<_Fn, _Types...>;
+        using _State  = _Task_state<_Result, _STD decay_t<_Fn>, _STD decay_t<_Types>...>;
+        _State* const _Ptr = _State::_Create(_STD forward<_Fn>(_Func), _STD forward<_Types>(_Args)...);
+        if (!_Ptr) { // allocation failed
+            return task_future<_Result>{};
+        }
+
+        // Note: A dropped task completes its future as expired, so that get() never blocks forever.
+        //       A task may wait for another one in either mode, while it waits its thread runs
+        //       the tasks queued on it (the awaited one may be among them). The wait never ends
+        //       only if the awaited task is queued on a suspended thread.
+        const task_options _Task_options = {_Options.priority, _Options.deadline, &_State::_Drop};
+        if (!submit_task(&_State::_Run, _Ptr, _Task_options)) { // never runs, drop both references
+            _Ptr->_Release();
+            _Ptr->_Release();
+            return task_future<_Result>{};
+        }
+
+        return task_future<_Result>(_Ptr);
+    }
+
     // tries to suspend the thread-pool
     _NODISCARD bool suspend() noexcept;
 
@@ -153,12 +238,49 @@ private:
         _Working
     };
 
+    // tries to start the work-stealing scheduler with _Workers workers, the threads of the thread-pool
+    // run the first ones, the rest is elastic
+    _NODISCARD bool _Start_scheduler(
+        const size_t _Workers, const _Work_stealing_elasticity& _Elasticity) noexcept;
+
+    // destroys the work-stealing scheduler
+    void _Release_scheduler() noexcept;
+
     _Thread_list _Mylist;
     _Internal_state _Mystate;
+    _Work_stealing_scheduler* _Mysched; // used only in thread_pool_mode::work_stealing
 };
 
 // FUNCTION default_thread_pool
 _SDSDLL_API _NODISCARD thread_pool& default_thread_pool() noexcept;
+
+// ALIAS _Parallel_range_task_t
+using _Parallel_range_task_t = void(__stdcall*)(const size_t, const size_t, void* const) noexcept;
+
+// STRUCT _Parallel_job
+struct _Parallel_job {
+    _Parallel_range_task_t _Task;
+    void* _Data;
+    size_t _First;
+    size_t _Last;
+    size_t _Grain; // the smallest number of indexes claimed at once
+    size_t _Participants; // the caller and the submitted tasks
+    atomic<size_t> _Next; // first index to be claimed
+    atomic<size_t> _Done; // number of finished indexes
+    atomic<size_t> _Refs; // number of owners (the caller and the submitted tasks)
+};
+
+// FUNCTION _Claim_parallel_range
+extern _NODISCARD bool _Claim_parallel_range(
+    _Parallel_job* const _Job, size_t& _First, size_t& _Last) noexcept;
+
+// FUNCTION _Parallel_job_task
+extern void __stdcall _Parallel_job_task(void* const _Data) noexcept;
+
+// FUNCTION _Parallel_invoke_range
+extern void _Parallel_invoke_range(thread_pool& _Pool, const size_t _First, const size_t _Last,
+    const size_t _Grain, const _Parallel_range_task_t _Task, void* const _Data,
+    const task_priority _Priority = task_priority::normal) noexcept;
 _SDSDLL_END
 
 #endif // _SDSDLL_PREPROCESSOR_GUARD
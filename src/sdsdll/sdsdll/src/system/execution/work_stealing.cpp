@@ -0,0 +1,507 @@
+// work_stealing.cpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <build/sdsdll_pch.hpp>
+#include <system/execution/work_stealing.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+
+_SDSDLL_BEGIN
+// FUNCTION _Work_stealing_deque constructor/destructor
+_Work_stealing_deque::_Work_stealing_deque() noexcept : _Mytop(0), _Mybottom(0), _Myslots() {}
+
+_Work_stealing_deque::~_Work_stealing_deque() noexcept {}
+
+// FUNCTION _Work_stealing_deque::_Read_slot
+_NODISCARD _Thread_task_data _Work_stealing_deque::_Read_slot(const int64_t _Idx) const noexcept {
+    // Note: A thief may read a slot that the owner is overwriting at the same time. The value is
+    //       discarded in that case (the thief's CAS on the top fails), the slots are atomic only
+    //       to make the read itself well-defined.
+    const _Slot& _Target = _Myslots[static_cast<size_t>(_Idx) & _Mask];
+    return _Thread_task_data{_Target._Task.load(_STD memory_order_relaxed),
+        _Target._Data.load(_STD memory_order_relaxed), _Target._Queued.load(_STD memory_order_relaxed),
+        _Target._Deadline.load(_STD memory_order_relaxed), _Target._Expired.load(_STD memory_order_relaxed)};
+}
+
+// FUNCTION _Work_stealing_deque::_Empty
+_NODISCARD bool _Work_stealing_deque::_Empty() const noexcept {
+    return _Mybottom.load() <= _Mytop.load();
+}
+
+// FUNCTION _Work_stealing_deque::_Size
+_NODISCARD size_t _Work_stealing_deque::_Size() const noexcept {
+    const int64_t _Bottom = _Mybottom.load(_STD memory_order_relaxed);
+    const int64_t _Top    = _Mytop.load(_STD memory_order_relaxed);
+    return _Bottom > _Top ? static_cast<size_t>(_Bottom - _Top) : 0;
+}
+
+// FUNCTION _Work_stealing_deque::_Push
+_NODISCARD bool _Work_stealing_deque::_Push(const _Thread_task_data& _Task) noexcept {
+    const int64_t _Bottom = _Mybottom.load(_STD memory_order_relaxed);
+    const int64_t _Top    = _Mytop.load(_STD memory_order_acquire);
+    if (_Bottom - _Top >= static_cast<int64_t>(_Work_stealing_deque_capacity)) { // the deque is full
+        return false;
+    }
+
+    _Slot& _Target = _Myslots[static_cast<size_t>(_Bottom) & _Mask];
+    _Target._Task.store(_Task._Task, _STD memory_order_relaxed);
+    _Target._Data.store(_Task._Data, _STD memory_order_relaxed);
+    _Target._Queued.store(_Task._Queued, _STD memory_order_relaxed);
+    _Target._Deadline.store(_Task._Deadline, _STD memory_order_relaxed);
+    _Target._Expired.store(_Task._Expired, _STD memory_order_relaxed);
+    _STD atomic_thread_fence(_STD memory_order_release); // publish the slot before the new bottom
+    _Mybottom.store(_Bottom + 1, _STD memory_order_relaxed);
+    return true;
+}
+
+// FUNCTION _Work_stealing_deque::_Pop
+_NODISCARD bool _Work_stealing_deque::_Pop(_Thread_task_data& _Task) noexcept {
+    // Note: The bottom is reserved before the top is read, the full fence makes sure that a thief
+    //       either sees the reservation or the owner sees the thief's top. Only the last task
+    //       can be contested, it goes to whoever advances the top first.
+    const int64_t _Bottom = _Mybottom.load(_STD memory_order_relaxed) - 1;
+    _Mybottom.store(_Bottom, _STD memory_order_relaxed);
+    _STD atomic_thread_fence(_STD memory_order_seq_cst);
+    int64_t _Top = _Mytop.load(_STD memory_order_relaxed);
+    if (_Top > _Bottom) { // the deque is empty, restore the bottom
+        _Mybottom.store(_Bottom + 1, _STD memory_order_relaxed);
+        return false;
+    }
+
+    _Task = _Read_slot(_Bottom);
+    if (_Top == _Bottom) { // the last task, race with the thieves
+        const bool _Won = _Mytop.compare_exchange_strong(
+            _Top, _Top + 1, _STD memory_order_seq_cst, _STD memory_order_relaxed);
+        _Mybottom.store(_Bottom + 1, _STD memory_order_relaxed);
+        return _Won;
+    }
+
+    return true;
+}
+
+// FUNCTION _Work_stealing_deque::_Steal
+_NODISCARD bool _Work_stealing_deque::_Steal(_Thread_task_data& _Task) noexcept {
+    int64_t _Top = _Mytop.load(_STD memory_order_acquire);
+    _STD atomic_thread_fence(_STD memory_order_seq_cst);
+    const int64_t _Bottom = _Mybottom.load(_STD memory_order_acquire);
+    if (_Top >= _Bottom) { // the deque is empty
+        return false;
+    }
+
+    _Task = _Read_slot(_Top);
+    return _Mytop.compare_exchange_strong(
+        _Top, _Top + 1, _STD memory_order_seq_cst, _STD memory_order_relaxed);
+}
+
+// FUNCTION _Work_stealing_worker constructor/destructor
+_Work_stealing_worker::_Work_stealing_worker() noexcept
+    : _Deque(), _Wakeup(), _Sleeping(false), _Owner(nullptr), _Index(0), _Victim(0), _Ticks(0),
+      _Telemetry(), _Status(_Worker_stopped), _Handle(nullptr) {}
+
+_Work_stealing_worker::~_Work_stealing_worker() noexcept {}
+
+// FUNCTION _Current_work_stealing_context
+_NODISCARD _Work_stealing_context& _Current_work_stealing_context() noexcept {
+    thread_local _Work_stealing_context _Context = {nullptr, nullptr};
+    return _Context;
+}
+
+// FUNCTION _Work_stealing_worker_task
+void __stdcall _Work_stealing_worker_task(void* const _Data) noexcept {
+    // Note: This task occupies the thread until the scheduler is stopped. The context lets
+    //       the tasks that run on this thread submit new tasks to its own deque.
+    _Work_stealing_worker* const _Worker = static_cast<_Work_stealing_worker*>(_Data);
+    _Work_stealing_context& _Context     = _SDSDLL _Current_work_stealing_context();
+    _Context                             = _Work_stealing_context{_Worker->_Owner, _Worker};
+    _Worker->_Owner->_Run(*_Worker);
+    _Context = _Work_stealing_context{nullptr, nullptr};
+}
+
+// FUNCTION _Work_stealing_elastic_thread
+DWORD __stdcall _Work_stealing_elastic_thread(void* const _Data) noexcept {
+    // Note: The CreateThread() requires the thread routine to return a DWORD. The worker loop
+    //       returns once the worker retires or the scheduler is stopped. The thread that started
+    //       this one publishes the handle before it marks the worker as running, so the worker
+    //       must not be marked as stopped before that, otherwise the handle could be lost.
+    _Work_stealing_worker* const _Worker = static_cast<_Work_stealing_worker*>(_Data);
+    _Work_stealing_worker_task(_Worker);
+    _Work_stealing_worker_status _Status = _Worker->_Status.load();
+    while (_Status == _Worker_starting) {
+        ::WaitOnAddress(_SDSDLL addressof(_Worker->_Status), &_Status, sizeof(_Status), INFINITE);
+        _Status = _Worker->_Status.load();
+    }
+
+    _Worker->_Owner->_Retired();
+    _Worker->_Status.store(_Worker_stopped);
+    return 0;
+}
+
+// FUNCTION _Work_stealing_scheduler constructor/destructor
+_Work_stealing_scheduler::_Work_stealing_scheduler() noexcept
+    : _Myworkers(nullptr), _Mycount(0), _Myinjection(), _Myurgent(), _Myidle(0), _Myrunning(0),
+      _Mystop(false), _Mysuspended(false), _Myelasticity{0, INFINITE, 0, 0} {}
+
+_Work_stealing_scheduler::~_Work_stealing_scheduler() noexcept {
+    _Release();
+}
+
+// FUNCTION _Work_stealing_scheduler::_Release
+void _Work_stealing_scheduler::_Release() noexcept {
+    if (_Myworkers) {
+        _Join_elastic(); // the elastic workers run on threads that the scheduler owns
+        _Thread_task_data _Task = {nullptr, nullptr, 0, 0, nullptr};
+        for (size_t _Idx = 0; _Idx < _Mycount; ++_Idx) { // no worker runs, any thread may pop
+            while (_Myworkers[_Idx]._Deque._Steal(_Task)) {
+                if (_Task._Expired) {
+                    (*_Task._Expired)(_Task._Data);
+                }
+            }
+        }
+
+        _Myurgent._Clear();
+        _Myinjection._Clear();
+        for (size_t _Idx = 0; _Idx < _Mycount; ++_Idx) {
+            _Myworkers[_Idx].~_Work_stealing_worker();
+        }
+
+        allocator<_Work_stealing_worker>{}.deallocate(_Myworkers, _Mycount);
+        _Myworkers = nullptr;
+        _Mycount   = 0;
+    }
+}
+
+// FUNCTION _Work_stealing_scheduler::_Create
+_NODISCARD bool _Work_stealing_scheduler::_Create(const size_t _Count) noexcept {
+    if (_Myworkers || _Count == 0) { // already created or nothing to create
+        return false;
+    }
+
+    _Myworkers = allocator<_Work_stealing_worker>{}.allocate(_Count);
+    if (!_Myworkers) { // allocation failed
+        return false;
+    }
+
+    _Mycount      = _Count;
+    _Myelasticity = _Work_stealing_elasticity{_Count, INFINITE, 0, 0}; // no elastic workers
+    _Myrunning.store(_Count, _STD memory_order_relaxed);
+    for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+        _Work_stealing_worker* const _Worker = ::new (_Myworkers + _Idx) _Work_stealing_worker;
+        _Worker->_Owner                      = this;
+        _Worker->_Index                      = _Idx;
+        _Worker->_Victim                     = (_Idx + 1) % _Count;
+    }
+
+    return true;
+}
+
+// FUNCTION _Work_stealing_scheduler::_Make_elastic
+void _Work_stealing_scheduler::_Make_elastic(const _Work_stealing_elasticity& _Elasticity) noexcept {
+    _Myelasticity            = _Elasticity;
+    _Myelasticity._Permanent = (_STD min)(_Elasticity._Permanent, _Mycount);
+    _Myrunning.store(_Myelasticity._Permanent, _STD memory_order_relaxed);
+}
+
+// FUNCTION _Work_stealing_scheduler::_Elastic
+_NODISCARD bool _Work_stealing_scheduler::_Elastic() const noexcept {
+    return _Myelasticity._Permanent < _Mycount;
+}
+
+// FUNCTION _Work_stealing_scheduler::_Workers
+_NODISCARD size_t _Work_stealing_scheduler::_Workers() const noexcept {
+    return _Mycount;
+}
+
+// FUNCTION _Work_stealing_scheduler::_Running
+_NODISCARD size_t _Work_stealing_scheduler::_Running() const noexcept {
+    return _Myrunning.load(_STD memory_order_relaxed);
+}
+
+// FUNCTION _Work_stealing_scheduler::_Retired
+void _Work_stealing_scheduler::_Retired() noexcept {
+    _Myrunning.fetch_sub(1, _STD memory_order_relaxed);
+}
+
+// FUNCTION _Work_stealing_scheduler::_Worker
+_NODISCARD _Work_stealing_worker* _Work_stealing_scheduler::_Worker(const size_t _Idx) noexcept {
+    return _Idx < _Mycount ? _Myworkers + _Idx : nullptr;
+}
+
+_NODISCARD const _Work_stealing_worker* _Work_stealing_scheduler::_Worker(
+    const size_t _Idx) const noexcept {
+    return _Idx < _Mycount ? _Myworkers + _Idx : nullptr;
+}
+
+// FUNCTION _Work_stealing_scheduler::_Queued
+_NODISCARD size_t _Work_stealing_scheduler::_Queued() const noexcept {
+    size_t _Count = _Myurgent._Size() + _Myinjection._Size();
+    for (size_t _Idx = 0; _Idx < _Mycount; ++_Idx) {
+        _Count += _Myworkers[_Idx]._Deque._Size();
+    }
+
+    return _Count;
+}
+
+// FUNCTION _Work_stealing_scheduler::_Submit
+_NODISCARD bool _Work_stealing_scheduler::_Submit(
+    const _Thread_task_t _Task, void* const _Data, const task_options& _Options) noexcept {
+    if (!_Task || _Mystop.load(_STD memory_order_acquire)) {
+        return false;
+    }
+
+    // Note: A task submitted by one of the workers goes to its own deque, where it stays hot in
+    //       the worker's cache and is visible to the thieves. Other threads (and workers whose
+    //       deque is full) use the shared injection queue. The urgent tasks always use their own
+    //       queue, which every worker checks before anything else.
+    const _Work_stealing_context& _Context = _SDSDLL _Current_work_stealing_context();
+    const _Thread_task_data _Item          = _SDSDLL _Make_thread_task_data(_Task, _Data, _Options);
+    if (_Options.priority == task_priority::high) {
+        _Myurgent._Push(_Item);
+    } else if (_Context._Scheduler != this || !_Context._Worker->_Deque._Push(_Item)) {
+        _Myinjection._Push(_Item);
+    }
+
+    // Note: Pairs with the fence in _Idle(), either the worker sees the new task, or the submitter
+    //       sees the worker's announcement and wakes it.
+    _STD atomic_thread_fence(_STD memory_order_seq_cst);
+    if (_Myidle.load(_STD memory_order_relaxed) > 0) {
+        _Wake_one();
+    } else if (_Elastic()) { // all running workers are busy, check if the queue grows too long
+        const size_t _Running = _Myrunning.load(_STD memory_order_relaxed);
+        const size_t _Waiting = _Myurgent._Size() + _Myinjection._Size();
+        if (_Waiting >= _Myelasticity._Depth_threshold * (_Running > 0 ? _Running : 1)) {
+            _Grow();
+        }
+    }
+
+    return true;
+}
+
+// FUNCTION _Work_stealing_scheduler::_Suspend
+void _Work_stealing_scheduler::_Suspend() noexcept {
+    _Mysuspended.store(true, _STD memory_order_release);
+}
+
+// FUNCTION _Work_stealing_scheduler::_Resume
+void _Work_stealing_scheduler::_Resume() noexcept {
+    _Mysuspended.store(false, _STD memory_order_release);
+    _Wake_all();
+}
+
+// FUNCTION _Work_stealing_scheduler::_Stop
+void _Work_stealing_scheduler::_Stop() noexcept {
+    // Note: The workers finish their current tasks and return, the tasks that are still waiting
+    //       are discarded, just like the queue of a terminated thread.
+    _Mystop.store(true, _STD memory_order_release);
+    _Wake_all();
+}
+
+// FUNCTION _Work_stealing_scheduler::_Find_task
+_NODISCARD bool _Work_stealing_scheduler::_Find_task(
+    _Work_stealing_worker& _Worker, _Thread_task_data& _Task) noexcept {
+    // Note: The urgent tasks are strictly preferred, a normal task runs only if no urgent one waits.
+    //       The injection queue is checked first from time to time, otherwise tasks that keep
+    //       submitting new tasks could starve the tasks submitted by other threads.
+    if (_Myurgent._Pop(_Task)) {
+        return true;
+    }
+
+    if (++_Worker._Ticks % _Work_stealing_injection_interval == 0 && _Myinjection._Pop(_Task)) {
+        return true;
+    }
+
+    if (_Worker._Deque._Pop(_Task) || _Myinjection._Pop(_Task)) {
+        return true;
+    }
+
+    for (size_t _Attempt = 0; _Attempt < _Mycount; ++_Attempt) { // try each other worker once
+        const size_t _Victim = _Worker._Victim;
+        _Worker._Victim      = (_Victim + 1) % _Mycount;
+        if (_Victim != _Worker._Index && _Myworkers[_Victim]._Deque._Steal(_Task)) {
+            _Worker._Telemetry._Task_stolen();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// FUNCTION _Work_stealing_scheduler::_Has_work
+_NODISCARD bool _Work_stealing_scheduler::_Has_work() const noexcept {
+    if (!_Myurgent._Empty() || !_Myinjection._Empty()) {
+        return true;
+    }
+
+    for (size_t _Idx = 0; _Idx < _Mycount; ++_Idx) {
+        if (!_Myworkers[_Idx]._Deque._Empty()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// FUNCTION _Work_stealing_scheduler::_Idle
+_NODISCARD bool _Work_stealing_scheduler::_Idle(_Work_stealing_worker& _Worker) noexcept {
+    // Note: The worker announces that it is going to sleep and only then checks for work once
+    //       again. A task that is submitted after the check sees the announcement and unparks
+    //       the worker, so a wake-up is never lost.
+    _Worker._Sleeping.store(true, _STD memory_order_relaxed);
+    _Myidle.fetch_add(1, _STD memory_order_relaxed);
+    _STD atomic_thread_fence(_STD memory_order_seq_cst);
+    const bool _Cancel = _Mystop.load(_STD memory_order_relaxed)
+                      || (!_Mysuspended.load(_STD memory_order_relaxed) && _Has_work());
+    bool _Timed_out = false;
+    if (!_Cancel) {
+        const uint64_t _Parked = _Worker._Telemetry._Parking();
+        if (_Worker._Index < _Myelasticity._Permanent) {
+            _Worker._Wakeup._Park();
+        } else { // an elastic worker waits only for a limited time
+            _Timed_out = !_Worker._Wakeup._Park_for(_Myelasticity._Idle_timeout);
+        }
+
+        _Worker._Telemetry._Unparked(_Parked);
+    }
+
+    if (!_Worker._Sleeping.exchange(false, _STD memory_order_acq_rel)) { // woken by _Wake_one()
+        return false;
+    }
+
+    _Myidle.fetch_sub(1, _STD memory_order_relaxed);
+    if (!_Timed_out || _Mystop.load(_STD memory_order_relaxed)) {
+        return false;
+    }
+
+    // Note: Nobody has woken the worker up for the whole timeout, so it retires. The queues are
+    //       checked once again, a task submitted after the worker stopped being counted as idle
+    //       is not lost, but it could wait until another worker looks for a task.
+    _STD atomic_thread_fence(_STD memory_order_seq_cst);
+    return !_Has_work();
+}
+
+// FUNCTION _Work_stealing_scheduler::_Grow
+void _Work_stealing_scheduler::_Grow() noexcept {
+    // Note: The first stopped elastic worker is claimed, so that concurrent submissions never start
+    //       the same worker twice. The thread of its previous run (if any) has already returned
+    //       from the worker loop, so waiting for it takes no time, its handle is closed here.
+    for (size_t _Idx = _Myelasticity._Permanent; _Idx < _Mycount; ++_Idx) {
+        _Work_stealing_worker& _Worker        = _Myworkers[_Idx];
+        _Work_stealing_worker_status _Expected = _Worker_stopped;
+        if (_Worker._Status.load(_STD memory_order_relaxed) != _Worker_stopped
+            || !_Worker._Status.compare_exchange_strong(_Expected, _Worker_starting)) {
+            continue;
+        }
+
+        if (_Mystop.load()) { // the scheduler is being stopped, never start new threads
+            _Worker._Status.store(_Worker_stopped);
+            return;
+        }
+
+        if (_Worker._Handle) {
+            ::WaitForSingleObject(_Worker._Handle, INFINITE);
+            ::CloseHandle(_Worker._Handle);
+        }
+
+        _Myrunning.fetch_add(1, _STD memory_order_relaxed);
+        _Worker._Handle = ::CreateThread(nullptr, 0, _Work_stealing_elastic_thread,
+            _SDSDLL addressof(_Worker), 0, nullptr);
+        if (!_Worker._Handle) { // creation failed
+            _Myrunning.fetch_sub(1, _STD memory_order_relaxed);
+            _Worker._Status.store(_Worker_stopped);
+            return;
+        }
+
+        _Worker._Status.store(_Worker_running);
+        ::WakeByAddressAll(_SDSDLL addressof(_Worker._Status));
+        return;
+    }
+}
+
+// FUNCTION _Work_stealing_scheduler::_Join_elastic
+void _Work_stealing_scheduler::_Join_elastic() noexcept {
+    // Note: The scheduler is stopped at this point, so no worker is claimed anymore, but a thread
+    //       may still be starting. Wait until it publishes its handle and then for the thread itself.
+    //       While the library is being unloaded, the loader lock is held. The threads then are either
+    //       terminated already (the process exits) or cannot exit without that lock, so they are
+    //       never waited for, otherwise the wait could deadlock.
+    const bool _Join = !_SDSDLL _Process_detaching().load(_STD memory_order_relaxed);
+    for (size_t _Idx = _Myelasticity._Permanent; _Idx < _Mycount; ++_Idx) {
+        _Work_stealing_worker& _Worker       = _Myworkers[_Idx];
+        _Work_stealing_worker_status _Status = _Worker._Status.load();
+        while (_Join && _Status == _Worker_starting) {
+            ::WaitOnAddress(_SDSDLL addressof(_Worker._Status), &_Status, sizeof(_Status), INFINITE);
+            _Status = _Worker._Status.load();
+        }
+
+        if (_Worker._Handle) {
+            if (_Join) {
+                ::WaitForSingleObject(_Worker._Handle, INFINITE);
+            }
+
+            ::CloseHandle(_Worker._Handle);
+            _Worker._Handle = nullptr;
+        }
+    }
+}
+
+// FUNCTION _Work_stealing_scheduler::_Wake_one
+void _Work_stealing_scheduler::_Wake_one() noexcept {
+    for (size_t _Idx = 0; _Idx < _Mycount; ++_Idx) {
+        _Work_stealing_worker& _Worker = _Myworkers[_Idx];
+        if (_Worker._Sleeping.load(_STD memory_order_relaxed)
+            && _Worker._Sleeping.exchange(false, _STD memory_order_acq_rel)) {
+            _Myidle.fetch_sub(1, _STD memory_order_relaxed);
+            _Worker._Telemetry._Woken();
+            _Worker._Wakeup._Unpark();
+            return;
+        }
+    }
+}
+
+// FUNCTION _Work_stealing_scheduler::_Wake_all
+void _Work_stealing_scheduler::_Wake_all() noexcept {
+    for (size_t _Idx = 0; _Idx < _Mycount; ++_Idx) {
+        _Work_stealing_worker& _Worker = _Myworkers[_Idx];
+        if (_Worker._Sleeping.exchange(false, _STD memory_order_acq_rel)) {
+            _Myidle.fetch_sub(1, _STD memory_order_relaxed);
+        }
+
+        _Worker._Wakeup._Unpark();
+    }
+}
+
+// FUNCTION _Work_stealing_scheduler::_Run
+void _Work_stealing_scheduler::_Run(_Work_stealing_worker& _Worker) noexcept {
+    while (!_Mystop.load(_STD memory_order_acquire)) {
+        if (!_Run_one(_Worker) && _Idle(_Worker)) { // the elastic worker retires
+            break;
+        }
+    }
+}
+
+// FUNCTION _Work_stealing_scheduler::_Run_one
+_NODISCARD bool _Work_stealing_scheduler::_Run_one(_Work_stealing_worker& _Worker) noexcept {
+    _Thread_task_data _Task = {nullptr, nullptr, 0, 0, nullptr};
+    if (_Mystop.load(_STD memory_order_acquire) || _Mysuspended.load(_STD memory_order_acquire)
+        || !_Find_task(_Worker, _Task)) {
+        return false;
+    }
+
+    if (_SDSDLL _Drop_expired_task(_Task)) {
+        _Worker._Telemetry._Task_expired();
+        return true;
+    }
+
+    const uint64_t _Started = _Worker._Telemetry._Task_started(_Task._Queued);
+    if (_Elastic() && _Myidle.load(_STD memory_order_relaxed) == 0 && _Started > _Task._Queued
+        && _SDSDLL _Telemetry_ticks_to_ns(_Started - _Task._Queued) >= _Myelasticity._Wait_threshold) {
+        _Grow(); // the task has waited too long, while all running workers were busy
+    }
+
+    (*_Task._Task)(_Task._Data);
+    _Worker._Telemetry._Task_finished(_Started);
+    return true;
+}
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
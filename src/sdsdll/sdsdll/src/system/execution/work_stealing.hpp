@@ -0,0 +1,218 @@
+// work_stealing.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SDSDLL_SYSTEM_EXECUTION_WORK_STEALING_HPP_
+#define _SDSDLL_SYSTEM_EXECUTION_WORK_STEALING_HPP_
+#include <core/defs.hpp>
+#if _SDSDLL_PREPROCESSOR_GUARD
+#include <atomic>
+#include <core/memory/allocator.hpp>
+#include <core/traits/type_traits.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <minwindef.h>
+#include <processthreadsapi.h>
+#include <synchapi.h>
+#include <system/execution/parker.hpp>
+#include <system/execution/telemetry.hpp>
+#include <system/execution/thread.hpp>
+
+// STD types
+using _STD atomic;
+
+_SDSDLL_BEGIN
+// CONSTANT _Work_stealing_deque_capacity
+inline constexpr size_t _Work_stealing_deque_capacity = 1024; // must be a power of 2
+
+// CONSTANT _Work_stealing_injection_interval
+inline constexpr size_t _Work_stealing_injection_interval = 61; // searches between forced injection checks
+
+// CLASS _Work_stealing_deque
+class _Work_stealing_deque { // bounded Chase-Lev deque, the owner works at the bottom, thieves at the top
+public:
+    _Work_stealing_deque() noexcept;
+    ~_Work_stealing_deque() noexcept;
+
+    _Work_stealing_deque(const _Work_stealing_deque&) = delete;
+    _Work_stealing_deque& operator=(const _Work_stealing_deque&) = delete;
+
+    // checks if the deque seems to be empty
+    _NODISCARD bool _Empty() const noexcept;
+
+    // returns the approximate number of tasks
+    _NODISCARD size_t _Size() const noexcept;
+
+    // pushes a task at the bottom (owner only), fails if the deque is full
+    _NODISCARD bool _Push(const _Thread_task_data& _Task) noexcept;
+
+    // pops the last pushed task (owner only)
+    _NODISCARD bool _Pop(_Thread_task_data& _Task) noexcept;
+
+    // steals the first pushed task (any thread)
+    _NODISCARD bool _Steal(_Thread_task_data& _Task) noexcept;
+
+private:
+    static constexpr size_t _Mask = _Work_stealing_deque_capacity - 1;
+
+    struct _Slot {
+        atomic<_Thread_task_t> _Task;
+        atomic<void*> _Data;
+        atomic<uint64_t> _Queued;
+        atomic<uint64_t> _Deadline;
+        atomic<_Thread_task_t> _Expired;
+    };
+
+    // reads the selected slot
+    _NODISCARD _Thread_task_data _Read_slot(const int64_t _Idx) const noexcept;
+
+    alignas(64) atomic<int64_t> _Mytop; // next task to be stolen
+    alignas(64) atomic<int64_t> _Mybottom; // next free slot
+    alignas(64) _Slot _Myslots[_Work_stealing_deque_capacity];
+};
+
+class _Work_stealing_scheduler;
+
+// ENUM _Work_stealing_worker_status
+enum _Work_stealing_worker_status : unsigned char {
+    _Worker_stopped, // no thread runs the worker
+    _Worker_starting, // a thread is being started for the worker
+    _Worker_running // a thread runs the worker
+};
+
+// STRUCT _Work_stealing_worker
+struct _Work_stealing_worker {
+    _Work_stealing_worker() noexcept;
+    ~_Work_stealing_worker() noexcept;
+
+    _Work_stealing_deque _Deque; // tasks submitted by this worker
+    _Parker _Wakeup; // parks the worker while there is nothing to do
+    atomic<bool> _Sleeping; // true if the worker is parked (or about to park)
+    _Work_stealing_scheduler* _Owner;
+    size_t _Index; // position in the scheduler
+    size_t _Victim; // next worker to steal from
+    size_t _Ticks; // number of searches for a task
+    _Worker_telemetry _Telemetry;
+    atomic<_Work_stealing_worker_status> _Status; // used only by the elastic workers
+    void* _Handle; // thread of an elastic worker, owned by the thread that starts it
+};
+
+// STRUCT _Work_stealing_elasticity
+struct _Work_stealing_elasticity {
+    size_t _Permanent; // workers that run on the threads of the thread-pool, the rest is elastic
+    DWORD _Idle_timeout; // milliseconds after which an idle elastic worker retires
+    uint64_t _Wait_threshold; // nanoseconds a task may wait before another worker is started
+    size_t _Depth_threshold; // waiting tasks per running worker that start another worker
+};
+
+// STRUCT _Work_stealing_context
+struct _Work_stealing_context {
+    _Work_stealing_scheduler* _Scheduler; // scheduler of the current worker (null outside workers)
+    _Work_stealing_worker* _Worker; // current worker
+};
+
+// FUNCTION _Current_work_stealing_context
+extern _NODISCARD _Work_stealing_context& _Current_work_stealing_context() noexcept;
+
+// FUNCTION _Work_stealing_worker_task
+extern void __stdcall _Work_stealing_worker_task(void* const _Data) noexcept;
+
+// FUNCTION _Work_stealing_elastic_thread
+extern DWORD __stdcall _Work_stealing_elastic_thread(void* const _Data) noexcept;
+
+// CLASS _Work_stealing_scheduler
+class _Work_stealing_scheduler { // distributes tasks between workers that steal from each other
+public:
+    _Work_stealing_scheduler() noexcept;
+    ~_Work_stealing_scheduler() noexcept;
+
+    _Work_stealing_scheduler(const _Work_stealing_scheduler&) = delete;
+    _Work_stealing_scheduler& operator=(const _Work_stealing_scheduler&) = delete;
+
+    // allocates _Count workers
+    _NODISCARD bool _Create(const size_t _Count) noexcept;
+
+    // makes the workers above _Elasticity._Permanent elastic (must be called before any worker runs)
+    void _Make_elastic(const _Work_stealing_elasticity& _Elasticity) noexcept;
+
+    // checks if some workers are elastic
+    _NODISCARD bool _Elastic() const noexcept;
+
+    // returns the number of workers
+    _NODISCARD size_t _Workers() const noexcept;
+
+    // returns the number of running workers
+    _NODISCARD size_t _Running() const noexcept;
+
+    // records that an elastic worker has retired
+    void _Retired() noexcept;
+
+    // returns the selected worker
+    _NODISCARD _Work_stealing_worker* _Worker(const size_t _Idx) noexcept;
+
+    // returns the non-mutable selected worker
+    _NODISCARD const _Work_stealing_worker* _Worker(const size_t _Idx) const noexcept;
+
+    // returns the approximate number of waiting tasks
+    _NODISCARD size_t _Queued() const noexcept;
+
+    // submits a new task
+    _NODISCARD bool _Submit(
+        const _Thread_task_t _Task, void* const _Data, const task_options& _Options) noexcept;
+
+    // stops handing out tasks until resumed
+    void _Suspend() noexcept;
+
+    // resumes handing out tasks
+    void _Resume() noexcept;
+
+    // makes all workers return from _Run()
+    void _Stop() noexcept;
+
+    // runs the worker loop until stopped
+    void _Run(_Work_stealing_worker& _Worker) noexcept;
+
+    // runs one waiting task (if any) on the selected worker
+    _NODISCARD bool _Run_one(_Work_stealing_worker& _Worker) noexcept;
+
+private:
+    // tries to find a task for the selected worker
+    _NODISCARD bool _Find_task(_Work_stealing_worker& _Worker, _Thread_task_data& _Task) noexcept;
+
+    // checks if any task is waiting
+    _NODISCARD bool _Has_work() const noexcept;
+
+    // parks the selected worker until a task is submitted, returns true if the worker should retire
+    _NODISCARD bool _Idle(_Work_stealing_worker& _Worker) noexcept;
+
+    // starts one of the stopped elastic workers (if any)
+    void _Grow() noexcept;
+
+    // waits for the threads of the elastic workers
+    void _Join_elastic() noexcept;
+
+    // wakes one parked worker (if any)
+    void _Wake_one() noexcept;
+
+    // wakes all workers
+    void _Wake_all() noexcept;
+
+    // discards the waiting tasks and destroys all workers
+    void _Release() noexcept;
+
+    _Work_stealing_worker* _Myworkers;
+    size_t _Mycount;
+    _Thread_task_queue _Myinjection; // tasks submitted by other threads
+    _Thread_task_queue _Myurgent; // tasks with task_priority::high, submitted by any thread
+    atomic<size_t> _Myidle; // number of parked workers
+    atomic<size_t> _Myrunning; // number of running workers
+    atomic<bool> _Mystop;
+    atomic<bool> _Mysuspended;
+    _Work_stealing_elasticity _Myelasticity;
+};
+_SDSDLL_END
+
+#endif // _SDSDLL_PREPROCESSOR_GUARD
+#endif // _SDSDLL_SYSTEM_EXECUTION_WORK_STEALING_HPP_
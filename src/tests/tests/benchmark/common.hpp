@@ -0,0 +1,54 @@
+// common.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _BENCHMARK_COMMON_HPP_
+#define _BENCHMARK_COMMON_HPP_
+#include <chrono>
+#include <core/defs.hpp>
+#include <cstddef>
+#include <cstdio>
+
+// Note: Benchmarks are registered as disabled tests, so that they do not slow down the unit tests.
+//       Run them with --gtest_also_run_disabled_tests --gtest_filter=benchmark_*.
+
+namespace tests {
+    // CLASS _Benchmark_timer
+    class _Benchmark_timer { // measures the elapsed time
+    public:
+        using clock = _STD chrono::steady_clock;
+
+        _Benchmark_timer() noexcept : _Mystart(clock::now()) {}
+
+        ~_Benchmark_timer() noexcept {}
+
+        // starts measuring again
+        void _Restart() noexcept {
+            _Mystart = clock::now();
+        }
+
+        // returns the elapsed time in nanoseconds
+        _NODISCARD double _Elapsed_ns() const noexcept {
+            return static_cast<double>(
+                _STD chrono::duration_cast<_STD chrono::nanoseconds>(clock::now() - _Mystart).count());
+        }
+
+    private:
+        clock::time_point _Mystart;
+    };
+
+    // FUNCTION _Report_benchmark
+    inline void _Report_benchmark(const char* const _Name, const size_t _Size, const double _Ns_per_op) noexcept {
+        _CSTD printf("[ BENCH    ] %-32s n = %-10zu %12.1f ns/op\n", _Name, _Size, _Ns_per_op);
+    }
+
+    // FUNCTION _Report_throughput
+    inline void _Report_throughput(
+        const char* const _Name, const size_t _Size, const double _Ops_per_sec) noexcept {
+        _CSTD printf("[ BENCH    ] %-32s n = %-10zu %12.0f ops/s\n", _Name, _Size, _Ops_per_sec);
+    }
+} // namespace tests
+
+#endif // _BENCHMARK_COMMON_HPP_
@@ -0,0 +1,70 @@
+// aes256_gcm.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _BENCHMARK_CRYPTOGRAPHY_CIPHER_SYMMETRIC_AES256_GCM_HPP_
+#define _BENCHMARK_CRYPTOGRAPHY_CIPHER_SYMMETRIC_AES256_GCM_HPP_
+#include <benchmark/common.hpp>
+#include <core/defs.hpp>
+#include <cryptography/cipher/symmetric/aes256_gcm.hpp>
+#include <cryptography/cipher/symmetric/iv.hpp>
+#include <cryptography/cipher/symmetric/session.hpp>
+#include <cryptography/cipher/symmetric/symmetric_key.hpp>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <string>
+
+// SDSDLL types
+using _SDSDLL aes256_gcm_session;
+using _SDSDLL aes256_gcm_traits;
+using _SDSDLL iv;
+using _SDSDLL symmetric_key;
+
+namespace tests {
+    // CONSTANT _Aes256_gcm_benchmark_rounds
+    inline constexpr size_t _Aes256_gcm_benchmark_rounds = 100'000;
+
+    // FUNCTION _Benchmark_aes256_gcm_traits
+    inline double _Benchmark_aes256_gcm_traits(const size_t _Size) {
+        using _Traits = aes256_gcm_traits<unsigned char>;
+        const symmetric_key<32> _Key; // the key does not matter here
+        const iv<12> _Iv = _SDSDLL make_iv<12>();
+        const _STD basic_string<unsigned char> _Data(_Size, static_cast<unsigned char>('x'));
+        _STD basic_string<unsigned char> _Buf(_Traits::bytes_count(_Size), static_cast<unsigned char>(0));
+        _Benchmark_timer _Timer;
+        for (size_t _Round = 0; _Round < _Aes256_gcm_benchmark_rounds; ++_Round) {
+            EXPECT_TRUE(_Traits::encrypt(_Buf.data(), _Buf.size(), _Data.c_str(), _Data.size(), _Key, _Iv));
+        }
+
+        return _Timer._Elapsed_ns() / static_cast<double>(_Aes256_gcm_benchmark_rounds);
+    }
+
+    // FUNCTION _Benchmark_aes256_gcm_session
+    inline double _Benchmark_aes256_gcm_session(const size_t _Size) {
+        const symmetric_key<32> _Key; // the key does not matter here
+        const iv<12> _Iv = _SDSDLL make_iv<12>();
+        const aes256_gcm_session<unsigned char> _Session(_Key);
+        EXPECT_TRUE(_Session.valid());
+        const _STD basic_string<unsigned char> _Data(_Size, static_cast<unsigned char>('x'));
+        _STD basic_string<unsigned char> _Buf(
+            aes256_gcm_traits<unsigned char>::bytes_count(_Size), static_cast<unsigned char>(0));
+        _Benchmark_timer _Timer;
+        for (size_t _Round = 0; _Round < _Aes256_gcm_benchmark_rounds; ++_Round) {
+            EXPECT_TRUE(_Session.encrypt(_Buf.data(), _Buf.size(), _Data.c_str(), _Data.size(), _Iv));
+        }
+
+        return _Timer._Elapsed_ns() / static_cast<double>(_Aes256_gcm_benchmark_rounds);
+    }
+
+    TEST(benchmark_cryptography, DISABLED_aes256_gcm_small_messages) {
+        static constexpr size_t _Sizes[] = {64, 256, 1024, 4096};
+        for (const size_t _Size : _Sizes) {
+            _Report_benchmark("aes256_gcm encrypt (per call)", _Size, _Benchmark_aes256_gcm_traits(_Size));
+            _Report_benchmark("aes256_gcm encrypt (session)", _Size, _Benchmark_aes256_gcm_session(_Size));
+        }
+    }
+} // namespace tests
+
+#endif // _BENCHMARK_CRYPTOGRAPHY_CIPHER_SYMMETRIC_AES256_GCM_HPP_
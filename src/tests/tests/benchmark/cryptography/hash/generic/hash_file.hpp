@@ -0,0 +1,82 @@
+// hash_file.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _BENCHMARK_CRYPTOGRAPHY_HASH_GENERIC_HASH_FILE_HPP_
+#define _BENCHMARK_CRYPTOGRAPHY_HASH_GENERIC_HASH_FILE_HPP_
+#include <benchmark/common.hpp>
+#include <core/defs.hpp>
+#include <cryptography/hash/generic.hpp>
+#include <cryptography/hash/generic/blake3.hpp>
+#include <cryptography/hash/generic/sha512.hpp>
+#include <cryptography/hash/generic/xxhash.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem/file.hpp>
+#include <gtest/gtest.h>
+#include <string>
+
+// SDSDLL types
+using _SDSDLL blake3_traits;
+using _SDSDLL file;
+using _SDSDLL sha512_traits;
+using _SDSDLL xxhash_traits;
+
+namespace tests {
+    // FUNCTION _Make_benchmark_file
+    inline void _Make_benchmark_file(const wchar_t* const _Target, const uint64_t _Size) {
+        file _File(_Target, _SDSDLL file_access::all,
+            _SDSDLL file_share::none, _SDSDLL file_disposition::force_create);
+        ASSERT_TRUE(_File.is_open());
+        const _STD basic_string<uint8_t> _Chunk(1048576, static_cast<uint8_t>(0xAB)); // 1 MiB chunk
+        for (uint64_t _Written = 0; _Written < _Size; _Written += _Chunk.size()) {
+            ASSERT_TRUE(_File.write(_Chunk));
+        }
+    }
+
+    // FUNCTION TEMPLATE _Benchmark_hash_file
+    template <class _Traits>
+    inline double _Benchmark_hash_file(const wchar_t* const _Target) {
+        file _File(_Target, _SDSDLL file_access::read);
+        EXPECT_TRUE(_File.is_open());
+        _Benchmark_timer _Timer;
+        EXPECT_FALSE(_SDSDLL hash_file<_Traits>(_File).empty());
+        return _Timer._Elapsed_ns();
+    }
+
+    // FUNCTION _Benchmark_blake3_file_parallel
+    inline double _Benchmark_blake3_file_parallel(const wchar_t* const _Target) {
+        file _File(_Target, _SDSDLL file_access::read);
+        EXPECT_TRUE(_File.is_open());
+        unsigned char _Bytes[32];
+        _Benchmark_timer _Timer;
+        EXPECT_TRUE(blake3_traits<uint8_t>::hash_file_parallel(_Bytes, sizeof(_Bytes), _File, 0));
+        return _Timer._Elapsed_ns();
+    }
+
+    TEST(benchmark_cryptography, DISABLED_hash_file) {
+        // Note: The largest file takes 4 GiB of disk space. The parallel hash uses the tree if the file
+        //       has at least one subtree (1 MiB) for each thread of the default thread-pool and the caller.
+        static constexpr wchar_t _Target[] = L"benchmark_hash_file.bin";
+        static constexpr uint64_t _Sizes[] = {uint64_t{1} << 20, uint64_t{1} << 24,
+            uint64_t{1} << 25, uint64_t{1} << 28, uint64_t{1} << 32};
+        for (const uint64_t _Size : _Sizes) {
+            _Make_benchmark_file(_Target, _Size);
+            const size_t _Size_mib = static_cast<size_t>(_Size >> 20);
+            const double _Blake3   = _Benchmark_hash_file<blake3_traits<uint8_t>>(_Target);
+            const double _Xxhash   = _Benchmark_hash_file<xxhash_traits<uint8_t>>(_Target);
+            const double _Sha512   = _Benchmark_hash_file<sha512_traits<uint8_t>>(_Target);
+            const double _Parallel = _Benchmark_blake3_file_parallel(_Target);
+            _Report_benchmark("blake3 hash_file (MiB)", _Size_mib, _Blake3);
+            _Report_benchmark("xxhash hash_file (MiB)", _Size_mib, _Xxhash);
+            _Report_benchmark("sha512 hash_file (MiB)", _Size_mib, _Sha512);
+            _Report_benchmark("blake3 hash_file_parallel (MiB)", _Size_mib, _Parallel);
+        }
+
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+    }
+} // namespace tests
+
+#endif // _BENCHMARK_CRYPTOGRAPHY_HASH_GENERIC_HASH_FILE_HPP_
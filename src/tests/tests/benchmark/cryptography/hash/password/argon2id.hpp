@@ -0,0 +1,112 @@
+// argon2id.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _BENCHMARK_CRYPTOGRAPHY_HASH_PASSWORD_ARGON2ID_HPP_
+#define _BENCHMARK_CRYPTOGRAPHY_HASH_PASSWORD_ARGON2ID_HPP_
+#include <algorithm>
+#include <benchmark/common.hpp>
+#include <botan/argon2.h>
+#include <core/defs.hpp>
+#include <cryptography/hash/password/arena.hpp>
+#include <cryptography/hash/password/argon2id.hpp>
+#include <cryptography/hash/password/calibration.hpp>
+#include <cryptography/random/salt.hpp>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <vector>
+
+// SDSDLL types
+using _SDSDLL argon2_params;
+using _SDSDLL argon2id_traits;
+using _SDSDLL password_arena;
+
+namespace tests {
+    // CONSTANT _Argon2id_benchmark_samples
+    inline constexpr size_t _Argon2id_benchmark_samples = 100;
+
+    // FUNCTION _Report_argon2id_latency
+    inline void _Report_argon2id_latency(
+        const char* const _P50_name, const char* const _P99_name, const size_t _Memory_amount,
+        _STD vector<double>& _Samples) {
+        _STD sort(_Samples.begin(), _Samples.end());
+        _Report_benchmark(_P50_name, _Memory_amount, _Samples[_Samples.size() / 2]);
+        _Report_benchmark(_P99_name, _Memory_amount, _Samples[_Samples.size() * 99 / 100]);
+    }
+
+    // FUNCTION _Benchmark_argon2id_latency
+    inline void _Benchmark_argon2id_latency(const argon2_params& _Params, const bool _Reuse_arena) {
+        // Note: Without the reuse, each hash gets a new arena, so it pays for the allocation
+        //       and the page faults (like the hashes that allocate their memory on each call).
+        using _Traits = argon2id_traits<char>;
+        static constexpr char _Password[] = "correct horse battery staple";
+        const _Traits::salt _Salt         = _SDSDLL make_salt<16>();
+        unsigned char _Buf[64];
+        password_arena _Shared;
+        _STD vector<double> _Samples(_Argon2id_benchmark_samples);
+        for (double& _Sample : _Samples) {
+            _Benchmark_timer _Timer;
+            if (_Reuse_arena) {
+                EXPECT_TRUE(_Traits::hash(_Buf, sizeof(_Buf), _Password, sizeof(_Password) - 1, _Salt,
+                    _Params.memory_amount, _Params.iterations, _Params.parallelism, _Shared));
+            } else {
+                password_arena _Fresh;
+                EXPECT_TRUE(_Traits::hash(_Buf, sizeof(_Buf), _Password, sizeof(_Password) - 1, _Salt,
+                    _Params.memory_amount, _Params.iterations, _Params.parallelism, _Fresh));
+            }
+
+            _Sample = _Timer._Elapsed_ns();
+        }
+
+        if (_Reuse_arena) {
+            _Report_argon2id_latency("argon2id p50 (reused arena)", "argon2id p99 (reused arena)",
+                _Params.memory_amount, _Samples);
+        } else {
+            _Report_argon2id_latency(
+                "argon2id p50 (new arena)", "argon2id p99 (new arena)", _Params.memory_amount, _Samples);
+        }
+    }
+
+    // FUNCTION _Benchmark_botan_argon2id_latency
+    inline void _Benchmark_botan_argon2id_latency(const argon2_params& _Params) {
+        // Note: This is the previous implementation, it allocates the memory on each call.
+        static constexpr char _Password[] = "correct horse battery staple";
+        const argon2id_traits<char>::salt _Salt = _SDSDLL make_salt<16>();
+        unsigned char _Buf[64];
+        _STD vector<double> _Samples(_Argon2id_benchmark_samples);
+        for (double& _Sample : _Samples) {
+            _Benchmark_timer _Timer;
+            try {
+                ::Botan::argon2(_Buf, sizeof(_Buf), _Password, sizeof(_Password) - 1, _Salt.get(),
+                    _Salt.size, nullptr, 0, nullptr, 0, 2, _Params.parallelism, _Params.memory_amount,
+                    _Params.iterations); // 2 means Argon2id
+            } catch (...) {
+                ADD_FAILURE();
+            }
+
+            _Sample = _Timer._Elapsed_ns();
+        }
+
+        _Report_argon2id_latency(
+            "argon2id p50 (botan)", "argon2id p99 (botan)", _Params.memory_amount, _Samples);
+    }
+
+    TEST(benchmark_cryptography, DISABLED_argon2id_arena) {
+        // Note: n is the memory amount in KiB. The first parameters are the minimum that
+        //       calibrate_argon2id() selects (19 MiB, 2 iterations, a single lane), the second
+        //       ones are calibrated on this machine for 250 ms, like a server would select them.
+        //       The last ones are fixed, so that the results can be compared between machines.
+        argon2_params _Calibrated = {19456, 2, 1};
+        EXPECT_TRUE(_SDSDLL calibrate_argon2id(_Calibrated, 250));
+        const argon2_params _Params[] = {{19456, 2, 1}, _Calibrated, {262144, 3, 1}};
+        for (const argon2_params& _Current : _Params) {
+            _Benchmark_argon2id_latency(_Current, false);
+            _Benchmark_argon2id_latency(_Current, true);
+            _Benchmark_botan_argon2id_latency(_Current);
+        }
+    }
+} // namespace tests
+
+#endif // _BENCHMARK_CRYPTOGRAPHY_HASH_PASSWORD_ARGON2ID_HPP_
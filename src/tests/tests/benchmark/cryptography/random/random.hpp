@@ -0,0 +1,71 @@
+// random.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _BENCHMARK_CRYPTOGRAPHY_RANDOM_RANDOM_HPP_
+#define _BENCHMARK_CRYPTOGRAPHY_RANDOM_RANDOM_HPP_
+#include <algorithm>
+#include <benchmark/common.hpp>
+#include <core/defs.hpp>
+#include <cryptography/random/random.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <recovery/arc.hpp>
+#include <string>
+
+// SDSDLL types
+using _SDSDLL random_format;
+
+namespace tests {
+    // CONSTANT _Random_benchmark_bytes
+    inline constexpr size_t _Random_benchmark_bytes = 64 * 1048576; // generated bytes per measurement
+
+    // FUNCTION _Benchmark_random_fill
+    inline double _Benchmark_random_fill(const size_t _Size) {
+        _STD basic_string<uint8_t> _Buf(_Size, static_cast<uint8_t>(0));
+        const size_t _Rounds = _Random_benchmark_bytes / _Size;
+        _Benchmark_timer _Timer;
+        for (size_t _Round = 0; _Round < _Rounds; ++_Round) {
+            EXPECT_TRUE(_SDSDLL random_fill(_Buf.data(), _Size));
+        }
+
+        return _Timer._Elapsed_ns() / static_cast<double>(_Rounds);
+    }
+
+    // FUNCTION _Benchmark_random_bytes
+    inline double _Benchmark_random_bytes(const size_t _Size) {
+        const size_t _Rounds = (_STD max)(_Random_benchmark_bytes / 16 / _Size, size_t{1});
+        _Benchmark_timer _Timer;
+        for (size_t _Round = 0; _Round < _Rounds; ++_Round) {
+            EXPECT_EQ(_SDSDLL random_bytes(_Size, random_format::general).size(), _Size);
+        }
+
+        return _Timer._Elapsed_ns() / static_cast<double>(_Rounds);
+    }
+
+    // FUNCTION _Benchmark_make_arc
+    inline double _Benchmark_make_arc() {
+        static constexpr size_t _Rounds = 100'000;
+        _Benchmark_timer _Timer;
+        for (size_t _Round = 0; _Round < _Rounds; ++_Round) {
+            (void) _SDSDLL make_arc();
+        }
+
+        return _Timer._Elapsed_ns() / static_cast<double>(_Rounds);
+    }
+
+    TEST(benchmark_cryptography, DISABLED_random) {
+        static constexpr size_t _Sizes[] = {16, 1024, 1048576};
+        for (const size_t _Size : _Sizes) {
+            _Report_benchmark("random fill (drbg)", _Size, _Benchmark_random_fill(_Size));
+            _Report_benchmark("random_bytes (general)", _Size, _Benchmark_random_bytes(_Size));
+        }
+
+        _Report_benchmark("make_arc", 1, _Benchmark_make_arc());
+    }
+} // namespace tests
+
+#endif // _BENCHMARK_CRYPTOGRAPHY_RANDOM_RANDOM_HPP_
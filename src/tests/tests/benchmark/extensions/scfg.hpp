@@ -0,0 +1,55 @@
+// scfg.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _BENCHMARK_EXTENSIONS_SCFG_HPP_
+#define _BENCHMARK_EXTENSIONS_SCFG_HPP_
+#include <benchmark/common.hpp>
+#include <core/defs.hpp>
+#include <cryptography/cipher/symmetric/aes_key.hpp>
+#include <cryptography/cipher/symmetric/iv.hpp>
+#include <cstddef>
+#include <extensions/scfg.hpp>
+#include <filesystem/file.hpp>
+#include <gtest/gtest.h>
+#include <string>
+
+// SDSDLL types
+using _SDSDLL aes_key;
+using _SDSDLL iv;
+using _SDSDLL scfg_file;
+
+namespace tests {
+    // FUNCTION _Benchmark_scfg_flush
+    inline double _Benchmark_scfg_flush(const wchar_t* const _Target, const size_t _Count) {
+        EXPECT_TRUE(scfg_file::make_storage(_Target));
+        const aes_key<32> _Key; // the key does not matter here
+        const iv<12> _Iv = _SDSDLL make_iv<12>();
+        scfg_file _File(_Target, _Key, _Iv);
+        EXPECT_TRUE(_File.ok());
+        for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+            const _STD wstring& _Id = L"entry_" + _STD to_wstring(_Idx);
+            EXPECT_TRUE(_File.append_entry(_Id, L"value of the " + _Id));
+        }
+
+        _Benchmark_timer _Timer;
+        EXPECT_TRUE(_File.flush());
+        return _Timer._Elapsed_ns();
+    }
+
+    TEST(benchmark_extensions, DISABLED_scfg_flush) {
+        static constexpr wchar_t _Target[] = L"benchmark_scfg_flush.scfg";
+        static constexpr size_t _Sizes[]   = {10'000, 100'000};
+        for (const size_t _Size : _Sizes) {
+            const double _Elapsed = _Benchmark_scfg_flush(_Target, _Size);
+            _Report_benchmark("scfg_file flush (total)", _Size, _Elapsed);
+            _Report_benchmark("scfg_file flush (per entry)", _Size, _Elapsed / static_cast<double>(_Size));
+        }
+
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+    }
+} // namespace tests
+
+#endif // _BENCHMARK_EXTENSIONS_SCFG_HPP_
@@ -0,0 +1,221 @@
+// sudb.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _BENCHMARK_EXTENSIONS_SUDB_HPP_
+#define _BENCHMARK_EXTENSIONS_SUDB_HPP_
+#include <array>
+#include <benchmark/common.hpp>
+#include <core/defs.hpp>
+#include <core/traits/memory_traits.hpp>
+#include <core/traits/string_traits.hpp>
+#include <cryptography/hash/generic.hpp>
+#include <cryptography/hash/generic/xxhash.hpp>
+#include <cryptography/hash/password/calibration.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <extensions/sudb.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <string>
+#include <system/execution/thread_pool.hpp>
+#include <thread>
+#include <vector>
+
+// SDSDLL types
+using _SDSDLL argon2_params;
+using _SDSDLL byte_string;
+using _SDSDLL memory_traits;
+using _SDSDLL sudb_credentials;
+using _SDSDLL sudb_file;
+using _SDSDLL thread_pool;
+using _SDSDLL xxhash_traits;
+
+namespace tests {
+    // CLASS _Sudb_lookup_benchmark
+    class _Sudb_lookup_benchmark { // compares sudb_file::has_entry() with the baseline linear scan
+    public:
+        explicit _Sudb_lookup_benchmark(const size_t _Count)
+            : _Mynames(_Count), _Myhashes(_Count), _Mygen(_Count) {
+            EXPECT_TRUE(sudb_file::make_storage(_Target));
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.ok());
+            EXPECT_TRUE(_File.password_params(argon2_params{64, 1, 1})); // cheap, only the lookups are timed
+            for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+                _Mynames[_Idx] = L"account-" + _STD to_wstring(_Idx);
+                EXPECT_TRUE(_File.append_entry(_Mynames[_Idx], L"password-" + _STD to_wstring(_Idx)));
+                const byte_string& _Hash = _SDSDLL hash<xxhash_traits<wchar_t>>(_Mynames[_Idx]);
+                EXPECT_EQ(_Hash.size(), _Myhashes[_Idx].size());
+                memory_traits::copy(_Myhashes[_Idx].data(), _Hash.c_str(), _Myhashes[_Idx].size());
+            }
+
+            EXPECT_TRUE(_File.flush());
+        }
+
+        ~_Sudb_lookup_benchmark() noexcept {
+            (void) _SDSDLL delete_file(_Target);
+        }
+
+        // returns the average time of a baseline lookup (hash the name, then scan all entries)
+        _NODISCARD double _Scan(const size_t _Lookups) {
+            // Note: This replicates sudb_file::_Find_entry_by_account_name() before the digest index,
+            //       it hashes the name and compares the hash with the account of each entry in order.
+            size_t _Found = 0;
+            _Benchmark_timer _Timer;
+            for (size_t _Iter = 0; _Iter < _Lookups; ++_Iter) {
+                const byte_string& _Hash = _SDSDLL hash<xxhash_traits<wchar_t>>(_Random_name());
+                for (size_t _Idx = 0; _Idx < _Myhashes.size(); ++_Idx) {
+                    if (memory_traits::compare(_Myhashes[_Idx].data(), _Hash.c_str(), _Hash.size()) == 0) {
+                        ++_Found;
+                        break;
+                    }
+                }
+            }
+
+            const double _Elapsed = _Timer._Elapsed_ns();
+            EXPECT_EQ(_Found, _Lookups);
+            return _Elapsed / static_cast<double>(_Lookups);
+        }
+
+        // returns the average time of sudb_file::has_entry()
+        _NODISCARD double _Has_entry(const size_t _Lookups) {
+            // Note: Unlike the baseline scan, each call also takes the shared lock of the file.
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.ok());
+            size_t _Found = 0;
+            _Benchmark_timer _Timer;
+            for (size_t _Iter = 0; _Iter < _Lookups; ++_Iter) {
+                _Found += _File.has_entry(_Random_name()) ? 1 : 0;
+            }
+
+            const double _Elapsed = _Timer._Elapsed_ns();
+            EXPECT_EQ(_Found, _Lookups);
+            return _Elapsed / static_cast<double>(_Lookups);
+        }
+
+    private:
+        static constexpr wchar_t _Target[] = L"sudb_lookup_benchmark.sudb";
+
+        _NODISCARD const _STD wstring& _Random_name() noexcept {
+            return _Mynames[_Mygen() % _Mynames.size()];
+        }
+
+        _STD vector<_STD wstring> _Mynames;
+        _STD vector<_STD array<uint8_t, 8>> _Myhashes;
+        _STD mt19937_64 _Mygen;
+    };
+
+    TEST(benchmark_extensions, DISABLED_sudb_lookup) {
+        static constexpr size_t _Sizes[] = {1'000, 10'000, 100'000};
+        for (const size_t _Size : _Sizes) {
+            _Sudb_lookup_benchmark _Bench(_Size);
+            _Report_benchmark("sudb_file lookup (scan)", _Size, _Bench._Scan(200));
+            _Report_benchmark("sudb_file lookup (has_entry)", _Size, _Bench._Has_entry(100'000));
+        }
+    }
+
+    // CLASS _Sudb_password_benchmark
+    class _Sudb_password_benchmark { // compares the serial verification with the batch one
+    public:
+        explicit _Sudb_password_benchmark(const size_t _Count)
+            : _Mynames(_Count), _Mypasswords(_Count), _Mycredentials(_Count) {
+            EXPECT_TRUE(sudb_file::make_storage(_Target));
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.ok());
+            for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+                _Mynames[_Idx]     = L"account-" + _STD to_wstring(_Idx);
+                _Mypasswords[_Idx] = L"password-" + _STD to_wstring(_Idx * 7919);
+                EXPECT_TRUE(_File.append_entry(_Mynames[_Idx], _Mypasswords[_Idx]));
+                _Mycredentials[_Idx] = sudb_credentials{_Mynames[_Idx], _Mypasswords[_Idx]};
+            }
+
+            EXPECT_TRUE(_File.flush());
+        }
+
+        ~_Sudb_password_benchmark() noexcept {
+            (void) _SDSDLL delete_file(_Target);
+        }
+
+        // returns the average time of one verification in a serial loop
+        _NODISCARD double _Serial() const {
+            sudb_file _File(_Target);
+            _Benchmark_timer _Timer;
+            for (size_t _Idx = 0; _Idx < _Mycredentials.size(); ++_Idx) {
+                EXPECT_TRUE(_File.compare_passwords(_Mynames[_Idx], _Mypasswords[_Idx]));
+            }
+
+            return _Timer._Elapsed_ns() / static_cast<double>(_Mycredentials.size());
+        }
+
+        // returns the time of verifying all credentials in one batch
+        _NODISCARD double _Batch(thread_pool& _Pool, const size_t _Concurrency) const {
+            sudb_file _File(_Target);
+            const _STD unique_ptr<bool[]> _Results(new bool[_Mycredentials.size()]);
+            _Benchmark_timer _Timer;
+            EXPECT_TRUE(_File.compare_passwords(
+                _Mycredentials.data(), _Mycredentials.size(), _Results.get(), _Concurrency, _Pool));
+            const double _Elapsed = _Timer._Elapsed_ns();
+            for (size_t _Idx = 0; _Idx < _Mycredentials.size(); ++_Idx) {
+                EXPECT_TRUE(_Results[_Idx]);
+            }
+
+            return _Elapsed;
+        }
+
+        // returns the average time of one verification, _Threads threads share the same file
+        _NODISCARD double _Shared(const size_t _Threads) const {
+            sudb_file _File(_Target);
+            _STD vector<_STD thread> _Workers;
+            _Workers.reserve(_Threads);
+            _Benchmark_timer _Timer;
+            for (size_t _Id = 0; _Id < _Threads; ++_Id) {
+                _Workers.emplace_back([&, _Id] {
+                    for (size_t _Idx = _Id; _Idx < _Mycredentials.size(); _Idx += _Threads) {
+                        EXPECT_TRUE(_File.compare_passwords(_Mynames[_Idx], _Mypasswords[_Idx]));
+                    }
+                });
+            }
+
+            for (_STD thread& _Worker : _Workers) {
+                _Worker.join();
+            }
+
+            return _Timer._Elapsed_ns() / static_cast<double>(_Mycredentials.size());
+        }
+
+    private:
+        static constexpr wchar_t _Target[] = L"sudb_password_benchmark.sudb";
+
+        _STD vector<_STD wstring> _Mynames;
+        _STD vector<_STD wstring> _Mypasswords;
+        _STD vector<sudb_credentials> _Mycredentials;
+    };
+
+    TEST(benchmark_extensions, DISABLED_sudb_compare_passwords) {
+        // Note: The serial row reports the time of one verification. For the batch rows, n is
+        //       the concurrency cap. The first one reports the time of the whole batch (latency),
+        //       the second one the batch time divided by the number of credentials (throughput).
+        static constexpr size_t _Count         = 64;
+        static constexpr size_t _Concurrency[] = {1, 2, 4, 8};
+        _Sudb_password_benchmark _Bench(_Count);
+        thread_pool _Pool(8);
+        _Report_benchmark("sudb_file compare (serial)", _Count, _Bench._Serial());
+        for (const size_t _Limit : _Concurrency) {
+            const double _Elapsed = _Bench._Batch(_Pool, _Limit);
+            _Report_benchmark("sudb_file compare (batch)", _Limit, _Elapsed);
+            _Report_benchmark("sudb_file compare (batch, per item)", _Limit,
+                _Elapsed / static_cast<double>(_Count));
+        }
+
+        // Note: The shared rows verify the passwords from n threads that call compare_passwords()
+        //       on the same sudb_file, the hashes no longer wait for each other.
+        for (const size_t _Threads : _Concurrency) {
+            _Report_benchmark("sudb_file compare (shared, per item)", _Threads, _Bench._Shared(_Threads));
+        }
+    }
+} // namespace tests
+
+#endif // _BENCHMARK_EXTENSIONS_SUDB_HPP_
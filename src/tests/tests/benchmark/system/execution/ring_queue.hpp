@@ -0,0 +1,93 @@
+// ring_queue.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _BENCHMARK_SYSTEM_EXECUTION_RING_QUEUE_HPP_
+#define _BENCHMARK_SYSTEM_EXECUTION_RING_QUEUE_HPP_
+#include <algorithm>
+#include <benchmark/common.hpp>
+#include <core/defs.hpp>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <system/execution/ring_queue.hpp>
+#include <system/execution/shared_queue.hpp>
+#include <thread>
+
+// SDSDLL types
+using _SDSDLL mpmc_ring_queue;
+using _SDSDLL shared_queue;
+using _SDSDLL spsc_ring_queue;
+
+namespace tests {
+    // FUNCTION TEMPLATE _Benchmark_ring_queue_transfer
+    template <class _Queue>
+    inline double _Benchmark_ring_queue_transfer(_Queue& _Ring, const size_t _Count, const size_t _Batch) {
+        // Note: One thread pushes _Count values in batches of _Batch, the calling thread pops them.
+        _Benchmark_timer _Timer;
+        _STD thread _Producer([&_Ring, _Count, _Batch] {
+            size_t _Values[64];
+            for (size_t _Idx = 0; _Idx < _Count;) {
+                const size_t _Size = (_STD min)(_Batch, _Count - _Idx);
+                for (size_t _Offset = 0; _Offset < _Size; ++_Offset) {
+                    _Values[_Offset] = _Idx + _Offset;
+                }
+
+                const size_t _Pushed = _Ring.try_push_bulk(_Values, _Size);
+                _Idx                += _Pushed;
+                if (_Pushed == 0) {
+                    _STD this_thread::yield();
+                }
+            }
+        });
+
+        size_t _Values[64];
+        for (size_t _Popped = 0; _Popped < _Count;) {
+            const size_t _Count_popped = _Ring.try_pop_bulk(_Values, _Batch);
+            _Popped                   += _Count_popped;
+            if (_Count_popped == 0) {
+                _STD this_thread::yield();
+            }
+        }
+
+        _Producer.join();
+        return _Timer._Elapsed_ns() / static_cast<double>(_Count);
+    }
+
+    // FUNCTION _Benchmark_shared_queue_transfer
+    inline double _Benchmark_shared_queue_transfer(const size_t _Count) {
+        shared_queue<size_t> _Queue;
+        _Benchmark_timer _Timer;
+        _STD thread _Producer([&_Queue, _Count] {
+            for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+                _Queue.push(_Idx + 1);
+            }
+        });
+
+        for (size_t _Popped = 0; _Popped < _Count;) {
+            if (_Queue.pop() != 0) { // 0 means that the queue was empty
+                ++_Popped;
+            }
+        }
+
+        _Producer.join();
+        return _Timer._Elapsed_ns() / static_cast<double>(_Count);
+    }
+
+    TEST(benchmark_system, DISABLED_ring_queue) {
+        static constexpr size_t _Count     = 2'000'000;
+        static constexpr size_t _Batches[] = {1, 16, 64};
+        _Report_benchmark("shared_queue (list)", 1, _Benchmark_shared_queue_transfer(_Count));
+        for (const size_t _Batch : _Batches) {
+            mpmc_ring_queue<size_t> _Mpmc(1024);
+            spsc_ring_queue<size_t> _Spsc(1024);
+            _Report_benchmark(
+                "mpmc_ring_queue", _Batch, _Benchmark_ring_queue_transfer(_Mpmc, _Count, _Batch));
+            _Report_benchmark(
+                "spsc_ring_queue", _Batch, _Benchmark_ring_queue_transfer(_Spsc, _Count, _Batch));
+        }
+    }
+} // namespace tests
+
+#endif // _BENCHMARK_SYSTEM_EXECUTION_RING_QUEUE_HPP_
@@ -0,0 +1,73 @@
+// shared_lock.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _BENCHMARK_SYSTEM_EXECUTION_SHARED_LOCK_HPP_
+#define _BENCHMARK_SYSTEM_EXECUTION_SHARED_LOCK_HPP_
+#include <atomic>
+#include <benchmark/common.hpp>
+#include <core/defs.hpp>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <list>
+#include <system/execution/distributed_lock.hpp>
+#include <system/execution/futex_lock.hpp>
+#include <system/execution/shared_lock.hpp>
+#include <system/execution/shared_queue.hpp>
+#include <thread>
+#include <vector>
+
+// SDSDLL types
+using _SDSDLL distributed_shared_lock;
+using _SDSDLL futex_shared_lock;
+using _SDSDLL shared_lock;
+using _SDSDLL shared_queue;
+
+namespace tests {
+    // FUNCTION TEMPLATE _Benchmark_shared_queue_reads
+    template <class _Lock>
+    inline double _Benchmark_shared_queue_reads(const size_t _Threads, const size_t _Reads) {
+        // Note: Each thread keeps calling size() on the same queue, which only takes the shared lock.
+        //       Returns the time of a single read, as seen by one thread.
+        shared_queue<size_t, _STD list<size_t>, _Lock> _Queue;
+        _Queue.push(1);
+        _STD atomic<size_t> _Sum(0);
+        _STD vector<_STD thread> _Readers;
+        _Benchmark_timer _Timer;
+        for (size_t _Idx = 0; _Idx < _Threads; ++_Idx) {
+            _Readers.emplace_back([&_Queue, &_Sum, _Reads] {
+                size_t _Local = 0;
+                for (size_t _Read = 0; _Read < _Reads; ++_Read) {
+                    _Local += _Queue.size();
+                }
+
+                _Sum.fetch_add(_Local, _STD memory_order_relaxed);
+            });
+        }
+
+        for (_STD thread& _Reader : _Readers) {
+            _Reader.join();
+        }
+
+        const double _Ns = _Timer._Elapsed_ns() / static_cast<double>(_Reads);
+        EXPECT_EQ(_Sum.load(), _Threads * _Reads);
+        return _Ns;
+    }
+
+    TEST(benchmark_system, DISABLED_shared_lock) {
+        static constexpr size_t _Reads     = 1'000'000;
+        static constexpr size_t _Threads[] = {1, 2, 4, 8};
+        for (const size_t _Count : _Threads) {
+            _Report_benchmark("shared_queue reads (srw)", _Count,
+                _Benchmark_shared_queue_reads<shared_lock>(_Count, _Reads));
+            _Report_benchmark("shared_queue reads (distributed)", _Count,
+                _Benchmark_shared_queue_reads<distributed_shared_lock>(_Count, _Reads));
+            _Report_benchmark("shared_queue reads (futex)", _Count,
+                _Benchmark_shared_queue_reads<futex_shared_lock>(_Count, _Reads));
+        }
+    }
+} // namespace tests
+
+#endif // _BENCHMARK_SYSTEM_EXECUTION_SHARED_LOCK_HPP_
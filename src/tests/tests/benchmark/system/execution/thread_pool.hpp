@@ -0,0 +1,272 @@
+// thread_pool.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _BENCHMARK_SYSTEM_EXECUTION_THREAD_POOL_HPP_
+#define _BENCHMARK_SYSTEM_EXECUTION_THREAD_POOL_HPP_
+#include <algorithm>
+#include <atomic>
+#include <benchmark/common.hpp>
+#include <core/defs.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <system/execution/parallel.hpp>
+#include <system/execution/thread_pool.hpp>
+#include <time_zone/timer.hpp>
+#include <vector>
+
+// SDSDLL types
+using _SDSDLL task_options;
+using _SDSDLL task_priority;
+using _SDSDLL thread_pool;
+using _SDSDLL thread_pool_mode;
+
+namespace tests {
+    // FUNCTION _Benchmark_thread_pool_round_trip
+    inline double _Benchmark_thread_pool_round_trip(thread_pool& _Pool, const bool _Idle) noexcept {
+        // Note: Each task is submitted only after the previous one has finished. If _Idle is true,
+        //       the caller sleeps before each submission, so that the worker has to be woken up
+        //       from the parked state. The sleep is not measured.
+        const size_t _Rounds = _Idle ? 200 : 100'000;
+        _STD atomic<size_t> _Done(0);
+        double _Total = 0.0;
+        for (size_t _Round = 0; _Round < _Rounds; ++_Round) {
+            if (_Idle) {
+                _SDSDLL sleep_for(2, _SDSDLL time_format::milliseconds);
+            }
+
+            _Benchmark_timer _Timer;
+            EXPECT_TRUE(_Pool.submit_task(
+                [](void* const _Data) noexcept {
+                    static_cast<_STD atomic<size_t>*>(_Data)->fetch_add(1, _STD memory_order_release);
+                }, &_Done
+            ));
+            while (_Done.load(_STD memory_order_acquire) != _Round + 1) {
+            }
+
+            _Total += _Timer._Elapsed_ns();
+        }
+
+        return _Total / static_cast<double>(_Rounds);
+    }
+
+    // FUNCTION _Benchmark_thread_pool_future_round_trip
+    inline double _Benchmark_thread_pool_future_round_trip(thread_pool& _Pool) noexcept {
+        // Note: Measures submit() followed by get(), the state of each task comes from the block pool.
+        static constexpr size_t _Rounds = 100'000;
+        size_t _Sum = 0;
+        _Benchmark_timer _Timer;
+        for (size_t _Round = 0; _Round < _Rounds; ++_Round) {
+            _Sum += _Pool.submit([](const size_t _Value) noexcept { return _Value + 1; }, _Round).get();
+        }
+
+        const double _Ns = _Timer._Elapsed_ns() / static_cast<double>(_Rounds);
+        EXPECT_EQ(_Sum, _Rounds * (_Rounds + 1) / 2);
+        return _Ns;
+    }
+
+    // FUNCTION _Benchmark_thread_pool_tiny_tasks
+    inline double _Benchmark_thread_pool_tiny_tasks(thread_pool& _Pool, const size_t _Count) noexcept {
+        _STD atomic<size_t> _Done(0);
+        _Benchmark_timer _Timer;
+        for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+            EXPECT_TRUE(_Pool.submit_task(
+                [](void* const _Data) noexcept {
+                    static_cast<_STD atomic<size_t>*>(_Data)->fetch_add(1, _STD memory_order_relaxed);
+                }, &_Done
+            ));
+        }
+
+        while (_Done.load(_STD memory_order_relaxed) != _Count) {
+        }
+
+        return _Timer._Elapsed_ns() / static_cast<double>(_Count);
+    }
+
+    // STRUCT _Thread_pool_fan_out_data
+    struct _Thread_pool_fan_out_data {
+        thread_pool* _Pool;
+        _STD atomic<size_t> _Done;
+    };
+
+    // FUNCTION _Benchmark_thread_pool_fan_out
+    inline double _Benchmark_thread_pool_fan_out(thread_pool& _Pool, const size_t _Count) noexcept {
+        // Note: Each task submits 8 children from inside the thread-pool, the children spin for
+        //       different amounts of time, so that some threads run out of work much sooner.
+        static constexpr size_t _Children = 8;
+        _Thread_pool_fan_out_data _Data   = {_SDSDLL addressof(_Pool), 0};
+        _Benchmark_timer _Timer;
+        for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+            EXPECT_TRUE(_Pool.submit_task(
+                [](void* const _Raw) noexcept {
+                    _Thread_pool_fan_out_data* const _Data = static_cast<_Thread_pool_fan_out_data*>(_Raw);
+                    for (size_t _Child = 0; _Child < _Children; ++_Child) {
+                        (void) _Data->_Pool->submit_task(
+                            [](void* const _Child_raw) noexcept {
+                                _STD atomic<size_t>& _Done =
+                                    static_cast<_Thread_pool_fan_out_data*>(_Child_raw)->_Done;
+                                const size_t _Spins = (_Done.load(_STD memory_order_relaxed) % 16) * 256;
+                                for (volatile size_t _Spin = 0; _Spin < _Spins; ++_Spin) {
+                                }
+
+                                _Done.fetch_add(1, _STD memory_order_relaxed);
+                            }, _Raw
+                        );
+                    }
+
+                    _Data->_Done.fetch_add(1, _STD memory_order_relaxed);
+                }, &_Data
+            ));
+        }
+
+        while (_Data._Done.load(_STD memory_order_relaxed) != _Count * (_Children + 1)) {
+        }
+
+        return _Timer._Elapsed_ns() / static_cast<double>(_Count * (_Children + 1));
+    }
+
+    // FUNCTION _Benchmark_thread_pool_parallel_reduce
+    inline double _Benchmark_thread_pool_parallel_reduce(thread_pool& _Pool, const size_t _Count) noexcept {
+        // Note: Measures the cost of a single index, the range is split by parallel_reduce().
+        _Benchmark_timer _Timer;
+        const uint64_t _Sum = _SDSDLL parallel_reduce(
+            _Pool, _SDSDLL parallel_range{0, _Count}, 1024, uint64_t{0},
+            [](const size_t _Idx) noexcept { return static_cast<uint64_t>(_Idx) * _Idx; },
+            [](const uint64_t _Left, const uint64_t _Right) noexcept { return _Left + _Right; }
+        );
+        const double _Ns = _Timer._Elapsed_ns() / static_cast<double>(_Count);
+        EXPECT_NE(_Sum, 0u);
+        return _Ns;
+    }
+
+    // STRUCT _Benchmark_bulk_load
+    struct _Benchmark_bulk_load {
+        thread_pool* _Pool;
+        double _Length; // time of a single bulk task in nanoseconds
+        _STD atomic<bool> _Stop;
+        _STD atomic<size_t> _Active; // bulk tasks that are queued or running
+    };
+
+    // FUNCTION _Benchmark_bulk_task
+    inline void __stdcall _Benchmark_bulk_task(void* const _Raw) noexcept {
+        // Note: Each bulk task keeps its thread busy for the selected time and then resubmits itself,
+        //       so the queues never drain while the load is running.
+        _Benchmark_bulk_load* const _Load = static_cast<_Benchmark_bulk_load*>(_Raw);
+        _Benchmark_timer _Timer;
+        while (_Timer._Elapsed_ns() < _Load->_Length) {
+        }
+
+        if (_Load->_Stop.load(_STD memory_order_acquire)
+            || !_Load->_Pool->submit_task(_Benchmark_bulk_task, _Raw)) {
+            _Load->_Active.fetch_sub(1, _STD memory_order_release);
+        }
+    }
+
+    // FUNCTION _Benchmark_thread_pool_probe_latency
+    inline double _Benchmark_thread_pool_probe_latency(
+        thread_pool& _Pool, const task_priority _Priority, const double _Percentile) noexcept {
+        // Note: Measures submit() followed by get() of a trivial task, the probes are spaced out,
+        //       so that they never queue behind each other.
+        static constexpr size_t _Probes = 200;
+        _STD vector<double> _Latencies(_Probes);
+        for (double& _Latency : _Latencies) {
+            _SDSDLL sleep_for(1, _SDSDLL time_format::milliseconds);
+            _Benchmark_timer _Timer;
+            const int _Result =
+                _Pool.submit(task_options{_Priority, 0, nullptr}, []() noexcept { return 1; }).get();
+            EXPECT_EQ(_Result, 1);
+            _Latency = _Timer._Elapsed_ns();
+        }
+
+        _STD sort(_Latencies.begin(), _Latencies.end());
+        return _Latencies[static_cast<size_t>(_Percentile * static_cast<double>(_Probes - 1))];
+    }
+
+    // FUNCTION _Benchmark_thread_pool_priority
+    inline void _Benchmark_thread_pool_priority(const thread_pool_mode _Mode, const size_t _Bulk_length,
+        const char* const _Idle_name, const char* const _High_name, const char* const _Normal_name) noexcept {
+        static constexpr size_t _Threads = 2;
+        thread_pool _Pool(_Threads, _Mode);
+        _Report_benchmark(
+            _Idle_name, _Bulk_length, _Benchmark_thread_pool_probe_latency(_Pool, task_priority::high, 0.99));
+
+        // Note: The bulk load saturates the thread-pool with 8 tasks per thread. A high-priority probe
+        //       waits only for a running bulk task to finish, a normal one waits behind the whole queue.
+        _Benchmark_bulk_load _Load = {
+            _SDSDLL addressof(_Pool), static_cast<double>(_Bulk_length) * 1'000.0, false, _Threads * 8};
+        for (size_t _Idx = 0; _Idx < _Threads * 8; ++_Idx) {
+            if (!_Pool.submit_task(_Benchmark_bulk_task, &_Load)) {
+                _Load._Active.fetch_sub(1, _STD memory_order_release);
+            }
+        }
+
+        _Report_benchmark(
+            _High_name, _Bulk_length, _Benchmark_thread_pool_probe_latency(_Pool, task_priority::high, 0.99));
+        _Report_benchmark(_Normal_name, _Bulk_length,
+            _Benchmark_thread_pool_probe_latency(_Pool, task_priority::normal, 0.99));
+        _Load._Stop.store(true, _STD memory_order_release);
+        while (_Load._Active.load(_STD memory_order_acquire) != 0) {
+            _SDSDLL sleep_for(1, _SDSDLL time_format::milliseconds);
+        }
+    }
+
+    TEST(benchmark_system, DISABLED_thread_pool_priority) {
+        // Note: n is the time of a single bulk task in microseconds. The running tasks are never
+        //       preempted, so while every thread runs a bulk task, a high-priority probe still waits
+        //       for the first one of them to finish. Its p99 is therefore bounded by the length of
+        //       a bulk task, not by the length of the queue. 1 ms is about a small SCFG chunk, 30 ms
+        //       about a single Argon2id hash with the minimum calibrated parameters.
+        static constexpr size_t _Bulk_lengths[] = {1'000, 30'000};
+        for (const size_t _Bulk_length : _Bulk_lengths) {
+            _Benchmark_thread_pool_priority(thread_pool_mode::per_thread, _Bulk_length,
+                "p99 high (idle, per-thread)", "p99 high (bulk, per-thread)",
+                "p99 normal (bulk, per-thread)");
+            _Benchmark_thread_pool_priority(thread_pool_mode::work_stealing, _Bulk_length,
+                "p99 high (idle, work-stealing)", "p99 high (bulk, work-stealing)",
+                "p99 normal (bulk, work-stealing)");
+        }
+    }
+
+    TEST(benchmark_system, DISABLED_thread_pool) {
+        static constexpr size_t _Tasks = 200'000;
+        thread_pool _Single(1);
+        _Report_benchmark("round trip (busy worker)", 1, _Benchmark_thread_pool_round_trip(_Single, false));
+        _Report_benchmark("round trip (parked worker)", 1, _Benchmark_thread_pool_round_trip(_Single, true));
+        _Report_benchmark("submit + get round trip", 1, _Benchmark_thread_pool_future_round_trip(_Single));
+        static constexpr size_t _Threads[] = {1, 2, 4};
+        for (const size_t _Count : _Threads) {
+            thread_pool _Pool(_Count);
+            if (_Pool.threads() != _Count) { // not enough cores
+                continue;
+            }
+
+            const double _Ns = _Benchmark_thread_pool_tiny_tasks(_Pool, _Tasks);
+            _Report_benchmark("tiny tasks (per-thread)", _Count, _Ns);
+            _Report_throughput("tiny tasks (per-thread)", _Count, 1'000'000'000.0 / _Ns);
+            _Report_benchmark(
+                "fan-out (per-thread)", _Count, _Benchmark_thread_pool_fan_out(_Pool, _Tasks / 8));
+            _Report_benchmark("parallel_reduce (per-thread)", _Count,
+                _Benchmark_thread_pool_parallel_reduce(_Pool, _Tasks * 50));
+        }
+
+        for (const size_t _Count : _Threads) {
+            thread_pool _Pool(_Count, thread_pool_mode::work_stealing);
+            if (_Pool.threads() != _Count) { // not enough cores
+                continue;
+            }
+
+            const double _Ns = _Benchmark_thread_pool_tiny_tasks(_Pool, _Tasks);
+            _Report_benchmark("tiny tasks (work-stealing)", _Count, _Ns);
+            _Report_throughput("tiny tasks (work-stealing)", _Count, 1'000'000'000.0 / _Ns);
+            _Report_benchmark(
+                "fan-out (work-stealing)", _Count, _Benchmark_thread_pool_fan_out(_Pool, _Tasks / 8));
+            _Report_benchmark("parallel_reduce (work-stealing)", _Count,
+                _Benchmark_thread_pool_parallel_reduce(_Pool, _Tasks * 50));
+        }
+    }
+} // namespace tests
+
+#endif // _BENCHMARK_SYSTEM_EXECUTION_THREAD_POOL_HPP_
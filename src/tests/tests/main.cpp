@@ -4,10 +4,32 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <Windows.h>
+#include <benchmark/cryptography/cipher/symmetric/aes256_gcm.hpp>
+#include <benchmark/cryptography/hash/generic/hash_file.hpp>
+#include <benchmark/cryptography/hash/password/argon2id.hpp>
+#include <benchmark/cryptography/random/random.hpp>
+#include <benchmark/extensions/scfg.hpp>
+#include <benchmark/extensions/sudb.hpp>
+#include <benchmark/system/execution/ring_queue.hpp>
+#include <benchmark/system/execution/shared_lock.hpp>
+#include <benchmark/system/execution/thread_pool.hpp>
 #include <gtest/gtest.h>
+#include <unit/core/container/digest_index.hpp>
+#include <unit/cryptography/cipher/symmetric/session.hpp>
+#include <unit/cryptography/cipher/symmetric/stream.hpp>
 #include <unit/cryptography/hash/generic/blake3.hpp>
 #include <unit/cryptography/hash/generic/sha512.hpp>
 #include <unit/cryptography/hash/generic/xxhash.hpp>
+#include <unit/cryptography/hash/password/argon2.hpp>
+#include <unit/cryptography/hash/password/calibration.hpp>
+#include <unit/cryptography/hash/password/scrypt.hpp>
+#include <unit/cryptography/random/random.hpp>
+#include <unit/extensions/scfg.hpp>
+#include <unit/extensions/sudb.hpp>
+#include <unit/system/execution/parallel.hpp>
+#include <unit/system/execution/ring_queue.hpp>
+#include <unit/system/execution/shared_lock.hpp>
+#include <unit/system/execution/thread_pool.hpp>
 
 int main() {
     ::testing::InitGoogleTest();
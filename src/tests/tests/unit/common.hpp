@@ -0,0 +1,50 @@
+// common.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _UNIT_COMMON_HPP_
+#define _UNIT_COMMON_HPP_
+#include <core/defs.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem/file.hpp>
+#include <gtest/gtest.h>
+#include <string>
+
+namespace tests {
+    // ALIAS _Test_bytes
+    using _Test_bytes = _STD basic_string<unsigned char>;
+
+    // FUNCTION _Open_test_file
+    inline _SDSDLL file _Open_test_file(const wchar_t* const _Target) {
+        return _SDSDLL file{_Target, _SDSDLL file_access::all,
+            _SDSDLL file_share::none, _SDSDLL file_disposition::force_create};
+    }
+
+    // FUNCTION _Read_test_file
+    inline _Test_bytes _Read_test_file(const wchar_t* const _Target) {
+        _SDSDLL file _File(_Target, _SDSDLL file_access::read);
+        _Test_bytes _Bytes(static_cast<size_t>(_SDSDLL file_size(_Target)), 0);
+        EXPECT_TRUE(_Bytes.empty() || _File.read(_Bytes.data(), _Bytes.size(), _Bytes.size()));
+        return _Bytes;
+    }
+
+    // FUNCTION _Write_test_file
+    inline void _Write_test_file(const wchar_t* const _Target, const _Test_bytes& _Bytes) {
+        _SDSDLL file _File = _Open_test_file(_Target);
+        EXPECT_TRUE(_Bytes.empty() || _File.write(_Bytes.c_str(), _Bytes.size()));
+    }
+
+    // FUNCTION _Damage_test_file
+    inline void _Damage_test_file(const wchar_t* const _Target, const uintmax_t _Off) {
+        _SDSDLL file _File(_Target);
+        uint8_t _Byte = 0;
+        EXPECT_TRUE(_File.is_open());
+        EXPECT_TRUE(_File.seek(_Off) && _File.get(_Byte));
+        EXPECT_TRUE(_File.seek(_Off) && _File.put(static_cast<uint8_t>(_Byte ^ 0xFF)));
+    }
+} // namespace tests
+
+#endif // _UNIT_COMMON_HPP_
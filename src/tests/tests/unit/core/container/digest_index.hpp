@@ -0,0 +1,156 @@
+// digest_index.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _UNIT_CORE_CONTAINER_DIGEST_INDEX_HPP_
+#define _UNIT_CORE_CONTAINER_DIGEST_INDEX_HPP_
+#include <array>
+#include <core/container/digest_index.hpp>
+#include <core/defs.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+// SDSDLL types
+using _SDSDLL _Digest_index;
+
+namespace tests {
+    // ALIAS _Digest_test_key
+    using _Digest_test_key = _STD array<uint8_t, 16>;
+
+    // FUNCTION _Make_digest_test_key
+    inline _Digest_test_key _Make_digest_test_key(const uint64_t _Prefix, const uint64_t _Suffix) noexcept {
+        // Note: The index hashes the first 8 bytes of the key (in the native byte order), so the prefix
+        //       selects the home slot and the suffix makes keys with the same prefix different.
+        _Digest_test_key _Result;
+        for (size_t _Off = 0; _Off < 8; ++_Off) {
+            _Result[_Off]     = static_cast<uint8_t>(_Prefix >> (_Off * 8));
+            _Result[8 + _Off] = static_cast<uint8_t>(_Suffix >> (_Off * 8));
+        }
+
+        return _Result;
+    }
+
+    // CLASS _Digest_test_index
+    class _Digest_test_index { // keeps the keys that the index points to
+    public:
+        _Digest_test_index() noexcept : _Myindex(), _Mykeys() {}
+
+        ~_Digest_test_index() noexcept {}
+
+        _Digest_test_index(const _Digest_test_index&) = delete;
+        _Digest_test_index& operator=(const _Digest_test_index&) = delete;
+
+        // stores the key and indexes it at the next position
+        uint32_t _Insert(const _Digest_test_key& _Key) {
+            const uint32_t _Pos = static_cast<uint32_t>(_Mykeys.size());
+            _Mykeys.push_back(_Key);
+            _Myindex._Insert(_Key.data(), _Pos);
+            return _Pos;
+        }
+
+        // removes the key stored at the selected position from the index
+        void _Erase(const uint32_t _Pos) noexcept {
+            _Myindex._Erase(_Mykeys[_Pos].data(), _Pos);
+        }
+
+        // returns the position of the key, npos if not indexed
+        _NODISCARD uint32_t _Find(const _Digest_test_key& _Key) const noexcept {
+            return _Myindex._Find(_Key.data(), [this](const uint32_t _Pos) noexcept {
+                return _Mykeys[_Pos].data();
+            });
+        }
+
+        // returns the number of indexed keys
+        _NODISCARD size_t _Size() const noexcept {
+            return _Myindex._Size();
+        }
+
+    private:
+        _Digest_index<16> _Myindex;
+        _STD vector<_Digest_test_key> _Mykeys;
+    };
+
+    // CONSTANT _Digest_test_npos
+    inline constexpr uint32_t _Digest_test_npos = _Digest_index<16>::npos;
+
+    TEST(core_container, digest_index_colliding_digests) {
+        // Note: Keys with the same first 8 bytes share the hash, keys whose hashes differ only
+        //       in the high bits share the home slot. All of them must be told apart.
+        _Digest_test_index _Index;
+        const uint32_t _Same_hash[] = {_Index._Insert(_Make_digest_test_key(0x1234, 1)),
+            _Index._Insert(_Make_digest_test_key(0x1234, 2)),
+            _Index._Insert(_Make_digest_test_key(0x1234, 3))};
+        const uint32_t _Same_slot[] = {_Index._Insert(_Make_digest_test_key(0x1000'0000'0000'0005, 0)),
+            _Index._Insert(_Make_digest_test_key(0x2000'0000'0000'0005, 0))};
+        EXPECT_EQ(_Index._Size(), size_t{5});
+        for (uint32_t _Idx = 0; _Idx < 3; ++_Idx) {
+            EXPECT_EQ(_Index._Find(_Make_digest_test_key(0x1234, _Idx + 1)), _Same_hash[_Idx]);
+        }
+
+        EXPECT_EQ(_Index._Find(_Make_digest_test_key(0x1000'0000'0000'0005, 0)), _Same_slot[0]);
+        EXPECT_EQ(_Index._Find(_Make_digest_test_key(0x2000'0000'0000'0005, 0)), _Same_slot[1]);
+        EXPECT_EQ(_Index._Find(_Make_digest_test_key(0x1234, 4)), _Digest_test_npos); // same hash, not stored
+        EXPECT_EQ(_Index._Find(_Make_digest_test_key(0x3000'0000'0000'0005, 0)), _Digest_test_npos);
+    }
+
+    TEST(core_container, digest_index_erase_in_probe_run) {
+        // Note: All keys have the same home slot, so they form one probe run. Erasing a key from
+        //       the middle of the run must keep the keys after it reachable, and a new key must
+        //       be able to reuse the freed slot.
+        static constexpr size_t _Count = 6;
+        auto _Run_key                  = [](const uint64_t _Idx) noexcept {
+            return _Make_digest_test_key((_Idx << 32) | 7, _Idx); // home slot 7
+        };
+        _Digest_test_index _Index;
+        for (uint64_t _Idx = 0; _Idx < _Count; ++_Idx) {
+            EXPECT_EQ(_Index._Insert(_Run_key(_Idx)), _Idx);
+        }
+
+        _Index._Erase(2);
+        _Index._Erase(0);
+        EXPECT_EQ(_Index._Size(), _Count - 2);
+        for (uint64_t _Idx = 0; _Idx < _Count; ++_Idx) {
+            const uint32_t _Expected = _Idx == 0 || _Idx == 2 ? _Digest_test_npos
+                : static_cast<uint32_t>(_Idx);
+            EXPECT_EQ(_Index._Find(_Run_key(_Idx)), _Expected);
+        }
+
+        const uint32_t _Pos = _Index._Insert(_Run_key(9));
+        EXPECT_EQ(_Index._Find(_Run_key(9)), _Pos);
+        EXPECT_EQ(_Index._Find(_Run_key(5)), 5);
+        _Index._Erase(5);
+        _Index._Erase(5); // not indexed anymore, nothing happens
+        EXPECT_EQ(_Index._Size(), _Count - 2);
+        EXPECT_EQ(_Index._Find(_Run_key(5)), _Digest_test_npos);
+        EXPECT_EQ(_Index._Find(_Run_key(4)), 4);
+    }
+
+    TEST(core_container, digest_index_growth) {
+        // Note: The index starts with 16 slots and doubles when it is half full, so inserting
+        //       the keys one by one rehashes it many times. Every third key is erased between
+        //       the rehashes, the others must keep their positions.
+        static constexpr size_t _Count = 5000;
+        _Digest_test_index _Index;
+        for (uint64_t _Idx = 0; _Idx < _Count; ++_Idx) {
+            const uint64_t _Prefix = _Idx / 2 * 0x9E37'79B9'7F4A'7C15; // two keys share each hash
+            EXPECT_EQ(_Index._Insert(_Make_digest_test_key(_Prefix, _Idx)), _Idx);
+            if (_Idx % 3 == 2) {
+                _Index._Erase(static_cast<uint32_t>(_Idx - 1));
+            }
+        }
+
+        EXPECT_EQ(_Index._Size(), _Count - _Count / 3);
+        for (uint64_t _Idx = 0; _Idx < _Count; ++_Idx) {
+            const uint64_t _Prefix   = _Idx / 2 * 0x9E37'79B9'7F4A'7C15;
+            const uint32_t _Expected = _Idx % 3 == 1 && _Idx + 1 < _Count ? _Digest_test_npos
+                : static_cast<uint32_t>(_Idx);
+            EXPECT_EQ(_Index._Find(_Make_digest_test_key(_Prefix, _Idx)), _Expected);
+        }
+    }
+} // namespace tests
+
+#endif // _UNIT_CORE_CONTAINER_DIGEST_INDEX_HPP_
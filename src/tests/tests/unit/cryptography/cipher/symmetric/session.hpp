@@ -0,0 +1,196 @@
+// session.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _UNIT_CRYPTOGRAPHY_CIPHER_SYMMETRIC_SESSION_HPP_
+#define _UNIT_CRYPTOGRAPHY_CIPHER_SYMMETRIC_SESSION_HPP_
+#include <atomic>
+#include <core/defs.hpp>
+#include <cryptography/cipher/symmetric/aes256_gcm.hpp>
+#include <cryptography/cipher/symmetric/chacha20_poly1305.hpp>
+#include <cryptography/cipher/symmetric/iv.hpp>
+#include <cryptography/cipher/symmetric/session.hpp>
+#include <cryptography/cipher/symmetric/symmetric_key.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <unit/common.hpp>
+#include <vector>
+
+// SDSDLL types
+using _SDSDLL aes256_gcm_session;
+using _SDSDLL aes256_gcm_traits;
+using _SDSDLL chacha20_poly1305_session;
+using _SDSDLL chacha20_poly1305_traits;
+using _SDSDLL iv;
+using _SDSDLL symmetric_key;
+
+namespace tests {
+    // FUNCTION _Make_session_test_nonce
+    inline iv<12> _Make_session_test_nonce(const iv<12>& _Iv, const uint32_t _Message) {
+        iv<12> _Result = _Iv;
+        for (size_t _Off = 0; _Off < 4; ++_Off) {
+            _Result.get()[8 + _Off] ^= static_cast<unsigned char>(_Message >> (_Off * 8));
+        }
+
+        return _Result;
+    }
+
+    // FUNCTION _Make_session_test_text
+    inline _STD string _Make_session_test_text(const size_t _Size) {
+        _STD string _Result(_Size, '\0');
+        for (size_t _Idx = 0; _Idx < _Size; ++_Idx) {
+            _Result[_Idx] = static_cast<char>('a' + (_Idx * 7 + _Idx / 13) % 26);
+        }
+
+        return _Result;
+    }
+
+    // FUNCTION TEMPLATE _Run_session_round_trip
+    template <class _Traits, class _Session>
+    inline void _Run_session_round_trip() {
+        // Note: The session must produce the same ciphers as the one-shot traits and decrypt them
+        //       back, for texts shorter than a block and texts of many blocks.
+        static constexpr size_t _Sizes[] = {1, 15, 16, 17, 1000, 65536 + 3};
+        const symmetric_key<32> _Key     = _SDSDLL make_symmetric_key<32>();
+        const iv<12> _Iv                 = _SDSDLL make_iv<12>();
+        uint32_t _Message                = 0;
+        _Session _Sess(_Key);
+        EXPECT_TRUE(_Sess.valid());
+        for (const size_t _Size : _Sizes) {
+            const _STD string& _Text = _Make_session_test_text(_Size);
+            const iv<12>& _Nonce     = _Make_session_test_nonce(_Iv, _Message++);
+            _Test_bytes _Expected(_Traits::bytes_count(_Size), 0);
+            _Test_bytes _Cipher(_Traits::bytes_count(_Size), 0);
+            EXPECT_TRUE(
+                _Traits::encrypt(_Expected.data(), _Expected.size(), _Text.c_str(), _Size, _Key, _Nonce));
+            EXPECT_TRUE(_Sess.encrypt(_Cipher.data(), _Cipher.size(), _Text.c_str(), _Size, _Nonce));
+            EXPECT_EQ(_Cipher, _Expected);
+
+            _STD string _Plain(_Size, '\0');
+            size_t _Count = 0;
+            EXPECT_TRUE(_Sess.decrypt(
+                _Plain.data(), _Plain.size(), _Cipher.c_str(), _Cipher.size(), _Nonce, &_Count));
+            EXPECT_EQ(_Count, _Size);
+            EXPECT_EQ(_Plain, _Text);
+        }
+    }
+
+    // FUNCTION TEMPLATE _Run_session_unicode_round_trip
+    template <class _Traits, class _Session>
+    inline void _Run_session_unicode_round_trip() {
+        // Note: A Unicode text is encrypted as UTF-8, the text below takes 26 bytes in UTF-8
+        //       (9 characters take 2 bytes).
+        static constexpr wchar_t _Text[] = L"Zażółć gęślą jaźń";
+        static constexpr size_t _Size    = sizeof(_Text) / sizeof(wchar_t) - 1;
+        const size_t _Cipher_size        = _Traits::bytes_count(26);
+        const symmetric_key<32> _Key     = _SDSDLL make_symmetric_key<32>();
+        const iv<12> _Iv                 = _SDSDLL make_iv<12>();
+        _Session _Sess(_Key);
+        _Test_bytes _Expected(_Cipher_size, 0);
+        _Test_bytes _Cipher(_Cipher_size, 0);
+        EXPECT_TRUE(_Traits::encrypt(_Expected.data(), _Expected.size(), _Text, _Size, _Key, _Iv));
+        EXPECT_TRUE(_Sess.encrypt(_Cipher.data(), _Cipher.size(), _Text, _Size, _Iv));
+        EXPECT_EQ(_Cipher, _Expected);
+
+        _STD wstring _Plain(_Size, L'\0');
+        size_t _Count = 0;
+        EXPECT_TRUE(
+            _Sess.decrypt(_Plain.data(), _Plain.size(), _Cipher.c_str(), _Cipher.size(), _Iv, &_Count));
+        _Plain.resize(_Count);
+        EXPECT_EQ(_Plain, _Text);
+    }
+
+    // FUNCTION TEMPLATE _Run_session_tamper_test
+    template <class _Traits, class _Session>
+    inline void _Run_session_tamper_test() {
+        // Note: A damaged cipher or tag, or a different nonce, must be rejected, and the output buffer
+        //       must not keep any unauthenticated plain bytes.
+        static constexpr size_t _Size = 100;
+        const symmetric_key<32> _Key  = _SDSDLL make_symmetric_key<32>();
+        const iv<12> _Iv              = _SDSDLL make_iv<12>();
+        const _STD string& _Text      = _Make_session_test_text(_Size);
+        _Session _Sess(_Key);
+        _Test_bytes _Cipher(_Traits::bytes_count(_Size), 0);
+        EXPECT_TRUE(_Sess.encrypt(_Cipher.data(), _Cipher.size(), _Text.c_str(), _Size, _Iv));
+        auto _Expect_rejected = [&](const _Test_bytes& _Damaged, const iv<12>& _Nonce) {
+            _STD string _Plain(_Size, '#');
+            EXPECT_FALSE(
+                _Sess.decrypt(_Plain.data(), _Plain.size(), _Damaged.c_str(), _Damaged.size(), _Nonce));
+            EXPECT_EQ(_Plain, _STD string(_Size, '\0'));
+        };
+
+        for (const size_t _Off : {size_t{0}, _Size / 2, _Size - 1, _Size, _Cipher.size() - 1}) {
+            _Test_bytes _Damaged = _Cipher;
+            _Damaged[_Off] ^= 0x01; // the last two offsets are in the tag
+            _Expect_rejected(_Damaged, _Iv);
+        }
+
+        _Expect_rejected(_Cipher, _Make_session_test_nonce(_Iv, 1));
+        _STD string _Plain(_Size, '\0');
+        EXPECT_TRUE(_Sess.decrypt(_Plain.data(), _Plain.size(), _Cipher.c_str(), _Cipher.size(), _Iv));
+        EXPECT_EQ(_Plain, _Text); // the session still works after the failures
+    }
+
+    // FUNCTION TEMPLATE _Run_session_concurrency_test
+    template <class _Traits, class _Session>
+    inline void _Run_session_concurrency_test() {
+        // Note: Each message takes its own context from the session, so concurrent messages must not
+        //       affect each other. Each cipher is compared with the one-shot traits.
+        static constexpr size_t _Threads  = 4;
+        static constexpr size_t _Messages = 200;
+        const symmetric_key<32> _Key      = _SDSDLL make_symmetric_key<32>();
+        const iv<12> _Iv                  = _SDSDLL make_iv<12>();
+        _Session _Sess(_Key);
+        _STD atomic<size_t> _Mismatches(0);
+        _STD vector<_STD thread> _Workers;
+        for (size_t _Thread = 0; _Thread < _Threads; ++_Thread) {
+            _Workers.emplace_back([&, _Thread] {
+                for (size_t _Idx = 0; _Idx < _Messages; ++_Idx) {
+                    const uint32_t _Message  = static_cast<uint32_t>(_Thread * _Messages + _Idx);
+                    const size_t _Size       = 1 + _Message % 300;
+                    const _STD string& _Text = _Make_session_test_text(_Size);
+                    const iv<12>& _Nonce     = _Make_session_test_nonce(_Iv, _Message);
+                    _Test_bytes _Expected(_Traits::bytes_count(_Size), 0);
+                    _Test_bytes _Cipher(_Traits::bytes_count(_Size), 0);
+                    _STD string _Plain(_Size, '\0');
+                    const bool _Sealed = _Traits::encrypt(
+                        _Expected.data(), _Expected.size(), _Text.c_str(), _Size, _Key, _Nonce)
+                        && _Sess.encrypt(_Cipher.data(), _Cipher.size(), _Text.c_str(), _Size, _Nonce);
+                    const bool _Opened = _Sealed && _Cipher == _Expected && _Sess.decrypt(
+                        _Plain.data(), _Plain.size(), _Cipher.c_str(), _Cipher.size(), _Nonce);
+                    if (!_Opened || _Plain != _Text) {
+                        _Mismatches.fetch_add(1);
+                    }
+                }
+            });
+        }
+
+        for (_STD thread& _Worker : _Workers) {
+            _Worker.join();
+        }
+
+        EXPECT_EQ(_Mismatches.load(), size_t{0});
+    }
+
+    TEST(cryptography_cipher_symmetric, aes256_gcm_session) {
+        _Run_session_round_trip<aes256_gcm_traits<char>, aes256_gcm_session<char>>();
+        _Run_session_unicode_round_trip<aes256_gcm_traits<wchar_t>, aes256_gcm_session<wchar_t>>();
+        _Run_session_tamper_test<aes256_gcm_traits<char>, aes256_gcm_session<char>>();
+        _Run_session_concurrency_test<aes256_gcm_traits<char>, aes256_gcm_session<char>>();
+    }
+
+    TEST(cryptography_cipher_symmetric, chacha20_poly1305_session) {
+        using _Wide_traits = chacha20_poly1305_traits<wchar_t>;
+        _Run_session_round_trip<chacha20_poly1305_traits<char>, chacha20_poly1305_session<char>>();
+        _Run_session_unicode_round_trip<_Wide_traits, chacha20_poly1305_session<wchar_t>>();
+        _Run_session_tamper_test<chacha20_poly1305_traits<char>, chacha20_poly1305_session<char>>();
+        _Run_session_concurrency_test<chacha20_poly1305_traits<char>, chacha20_poly1305_session<char>>();
+    }
+} // namespace tests
+
+#endif // _UNIT_CRYPTOGRAPHY_CIPHER_SYMMETRIC_SESSION_HPP_
@@ -0,0 +1,211 @@
+// stream.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _UNIT_CRYPTOGRAPHY_CIPHER_SYMMETRIC_STREAM_HPP_
+#define _UNIT_CRYPTOGRAPHY_CIPHER_SYMMETRIC_STREAM_HPP_
+#include <algorithm>
+#include <core/defs.hpp>
+#include <cryptography/cipher/symmetric/aes256_gcm.hpp>
+#include <cryptography/cipher/symmetric/chacha20_poly1305.hpp>
+#include <cryptography/cipher/symmetric/iv.hpp>
+#include <cryptography/cipher/symmetric/stream.hpp>
+#include <cryptography/cipher/symmetric/symmetric_key.hpp>
+#include <cstddef>
+#include <filesystem/file.hpp>
+#include <gtest/gtest.h>
+#include <string>
+#include <unit/common.hpp>
+
+// SDSDLL types
+using _SDSDLL aead_segment_size;
+using _SDSDLL aes256_gcm_traits;
+using _SDSDLL chacha20_poly1305_traits;
+using _SDSDLL file;
+using _SDSDLL iv;
+using _SDSDLL stream_decryptor;
+using _SDSDLL stream_encryptor;
+using _SDSDLL symmetric_key;
+
+namespace tests {
+    // CONSTANT _Stream_test_segment_size
+    inline constexpr size_t _Stream_test_segment_size = aead_segment_size + 16; // segment and its tag
+
+    // FUNCTION _Make_stream_test_payload
+    inline _Test_bytes _Make_stream_test_payload(const size_t _Size) {
+        _Test_bytes _Result(_Size, 0);
+        for (size_t _Idx = 0; _Idx < _Size; ++_Idx) {
+            _Result[_Idx] = static_cast<unsigned char>(_Idx * 31 + _Idx / 251);
+        }
+
+        return _Result;
+    }
+
+    // FUNCTION TEMPLATE _Encrypt_stream_test_payload
+    template <class _Traits>
+    inline _Test_bytes _Encrypt_stream_test_payload(const _Test_bytes& _Payload,
+        const symmetric_key<32>& _Key, const iv<12>& _Iv, const size_t _Part) {
+        // Note: The payload is appended in parts that do not match the segments.
+        static constexpr wchar_t _Target[] = L"unit_stream_cipher.bin";
+        {
+            file _File = _Open_test_file(_Target);
+            stream_encryptor<_Traits> _Stream(_File, _Key, _Iv);
+            for (size_t _Off = 0; _Off < _Payload.size(); _Off += _Part) {
+                const size_t _Count = (_STD min)(_Part, _Payload.size() - _Off);
+                EXPECT_TRUE(_Stream.append(_Payload.c_str() + _Off, _Count));
+            }
+
+            EXPECT_TRUE(_Stream.complete());
+        }
+
+        const _Test_bytes& _Result = _Read_test_file(_Target);
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+        return _Result;
+    }
+
+    // FUNCTION TEMPLATE _Decrypt_stream_test_payload
+    template <class _Traits>
+    inline bool _Decrypt_stream_test_payload(const _Test_bytes& _Cipher,
+        const symmetric_key<32>& _Key, const iv<12>& _Iv, _Test_bytes& _Payload) {
+        static constexpr wchar_t _Target[] = L"unit_stream_plain.bin";
+        bool _Result = false;
+        {
+            file _File = _Open_test_file(_Target);
+            stream_decryptor<_Traits> _Stream(_File, _Key, _Iv);
+            _Result = _Stream.append(_Cipher.c_str(), _Cipher.size()) && _Stream.complete();
+        }
+
+        _Payload = _Read_test_file(_Target);
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+        return _Result;
+    }
+
+    // FUNCTION TEMPLATE _Run_stream_round_trip_test
+    template <class _Traits>
+    inline void _Run_stream_round_trip_test() {
+        // Note: Only the last segment may be shorter, an empty payload is stored as a single tag.
+        static constexpr size_t _Sizes[] = {0, aead_segment_size, aead_segment_size + 1, 3 * 1024 * 1024 + 5};
+        const symmetric_key<32> _Key     = _SDSDLL make_symmetric_key<32>();
+        const iv<12> _Iv                 = _SDSDLL make_iv<12>();
+        for (const size_t _Size : _Sizes) {
+            const _Test_bytes& _Payload = _Make_stream_test_payload(_Size);
+            const _Test_bytes& _Cipher  =
+                _Encrypt_stream_test_payload<_Traits>(_Payload, _Key, _Iv, 1000);
+            const size_t _Segments      = _Size == 0 ? 1 : (_Size - 1) / aead_segment_size + 1;
+            EXPECT_EQ(_Cipher.size(), _Size + 16 * _Segments);
+            _Test_bytes _Decrypted;
+            EXPECT_TRUE(_Decrypt_stream_test_payload<_Traits>(_Cipher, _Key, _Iv, _Decrypted));
+            EXPECT_EQ(_Decrypted, _Payload);
+        }
+    }
+
+    // FUNCTION TEMPLATE _Run_stream_tampered_test
+    template <class _Traits>
+    inline void _Run_stream_tampered_test() {
+        // Note: The payload has three full segments, the last one is marked. Each change keeps
+        //       the segments intact, so only the segment order and the last-segment mark reject it.
+        const symmetric_key<32> _Key = _SDSDLL make_symmetric_key<32>();
+        const iv<12> _Iv             = _SDSDLL make_iv<12>();
+        const _Test_bytes& _Payload  = _Make_stream_test_payload(3 * aead_segment_size);
+        const _Test_bytes& _Cipher   = _Encrypt_stream_test_payload<_Traits>(_Payload, _Key, _Iv, 4096);
+        EXPECT_EQ(_Cipher.size(), 3 * _Stream_test_segment_size);
+        static constexpr size_t _Size = _Stream_test_segment_size;
+        const _Test_bytes& _First     = _Cipher.substr(0, _Size);
+        const _Test_bytes& _Second    = _Cipher.substr(_Size, _Size);
+        const _Test_bytes& _Third     = _Cipher.substr(2 * _Size);
+        _Test_bytes _Decrypted;
+        EXPECT_TRUE(_Decrypt_stream_test_payload<_Traits>(_First + _Second + _Third, _Key, _Iv, _Decrypted));
+        EXPECT_EQ(_Decrypted, _Payload);
+
+        // truncated at the segment boundary, the last segment is missing (the first segment has already
+        // been released, the caller must discard the target)
+        EXPECT_FALSE(_Decrypt_stream_test_payload<_Traits>(_First + _Second, _Key, _Iv, _Decrypted));
+        EXPECT_EQ(_Decrypted, _Payload.substr(0, aead_segment_size));
+
+        // swapped segments
+        EXPECT_FALSE(_Decrypt_stream_test_payload<_Traits>(_Second + _First + _Third, _Key, _Iv, _Decrypted));
+        EXPECT_FALSE(_Decrypt_stream_test_payload<_Traits>(_First + _Third + _Second, _Key, _Iv, _Decrypted));
+
+        // appended segment, after the last one
+        EXPECT_FALSE(_Decrypt_stream_test_payload<_Traits>(_Cipher + _Second, _Key, _Iv, _Decrypted));
+        EXPECT_FALSE(_Decrypt_stream_test_payload<_Traits>(_Cipher + _Third, _Key, _Iv, _Decrypted));
+    }
+
+    // FUNCTION TEMPLATE _Decrypt_stream_test_file
+    template <class _Traits>
+    inline bool _Decrypt_stream_test_file(const _Test_bytes& _Cipher,
+        const symmetric_key<32>& _Key, const iv<12>& _Iv, _Test_bytes& _Payload) {
+        static constexpr wchar_t _Source[] = L"unit_stream_file_cipher.bin";
+        static constexpr wchar_t _Target[] = L"unit_stream_file_plain.bin";
+        _Write_test_file(_Source, _Cipher);
+        bool _Result = false;
+        {
+            file _Source_file(_Source, _SDSDLL file_access::read);
+            file _Target_file = _Open_test_file(_Target);
+            _Result           = _SDSDLL decrypt_file<_Traits>(_Source_file, _Target_file, _Key, _Iv);
+        }
+
+        _Payload = _Read_test_file(_Target);
+        EXPECT_TRUE(_SDSDLL delete_file(_Source));
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+        return _Result;
+    }
+
+    // FUNCTION TEMPLATE _Run_stream_file_test
+    template <class _Traits>
+    inline void _Run_stream_file_test() {
+        // Note: The files are read in blocks of 16 segments, the payload spans three blocks and ends
+        //       in a short segment. The file ciphertext must match the appended one.
+        static constexpr wchar_t _Source[] = L"unit_stream_file_source.bin";
+        static constexpr wchar_t _Target[] = L"unit_stream_file_target.bin";
+        const symmetric_key<32> _Key       = _SDSDLL make_symmetric_key<32>();
+        const iv<12> _Iv                   = _SDSDLL make_iv<12>();
+        const _Test_bytes& _Payload        = _Make_stream_test_payload(32 * aead_segment_size + 7);
+        _Write_test_file(_Source, _Payload);
+        {
+            file _Source_file(_Source, _SDSDLL file_access::read);
+            file _Target_file = _Open_test_file(_Target);
+            EXPECT_TRUE(_SDSDLL encrypt_file<_Traits>(_Source_file, _Target_file, _Key, _Iv));
+        }
+
+        const _Test_bytes& _Cipher = _Read_test_file(_Target);
+        EXPECT_TRUE(_SDSDLL delete_file(_Source));
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+        EXPECT_EQ(_Cipher, _Encrypt_stream_test_payload<_Traits>(_Payload, _Key, _Iv, 5000));
+        _Test_bytes _Decrypted;
+        EXPECT_TRUE(_Decrypt_stream_test_file<_Traits>(_Cipher, _Key, _Iv, _Decrypted));
+        EXPECT_EQ(_Decrypted, _Payload);
+
+        // truncated inside the last segment, at the segment boundary and inside the tag
+        EXPECT_FALSE(_Decrypt_stream_test_file<_Traits>(
+            _Cipher.substr(0, _Cipher.size() - 1), _Key, _Iv, _Decrypted));
+        EXPECT_FALSE(_Decrypt_stream_test_file<_Traits>(
+            _Cipher.substr(0, 32 * _Stream_test_segment_size), _Key, _Iv, _Decrypted));
+        EXPECT_FALSE(_Decrypt_stream_test_file<_Traits>(
+            _Cipher.substr(0, 32 * _Stream_test_segment_size + 8), _Key, _Iv, _Decrypted));
+
+        // modified ciphertext and tag of a segment inside the second block
+        _Test_bytes _Tampered = _Cipher;
+        _Tampered[20 * _Stream_test_segment_size + 100] ^= 0x01;
+        EXPECT_FALSE(_Decrypt_stream_test_file<_Traits>(_Tampered, _Key, _Iv, _Decrypted));
+        _Tampered = _Cipher;
+        _Tampered[21 * _Stream_test_segment_size - 1] ^= 0x80;
+        EXPECT_FALSE(_Decrypt_stream_test_file<_Traits>(_Tampered, _Key, _Iv, _Decrypted));
+    }
+
+    TEST(cryptography_cipher_symmetric, aes256_gcm_stream) {
+        _Run_stream_round_trip_test<aes256_gcm_traits<unsigned char>>();
+        _Run_stream_tampered_test<aes256_gcm_traits<unsigned char>>();
+        _Run_stream_file_test<aes256_gcm_traits<unsigned char>>();
+    }
+
+    TEST(cryptography_cipher_symmetric, chacha20_poly1305_stream) {
+        _Run_stream_round_trip_test<chacha20_poly1305_traits<unsigned char>>();
+        _Run_stream_tampered_test<chacha20_poly1305_traits<unsigned char>>();
+        _Run_stream_file_test<chacha20_poly1305_traits<unsigned char>>();
+    }
+} // namespace tests
+
+#endif // _UNIT_CRYPTOGRAPHY_CIPHER_SYMMETRIC_STREAM_HPP_
@@ -6,6 +6,7 @@
 #pragma once
 #ifndef _UNIT_CRYPTOGRAPHY_HASH_GENERIC_BLAKE3_HPP_
 #define _UNIT_CRYPTOGRAPHY_HASH_GENERIC_BLAKE3_HPP_
+#include <algorithm>
 #include <core/defs.hpp>
 #include <core/traits/string_traits.hpp>
 #include <cstddef>
@@ -13,12 +14,19 @@
 #include <cstring>
 #include <cryptography/hash/generic.hpp>
 #include <cryptography/hash/generic/blake3.hpp>
+#include <cryptography/hash/generic/blake3_tree.hpp>
+#include <filesystem/file.hpp>
 #include <gtest/gtest.h>
+#include <string>
+#include <system/execution/thread_pool.hpp>
 #include <unit/cryptography/hash/generic/common.hpp>
+#include <vector>
 
 // SDSDLL types
 using _SDSDLL blake3_traits;
 using _SDSDLL byte_string;
+using _SDSDLL file;
+using _SDSDLL thread_pool;
 
 namespace tests {
     // CLASS _Blake3_test
@@ -100,6 +108,69 @@ namespace tests {
         _Test._Run_test_case(_Test._Unicode_short(), _Blake3_test::_Unicode);
         _Test._Run_test_case(_Test._Unicode_long(), _Blake3_test::_Unicode);
     }
+
+    TEST(cryptography_hash_generic, blake3_file_parallel) {
+        // Note: The file spans many batches and ends with a partial subtree and a partial chunk, the parallel
+        //       hash must be equal to the serial one. Both thread-pools hash the tree, in batches of 2 and 4
+        //       subtrees, the thread-pool without threads always uses the serial hash.
+        static constexpr wchar_t _Target[] = L"blake3_file_parallel.bin";
+        static constexpr size_t _Size      = 33 * 1048576 + 517;
+        {
+            file _File(_Target, _SDSDLL file_access::all,
+                _SDSDLL file_share::none, _SDSDLL file_disposition::force_create);
+            ASSERT_TRUE(_File.is_open());
+            _STD basic_string<uint8_t> _Data(_Size, static_cast<uint8_t>(0));
+            for (size_t _Idx = 0; _Idx < _Size; ++_Idx) {
+                _Data[_Idx] = static_cast<uint8_t>(_Idx % 251);
+            }
+
+            ASSERT_TRUE(_File.write(_Data));
+        }
+
+        file _File(_Target, _SDSDLL file_access::read);
+        ASSERT_TRUE(_File.is_open());
+        const byte_string& _Serial = _SDSDLL hash_file<blake3_traits<uint8_t>>(_File);
+        ASSERT_EQ(_Serial.size(), size_t{32});
+        EXPECT_TRUE(_CSTD memcmp(_Serial.c_str(),
+            "\x19\x9D\x0F\x5C\x1E\x3D\x4C\x82\x19\x66\x63\x6D\x42\xBB\x4B\xDE"
+            "\x97\xC8\x5C\x82\xCF\x30\x19\x03\x5D\x94\xFF\x71\x61\x57\xBC\xBC",
+            _Serial.size()) == 0);
+        for (const size_t _Threads : {size_t{0}, size_t{1}, size_t{3}}) {
+            thread_pool _Pool(_Threads);
+            unsigned char _Bytes[32];
+            EXPECT_TRUE(blake3_traits<uint8_t>::hash_file_parallel(_Bytes, sizeof(_Bytes), _File, 0, _Pool));
+            EXPECT_TRUE(_Serial == byte_string(_Bytes, sizeof(_Bytes)));
+        }
+
+        _File.close();
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+    }
+
+    TEST(cryptography_hash_generic, blake3_tree) {
+        // Note: The subtrees are hashed and merged directly, so the tree is checked on any hardware.
+        //       The sizes cover a last subtree with a single partial chunk, full subtrees only, a partial
+        //       chunk after full chunks and a subtree count that is not a power of 2.
+        static constexpr size_t _Subtree = _SDSDLL _Blake3_subtree_size;
+        static constexpr size_t _Sizes[] = {_Subtree + 100, 2 * _Subtree,
+            3 * _Subtree + 3 * _SDSDLL _Blake3_chunk_size + 5, 5 * _Subtree - 1};
+        for (const size_t _Size : _Sizes) {
+            _STD basic_string<uint8_t> _Data(_Size, static_cast<uint8_t>(0));
+            for (size_t _Idx = 0; _Idx < _Size; ++_Idx) {
+                _Data[_Idx] = static_cast<uint8_t>(_Idx % 251);
+            }
+
+            _STD vector<_SDSDLL _Blake3_chaining_value> _Cvs;
+            for (size_t _Off = 0; _Off < _Size; _Off += _Subtree) {
+                _Cvs.push_back(_SDSDLL _Blake3_subtree_cv(_Data.c_str() + _Off,
+                    (_STD min)(_Size - _Off, _Subtree), _Off / _SDSDLL _Blake3_chunk_size));
+            }
+
+            unsigned char _Bytes[32];
+            _SDSDLL _Blake3_root_hash(_Cvs.data(), _Cvs.size(), _Bytes);
+            EXPECT_TRUE(_SDSDLL hash<blake3_traits<uint8_t>>(_Data.c_str(), _Size)
+                == byte_string(_Bytes, sizeof(_Bytes)));
+        }
+    }
 } // namespace tests
 
 #endif // _UNIT_CRYPTOGRAPHY_HASH_GENERIC_BLAKE3_HPP_
\ No newline at end of file
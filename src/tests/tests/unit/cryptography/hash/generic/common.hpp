@@ -14,10 +14,14 @@
 #include <cstring>
 #include <cryptography/hash/generic.hpp>
 #include <cryptography/hash/generic/blake3.hpp>
+#include <cryptography/hash/generic/file_reader.hpp>
+#include <filesystem/file.hpp>
 #include <gtest/gtest.h>
+#include <string>
 
 // SDSDLL types
 using _SDSDLL byte_string;
+using _SDSDLL file;
 
 namespace tests {
     // CLASS TEMPLATE _Hash_test_base
@@ -82,6 +86,33 @@ namespace tests {
             unsigned char _Bytes[_Bits / CHAR_BIT]; // expected bytes
         };
     };
+
+    // FUNCTION TEMPLATE _Run_hash_file_test
+    template <class _Traits>
+    inline void _Run_hash_file_test(const wchar_t* const _Target) {
+        // Note: The sizes end inside the first block, at the block boundary and inside a later block,
+        //       so both the direct read and the read-ahead of the following blocks are used.
+        static constexpr size_t _Block   = _SDSDLL _Hash_file_block_size;
+        static constexpr size_t _Sizes[] = {0, 100, _Block, _Block + 1, 2 * _Block, 7 * _Block + 13};
+        for (const size_t _Size : _Sizes) {
+            _STD basic_string<unsigned char> _Data(_Size, 0);
+            for (size_t _Idx = 0; _Idx < _Size; ++_Idx) {
+                _Data[_Idx] = static_cast<unsigned char>(_Idx * 7 + _Idx / 1000);
+            }
+
+            {
+                file _File(_Target, _SDSDLL file_access::all,
+                    _SDSDLL file_share::none, _SDSDLL file_disposition::force_create);
+                EXPECT_TRUE(_Data.empty() || _File.write(_Data.c_str(), _Data.size()));
+            }
+
+            const byte_string& _Bytes = _SDSDLL hash_file<_Traits>(_Target);
+            EXPECT_FALSE(_Bytes.empty());
+            EXPECT_EQ(_Bytes, _SDSDLL hash<_Traits>(_Data.c_str(), _Data.size()));
+        }
+
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+    }
 } // namespace tests
 
 #endif // _UNIT_CRYPTOGRAPHY_HASH_GENERIC_COMMON_HPP_
\ No newline at end of file
@@ -112,6 +112,10 @@ namespace tests {
         _Test._Run_test_case(_Test._Unicode_short(), _Sha512_test::_Unicode);
         _Test._Run_test_case(_Test._Unicode_long(), _Sha512_test::_Unicode);
     }
+
+    TEST(cryptography_hash_generic, sha512_file) {
+        _Run_hash_file_test<sha512_traits<unsigned char>>(L"sha512_file.bin");
+    }
 } // namespace tests
 
 #endif // _UNIT_CRYPTOGRAPHY_HASH_GENERIC_SHA512_HPP_
\ No newline at end of file
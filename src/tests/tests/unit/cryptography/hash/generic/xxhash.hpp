@@ -82,6 +82,10 @@ namespace tests {
         _Test._Run_test_case(_Test._Unicode_short(), _Xxhash_test::_Unicode);
         _Test._Run_test_case(_Test._Unicode_long(), _Xxhash_test::_Unicode);
     }
+
+    TEST(cryptography_hash_generic, xxhash_file) {
+        _Run_hash_file_test<xxhash_traits<unsigned char>>(L"xxhash_file.bin");
+    }
 } // namespace tests
 
 #endif // _UNIT_CRYPTOGRAPHY_HASH_GENERIC_XXHASH_HPP_
\ No newline at end of file
@@ -0,0 +1,134 @@
+// argon2.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _UNIT_CRYPTOGRAPHY_HASH_PASSWORD_ARGON2_HPP_
+#define _UNIT_CRYPTOGRAPHY_HASH_PASSWORD_ARGON2_HPP_
+#include <core/defs.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cryptography/hash/password/arena.hpp>
+#include <cryptography/hash/password/argon2_core.hpp>
+#include <cryptography/hash/password/argon2d.hpp>
+#include <cryptography/hash/password/argon2i.hpp>
+#include <cryptography/hash/password/argon2id.hpp>
+#include <gtest/gtest.h>
+
+// SDSDLL types
+using _SDSDLL argon2d_traits;
+using _SDSDLL argon2i_traits;
+using _SDSDLL argon2id_traits;
+using _SDSDLL _Argon2_extras;
+using _SDSDLL _Argon2_variant;
+using _SDSDLL password_arena;
+
+namespace tests {
+    // FUNCTION TEMPLATE _Run_argon2_test_case
+    template <template <class> class _Traits>
+    void _Run_argon2_test_case(const char* const _Expected) noexcept {
+        // Note: 256 KiB of memory, 2 iterations and 2 lanes. The hash must be the same for the UTF-8
+        //       and the Unicode password, and for the thread arena and a separate one.
+        const typename _Traits<char>::salt _Salt(reinterpret_cast<const uint8_t*>("somesalt12345678"));
+        unsigned char _Bytes[64];
+        EXPECT_TRUE(_Traits<char>::hash(_Bytes, sizeof(_Bytes), "password", 8, _Salt, 256, 2, 2));
+        EXPECT_TRUE(_CSTD memcmp(_Bytes, _Expected, sizeof(_Bytes)) == 0);
+        _CSTD memset(_Bytes, 0, sizeof(_Bytes));
+        EXPECT_TRUE(_Traits<wchar_t>::hash(_Bytes, sizeof(_Bytes), L"password", 8, _Salt, 256, 2, 2));
+        EXPECT_TRUE(_CSTD memcmp(_Bytes, _Expected, sizeof(_Bytes)) == 0);
+        password_arena _Arena(1048576);
+        for (int _Round = 0; _Round < 2; ++_Round) { // the arena must be reusable
+            _CSTD memset(_Bytes, 0, sizeof(_Bytes));
+            EXPECT_TRUE(_Traits<char>::hash(_Bytes, sizeof(_Bytes), "password", 8, _Salt, 256, 2, 2, _Arena));
+            EXPECT_TRUE(_CSTD memcmp(_Bytes, _Expected, sizeof(_Bytes)) == 0);
+        }
+    }
+
+    // FUNCTION _Run_argon2_rfc_test_case
+    inline void _Run_argon2_rfc_test_case(
+        const _Argon2_variant _Variant, const char* const _Expected) noexcept {
+        // Note: The test vectors from RFC 9106, section 5: 32 KiB of memory, 3 iterations, 4 lanes,
+        //       an 8-byte secret key, 12 bytes of associated data and a 32-byte tag.
+        uint8_t _Password[32];
+        uint8_t _Salt[16];
+        uint8_t _Secret[8];
+        uint8_t _Data[12];
+        _CSTD memset(_Password, 0x01, sizeof(_Password));
+        _CSTD memset(_Salt, 0x02, sizeof(_Salt));
+        _CSTD memset(_Secret, 0x03, sizeof(_Secret));
+        _CSTD memset(_Data, 0x04, sizeof(_Data));
+        const _Argon2_extras _Extras = {_Secret, sizeof(_Secret), _Data, sizeof(_Data)};
+        uint8_t _Bytes[32];
+        password_arena _Arena;
+        EXPECT_TRUE(_SDSDLL _Argon2_hash(_Variant, _Bytes, sizeof(_Bytes), _Password,
+            sizeof(_Password), _Salt, sizeof(_Salt), 32, 3, 4, _Arena, _Extras));
+        EXPECT_TRUE(_CSTD memcmp(_Bytes, _Expected, sizeof(_Bytes)) == 0);
+    }
+
+    TEST(cryptography_hash_password, argon2d) {
+        _Run_argon2_test_case<argon2d_traits>(
+            "\x1F\x7B\x51\xD3\xB7\x48\x90\xB9\x8A\x74\xAA\x5B\x87\x77\x48\x68"
+            "\x46\x3A\x65\x26\x60\x42\xB2\xAC\xED\x76\x50\xE5\xFD\x3B\x85\x53"
+            "\x14\xD4\x16\x18\xF2\x67\x7A\xA6\x1C\x43\x7D\xF8\x90\x93\x58\xC3"
+            "\xBF\x70\x91\x19\x34\xB4\x45\xD1\x02\x79\xC5\x39\x75\x81\xEA\x6C");
+    }
+
+    TEST(cryptography_hash_password, argon2i) {
+        _Run_argon2_test_case<argon2i_traits>(
+            "\x81\x91\x6D\xBF\xE9\x3C\xBD\x1F\x82\x1D\xC1\xD6\x59\xF5\x95\xF2"
+            "\x02\x28\x1A\x01\xEE\xE7\x7D\xDE\x5C\x56\x0E\x25\x84\xE9\xD4\xD2"
+            "\xA0\xB4\xBE\x8D\x11\x5E\x7A\x92\x18\xB2\x86\x28\x65\x4E\xC9\x9D"
+            "\x3F\x75\x32\xCB\x17\x40\xAB\xCF\xCE\x9D\x98\x6B\x9E\x27\x35\xDA");
+    }
+
+    TEST(cryptography_hash_password, argon2id) {
+        _Run_argon2_test_case<argon2id_traits>(
+            "\x59\xC4\xD4\x70\x01\x46\x2B\xB2\x8E\xDD\x87\x69\xBC\x63\x92\xBF"
+            "\xFA\xB0\xE8\xC8\xC6\x8D\xE5\x18\x20\x04\xBE\x9E\x08\x32\xA1\xC9"
+            "\x90\x1E\x78\xBD\xE9\xD8\x26\x4A\xF4\x6A\xEB\x8D\x4A\xE2\xF1\xA8"
+            "\x5B\x99\xDC\x0B\xC6\x8E\x26\xF7\x4D\x33\xC6\xF8\x4A\xC5\xB9\x3B");
+    }
+
+    TEST(cryptography_hash_password, argon2d_rfc9106) {
+        _Run_argon2_rfc_test_case(_Argon2_variant::_Argon2d,
+            "\x51\x2B\x39\x1B\x6F\x11\x62\x97\x53\x71\xD3\x09\x19\x73\x42\x94"
+            "\xF8\x68\xE3\xBE\x39\x84\xF3\xC1\xA1\x3A\x4D\xB9\xFA\xBE\x4A\xCB");
+    }
+
+    TEST(cryptography_hash_password, argon2i_rfc9106) {
+        _Run_argon2_rfc_test_case(_Argon2_variant::_Argon2i,
+            "\xC8\x14\xD9\xD1\xDC\x7F\x37\xAA\x13\xF0\xD7\x7F\x24\x94\xBD\xA1"
+            "\xC8\xDE\x6B\x01\x6D\xD3\x88\xD2\x99\x52\xA4\xC4\x67\x2B\x6C\xE8");
+    }
+
+    TEST(cryptography_hash_password, argon2id_rfc9106) {
+        _Run_argon2_rfc_test_case(_Argon2_variant::_Argon2id,
+            "\x0D\x64\x0D\xF5\x8D\x78\x76\x6C\x08\xC0\x37\xA3\x4A\x8B\x53\xC9"
+            "\xD0\x1E\xF0\x45\x2D\x75\xB6\x5E\xB5\x25\x20\xE9\x6B\x01\xE6\x59");
+    }
+
+    TEST(cryptography_hash_password, argon2id_long_tag) {
+        // Note: A 100-byte tag consists of two 32-byte parts and a 36-byte digest.
+        static constexpr char _Expected[] =
+            "\xB3\xD9\x41\xAD\x49\xEF\xA8\x56\x7D\xB8\x1D\x9C\x13\xF6\x22\x42"
+            "\x37\x7C\xB4\x5E\x9A\xCE\xB8\xB8\x39\x77\x90\x37\xD6\x49\x22\x38"
+            "\x4B\x9B\x95\xED\x31\xA0\x1C\x23\x7E\xC9\xBA\x04\x6E\x6E\xE9\xE6"
+            "\x78\x10\xBB\x8A\xF9\x5D\xBD\x35\x96\xFC\xEE\x6F\xAC\x7B\xAF\xD5"
+            "\x3C\xCD\xBA\xCA\x34\x93\x4E\xAA\x42\xF5\xE1\x6E\xE7\x93\x19\x85"
+            "\x28\x74\xE0\x4D\x78\xDE\xCF\x8A\x99\x93\xCB\xDE\x6F\xA6\xF0\x8B"
+            "\x51\x5D\xEC\x63";
+        uint8_t _Password[32];
+        uint8_t _Salt[16];
+        _CSTD memset(_Password, 0x01, sizeof(_Password));
+        _CSTD memset(_Salt, 0x02, sizeof(_Salt));
+        uint8_t _Bytes[100];
+        password_arena _Arena;
+        EXPECT_TRUE(_SDSDLL _Argon2_hash(_Argon2_variant::_Argon2id, _Bytes, sizeof(_Bytes),
+            _Password, sizeof(_Password), _Salt, sizeof(_Salt), 32, 3, 4, _Arena));
+        EXPECT_TRUE(_CSTD memcmp(_Bytes, _Expected, sizeof(_Bytes)) == 0);
+    }
+} // namespace tests
+
+#endif // _UNIT_CRYPTOGRAPHY_HASH_PASSWORD_ARGON2_HPP_
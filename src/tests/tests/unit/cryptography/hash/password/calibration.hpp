@@ -0,0 +1,27 @@
+// calibration.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _UNIT_CRYPTOGRAPHY_HASH_PASSWORD_CALIBRATION_HPP_
+#define _UNIT_CRYPTOGRAPHY_HASH_PASSWORD_CALIBRATION_HPP_
+#include <core/defs.hpp>
+#include <cryptography/hash/password/calibration.hpp>
+#include <gtest/gtest.h>
+
+// SDSDLL types
+using _SDSDLL argon2_params;
+
+namespace tests {
+    TEST(cryptography_hash_password, argon2id_calibration) {
+        // Note: The minimum parameters are returned even if the target cannot be reached.
+        argon2_params _Params = {0, 0, 0};
+        EXPECT_TRUE(_SDSDLL calibrate_argon2id(_Params, 1, 1048576, 2));
+        EXPECT_TRUE(_Params == (argon2_params{19456, 2, 2}));
+        EXPECT_FALSE(_SDSDLL calibrate_argon2id(_Params, 0));
+        EXPECT_FALSE(_SDSDLL calibrate_argon2id(_Params, 100, 1024));
+    }
+} // namespace tests
+
+#endif // _UNIT_CRYPTOGRAPHY_HASH_PASSWORD_CALIBRATION_HPP_
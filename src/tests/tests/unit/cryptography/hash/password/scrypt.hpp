@@ -0,0 +1,77 @@
+// scrypt.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _UNIT_CRYPTOGRAPHY_HASH_PASSWORD_SCRYPT_HPP_
+#define _UNIT_CRYPTOGRAPHY_HASH_PASSWORD_SCRYPT_HPP_
+#include <core/defs.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cryptography/hash/password/arena.hpp>
+#include <cryptography/hash/password/scrypt.hpp>
+#include <cryptography/hash/password/scrypt_core.hpp>
+#include <gtest/gtest.h>
+
+// SDSDLL types
+using _SDSDLL password_arena;
+using _SDSDLL scrypt_traits;
+
+namespace tests {
+    // FUNCTION _Run_scrypt_rfc_test_case
+    inline void _Run_scrypt_rfc_test_case(const char* const _Password, const char* const _Salt,
+        const size_t _Cost, const size_t _Block_size, const size_t _Parallelism,
+        const char* const _Expected) {
+        uint8_t _Bytes[64];
+        password_arena _Arena;
+        EXPECT_TRUE(_SDSDLL _Scrypt_hash(_Bytes, sizeof(_Bytes), reinterpret_cast<const uint8_t*>(_Password),
+            _CSTD strlen(_Password), reinterpret_cast<const uint8_t*>(_Salt), _CSTD strlen(_Salt),
+            _Cost, _Block_size, _Parallelism, _Arena));
+        EXPECT_TRUE(_CSTD memcmp(_Bytes, _Expected, sizeof(_Bytes)) == 0);
+    }
+
+    TEST(cryptography_hash_password, scrypt) {
+        // Note: N = 1024, r = 8 and p = 2, the arena is reused by the second hash.
+        static constexpr char _Expected[] =
+            "\xC2\x77\xA4\x9F\x4B\xAB\x98\x02\xE1\x62\x78\xC1\x1D\xAB\xA0\x38"
+            "\x09\x44\x30\xEF\x09\x63\x09\x30\x82\x17\xD2\xFE\x73\xA5\x19\x65"
+            "\x86\x42\x15\xF0\x42\x21\x99\x9F\xA7\xD8\x54\x2A\x9E\xE1\x8F\xB9"
+            "\x37\x46\x9C\xBB\x7F\xC5\xCF\x94\x6D\x97\xB6\x91\xDE\x79\x20\x05";
+        const scrypt_traits<char>::salt _Salt(reinterpret_cast<const uint8_t*>("somesalt12345678"));
+        unsigned char _Bytes[64];
+        password_arena _Arena;
+        for (int _Round = 0; _Round < 2; ++_Round) {
+            _CSTD memset(_Bytes, 0, sizeof(_Bytes));
+            EXPECT_TRUE(
+                scrypt_traits<char>::hash(_Bytes, sizeof(_Bytes), "password", 8, _Salt, 1024, 8, 2, _Arena));
+            EXPECT_TRUE(_CSTD memcmp(_Bytes, _Expected, sizeof(_Bytes)) == 0);
+        }
+
+        _CSTD memset(_Bytes, 0, sizeof(_Bytes));
+        EXPECT_TRUE(scrypt_traits<wchar_t>::hash(_Bytes, sizeof(_Bytes), L"password", 8, _Salt, 1024, 8, 2));
+        EXPECT_TRUE(_CSTD memcmp(_Bytes, _Expected, sizeof(_Bytes)) == 0);
+    }
+
+    TEST(cryptography_hash_password, scrypt_rfc7914) {
+        // Note: The test vectors from RFC 7914, section 12, except the last one (1 GiB of memory).
+        _Run_scrypt_rfc_test_case("", "", 16, 1, 1,
+            "\x77\xD6\x57\x62\x38\x65\x7B\x20\x3B\x19\xCA\x42\xC1\x8A\x04\x97"
+            "\xF1\x6B\x48\x44\xE3\x07\x4A\xE8\xDF\xDF\xFA\x3F\xED\xE2\x14\x42"
+            "\xFC\xD0\x06\x9D\xED\x09\x48\xF8\x32\x6A\x75\x3A\x0F\xC8\x1F\x17"
+            "\xE8\xD3\xE0\xFB\x2E\x0D\x36\x28\xCF\x35\xE2\x0C\x38\xD1\x89\x06");
+        _Run_scrypt_rfc_test_case("password", "NaCl", 1024, 8, 16,
+            "\xFD\xBA\xBE\x1C\x9D\x34\x72\x00\x78\x56\xE7\x19\x0D\x01\xE9\xFE"
+            "\x7C\x6A\xD7\xCB\xC8\x23\x78\x30\xE7\x73\x76\x63\x4B\x37\x31\x62"
+            "\x2E\xAF\x30\xD9\x2E\x22\xA3\x88\x6F\xF1\x09\x27\x9D\x98\x30\xDA"
+            "\xC7\x27\xAF\xB9\x4A\x83\xEE\x6D\x83\x60\xCB\xDF\xA2\xCC\x06\x40");
+        _Run_scrypt_rfc_test_case("pleaseletmein", "SodiumChloride", 16384, 8, 1,
+            "\x70\x23\xBD\xCB\x3A\xFD\x73\x48\x46\x1C\x06\xCD\x81\xFD\x38\xEB"
+            "\xFD\xA8\xFB\xBA\x90\x4F\x8E\x3E\xA9\xB5\x43\xF6\x54\x5D\xA1\xF2"
+            "\xD5\x43\x29\x55\x61\x3F\x0F\xCF\x62\xD4\x97\x05\x24\x2A\x9A\xF9"
+            "\xE6\x1E\x85\xDC\x0D\x65\x1E\x40\xDF\xCF\x01\x7B\x45\x57\x58\x87");
+    }
+} // namespace tests
+
+#endif // _UNIT_CRYPTOGRAPHY_HASH_PASSWORD_SCRYPT_HPP_
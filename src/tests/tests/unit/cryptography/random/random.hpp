@@ -0,0 +1,84 @@
+// random.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _UNIT_CRYPTOGRAPHY_RANDOM_RANDOM_HPP_
+#define _UNIT_CRYPTOGRAPHY_RANDOM_RANDOM_HPP_
+#include <core/defs.hpp>
+#include <cryptography/cipher/symmetric/iv.hpp>
+#include <cryptography/cipher/symmetric/symmetric_key.hpp>
+#include <cryptography/random/random.hpp>
+#include <cryptography/random/salt.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+
+// SDSDLL types
+using _SDSDLL byte_string;
+using _SDSDLL iv;
+using _SDSDLL random_format;
+using _SDSDLL salt;
+using _SDSDLL symmetric_key;
+
+namespace tests {
+    // FUNCTION _Is_zero_random_range
+    inline bool _Is_zero_random_range(const uint8_t* const _Data, const size_t _Size) noexcept {
+        for (size_t _Idx = 0; _Idx < _Size; ++_Idx) {
+            if (_Data[_Idx] != 0) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    TEST(cryptography_random, random_fill) {
+        // Note: The sizes end inside the first chunk, at the chunk boundary and inside a later chunk,
+        //       each chunk must be filled (64 zero bytes in a row are practically impossible).
+        static constexpr size_t _Chunk   = _SDSDLL _Random_chunk_size;
+        static constexpr size_t _Sizes[] = {64, 4096 + 33, _Chunk, _Chunk + 64, 3 * _Chunk + 71};
+        for (const size_t _Size : _Sizes) {
+            _STD basic_string<uint8_t> _First(_Size, static_cast<uint8_t>(0));
+            _STD basic_string<uint8_t> _Second(_Size, static_cast<uint8_t>(0));
+            EXPECT_TRUE(_SDSDLL random_fill(_First.data(), _First.size()));
+            EXPECT_TRUE(_SDSDLL random_fill(_Second.data(), _Second.size()));
+            EXPECT_NE(_First, _Second);
+            for (size_t _Off = 0; _Off < _Size; _Off += _Chunk) {
+                EXPECT_FALSE(_Is_zero_random_range(_First.data() + _Off, 64));
+            }
+
+            EXPECT_FALSE(_Is_zero_random_range(_First.data() + _Size - 64, 64));
+        }
+
+        EXPECT_TRUE(_SDSDLL random_fill(nullptr, 0));
+        EXPECT_FALSE(_SDSDLL random_fill(nullptr, 1));
+    }
+
+    TEST(cryptography_random, random_bytes) {
+        const byte_string& _Bytes = _SDSDLL random_bytes(1000, random_format::number);
+        EXPECT_EQ(_Bytes.size(), 1000);
+        for (const uint8_t _Byte : _Bytes) {
+            EXPECT_TRUE(_Byte >= '0' && _Byte <= '9');
+        }
+
+        EXPECT_EQ(_SDSDLL random_string(1000, random_format::general).size(), 1000);
+    }
+
+    TEST(cryptography_random, make_random_containers) {
+        // Note: An empty container means that no random bytes could be generated.
+        const salt<16>& _Salt = _SDSDLL make_salt<16>();
+        EXPECT_FALSE(_Salt.empty());
+        EXPECT_TRUE(_Salt != _SDSDLL make_salt<16>());
+        const iv<12>& _Iv = _SDSDLL make_iv<12>();
+        EXPECT_FALSE(_Iv.empty());
+        EXPECT_TRUE(_Iv != _SDSDLL make_iv<12>());
+        const symmetric_key<32>& _Key = _SDSDLL make_symmetric_key<32>();
+        EXPECT_FALSE(_Key.empty());
+        EXPECT_TRUE(_Key != _SDSDLL make_symmetric_key<32>());
+    }
+} // namespace tests
+
+#endif // _UNIT_CRYPTOGRAPHY_RANDOM_RANDOM_HPP_
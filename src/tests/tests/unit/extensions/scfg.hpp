@@ -0,0 +1,487 @@
+// scfg.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _UNIT_EXTENSIONS_SCFG_HPP_
+#define _UNIT_EXTENSIONS_SCFG_HPP_
+#include <algorithm>
+#include <atomic>
+#include <core/defs.hpp>
+#include <core/traits/integer.hpp>
+#include <core/traits/string_traits.hpp>
+#include <cryptography/cipher/symmetric/aes_key.hpp>
+#include <cryptography/cipher/symmetric/iv.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <extensions/scfg.hpp>
+#include <filesystem/file.hpp>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <unit/common.hpp>
+#include <vector>
+
+// SDSDLL types
+using _SDSDLL aes_key;
+using _SDSDLL byte_string;
+using _SDSDLL file;
+using _SDSDLL iv;
+using _SDSDLL scfg_file;
+
+namespace tests {
+    // FUNCTION _Make_scfg_test_file
+    inline void _Make_scfg_test_file(
+        const wchar_t* const _Target, const aes_key<32>& _Key, const iv<12>& _Iv, const size_t _Count) {
+        EXPECT_TRUE(scfg_file::make_storage(_Target));
+        scfg_file _File(_Target, _Key, _Iv);
+        EXPECT_TRUE(_File.ok());
+        for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+            const _STD wstring& _Id = L"entry-" + _STD to_wstring(_Idx);
+            EXPECT_TRUE(_File.append_entry(_Id, L"value of " + _Id));
+        }
+
+        EXPECT_TRUE(_File.flush());
+    }
+
+    // FUNCTION _Make_scfg_shared_iv_file
+    inline void _Make_scfg_shared_iv_file(
+        const wchar_t* const _Target, const aes_key<32>& _Key, const iv<12>& _Iv, const size_t _Count) {
+        // Note: The first revision stores the 2-byte length and the hashed ID before each value,
+        //       all values are encrypted with the same IV.
+        static constexpr uint8_t _Signature[] = {0x4D, 0x4A, 0x00, 0x00, 0x00, 0x5D, 0x5C, 0xF6};
+        const auto& _Count_bytes              = _SDSDLL unpack_integer(static_cast<uint32_t>(_Count));
+        byte_string _Entries(_Count_bytes.data(), _Count_bytes.size());
+        for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+            const _STD wstring& _Id    = L"entry-" + _STD to_wstring(_Idx);
+            const byte_string& _Cipher = _SDSDLL encrypt_aes256_gcm(L"value of " + _Id, _Key, _Iv);
+            const byte_string& _Hash   = _SDSDLL xxhash(_Id.c_str(), _Id.size());
+            const auto& _Len_bytes     = _SDSDLL unpack_integer(static_cast<uint16_t>(_Cipher.size()));
+            _Entries.append(_Len_bytes.data(), _Len_bytes.size());
+            _Entries.append(_Hash.c_str(), 8);
+            _Entries.append(_Cipher);
+        }
+
+        byte_string _Bytes(_Signature, sizeof(_Signature));
+        _Bytes.append(_SDSDLL blake3(reinterpret_cast<const char*>(_Entries.c_str()), _Entries.size()));
+        _Bytes.append(_Entries);
+        EXPECT_TRUE(scfg_file::make_storage(_Target)); // overwritten with the old revision
+        file _File(_Target);
+        EXPECT_TRUE(_File.write(_Bytes));
+    }
+
+    // FUNCTION _Reseal_scfg_test_file
+    inline void _Reseal_scfg_test_file(const wchar_t* const _Target) {
+        // Note: Recomputes the checksum, so that a damaged value is detected by its own tag.
+        file _File(_Target);
+        const size_t _Size = static_cast<size_t>(_SDSDLL file_size(_Target));
+        byte_string _Bytes(_Size - 40, 0);
+        EXPECT_TRUE(_File.seek(40) && _File.read(_Bytes, _Bytes.size()));
+        const byte_string& _Checksum =
+            _SDSDLL blake3(reinterpret_cast<const char*>(_Bytes.c_str()), _Bytes.size());
+        EXPECT_TRUE(_File.seek(8) && _File.write(_Checksum));
+    }
+
+    // STRUCT _Scfg_test_entry
+    struct _Scfg_test_entry {
+        uint32_t _Generation; // generation whose nonce was used to encrypt the value
+        size_t _Off; // offset of the encrypted value in the file
+        byte_string _Cipher; // encrypted value
+    };
+
+    // FUNCTION _Read_scfg_test_entries
+    inline _STD vector<_Scfg_test_entry> _Read_scfg_test_entries(
+        const wchar_t* const _Target, uint32_t& _Generation) {
+        // Note: The 44-byte header is followed by the 4-byte generation of the last flush. Each entry
+        //       stores the 8-byte hashed ID, the varint generation, the varint length and the cipher.
+        const byte_string& _Bytes = _Read_test_file(_Target);
+        EXPECT_GE(_Bytes.size(), size_t{48});
+        _Generation = _SDSDLL pack_integer<uint32_t>({_Bytes[44], _Bytes[45], _Bytes[46], _Bytes[47]});
+        _STD vector<_Scfg_test_entry> _Result;
+        size_t _Off = 48;
+        while (_Off < _Bytes.size()) {
+            _Scfg_test_entry _Entry;
+            uint32_t _Count = 0;
+            _Off += 8; // skip the hashed ID
+            _Off += _SDSDLL decode_varint(_Bytes.c_str() + _Off, _Bytes.size() - _Off, _Entry._Generation);
+            _Off += _SDSDLL decode_varint(_Bytes.c_str() + _Off, _Bytes.size() - _Off, _Count);
+            _Entry._Off = _Off;
+            _Entry._Cipher.assign(_Bytes.c_str() + _Off, _Count);
+            _Result.push_back(_STD move(_Entry));
+            _Off += _Count;
+        }
+
+        return _Result;
+    }
+
+    // FUNCTION _Encrypt_scfg_test_value
+    inline byte_string _Encrypt_scfg_test_value(const _STD wstring& _Value, const aes_key<32>& _Key,
+        const iv<12>& _Iv, const uint32_t _Idx, const uint32_t _Generation,
+        _STD vector<byte_string>& _Nonces) {
+        // Note: Encrypts the value serially, one chunk after another, and records the nonce of each
+        //       chunk. The value must not contain surrogate pairs.
+        static constexpr size_t _Chunk_size = _SDSDLL _Scfg_chunk_size;
+        byte_string _Result;
+        size_t _Off     = 0;
+        uint32_t _Chunk = 0;
+        uint8_t _Len[_SDSDLL max_varint_size<uint32_t>];
+        do {
+            const size_t _Count      = (_STD min)(_Chunk_size, _Value.size() - _Off);
+            const iv<12>& _Nonce     = _SDSDLL _Make_scfg_nonce(
+                _Iv, _Idx, _Chunk++, _Off + _Count == _Value.size(), _Generation);
+            const byte_string& _Part = _SDSDLL encrypt_aes256_gcm(_Value.substr(_Off, _Count), _Key, _Nonce);
+            _Result.append(_Len, _SDSDLL encode_varint(static_cast<uint32_t>(_Part.size()), _Len));
+            _Result.append(_Part);
+            _Nonces.emplace_back(_Nonce.get(), 12);
+            _Off += _Count;
+        } while (_Off < _Value.size());
+
+        return _Result;
+    }
+
+    TEST(extensions, scfg_nonce_generation) {
+        // Note: Each flush encrypts the changed values with a new generation, the nonce of the value
+        //       depends on it. A value restored to its previous content must not get the previous
+        //       cipher back, otherwise the nonce would have been reused.
+        static constexpr wchar_t _Target[] = L"unit_scfg_nonce_generation.scfg";
+        const aes_key<32> _Key             = _SDSDLL make_symmetric_key<32>();
+        const iv<12> _Iv                   = _SDSDLL make_iv<12>();
+        _Make_scfg_test_file(_Target, _Key, _Iv, 2);
+        uint32_t _Generation                              = 0;
+        const _STD vector<_Scfg_test_entry>& _First_flush = _Read_scfg_test_entries(_Target, _Generation);
+        EXPECT_EQ(_Generation, 1);
+        EXPECT_EQ(_First_flush.size(), 2);
+        for (const _Scfg_test_entry& _Entry : _First_flush) {
+            EXPECT_EQ(_Entry._Generation, 1);
+        }
+
+        { // change the value, the other value keeps its cipher
+            scfg_file _File(_Target, _Key, _Iv);
+            EXPECT_TRUE(_File.modify_entry(L"entry-0", L"changed value"));
+            EXPECT_TRUE(_File.flush());
+        }
+
+        const _STD vector<_Scfg_test_entry>& _Second_flush = _Read_scfg_test_entries(_Target, _Generation);
+        EXPECT_EQ(_Generation, 2);
+        EXPECT_EQ(_Second_flush[0]._Generation, 2);
+        EXPECT_EQ(_Second_flush[1]._Generation, 1);
+        EXPECT_EQ(_Second_flush[1]._Cipher, _First_flush[1]._Cipher);
+        { // restore the value, it must be encrypted with a new nonce
+            scfg_file _File(_Target, _Key, _Iv);
+            EXPECT_EQ(_File.query_entry(L"entry-0"), L"changed value");
+            EXPECT_TRUE(_File.modify_entry(L"entry-0", L"value of entry-0"));
+            EXPECT_TRUE(_File.flush());
+        }
+
+        const _STD vector<_Scfg_test_entry>& _Third_flush = _Read_scfg_test_entries(_Target, _Generation);
+        EXPECT_EQ(_Generation, 3);
+        EXPECT_EQ(_Third_flush[0]._Generation, 3);
+        EXPECT_NE(_Third_flush[0]._Cipher, _First_flush[0]._Cipher);
+        { // both values must be decrypted with their own generations
+            scfg_file _File(_Target, _Key, _Iv);
+            EXPECT_EQ(_File.query_entry(L"entry-0"), L"value of entry-0");
+            EXPECT_EQ(_File.query_entry(L"entry-1"), L"value of entry-1");
+        }
+
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+    }
+
+    TEST(extensions, scfg_parallel_flush) {
+        // Note: The values are encrypted in parallel, but the file must be byte-identical to the one
+        //       whose values are encrypted serially. Every chunk encrypted by both flushes must get
+        //       a distinct nonce. Every 8th value spans several chunks.
+        static constexpr wchar_t _Target[] = L"unit_scfg_parallel_flush.scfg";
+        static constexpr size_t _Chunk     = _SDSDLL _Scfg_chunk_size;
+        static constexpr size_t _Count     = 64;
+        const aes_key<32> _Key             = _SDSDLL make_symmetric_key<32>();
+        const iv<12> _Iv                   = _SDSDLL make_iv<12>();
+        _STD vector<_STD wstring> _Values;
+        for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+            const wchar_t _Ch = static_cast<wchar_t>(L'a' + _Idx % 26);
+            _Values.push_back(_Idx % 8 == 0 ? _STD wstring(_Chunk * 2 + _Idx, _Ch)
+                : L"value of entry-" + _STD to_wstring(_Idx));
+        }
+
+        _STD vector<byte_string> _Nonces;
+        auto _Expect_serial_ciphers = [&](const uint32_t _Expected_generation) {
+            uint32_t _Generation                          = 0;
+            const _STD vector<_Scfg_test_entry>& _Entries = _Read_scfg_test_entries(_Target, _Generation);
+            EXPECT_EQ(_Generation, _Expected_generation);
+            EXPECT_EQ(_Entries.size(), _Count);
+            for (size_t _Idx = 0; _Idx < _Entries.size() && _Idx < _Count; ++_Idx) {
+                _STD vector<byte_string> _Entry_nonces;
+                const byte_string& _Cipher = _Encrypt_scfg_test_value(_Values[_Idx], _Key, _Iv,
+                    static_cast<uint32_t>(_Idx), _Entries[_Idx]._Generation, _Entry_nonces);
+                EXPECT_EQ(_Entries[_Idx]._Cipher, _Cipher);
+                if (_Entries[_Idx]._Generation == _Generation) { // encrypted by this flush
+                    _Nonces.insert(_Nonces.end(), _Entry_nonces.begin(), _Entry_nonces.end());
+                }
+            }
+        };
+
+        EXPECT_TRUE(scfg_file::make_storage(_Target));
+        {
+            scfg_file _File(_Target, _Key, _Iv);
+            for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+                EXPECT_TRUE(_File.append_entry(L"entry-" + _STD to_wstring(_Idx), _Values[_Idx]));
+            }
+
+            EXPECT_TRUE(_File.flush());
+        }
+
+        _Expect_serial_ciphers(1);
+        { // every third value is encrypted again by the second flush
+            scfg_file _File(_Target, _Key, _Iv);
+            for (size_t _Idx = 0; _Idx < _Count; _Idx += 3) {
+                _Values[_Idx] += L" (modified)";
+                EXPECT_TRUE(_File.modify_entry(L"entry-" + _STD to_wstring(_Idx), _Values[_Idx]));
+            }
+
+            EXPECT_TRUE(_File.flush());
+        }
+
+        _Expect_serial_ciphers(2);
+        const size_t _Used = _Nonces.size();
+        _STD sort(_Nonces.begin(), _Nonces.end());
+        EXPECT_EQ(_STD unique(_Nonces.begin(), _Nonces.end()) - _Nonces.begin(), _Used);
+        EXPECT_GT(_Used, _Count); // the long values use more than one nonce
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+    }
+
+    TEST(extensions, scfg_upgrade_from_shared_iv) {
+        static constexpr wchar_t _Target[] = L"unit_scfg_upgrade_from_shared_iv.scfg";
+        const aes_key<32> _Key             = _SDSDLL make_symmetric_key<32>();
+        const iv<12> _Iv                   = _SDSDLL make_iv<12>();
+        _Make_scfg_shared_iv_file(_Target, _Key, _Iv, 3);
+        { // the old values must be readable, the flush encrypts all of them again
+            scfg_file _File(_Target, _Key, _Iv);
+            EXPECT_TRUE(_File.ok());
+            EXPECT_EQ(_File.query_entry(L"entry-0"), L"value of entry-0");
+            EXPECT_TRUE(_File.modify_entry(L"entry-1", L"new value of entry-1"));
+            EXPECT_TRUE(_File.flush());
+        }
+
+        uint32_t _Generation                          = 0;
+        const _STD vector<_Scfg_test_entry>& _Entries = _Read_scfg_test_entries(_Target, _Generation);
+        EXPECT_EQ(_Generation, 1);
+        EXPECT_EQ(_Entries.size(), 3);
+        for (const _Scfg_test_entry& _Entry : _Entries) {
+            EXPECT_EQ(_Entry._Generation, 1);
+        }
+
+        { // the upgraded file must keep all values
+            scfg_file _File(_Target, _Key, _Iv);
+            EXPECT_TRUE(_File.ok());
+            EXPECT_EQ(_File.query_entry(L"entry-0"), L"value of entry-0");
+            EXPECT_EQ(_File.query_entry(L"entry-1"), L"new value of entry-1");
+            EXPECT_EQ(_File.query_entry(L"entry-2"), L"value of entry-2");
+        }
+
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+    }
+
+    TEST(extensions, scfg_chunked_values) {
+        // Note: A value of more than _Scfg_chunk_size characters spans several chunks, the third value
+        //       has a surrogate pair at the end of the first chunk.
+        static constexpr wchar_t _Target[] = L"unit_scfg_chunked_values.scfg";
+        static constexpr size_t _Chunk     = _SDSDLL _Scfg_chunk_size;
+        const aes_key<32> _Key             = _SDSDLL make_symmetric_key<32>();
+        const iv<12> _Iv                   = _SDSDLL make_iv<12>();
+        _STD wstring _Values[]             = {_STD wstring(_Chunk, L'a'), _STD wstring(_Chunk + 1, L'b'),
+            _STD wstring(_Chunk * 2 + 1, L'c'), _STD wstring(_Chunk * 5 + 7, L'd')};
+        _Values[2][_Chunk - 1] = static_cast<wchar_t>(0xD83D);
+        _Values[2][_Chunk]     = static_cast<wchar_t>(0xDE00);
+        EXPECT_TRUE(scfg_file::make_storage(_Target));
+        {
+            scfg_file _File(_Target, _Key, _Iv);
+            for (size_t _Idx = 0; _Idx < _STD size(_Values); ++_Idx) {
+                EXPECT_TRUE(_File.append_entry(L"entry-" + _STD to_wstring(_Idx), _Values[_Idx]));
+            }
+
+            EXPECT_TRUE(_File.flush());
+        }
+
+        uint32_t _Generation                          = 0;
+        const _STD vector<_Scfg_test_entry>& _Entries = _Read_scfg_test_entries(_Target, _Generation);
+        EXPECT_EQ(_Entries.size(), 4);
+        EXPECT_GT(_Entries[3]._Cipher.size(), size_t{0xFFFF}); // too long for the first revision
+        { // each value must be joined from its chunks
+            scfg_file _File(_Target, _Key, _Iv);
+            EXPECT_TRUE(_File.ok());
+            for (size_t _Idx = 0; _Idx < _STD size(_Values); ++_Idx) {
+                EXPECT_EQ(_File.query_entry(L"entry-" + _STD to_wstring(_Idx)), _Values[_Idx]);
+            }
+        }
+
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+    }
+
+    TEST(extensions, scfg_tampered_chunk) {
+        // Note: The checksum is recomputed after each change, so the chunk must be rejected
+        //       by its own authentication tag and nonce.
+        static constexpr wchar_t _Target[] = L"unit_scfg_tampered_chunk.scfg";
+        static constexpr size_t _Chunk     = _SDSDLL _Scfg_chunk_size;
+        const aes_key<32> _Key             = _SDSDLL make_symmetric_key<32>();
+        const iv<12> _Iv                   = _SDSDLL make_iv<12>();
+        const _STD wstring _Value(_Chunk * 3, L'x');
+        auto _Make_file = [&] {
+            _Make_scfg_test_file(_Target, _Key, _Iv, 2);
+            scfg_file _File(_Target, _Key, _Iv);
+            EXPECT_TRUE(_File.append_entry(L"long", _Value));
+            EXPECT_TRUE(_File.flush());
+        };
+
+        auto _Expect_rejected = [&] {
+            scfg_file _File(_Target, _Key, _Iv);
+            EXPECT_TRUE(_File.ok());
+            EXPECT_TRUE(_File.query_entry(L"long").empty());
+            EXPECT_EQ(_File.query_entry(L"entry-1"), L"value of entry-1");
+        };
+
+        { // damaged middle chunk
+            _Make_file();
+            uint32_t _Generation                          = 0;
+            const _STD vector<_Scfg_test_entry>& _Entries = _Read_scfg_test_entries(_Target, _Generation);
+            const _Scfg_test_entry& _Entry                = _Entries[2];
+            _Damage_test_file(_Target, _Entry._Off + _Entry._Cipher.size() / 2);
+        }
+
+        _Reseal_scfg_test_file(_Target);
+        _Expect_rejected();
+        { // swapped chunks of the same length (each chunk is prefixed with its length)
+            _Make_file();
+            uint32_t _Generation                          = 0;
+            const _STD vector<_Scfg_test_entry>& _Entries = _Read_scfg_test_entries(_Target, _Generation);
+            const _Scfg_test_entry& _Entry                = _Entries[2];
+            const size_t _Size                            = _Entry._Cipher.size() / 3;
+            file _File(_Target);
+            EXPECT_TRUE(_File.seek(_Entry._Off) && _File.write(_Entry._Cipher.substr(_Size, _Size)));
+            EXPECT_TRUE(_File.write(_Entry._Cipher.substr(0, _Size)));
+        }
+
+        _Reseal_scfg_test_file(_Target);
+        _Expect_rejected();
+        { // first chunk longer than any chunk written by the library, but shorter than the value
+            _Make_file();
+            uint32_t _Generation                          = 0;
+            const _STD vector<_Scfg_test_entry>& _Entries = _Read_scfg_test_entries(_Target, _Generation);
+            uint8_t _Len[_SDSDLL max_varint_size<uint32_t>];
+            const size_t _Len_size = _SDSDLL encode_varint(
+                static_cast<uint32_t>(_SDSDLL _Scfg_max_chunk_cipher + 1), _Len);
+            file _File(_Target);
+            EXPECT_TRUE(_File.seek(_Entries[2]._Off) && _File.write(_Len, _Len_size));
+        }
+
+        _Reseal_scfg_test_file(_Target);
+        _Expect_rejected();
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+    }
+
+    TEST(extensions, scfg_set_key) {
+        // Note: A new key and IV encrypt all values again. If a stored value cannot be decrypted,
+        //       the old key and IV are kept and the file stays usable with them.
+        static constexpr wchar_t _Target[] = L"unit_scfg_set_key.scfg";
+        const aes_key<32> _Key             = _SDSDLL make_symmetric_key<32>();
+        const iv<12> _Iv                   = _SDSDLL make_iv<12>();
+        const aes_key<32> _New_key         = _SDSDLL make_symmetric_key<32>();
+        const iv<12> _New_iv               = _SDSDLL make_iv<12>();
+        _Make_scfg_test_file(_Target, _Key, _Iv, 3);
+        {
+            scfg_file _File(_Target, _Key, _Iv);
+            EXPECT_TRUE(_File.set_key(_New_key));
+            EXPECT_TRUE(_File.set_iv(_New_iv));
+            EXPECT_TRUE(_File.flush());
+        }
+
+        {
+            scfg_file _File(_Target, _New_key, _New_iv);
+            EXPECT_TRUE(_File.ok());
+            EXPECT_EQ(_File.query_entry(L"entry-2"), L"value of entry-2");
+        }
+
+        { // damaged value, the other values are not decrypted before set_key()
+            uint32_t _Generation                          = 0;
+            const _STD vector<_Scfg_test_entry>& _Entries = _Read_scfg_test_entries(_Target, _Generation);
+            _Damage_test_file(_Target, _Entries[1]._Off + _Entries[1]._Cipher.size() / 2);
+        }
+
+        _Reseal_scfg_test_file(_Target);
+        {
+            scfg_file _File(_Target, _New_key, _New_iv);
+            EXPECT_TRUE(_File.ok());
+            EXPECT_FALSE(_File.set_key(_Key));
+            EXPECT_FALSE(_File.set_iv(_Iv));
+            EXPECT_TRUE(_File.ok());
+            EXPECT_EQ(_File.query_entry(L"entry-0"), L"value of entry-0");
+            EXPECT_EQ(_File.query_entry(L"entry-2"), L"value of entry-2");
+            EXPECT_TRUE(_File.query_entry(L"entry-1").empty());
+            EXPECT_TRUE(_File.flush()); // nothing has changed
+        }
+
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+    }
+
+    TEST(extensions, scfg_concurrent_queries) {
+        // Note: The cache holds a single value, so the readers keep decrypting and evicting values
+        //       while the writer switches the odd entries between two values.
+        static constexpr wchar_t _Target[] = L"unit_scfg_concurrent_queries.scfg";
+        static constexpr size_t _Count     = 64;
+        static constexpr size_t _Readers   = 4;
+        static constexpr size_t _Rounds    = 100;
+        const aes_key<32> _Key             = _SDSDLL make_symmetric_key<32>();
+        const iv<12> _Iv                   = _SDSDLL make_iv<12>();
+        _Make_scfg_test_file(_Target, _Key, _Iv, _Count);
+        {
+            scfg_file _File(_Target, _Key, _Iv);
+            EXPECT_TRUE(_File.ok());
+            _File.set_cache_limit(1);
+            _STD atomic<size_t> _Mismatches(0);
+            _STD atomic<size_t> _Started(0);
+            _STD vector<_STD thread> _Workers;
+            for (size_t _Reader = 0; _Reader < _Readers; ++_Reader) {
+                _Workers.emplace_back([&] {
+                    _Started.fetch_add(1);
+                    for (size_t _Round = 0; _Round < _Rounds; ++_Round) {
+                        for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+                            const _STD wstring& _Id    = L"entry-" + _STD to_wstring(_Idx);
+                            const _STD wstring& _Value = _File.query_entry(_Id);
+                            if (_Value != L"value of " + _Id && _Value != L"new value of " + _Id) {
+                                _Mismatches.fetch_add(1);
+                            }
+                        }
+                    }
+                });
+            }
+
+            while (_Started.load() < _Readers) { // make sure that the writer runs with the readers
+                _STD this_thread::yield();
+            }
+
+            for (size_t _Round = 0; _Round < _Rounds; ++_Round) {
+                for (size_t _Idx = 1; _Idx < _Count; _Idx += 2) {
+                    const _STD wstring& _Id      = L"entry-" + _STD to_wstring(_Idx);
+                    const wchar_t* const _Prefix = _Round % 2 == 0 ? L"new value of " : L"value of ";
+                    EXPECT_TRUE(_File.modify_entry(_Id, _Prefix + _Id));
+                }
+            }
+
+            for (_STD thread& _Worker : _Workers) {
+                _Worker.join();
+            }
+
+            EXPECT_EQ(_Mismatches.load(), size_t{0});
+            EXPECT_TRUE(_File.flush());
+        }
+
+        { // the last values must have been saved
+            scfg_file _File(_Target, _Key, _Iv);
+            EXPECT_EQ(_File.query_entry(L"entry-1"), L"value of entry-1");
+            EXPECT_EQ(_File.query_entry(L"entry-2"), L"value of entry-2");
+        }
+
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+    }
+} // namespace tests
+
+#endif // _UNIT_EXTENSIONS_SCFG_HPP_
@@ -0,0 +1,541 @@
+// sudb.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _UNIT_EXTENSIONS_SUDB_HPP_
+#define _UNIT_EXTENSIONS_SUDB_HPP_
+#include <atomic>
+#include <core/defs.hpp>
+#include <cryptography/hash/generic.hpp>
+#include <cryptography/hash/generic/blake3.hpp>
+#include <cryptography/hash/password/calibration.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <extensions/sudb.hpp>
+#include <filesystem/file.hpp>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <unit/common.hpp>
+#include <vector>
+
+// SDSDLL types
+using _SDSDLL argon2_params;
+using _SDSDLL blake3_traits;
+using _SDSDLL sudb_credentials;
+using _SDSDLL sudb_file;
+using _SDSDLL sudb_view;
+
+namespace tests {
+    // CONSTANT _Sudb_test_params
+    inline constexpr argon2_params _Sudb_test_params = {64, 1, 1}; // cheap parameters, tests only
+
+    // CONSTANT _Sudb_test_record_size
+    inline constexpr size_t _Sudb_test_record_size = 204; // journal record of the latest revision
+
+    // FUNCTION _Load_sudb_test_integer
+    inline uint32_t _Load_sudb_test_integer(const _Test_bytes& _Bytes, const size_t _Off) noexcept {
+        return static_cast<uint32_t>(_Bytes[_Off]) | static_cast<uint32_t>(_Bytes[_Off + 1]) << 8
+            | static_cast<uint32_t>(_Bytes[_Off + 2]) << 16 | static_cast<uint32_t>(_Bytes[_Off + 3]) << 24;
+    }
+
+    // FUNCTION _Load_sudb_test_params
+    inline argon2_params _Load_sudb_test_params(const _Test_bytes& _Bytes, const size_t _Off) noexcept {
+        // Note: The parameters follow the 152 bytes of the entry that the first revision stores.
+        return argon2_params{_Load_sudb_test_integer(_Bytes, _Off + 152),
+            _Load_sudb_test_integer(_Bytes, _Off + 156), _Load_sudb_test_integer(_Bytes, _Off + 160)};
+    }
+
+    // FUNCTION _Downgrade_sudb_file
+    inline void _Downgrade_sudb_file(const wchar_t* const _Target) {
+        // Note: Rewrites the file in the first revision: the entries and the journal records lose
+        //       their parameters, the checksums are computed again. All entries must have been hashed
+        //       with the default engine, which is what the first revision assumes.
+        const _Test_bytes& _Bytes = _Read_test_file(_Target);
+        const uint32_t _Count     = _Load_sudb_test_integer(_Bytes, 40);
+        const size_t _Journal     = 44 + static_cast<size_t>(_Count) * 164;
+        EXPECT_EQ(_Bytes[4], 1);
+        EXPECT_EQ((_Bytes.size() - _Journal) % _Sudb_test_record_size, 0);
+        _Test_bytes _Entries = _Bytes.substr(40, 4);
+        for (size_t _Off = 44; _Off < _Journal; _Off += 164) {
+            EXPECT_TRUE(_Load_sudb_test_params(_Bytes, _Off) == (argon2_params{0, 0, 0}));
+            _Entries += _Bytes.substr(_Off, 152);
+        }
+
+        _Test_bytes _Result = _Bytes.substr(0, 8);
+        _Result[4]          = 0; // the first byte of the magic value is the revision
+        _Result += _SDSDLL hash<blake3_traits<uint8_t>>(_Entries.c_str(), _Entries.size());
+        _Result += _Entries;
+        for (size_t _Off = _Journal; _Off < _Bytes.size(); _Off += _Sudb_test_record_size) {
+            const _Test_bytes& _Record = _Bytes.substr(_Off, 160);
+            _Result += _Record;
+            _Result += _SDSDLL hash<blake3_traits<uint8_t>>(_Record.c_str(), _Record.size());
+        }
+
+        _Write_test_file(_Target, _Result);
+    }
+
+    // FUNCTION _Make_sudb_test_file
+    inline void _Make_sudb_test_file(const wchar_t* const _Target, const size_t _Count) {
+        // Note: Each entry is appended as a separate journal record, the file is never compacted here.
+        EXPECT_TRUE(sudb_file::make_storage(_Target));
+        sudb_file _File(_Target);
+        EXPECT_TRUE(_File.ok());
+        EXPECT_TRUE(_File.password_params(_Sudb_test_params));
+        for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+            const _STD wstring& _Suffix = _STD to_wstring(_Idx);
+            EXPECT_TRUE(_File.append_entry(L"account-" + _Suffix, L"password-" + _Suffix));
+        }
+
+        EXPECT_TRUE(_File.flush());
+    }
+
+    TEST(extensions, sudb_journal_replay) {
+        static constexpr wchar_t _Target[] = L"unit_sudb_journal_replay.sudb";
+        _Make_sudb_test_file(_Target, 3);
+        EXPECT_EQ(_SDSDLL file_size(_Target), 44 + 3 * _Sudb_test_record_size);
+        { // modify the replayed entries, the changes are appended to the journal
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.ok());
+            EXPECT_TRUE(_File.has_entry(L"account-0"));
+            EXPECT_TRUE(_File.has_entry(L"account-1"));
+            EXPECT_TRUE(_File.compare_passwords(L"account-2", L"password-2"));
+            _File.erase_entry(L"account-1");
+            EXPECT_TRUE(_File.modify_entry_account_name(L"account-2", L"account-3"));
+            EXPECT_TRUE(_File.modify_entry_password(L"account-0", L"new-password"));
+            EXPECT_TRUE(_File.flush());
+        }
+
+        EXPECT_EQ(_SDSDLL file_size(_Target), 44 + 6 * _Sudb_test_record_size);
+        { // all records must be replayed in order
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.ok());
+            EXPECT_FALSE(_File.has_entry(L"account-1"));
+            EXPECT_FALSE(_File.has_entry(L"account-2"));
+            EXPECT_TRUE(_File.compare_passwords(L"account-3", L"password-2"));
+            EXPECT_TRUE(_File.compare_passwords(L"account-0", L"new-password"));
+            EXPECT_FALSE(_File.compare_passwords(L"account-0", L"password-0"));
+            _File.refresh();
+            EXPECT_TRUE(_File.ok());
+            EXPECT_TRUE(_File.has_entry(L"account-3"));
+        }
+
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+    }
+
+    TEST(extensions, sudb_journal_damaged) {
+        static constexpr wchar_t _Target[] = L"unit_sudb_journal_damaged.sudb";
+        static constexpr uintmax_t _Size   = 44 + 3 * _Sudb_test_record_size;
+        { // incomplete last record, the previous records are kept
+            _Make_sudb_test_file(_Target, 3);
+            EXPECT_TRUE(_SDSDLL resize_file(_Target, _Size - 10));
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.ok());
+            EXPECT_TRUE(_File.has_entry(L"account-1"));
+            EXPECT_FALSE(_File.has_entry(L"account-2"));
+            EXPECT_TRUE(_File.append_entry(L"account-4", L"password-4")); // overwrites the incomplete record
+            EXPECT_TRUE(_File.flush());
+        }
+
+        { // the incomplete record must have been overwritten
+            EXPECT_EQ(_SDSDLL file_size(_Target), _Size);
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.ok());
+            EXPECT_TRUE(_File.has_entry(L"account-4"));
+        }
+
+        { // damaged last record, the previous records are kept
+            _Make_sudb_test_file(_Target, 3);
+            _Damage_test_file(_Target, _Size - 40);
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.ok());
+            EXPECT_TRUE(_File.has_entry(L"account-1"));
+            EXPECT_FALSE(_File.has_entry(L"account-2"));
+        }
+
+        { // damaged record followed by valid ones, the file must be rejected and kept intact
+            _Make_sudb_test_file(_Target, 3);
+            _Damage_test_file(_Target, 44 + _Sudb_test_record_size + 20);
+            sudb_file _File(_Target);
+            EXPECT_FALSE(_File.ok());
+            EXPECT_FALSE(_File.has_entry(L"account-0"));
+            EXPECT_FALSE(_File.append_entry(L"account-4", L"password-4"));
+            EXPECT_FALSE(_File.flush());
+        }
+
+        EXPECT_EQ(_SDSDLL file_size(_Target), _Size);
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+    }
+
+    TEST(extensions, sudb_compaction) {
+        static constexpr wchar_t _Target[] = L"unit_sudb_compaction.sudb";
+        _Make_sudb_test_file(_Target, 2);
+        { // the journal becomes larger than the entries, so it is folded into them
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.ok());
+            for (size_t _Idx = 0; _Idx < 1100; ++_Idx) {
+                EXPECT_TRUE(_File.modify_entry_arc(_Idx % 2 == 0 ? L"account-0" : L"account-1"));
+            }
+
+            EXPECT_TRUE(_File.flush());
+        }
+
+        EXPECT_EQ(_SDSDLL file_size(_Target), 44 + 2 * 164);
+        { // the compacted entries must load without a journal and accept new records
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.ok());
+            EXPECT_TRUE(_File.compare_passwords(L"account-0", L"password-0"));
+            EXPECT_TRUE(_File.compare_passwords(L"account-1", L"password-1"));
+            _File.erase_entry(L"account-0");
+            EXPECT_TRUE(_File.flush());
+        }
+
+        EXPECT_EQ(_SDSDLL file_size(_Target), 44 + 2 * 164 + _Sudb_test_record_size);
+        { // erasing all entries always rewrites the file
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.ok());
+            EXPECT_FALSE(_File.has_entry(L"account-0"));
+            EXPECT_TRUE(_File.has_entry(L"account-1"));
+            _File.erase_all_entries();
+            EXPECT_TRUE(_File.flush());
+        }
+
+        EXPECT_EQ(_SDSDLL file_size(_Target), 44);
+        { // the file must be empty, but valid
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.ok());
+            EXPECT_FALSE(_File.has_entry(L"account-1"));
+        }
+
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+    }
+
+    TEST(extensions, sudb_view_lookups) {
+        static constexpr wchar_t _Target[] = L"unit_sudb_view_lookups.sudb";
+        _Make_sudb_test_file(_Target, 3);
+        { // the entries are served from the journal
+            sudb_view _View(_Target);
+            EXPECT_TRUE(_View.ok());
+            EXPECT_EQ(_View.size(), 3);
+            EXPECT_TRUE(_View.has_entry(L"account-0"));
+            EXPECT_TRUE(_View.compare_passwords(L"account-2", L"password-2"));
+            EXPECT_FALSE(_View.compare_passwords(L"account-2", L"password-1"));
+            EXPECT_FALSE(_View.has_entry(L"account-3"));
+        }
+
+        { // the view cannot be open while the file is modified
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.ok());
+            _File.erase_entry(L"account-0");
+            EXPECT_TRUE(_File.modify_entry_password(L"account-1", L"new-password"));
+            EXPECT_TRUE(_File.flush());
+        }
+
+        { // the replayed journal must match sudb_file
+            sudb_view _View(_Target);
+            EXPECT_EQ(_View.size(), 2);
+            EXPECT_FALSE(_View.has_entry(L"account-0"));
+            EXPECT_TRUE(_View.compare_passwords(L"account-1", L"new-password"));
+            EXPECT_TRUE(_View.compare_passwords(L"account-2", L"password-2"));
+            EXPECT_TRUE(_View.ok());
+        }
+
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+    }
+
+    TEST(extensions, sudb_view_damaged) {
+        static constexpr wchar_t _Target[] = L"unit_sudb_view_damaged.sudb";
+        static constexpr uintmax_t _Size   = 44 + 3 * _Sudb_test_record_size;
+        { // the view is opened before the entries are verified
+            _Make_sudb_test_file(_Target, 2);
+            { // compact the entries, so that they are covered by the checksum
+                sudb_file _File(_Target);
+                for (size_t _Idx = 0; _Idx < 1100; ++_Idx) {
+                    EXPECT_TRUE(_File.modify_entry_arc(L"account-0"));
+                }
+            }
+
+            _Damage_test_file(_Target, 44 + 164 + 20);
+            sudb_view _View(_Target);
+            EXPECT_FALSE(_View.has_entry(L"account-0"));
+            EXPECT_FALSE(_View.ok());
+            EXPECT_EQ(_View.size(), 0);
+        }
+
+        { // damaged last record, the previous records are kept
+            _Make_sudb_test_file(_Target, 3);
+            _Damage_test_file(_Target, _Size - 40);
+            sudb_view _View(_Target);
+            EXPECT_TRUE(_View.ok());
+            EXPECT_EQ(_View.size(), 2);
+            EXPECT_TRUE(_View.has_entry(L"account-1"));
+        }
+
+        { // damaged record followed by valid ones, the view must be rejected
+            _Make_sudb_test_file(_Target, 3);
+            _Damage_test_file(_Target, 44 + _Sudb_test_record_size + 20);
+            sudb_view _View(_Target);
+            EXPECT_FALSE(_View.ok());
+            EXPECT_FALSE(_View.has_entry(L"account-0"));
+        }
+
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+    }
+
+    TEST(extensions, sudb_entry_params) {
+        static constexpr wchar_t _Target[] = L"unit_sudb_entry_params.sudb";
+        _Make_sudb_test_file(_Target, 2);
+        { // each journal record stores the parameters of its entry
+            const _Test_bytes& _Bytes = _Read_test_file(_Target);
+            EXPECT_EQ(_Bytes.size(), 44 + 2 * _Sudb_test_record_size);
+            EXPECT_EQ(_Bytes[4], 1);
+            for (size_t _Idx = 0; _Idx < 2; ++_Idx) {
+                const size_t _Off = 44 + _Idx * _Sudb_test_record_size;
+                EXPECT_EQ(_Bytes[_Off], 1); // appended entry
+                EXPECT_EQ(_Load_sudb_test_integer(_Bytes, _Off + 4), _Idx);
+                EXPECT_TRUE(_Load_sudb_test_params(_Bytes, _Off + 8) == _Sudb_test_params);
+            }
+        }
+
+        { // fold the journal into the entries
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.ok());
+            for (size_t _Idx = 0; _Idx < 1100; ++_Idx) {
+                EXPECT_TRUE(_File.modify_entry_arc(L"account-1"));
+            }
+
+            EXPECT_TRUE(_File.flush());
+        }
+
+        { // each entry stores its parameters
+            const _Test_bytes& _Bytes = _Read_test_file(_Target);
+            EXPECT_EQ(_Bytes.size(), 44 + 2 * 164);
+            EXPECT_EQ(_Load_sudb_test_integer(_Bytes, 40), 2);
+            EXPECT_TRUE(_Load_sudb_test_params(_Bytes, 44) == _Sudb_test_params);
+            EXPECT_TRUE(_Load_sudb_test_params(_Bytes, 44 + 164) == _Sudb_test_params);
+        }
+
+        { // the stored parameters are used, even if no parameters are selected
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.ok());
+            EXPECT_TRUE(_File.password_params() == (argon2_params{0, 0, 0}));
+            EXPECT_TRUE(_File.compare_passwords(L"account-0", L"password-0"));
+            EXPECT_FALSE(_File.compare_passwords(L"account-1", L"password-0"));
+            sudb_view _View(_Target);
+            EXPECT_TRUE(_View.compare_passwords(L"account-1", L"password-1"));
+        }
+
+        EXPECT_EQ(_SDSDLL file_size(_Target), 44 + 2 * 164); // nothing to re-hash
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+    }
+
+    TEST(extensions, sudb_revision_upgrade) {
+        static constexpr wchar_t _Target[] = L"unit_sudb_revision_upgrade.sudb";
+        EXPECT_TRUE(sudb_file::make_storage(_Target));
+        { // two entries and a journal record, hashed with the default engine
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.append_entry(L"account-0", L"password-0"));
+            EXPECT_TRUE(_File.append_entry(L"account-1", L"password-1"));
+            for (size_t _Idx = 0; _Idx < 1100; ++_Idx) {
+                EXPECT_TRUE(_File.modify_entry_arc(L"account-0"));
+            }
+
+            EXPECT_TRUE(_File.flush());
+            EXPECT_TRUE(_File.append_entry(L"account-2", L"password-2"));
+            EXPECT_TRUE(_File.flush());
+        }
+
+        _Downgrade_sudb_file(_Target);
+        static constexpr uintmax_t _Old_size = 44 + 2 * 152 + 192;
+        EXPECT_EQ(_SDSDLL file_size(_Target), _Old_size);
+        { // the old revision is read as it is
+            sudb_view _View(_Target);
+            EXPECT_TRUE(_View.ok());
+            EXPECT_EQ(_View.size(), 3);
+            EXPECT_TRUE(_View.compare_passwords(L"account-2", L"password-2"));
+        }
+
+        { // the file is not rewritten without changes
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.ok());
+            EXPECT_TRUE(_File.compare_passwords(L"account-0", L"password-0"));
+            EXPECT_TRUE(_File.compare_passwords(L"account-2", L"password-2"));
+            EXPECT_TRUE(_File.flush());
+        }
+
+        EXPECT_EQ(_SDSDLL file_size(_Target), _Old_size);
+        { // the first change rewrites the file in the latest revision
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.ok());
+            _File.erase_entry(L"account-1");
+            EXPECT_TRUE(_File.flush());
+        }
+
+        {
+            const _Test_bytes& _Bytes = _Read_test_file(_Target);
+            EXPECT_EQ(_Bytes.size(), 44 + 2 * 164);
+            EXPECT_EQ(_Bytes[4], 1);
+            EXPECT_TRUE(_Load_sudb_test_params(_Bytes, 44) == (argon2_params{0, 0, 0}));
+            EXPECT_TRUE(_Load_sudb_test_params(_Bytes, 44 + 164) == (argon2_params{0, 0, 0}));
+        }
+
+        { // the upgraded entries keep their passwords, a verified password is re-hashed
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.ok());
+            EXPECT_FALSE(_File.has_entry(L"account-1"));
+            EXPECT_TRUE(_File.password_params(_Sudb_test_params));
+            EXPECT_TRUE(_File.compare_passwords(L"account-2", L"password-2"));
+            EXPECT_TRUE(_File.flush());
+        }
+
+        {
+            const _Test_bytes& _Bytes = _Read_test_file(_Target);
+            EXPECT_EQ(_Bytes.size(), 44 + 2 * 164 + _Sudb_test_record_size);
+            EXPECT_EQ(_Bytes[44 + 2 * 164], 2); // modified entry
+            EXPECT_TRUE(_Load_sudb_test_params(_Bytes, 44 + 2 * 164 + 8) == _Sudb_test_params);
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.compare_passwords(L"account-0", L"password-0"));
+            EXPECT_TRUE(_File.compare_passwords(L"account-2", L"password-2"));
+        }
+
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+    }
+
+    TEST(extensions, sudb_rehash_on_verify) {
+        // Note: The stored parameters are below the calibrated ones (which are never below 19 MiB),
+        //       so each successfully verified password is re-hashed and journaled once.
+        static constexpr wchar_t _Target[] = L"unit_sudb_rehash_on_verify.sudb";
+        static constexpr size_t _Size      = 44 + 2 * _Sudb_test_record_size;
+        argon2_params _Params              = {0, 0, 0};
+        EXPECT_TRUE(_SDSDLL calibrate_argon2id(_Params, 1));
+        EXPECT_TRUE(_Params.memory_amount > _Sudb_test_params.memory_amount);
+        _Make_sudb_test_file(_Target, 2);
+        {
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.ok());
+            EXPECT_TRUE(_File.password_params(_Params));
+            EXPECT_FALSE(_File.compare_passwords(L"account-0", L"password-1"));
+            EXPECT_TRUE(_File.flush());
+            EXPECT_EQ(_SDSDLL file_size(_Target), _Size); // a wrong password is never re-hashed
+            EXPECT_TRUE(_File.compare_passwords(L"account-0", L"password-0"));
+            EXPECT_TRUE(_File.compare_passwords(L"account-0", L"password-0"));
+            EXPECT_TRUE(_File.flush());
+            EXPECT_EQ(_SDSDLL file_size(_Target), _Size + _Sudb_test_record_size);
+            const sudb_credentials _Credentials[] = {
+                {L"account-1", L"password-1"}, {L"account-1", L"password-1"}, {L"account-0", L"password-0"}};
+            bool _Results[3];
+            EXPECT_TRUE(_File.compare_passwords(_Credentials, 3, _Results));
+            EXPECT_TRUE(_Results[0] && _Results[1] && _Results[2]);
+            EXPECT_TRUE(_File.flush());
+        }
+
+        {
+            const _Test_bytes& _Bytes = _Read_test_file(_Target);
+            EXPECT_EQ(_Bytes.size(), _Size + 2 * _Sudb_test_record_size);
+            for (size_t _Idx = 0; _Idx < 2; ++_Idx) {
+                const size_t _Off = _Size + _Idx * _Sudb_test_record_size;
+                EXPECT_EQ(_Bytes[_Off], 2); // modified entry
+                EXPECT_EQ(_Load_sudb_test_integer(_Bytes, _Off + 4), _Idx);
+                EXPECT_TRUE(_Load_sudb_test_params(_Bytes, _Off + 8) == _Params);
+            }
+        }
+
+        { // the re-hashed passwords are verified with their new parameters
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.ok());
+            EXPECT_TRUE(_File.compare_passwords(L"account-0", L"password-0"));
+            EXPECT_TRUE(_File.compare_passwords(L"account-1", L"password-1"));
+            EXPECT_FALSE(_File.compare_passwords(L"account-1", L"password-0"));
+            EXPECT_TRUE(_File.flush());
+        }
+
+        EXPECT_EQ(_SDSDLL file_size(_Target), _Size + 2 * _Sudb_test_record_size);
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+    }
+
+    TEST(extensions, sudb_concurrent_access) {
+        // Note: The writers add, rename, re-hash and erase their own entries and change the ARCs
+        //       of the shared ones, while the readers keep verifying the shared entries. A reader
+        //       must never see a shared entry missing or verify a wrong password.
+        static constexpr wchar_t _Target[] = L"unit_sudb_concurrent_access.sudb";
+        static constexpr size_t _Shared    = 4;
+        static constexpr size_t _Writers   = 2;
+        static constexpr size_t _Readers   = 4;
+        static constexpr size_t _Rounds    = 16;
+        _Make_sudb_test_file(_Target, _Shared);
+        {
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.ok());
+            _STD atomic<size_t> _Writing(_Writers);
+            _STD atomic<size_t> _Errors(0);
+            _STD vector<_STD thread> _Workers;
+            for (size_t _Idx = 0; _Idx < _Writers; ++_Idx) {
+                _Workers.emplace_back([&, _Idx] {
+                    for (size_t _Round = 0; _Round < _Rounds; ++_Round) {
+                        const _STD wstring& _Suffix  = _STD to_wstring(_Idx) + L"-" + _STD to_wstring(_Round);
+                        const _STD wstring& _Account = L"writer-" + _Suffix;
+                        const _STD wstring& _Renamed = L"renamed-" + _Suffix;
+                        const bool _Ok               = _File.append_entry(_Account, L"password-" + _Suffix)
+                            && _File.compare_passwords(_Account, L"password-" + _Suffix)
+                            && _File.modify_entry_password(_Account, L"new-password-" + _Suffix)
+                            && !_File.compare_passwords(_Account, L"password-" + _Suffix)
+                            && _File.modify_entry_account_name(_Account, _Renamed)
+                            && _File.compare_passwords(_Renamed, L"new-password-" + _Suffix)
+                            && _File.modify_entry_arc(L"account-" + _STD to_wstring(_Round % _Shared));
+                        _File.erase_entry(_Renamed);
+                        if (!_Ok || _File.has_entry(_Renamed)) {
+                            _Errors.fetch_add(1);
+                        }
+                    }
+
+                    _Writing.fetch_sub(1);
+                });
+            }
+
+            for (size_t _Idx = 0; _Idx < _Readers; ++_Idx) {
+                _Workers.emplace_back([&, _Idx] {
+                    // at least as many rounds as the writers make, even if they are already done
+                    for (size_t _Round = _Idx; _Round < _Idx + _Rounds || _Writing.load() > 0; ++_Round) {
+                        const size_t _Which             = _Round % _Shared;
+                        const size_t _Other             = (_Which + 1) % _Shared;
+                        const _STD wstring& _Account    = L"account-" + _STD to_wstring(_Which);
+                        const _STD wstring& _Password   = L"password-" + _STD to_wstring(_Which);
+                        const _STD wstring& _Wrong      = L"password-" + _STD to_wstring(_Other);
+                        const sudb_credentials _Batch[] = {{_Account, _Password}, {_Account, _Wrong}};
+                        bool _Results[2]                = {false, true};
+                        if (!_File.has_entry(_Account) || !_File.compare_passwords(_Account, _Password)
+                            || _File.compare_passwords(_Account, _Wrong)
+                            || !_File.compare_passwords(_Batch, 2, _Results) || !_Results[0] || _Results[1]) {
+                            _Errors.fetch_add(1);
+                        }
+                    }
+                });
+            }
+
+            for (_STD thread& _Worker : _Workers) {
+                _Worker.join();
+            }
+
+            EXPECT_EQ(_Errors.load(), size_t{0});
+            EXPECT_TRUE(_File.flush());
+        }
+
+        { // the journal replays to the same state
+            sudb_file _File(_Target);
+            EXPECT_TRUE(_File.ok());
+            for (size_t _Idx = 0; _Idx < _Shared; ++_Idx) {
+                const _STD wstring& _Suffix = _STD to_wstring(_Idx);
+                EXPECT_TRUE(_File.compare_passwords(L"account-" + _Suffix, L"password-" + _Suffix));
+            }
+
+            EXPECT_FALSE(_File.has_entry(L"writer-0-0"));
+            EXPECT_FALSE(_File.has_entry(L"renamed-0-0"));
+        }
+
+        EXPECT_TRUE(_SDSDLL delete_file(_Target));
+    }
+} // namespace tests
+
+#endif // _UNIT_EXTENSIONS_SUDB_HPP_
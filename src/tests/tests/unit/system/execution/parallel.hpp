@@ -0,0 +1,86 @@
+// parallel.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _UNIT_SYSTEM_EXECUTION_PARALLEL_HPP_
+#define _UNIT_SYSTEM_EXECUTION_PARALLEL_HPP_
+#include <atomic>
+#include <core/defs.hpp>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <system/execution/parallel.hpp>
+#include <vector>
+
+// SDSDLL types
+using _SDSDLL parallel_range;
+using _SDSDLL task_priority;
+using _SDSDLL thread_pool;
+using _SDSDLL thread_pool_mode;
+
+namespace tests {
+    // FUNCTION _Run_parallel_test
+    inline void _Run_parallel_test(const thread_pool_mode _Mode) {
+        static constexpr size_t _Count = 100'000;
+        thread_pool _Pool(2, _Mode);
+        _STD vector<_STD atomic<unsigned int>> _Hits(_Count);
+        for (_STD atomic<unsigned int>& _Hit : _Hits) {
+            _Hit.store(0);
+        }
+
+        // Note: The grains cover a single index, a typical grain and a grain larger than the range.
+        static constexpr size_t _Grains[] = {1, 64, _Count * 2};
+        for (const size_t _Grain : _Grains) {
+            _SDSDLL parallel_for(_Pool, parallel_range{0, _Count}, _Grain,
+                [&](const size_t _Idx) noexcept {
+                    _Hits[_Idx].fetch_add(1, _STD memory_order_relaxed);
+                }
+            );
+        }
+
+        _SDSDLL parallel_for(_Pool, parallel_range{0, _Count}, 64,
+            [&](const size_t _Idx) noexcept {
+                _Hits[_Idx].fetch_add(1, _STD memory_order_relaxed);
+            }, task_priority::high
+        );
+        for (size_t _Idx = 0; _Idx < _Count; ++_Idx) { // each index visited once for each call
+            EXPECT_EQ(_Hits[_Idx].load(), 4u);
+        }
+
+        bool _Called = false;
+        _SDSDLL parallel_for(_Pool, parallel_range{10, 10}, 1, [&](const size_t) noexcept {
+            _Called = true;
+        });
+        EXPECT_FALSE(_Called);
+
+        const size_t _Sum = _SDSDLL parallel_reduce(_Pool, parallel_range{1, _Count + 1}, 256, size_t{0},
+            [](const size_t _Idx) noexcept { return _Idx; },
+            [](const size_t _Left, const size_t _Right) noexcept { return _Left + _Right; }
+        );
+        EXPECT_EQ(_Sum, _Count * (_Count + 1) / 2);
+
+        _STD vector<size_t> _Input(_Count);
+        for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+            _Input[_Idx] = _Idx;
+        }
+
+        _STD vector<size_t> _Output(_Count, 0);
+        const auto _End = _SDSDLL parallel_transform(_Pool, _Input.begin(), _Input.end(), _Output.begin(),
+            128, [](const size_t _Value) noexcept { return _Value * 3; });
+        EXPECT_EQ(_End, _Output.end());
+        for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+            EXPECT_EQ(_Output[_Idx], _Idx * 3);
+        }
+    }
+
+    TEST(system_execution, parallel_per_thread) {
+        _Run_parallel_test(thread_pool_mode::per_thread);
+    }
+
+    TEST(system_execution, parallel_work_stealing) {
+        _Run_parallel_test(thread_pool_mode::work_stealing);
+    }
+} // namespace tests
+
+#endif // _UNIT_SYSTEM_EXECUTION_PARALLEL_HPP_
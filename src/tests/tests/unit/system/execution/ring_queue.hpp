@@ -0,0 +1,127 @@
+// ring_queue.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _UNIT_SYSTEM_EXECUTION_RING_QUEUE_HPP_
+#define _UNIT_SYSTEM_EXECUTION_RING_QUEUE_HPP_
+#include <atomic>
+#include <core/defs.hpp>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <system/execution/ring_queue.hpp>
+#include <thread>
+#include <vector>
+
+// SDSDLL types
+using _SDSDLL mpmc_ring_queue;
+using _SDSDLL spsc_ring_queue;
+
+namespace tests {
+    // FUNCTION TEMPLATE _Test_ring_queue_sequence
+    template <class _Queue>
+    inline void _Test_ring_queue_sequence(_Queue& _Ring) {
+        // Note: The capacity is rounded up to a power of 2, a push to a full queue fails.
+        EXPECT_EQ(_Ring.capacity(), size_t{8});
+        for (size_t _Idx = 0; _Idx < 8; ++_Idx) {
+            EXPECT_TRUE(_Ring.try_push(_Idx));
+        }
+
+        EXPECT_TRUE(_Ring.full());
+        EXPECT_FALSE(_Ring.try_push(size_t{8}));
+        size_t _Val = 0;
+        for (size_t _Idx = 0; _Idx < 8; ++_Idx) {
+            EXPECT_TRUE(_Ring.try_pop(_Val));
+            EXPECT_EQ(_Val, _Idx);
+        }
+
+        EXPECT_TRUE(_Ring.empty());
+        EXPECT_FALSE(_Ring.try_pop(_Val));
+
+        // Note: The batch operations move as many values as fit.
+        size_t _Input[6]  = {0, 1, 2, 3, 4, 5};
+        size_t _Output[8] = {};
+        EXPECT_EQ(_Ring.try_push_bulk(_Input, 6), size_t{6});
+        EXPECT_EQ(_Ring.try_push_bulk(_Input, 6), size_t{2});
+        EXPECT_EQ(_Ring.try_pop_bulk(_Output, 8), size_t{8});
+        EXPECT_EQ(_Output[5], size_t{5});
+        EXPECT_EQ(_Output[7], size_t{1});
+        EXPECT_EQ(_Ring.try_pop_bulk(_Output, 8), size_t{0});
+    }
+
+    TEST(system_execution, mpmc_ring_queue) {
+        mpmc_ring_queue<size_t> _Ring(5);
+        _Test_ring_queue_sequence(_Ring);
+
+        // Note: Every value pushed by the producers must be popped exactly once.
+        static constexpr size_t _Threads = 4;
+        static constexpr size_t _Values  = 20'000;
+        _STD atomic<size_t> _Popped(0);
+        _STD atomic<size_t> _Sum(0);
+        _STD vector<_STD thread> _Workers;
+        for (size_t _Thread = 0; _Thread < _Threads; ++_Thread) {
+            _Workers.emplace_back([&_Ring, _Thread] {
+                for (size_t _Idx = 1; _Idx <= _Values;) {
+                    if (_Ring.try_push(_Thread * _Values + _Idx)) {
+                        ++_Idx;
+                    } else {
+                        _STD this_thread::yield();
+                    }
+                }
+            });
+            _Workers.emplace_back([&_Ring, &_Popped, &_Sum] {
+                size_t _Val = 0;
+                while (_Popped.load() < _Threads * _Values) {
+                    if (_Ring.try_pop(_Val)) {
+                        _Sum.fetch_add(_Val);
+                        _Popped.fetch_add(1);
+                    } else {
+                        _STD this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        for (_STD thread& _Worker : _Workers) {
+            _Worker.join();
+        }
+
+        const size_t _Total = _Threads * _Values;
+        EXPECT_EQ(_Sum.load(), _Total * (_Total + 1) / 2);
+        EXPECT_TRUE(_Ring.empty());
+    }
+
+    TEST(system_execution, spsc_ring_queue) {
+        spsc_ring_queue<size_t> _Ring(8);
+        _Test_ring_queue_sequence(_Ring);
+
+        // Note: The values must arrive in the order they were pushed.
+        static constexpr size_t _Values = 100'000;
+        _STD thread _Producer([&_Ring] {
+            for (size_t _Idx = 1; _Idx <= _Values;) {
+                if (_Ring.try_push(_Idx)) {
+                    ++_Idx;
+                } else {
+                    _STD this_thread::yield();
+                }
+            }
+        });
+
+        size_t _Expected = 1;
+        size_t _Val      = 0;
+        while (_Expected <= _Values) {
+            if (_Ring.try_pop(_Val)) {
+                EXPECT_EQ(_Val, _Expected);
+                ++_Expected;
+            } else {
+                _STD this_thread::yield();
+            }
+        }
+
+        _Producer.join();
+        EXPECT_TRUE(_Ring.empty());
+    }
+} // namespace tests
+
+#endif // _UNIT_SYSTEM_EXECUTION_RING_QUEUE_HPP_
@@ -0,0 +1,90 @@
+// shared_lock.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _UNIT_SYSTEM_EXECUTION_SHARED_LOCK_HPP_
+#define _UNIT_SYSTEM_EXECUTION_SHARED_LOCK_HPP_
+#include <atomic>
+#include <core/defs.hpp>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <list>
+#include <system/execution/distributed_lock.hpp>
+#include <system/execution/futex_lock.hpp>
+#include <system/execution/shared_lock.hpp>
+#include <system/execution/shared_queue.hpp>
+#include <thread>
+#include <vector>
+
+// SDSDLL types
+using _SDSDLL distributed_shared_lock;
+using _SDSDLL exclusive_lock_guard;
+using _SDSDLL futex_shared_lock;
+using _SDSDLL shared_lock;
+using _SDSDLL shared_lock_guard;
+using _SDSDLL shared_queue;
+
+namespace tests {
+    // FUNCTION TEMPLATE _Run_shared_lock_test
+    template <class _Lock>
+    inline void _Run_shared_lock_test() {
+        // Note: The writers keep both values equal, so a reader that sees them differ has entered
+        //       while a writer was inside. More threads than reader slots share some of the slots.
+        static constexpr size_t _Threads    = 24;
+        static constexpr size_t _Iterations = 2000;
+        _Lock _Mylock;
+        size_t _First  = 0;
+        size_t _Second = 0;
+        _STD atomic<size_t> _Torn(0);
+        _STD vector<_STD thread> _Workers;
+        for (size_t _Idx = 0; _Idx < _Threads; ++_Idx) {
+            _Workers.emplace_back([&, _Idx] {
+                for (size_t _Iter = 0; _Iter < _Iterations; ++_Iter) {
+                    if ((_Iter + _Idx) % 8 == 0) { // one in eight operations writes
+                        exclusive_lock_guard _Guard(_Mylock);
+                        ++_First;
+                        ++_Second;
+                    } else {
+                        shared_lock_guard _Guard(_Mylock);
+                        if (_First != _Second) {
+                            _Torn.fetch_add(1);
+                        }
+                    }
+                }
+            });
+        }
+
+        for (_STD thread& _Worker : _Workers) {
+            _Worker.join();
+        }
+
+        EXPECT_EQ(_Torn.load(), size_t{0});
+        EXPECT_EQ(_First, _Threads * _Iterations / 8);
+        EXPECT_EQ(_Second, _First);
+
+        shared_queue<int, _STD list<int>, _Lock> _Queue;
+        _Queue.push(1);
+        _Queue.push(2);
+        EXPECT_EQ(_Queue.size(), size_t{2});
+        EXPECT_EQ(_Queue.top(), 1);
+        EXPECT_EQ(_Queue.pop(), 1);
+        EXPECT_EQ(_Queue.pop(), 2);
+        EXPECT_TRUE(_Queue.empty());
+    }
+
+    TEST(system_execution, shared_lock) {
+        _Run_shared_lock_test<shared_lock>();
+    }
+
+    TEST(system_execution, distributed_shared_lock) {
+        _Run_shared_lock_test<distributed_shared_lock>();
+    }
+
+    TEST(system_execution, futex_shared_lock) {
+        _Run_shared_lock_test<futex_shared_lock>();
+    }
+} // namespace tests
+
+#endif // _UNIT_SYSTEM_EXECUTION_SHARED_LOCK_HPP_
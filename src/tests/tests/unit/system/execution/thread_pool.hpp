@@ -0,0 +1,431 @@
+// thread_pool.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _UNIT_SYSTEM_EXECUTION_THREAD_POOL_HPP_
+#define _UNIT_SYSTEM_EXECUTION_THREAD_POOL_HPP_
+#include <atomic>
+#include <chrono>
+#include <core/defs.hpp>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <system/execution/thread_pool.hpp>
+#include <string>
+#include <thread>
+
+// SDSDLL types
+using _SDSDLL thread;
+using _SDSDLL thread_pool;
+using _SDSDLL task_future;
+using _SDSDLL task_options;
+using _SDSDLL task_priority;
+using _SDSDLL thread_pool_limits;
+using _SDSDLL thread_pool_mode;
+using _SDSDLL thread_pool_stats;
+using _SDSDLL worker_stats;
+
+namespace tests {
+    // FUNCTION _Wait_for_thread_pool_count
+    inline void _Wait_for_thread_pool_count(const _STD atomic<size_t>& _Counter, const size_t _Count) {
+        // Note: The tasks notify the waiting thread after each update of the counter.
+        size_t _Current = _Counter.load();
+        while (_Current != _Count) {
+            _Counter.wait(_Current);
+            _Current = _Counter.load();
+        }
+    }
+
+    // FUNCTION _Count_thread_pool_task
+    inline void _Count_thread_pool_task(_STD atomic<size_t>& _Counter) noexcept {
+        _Counter.fetch_add(1);
+        _Counter.notify_all();
+    }
+
+    // STRUCT _Thread_pool_test_data
+    struct _Thread_pool_test_data {
+        thread_pool* _Pool;
+        size_t _Children; // tasks submitted by each top-level task
+        _STD atomic<size_t> _Done;
+    };
+
+    // FUNCTION _Run_thread_pool_test
+    inline void _Run_thread_pool_test(const thread_pool_mode _Mode) {
+        // Note: Each top-level task submits further tasks from inside the thread-pool, so that
+        //       the work-stealing pool has to spread them between the workers.
+        static constexpr size_t _Tasks    = 1000;
+        static constexpr size_t _Children = 16;
+        thread_pool _Pool(2, _Mode);
+        if (_Pool.threads() == 0) { // not enough cores
+            return;
+        }
+
+        EXPECT_EQ(_Pool.mode(), _Mode);
+        _Thread_pool_test_data _Data = {_SDSDLL addressof(_Pool), _Children, 0};
+        for (size_t _Idx = 0; _Idx < _Tasks; ++_Idx) {
+            EXPECT_TRUE(_Pool.submit_task(
+                [](void* const _Raw) noexcept {
+                    _Thread_pool_test_data* const _Data = static_cast<_Thread_pool_test_data*>(_Raw);
+                    for (size_t _Child = 0; _Child < _Data->_Children; ++_Child) {
+                        EXPECT_TRUE(_Data->_Pool->submit_task(
+                            [](void* const _Child_raw) noexcept {
+                                _Count_thread_pool_task(
+                                    static_cast<_Thread_pool_test_data*>(_Child_raw)->_Done);
+                            }, _Raw
+                        ));
+                    }
+
+                    _Count_thread_pool_task(_Data->_Done);
+                }, &_Data
+            ));
+        }
+
+        _Wait_for_thread_pool_count(_Data._Done, _Tasks * (_Children + 1));
+        _Pool.close();
+        EXPECT_FALSE(_Pool.submit_task([](void* const) noexcept {}, nullptr));
+    }
+
+    TEST(system_execution, thread_pool_per_thread) {
+        _Run_thread_pool_test(thread_pool_mode::per_thread);
+    }
+
+    TEST(system_execution, thread_pool_work_stealing) {
+        _Run_thread_pool_test(thread_pool_mode::work_stealing);
+    }
+
+    // FUNCTION _Thread_pool_fibonacci
+    inline size_t _Thread_pool_fibonacci(thread_pool& _Pool, const size_t _Number) {
+        if (_Number < 10) { // too small to split
+            return _Number < 2 ? _Number : _Thread_pool_fibonacci(_Pool, _Number - 1)
+                                         + _Thread_pool_fibonacci(_Pool, _Number - 2);
+        }
+
+        task_future<size_t> _Future = _Pool.submit(
+            [&_Pool, _Number] { return _Thread_pool_fibonacci(_Pool, _Number - 1); });
+        const size_t _Other = _Thread_pool_fibonacci(_Pool, _Number - 2);
+        return _Future.get() + _Other;
+    }
+
+    // FUNCTION _Run_thread_pool_future_test
+    inline void _Run_thread_pool_future_test(const thread_pool_mode _Mode) {
+        thread_pool _Pool(2, _Mode);
+        if (_Pool.threads() == 0) { // not enough cores
+            return;
+        }
+
+        task_future<int> _Sum = _Pool.submit(
+            [](const int _Left, const int _Right) { return _Left + _Right; }, 2, 3);
+        ASSERT_TRUE(_Sum.valid());
+        EXPECT_EQ(_Sum.get(), 5);
+        EXPECT_FALSE(_Sum.valid());
+
+        _STD atomic<int> _Value(0);
+        task_future<void> _Void = _Pool.submit([&_Value] { _Value.store(7); });
+        _Void.wait();
+        EXPECT_TRUE(_Void.ready());
+        _Void.get();
+        EXPECT_EQ(_Value.load(), 7);
+        EXPECT_TRUE(_Pool.submit([&_Value] { _Value.store(8); }).try_get());
+        EXPECT_EQ(_Value.load(), 8);
+        EXPECT_FALSE(_Void.try_get()); // the future is no longer valid
+
+        // Note: The capture does not fit in a pooled block, so the state is allocated on its own.
+        unsigned char _Large[512] = {};
+        _Large[511]               = 42;
+        EXPECT_EQ(_Pool.submit([_Large] { return static_cast<int>(_Large[511]); }).get(), 42);
+
+        const _STD string _Text = "task";
+        EXPECT_EQ(_Pool.submit([](const _STD string& _Str) { return _Str + "_future"; }, _Text).get(),
+            "task_future");
+
+        { // the result is dropped together with the future
+            task_future<_STD string> _Dropped = _Pool.submit([] { return _STD string(64, 'x'); });
+        }
+
+        // the threads run other tasks while they wait
+        EXPECT_EQ(_Pool.submit([&_Pool] { return _Thread_pool_fibonacci(_Pool, 18); }).get(), size_t{2584});
+        { // the awaited task is queued behind the waiting one, on the same thread
+            thread_pool _Single(1, _Mode);
+            task_future<int> _Outer = _Single.submit(
+                [&_Single] { return _Single.submit([] { return 11; }).get() + 1; });
+            EXPECT_EQ(_Outer.get(), 12);
+        }
+
+        _Pool.close();
+        EXPECT_FALSE(_Pool.submit([] { return 0; }).valid());
+    }
+
+    TEST(system_execution, thread_pool_futures_per_thread) {
+        _Run_thread_pool_future_test(thread_pool_mode::per_thread);
+    }
+
+    TEST(system_execution, thread_pool_futures_work_stealing) {
+        _Run_thread_pool_future_test(thread_pool_mode::work_stealing);
+    }
+
+    // STRUCT _Thread_pool_stats_data
+    struct _Thread_pool_stats_data {
+        thread_pool* _Pool;
+        size_t _Threads; // one gate and one fence for each thread
+        _STD atomic<bool> _Open; // blocks the gates until set
+        _STD atomic<size_t> _Arrived; // number of fences that have started
+        _STD atomic<size_t> _Done;
+        thread_pool_stats _Stats; // taken by the last fence
+    };
+
+    // FUNCTION _Run_thread_pool_stats_test
+    inline void _Run_thread_pool_stats_test(const thread_pool_mode _Mode) {
+        // Note: Each thread is blocked by a gate until all tasks are queued, so the tasks are spread
+        //       evenly and each thread ends up with one fence. A task is counted right after it returns,
+        //       so the snapshot is taken by the last fence, when every thread has counted its tasks,
+        //       but not yet its fence (each fence is counted as started).
+        static constexpr size_t _Tasks = 1000;
+        thread_pool _Pool(2, _Mode);
+        if (_Pool.threads() == 0) { // not enough cores
+            return;
+        }
+
+        _Thread_pool_stats_data _Data = {_SDSDLL addressof(_Pool), _Pool.threads(), false, 0, 0, {}};
+        for (size_t _Idx = 0; _Idx < _Data._Threads; ++_Idx) {
+            EXPECT_TRUE(_Pool.submit_task(
+                [](void* const _Raw) noexcept {
+                    static_cast<_Thread_pool_stats_data*>(_Raw)->_Open.wait(false);
+                }, &_Data
+            ));
+        }
+
+        for (size_t _Idx = 0; _Idx < _Tasks; ++_Idx) {
+            EXPECT_TRUE(_Pool.submit_task(
+                [](void* const _Raw) noexcept {
+                    static_cast<_Thread_pool_stats_data*>(_Raw)->_Done.fetch_add(1);
+                }, &_Data
+            ));
+        }
+
+        for (size_t _Idx = 0; _Idx < _Data._Threads; ++_Idx) {
+            EXPECT_TRUE(_Pool.submit_task(
+                [](void* const _Raw) noexcept {
+                    _Thread_pool_stats_data* const _Data = static_cast<_Thread_pool_stats_data*>(_Raw);
+                    if (_Data->_Arrived.fetch_add(1) + 1 == _Data->_Threads) { // the last fence
+                        _Data->_Stats = _Data->_Pool->stats();
+                        _Data->_Arrived.fetch_add(1);
+                        _Data->_Arrived.notify_all();
+                    } else {
+                        _Wait_for_thread_pool_count(_Data->_Arrived, _Data->_Threads + 1);
+                    }
+                }, &_Data
+            ));
+        }
+
+        _Data._Open.store(true);
+        _Data._Open.notify_all();
+        _Wait_for_thread_pool_count(_Data._Arrived, _Data._Threads + 1);
+        const thread_pool_stats& _Stats = _Data._Stats;
+        const size_t _Finished          = _Tasks + _Data._Threads; // the tasks and the gates
+        EXPECT_EQ(_Data._Done.load(), _Tasks);
+        EXPECT_EQ(_Stats.total.tasks, uint64_t{_Finished});
+        EXPECT_EQ(_Stats.workers.size(), _Pool.threads());
+        EXPECT_EQ(_Stats.queued, size_t{0});
+        uint64_t _Histogram = 0;
+        uint64_t _Tasks_sum = 0;
+        for (const worker_stats& _Worker : _Stats.workers) {
+            _Tasks_sum += _Worker.tasks;
+        }
+
+        for (const uint64_t _Count : _Stats.total.wait_histogram) {
+            _Histogram += _Count;
+        }
+
+        EXPECT_EQ(_Tasks_sum, uint64_t{_Finished});
+        EXPECT_EQ(_Histogram, uint64_t{_Finished + _Data._Threads}); // the fences have started
+        if (_Mode == thread_pool_mode::per_thread) { // per-thread queues are never stolen from
+            EXPECT_EQ(_Stats.total.steals, uint64_t{0});
+        }
+    }
+
+    TEST(system_execution, thread_pool_stats_per_thread) {
+        _Run_thread_pool_stats_test(thread_pool_mode::per_thread);
+    }
+
+    TEST(system_execution, thread_pool_stats_work_stealing) {
+        _Run_thread_pool_stats_test(thread_pool_mode::work_stealing);
+    }
+
+    // STRUCT _Thread_pool_priority_data
+    struct _Thread_pool_priority_data {
+        _STD atomic<bool> _Started; // set by the first task
+        _STD atomic<bool> _Release; // blocks the first task until set
+        _STD atomic<size_t> _Sequence; // next position in the execution order
+        _STD atomic<size_t> _Expired; // number of dropped tasks
+        size_t _Order[64]; // positions of the tasks in the execution order
+    };
+
+    // FUNCTION _Run_thread_pool_priority_test
+    inline void _Run_thread_pool_priority_test(const thread_pool_mode _Mode) {
+        // Note: The only thread is blocked, so that all tasks wait in the queues. Once released,
+        //       the high-priority tasks must run before all normal ones, no matter the submission order.
+        static constexpr size_t _Tasks = 32;
+        thread_pool _Pool(1, _Mode);
+        _Thread_pool_priority_data _Data = {false, false, 0, 0, {}};
+        EXPECT_TRUE(_Pool.submit_task(
+            [](void* const _Raw) noexcept {
+                _Thread_pool_priority_data* const _Data = static_cast<_Thread_pool_priority_data*>(_Raw);
+                _Data->_Started.store(true);
+                _Data->_Started.notify_all();
+                _Data->_Release.wait(false);
+            }, &_Data
+        ));
+        _Data._Started.wait(false);
+
+        struct _Ordered_task {
+            _Thread_pool_priority_data* _Data;
+            size_t _Index;
+        } _Ordered[_Tasks * 2];
+        for (size_t _Idx = 0; _Idx < _Tasks * 2; ++_Idx) { // normal tasks first, high-priority ones last
+            _Ordered[_Idx]             = _Ordered_task{_SDSDLL addressof(_Data), _Idx};
+            const task_priority _Level = _Idx < _Tasks ? task_priority::normal : task_priority::high;
+            EXPECT_TRUE(_Pool.submit_task(
+                [](void* const _Raw) noexcept {
+                    const _Ordered_task* const _Task    = static_cast<const _Ordered_task*>(_Raw);
+                    _Task->_Data->_Order[_Task->_Index] = _Task->_Data->_Sequence.fetch_add(1);
+                }, _SDSDLL addressof(_Ordered[_Idx]), task_options{_Level, 0, nullptr}
+            ));
+        }
+
+        // Note: These tasks expire while the thread is blocked, so they never run.
+        task_future<int> _Dropped = _Pool.submit(
+            task_options{task_priority::high, 1, nullptr}, []() noexcept { return 1; });
+        EXPECT_TRUE(_Pool.submit_task(
+            [](void* const) noexcept {
+                ADD_FAILURE() << "an expired task must not run";
+            }, &_Data, task_options{task_priority::normal, 1,
+                [](void* const _Raw) noexcept {
+                    static_cast<_Thread_pool_priority_data*>(_Raw)->_Expired.fetch_add(1);
+                }
+            }
+        ));
+        task_future<int> _Kept = _Pool.submit(
+            task_options{task_priority::high, 60'000, nullptr}, []() noexcept { return 2; });
+
+        // Note: The fence is the last task in the queues, so it runs once all other tasks have run
+        //       (or expired) and takes the snapshot when all of them have been counted.
+        task_future<thread_pool_stats> _Fence = _Pool.submit([&_Pool] { return _Pool.stats(); });
+
+        // Note: The deadlines are measured from the submission, so they have passed for sure
+        //       once twice as much time has elapsed since.
+        _STD this_thread::sleep_until(_STD chrono::steady_clock::now() + _STD chrono::milliseconds(2));
+        _Data._Release.store(true);
+        _Data._Release.notify_all();
+        _Dropped.wait();
+        EXPECT_TRUE(_Dropped.expired());
+        int _Value = 0;
+        EXPECT_FALSE(_Dropped.try_get(_Value));
+        EXPECT_EQ(_Value, 0);
+        EXPECT_FALSE(_Dropped.valid());
+        EXPECT_TRUE(_Kept.try_get(_Value));
+        EXPECT_EQ(_Value, 2);
+        const thread_pool_stats& _Stats = _Fence.get();
+        EXPECT_EQ(_Data._Sequence.load(), _Tasks * 2);
+        EXPECT_EQ(_Data._Expired.load(), size_t{1});
+        for (size_t _Idx = _Tasks; _Idx < _Tasks * 2; ++_Idx) { // the high-priority tasks ran first
+            EXPECT_LT(_Data._Order[_Idx], _Tasks);
+        }
+
+        EXPECT_EQ(_Stats.total.expired, uint64_t{2});
+    }
+
+    TEST(system_execution, thread_pool_priority_per_thread) {
+        _Run_thread_pool_priority_test(thread_pool_mode::per_thread);
+    }
+
+    TEST(system_execution, thread_pool_priority_work_stealing) {
+        _Run_thread_pool_priority_test(thread_pool_mode::work_stealing);
+    }
+
+    // FUNCTION _Wait_for_thread_pool_threads
+    inline bool _Wait_for_thread_pool_threads(const thread_pool& _Pool, const size_t _Count) {
+        // Note: The thread-pool does not signal that a thread has retired, so its size is polled.
+        const auto _Deadline = _STD chrono::steady_clock::now() + _STD chrono::seconds(10);
+        while (_Pool.threads() != _Count) {
+            if (_STD chrono::steady_clock::now() > _Deadline) {
+                return false;
+            }
+
+            _STD this_thread::sleep_for(_STD chrono::milliseconds(1));
+        }
+
+        return true;
+    }
+
+    TEST(system_execution, thread_pool_clamped_count) {
+        // Note: A count above the number of cores used to create no threads at all.
+        thread_pool _Pool(thread::hardware_concurrency() + 1);
+        EXPECT_EQ(_Pool.threads(), thread::hardware_concurrency());
+        EXPECT_FALSE(_Pool.is_elastic());
+        EXPECT_FALSE(_Pool.increase_threads(1)); // the same bound as in the constructor
+
+        // Note: A thread-pool may grow up to the number of cores, not one thread fewer.
+        thread_pool _Small(1);
+        EXPECT_TRUE(_Small.increase_threads(thread::hardware_concurrency() - 1)
+            || thread::hardware_concurrency() == 1);
+        EXPECT_EQ(_Small.threads(), thread::hardware_concurrency());
+        EXPECT_FALSE(_Small.increase_threads(1));
+    }
+
+    // STRUCT _Thread_pool_blocking_data
+    struct _Thread_pool_blocking_data {
+        _STD atomic<bool> _Release; // blocks the tasks until set
+        _STD atomic<size_t> _Started; // number of tasks that have started
+    };
+
+    // FUNCTION _Submit_thread_pool_blocking_tasks
+    inline void _Submit_thread_pool_blocking_tasks(
+        thread_pool& _Pool, _Thread_pool_blocking_data& _Data, const size_t _Count) {
+        // Note: Each task blocks its thread until released, so the waiting tasks pile up and the
+        //       thread-pool has to start new threads to run them.
+        _Data._Release.store(false);
+        _Data._Started.store(0);
+        for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+            EXPECT_TRUE(_Pool.submit_task(
+                [](void* const _Raw) noexcept {
+                    _Thread_pool_blocking_data* const _Data = static_cast<_Thread_pool_blocking_data*>(_Raw);
+                    _Count_thread_pool_task(_Data->_Started);
+                    _Data->_Release.wait(false);
+                }, &_Data
+            ));
+        }
+
+        _Wait_for_thread_pool_count(_Data._Started, _Count); // all tasks run at the same time
+    }
+
+    // FUNCTION _Release_thread_pool_blocking_tasks
+    inline void _Release_thread_pool_blocking_tasks(_Thread_pool_blocking_data& _Data) noexcept {
+        _Data._Release.store(true);
+        _Data._Release.notify_all();
+    }
+
+    TEST(system_execution, thread_pool_elastic) {
+        const size_t _Max = (_STD min)(size_t{4}, thread::hardware_concurrency());
+        thread_pool _Pool(thread_pool_limits{1, _Max, 50, 100, 1});
+        EXPECT_TRUE(_Pool.is_elastic());
+        EXPECT_EQ(_Pool.mode(), thread_pool_mode::work_stealing);
+        EXPECT_EQ(_Pool.threads(), size_t{1});
+
+        _Thread_pool_blocking_data _Data = {false, 0};
+        _Submit_thread_pool_blocking_tasks(_Pool, _Data, _Max);
+        EXPECT_EQ(_Pool.threads(), _Max);
+        _Release_thread_pool_blocking_tasks(_Data);
+
+        // Note: Once idle, the threads above the minimum retire after the idle timeout.
+        EXPECT_TRUE(_Wait_for_thread_pool_threads(_Pool, 1));
+
+        // Note: The thread-pool grows again after it shrank.
+        _Submit_thread_pool_blocking_tasks(_Pool, _Data, _Max);
+        EXPECT_EQ(_Pool.threads(), _Max);
+        _Release_thread_pool_blocking_tasks(_Data);
+        _Pool.close();
+    }
+} // namespace tests
+
+#endif // _UNIT_SYSTEM_EXECUTION_THREAD_POOL_HPP_